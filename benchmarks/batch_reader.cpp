@@ -0,0 +1,120 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// External includes
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+
+// Local includes
+#include "../src/batch_reader.hpp"
+#include "../src/util.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Open every statistic that a full sample of the host reads on each
+ * tick.
+ */
+std::vector<syst::fd_t> open_host_files() {
+    std::vector<fs::path> paths;
+    std::error_code err;
+
+    for (const char* class_path : { "/sys/block", "/sys/class/net" }) {
+        for (const auto& device : fs::directory_iterator(class_path, err)) {
+            paths.push_back(device.path() / "stat");
+            for (const auto& stat :
+              fs::directory_iterator(device.path() / "statistics", err)) {
+                paths.push_back(stat.path());
+            }
+        }
+    }
+    for (const auto& zone : fs::directory_iterator("/sys/class/thermal", err)) {
+        paths.push_back(zone.path() / "temp");
+    }
+    for (const auto& chip : fs::directory_iterator("/sys/class/hwmon", err)) {
+        for (const auto& attribute : fs::directory_iterator(chip.path(), err)) {
+            const std::string name = attribute.path().filename();
+            if (name.find("_input") != std::string::npos) {
+                paths.push_back(attribute.path());
+            }
+        }
+    }
+
+    std::vector<syst::fd_t> files;
+    for (const fs::path& path : paths) {
+        syst::fd_t file{ open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (file.is_open()) {
+            files.push_back(std::move(file));
+        }
+    }
+    return files;
+}
+
+/**
+ * @brief Open every hwmon input of the fixture tree.
+ */
+std::vector<syst::fd_t> open_fixture_files() {
+    const fs::path hwmon_path =
+      get_fixture_tree().get_sys_path() / "class" / "hwmon";
+
+    std::vector<syst::fd_t> files;
+    for (const auto& chip : fs::directory_iterator(hwmon_path)) {
+        for (const auto& attribute : fs::directory_iterator(chip.path())) {
+            const std::string name = attribute.path().filename();
+            if (name.find("_input") != std::string::npos) {
+                files.emplace_back(
+                  open(attribute.path().c_str(), O_RDONLY | O_CLOEXEC));
+            }
+        }
+    }
+    return files;
+}
+
+void read_files(
+  benchmark::State& state, const std::vector<syst::fd_t>& files) {
+    const bool use_io_uring = state.range(0) != 0;
+
+    std::vector<const syst::fd_t*> file_ptrs;
+    for (const syst::fd_t& file : files) {
+        file_ptrs.push_back(&file);
+    }
+    syst::batch_reader_t reader{ std::move(file_ptrs), 64, use_io_uring };
+    if (use_io_uring && ! reader.uses_io_uring()) {
+        state.SkipWithError("io_uring is unavailable");
+        return;
+    }
+
+    // Warm up the caches and the kernel workers once before timing.
+    reader.read();
+
+    for (auto _ : state) {
+        reader.read();
+    }
+    state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(files.size()));
+    state.counters["files"] = static_cast<double>(files.size());
+}
+
+void batch_reader_host(benchmark::State& state) {
+    const std::vector<syst::fd_t> files = open_host_files();
+    read_files(state, files);
+}
+BENCHMARK(batch_reader_host)
+  ->ArgName("io_uring")
+  ->Arg(0)
+  ->Arg(1)
+  ->Unit(benchmark::kMicrosecond);
+
+void batch_reader_fixture(benchmark::State& state) {
+    const std::vector<syst::fd_t> files = open_fixture_files();
+    read_files(state, files);
+}
+BENCHMARK(batch_reader_fixture)
+  ->ArgName("io_uring")
+  ->Arg(0)
+  ->Arg(1)
+  ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,87 @@
+// Standard includes
+#include <filesystem>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Time a function that enumerates devices and report the number of
+ * devices it found.
+ */
+template<typename enumerate_t>
+void enumerate(benchmark::State& state, const enumerate_t& enumerate) {
+    size_t devices = 0;
+    for (auto _ : state) {
+        auto result = enumerate();
+        if (result.has_error()) {
+            state.SkipWithError(result.error().string().c_str());
+            return;
+        }
+        devices = result->size();
+    }
+    state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(devices));
+    state.counters["devices"] = static_cast<double>(devices);
+}
+
+fs::path fixture_class_path(const char* class_name) {
+    return get_fixture_tree().get_sys_path() / "class" / class_name;
+}
+
+void enumerate_thermal_zones(benchmark::State& state) {
+    const fs::path path = fixture_class_path("thermal");
+    enumerate(state, [&] { return syst::get_thermal_zones(path); });
+}
+BENCHMARK(enumerate_thermal_zones)->Unit(benchmark::kMicrosecond);
+
+void enumerate_cooling_devices(benchmark::State& state) {
+    const fs::path path = fixture_class_path("thermal");
+    enumerate(state, [&] { return syst::get_cooling_devices(path); });
+}
+BENCHMARK(enumerate_cooling_devices)->Unit(benchmark::kMicrosecond);
+
+void enumerate_hwmon_chips(benchmark::State& state) {
+    const fs::path path = fixture_class_path("hwmon");
+    enumerate(state, [&] { return syst::get_hwmon_chips(path); });
+}
+BENCHMARK(enumerate_hwmon_chips)->Unit(benchmark::kMillisecond);
+
+void enumerate_batteries(benchmark::State& state) {
+    const fs::path path = fixture_class_path("power_supply");
+    enumerate(state, [&] { return syst::get_batteries(path); });
+}
+BENCHMARK(enumerate_batteries)->Unit(benchmark::kMicrosecond);
+
+void enumerate_backlights(benchmark::State& state) {
+    const fs::path path = fixture_class_path("backlight");
+    enumerate(state, [&] { return syst::get_backlights(path); });
+}
+BENCHMARK(enumerate_backlights)->Unit(benchmark::kMicrosecond);
+
+void enumerate_disks(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    enumerate(state, [] { return syst::get_disks(); });
+}
+BENCHMARK(enumerate_disks)->Unit(benchmark::kMicrosecond);
+
+void enumerate_network_interfaces(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    enumerate(state, [] { return syst::get_network_interfaces(); });
+}
+BENCHMARK(enumerate_network_interfaces)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,409 @@
+// Standard includes
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+// External includes
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+fs::path fixture_parent = fs::temp_directory_path();
+std::unique_ptr<fixture_tree_t> fixture_tree;
+
+void write_file(const fs::path& path, const std::string& contents) {
+    std::ofstream file{ path };
+    file << contents << '\n';
+}
+
+/**
+ * @brief Write the uevent file of a power supply and the attribute file of
+ * each of its properties (POWER_SUPPLY_<NAME>=<value> -> <name>).
+ */
+void write_power_supply_uevent(
+  const fs::path& path, const std::string& contents) {
+    write_file(path / "uevent", contents);
+
+    const std::string prefix = "POWER_SUPPLY_";
+    std::istringstream lines{ contents };
+    std::string line;
+    while (std::getline(lines, line)) {
+        const size_t separator = line.find('=');
+        std::string name =
+          line.substr(prefix.size(), separator - prefix.size());
+        std::transform(name.begin(), name.end(), name.begin(), [](char chr) {
+            return static_cast<char>(std::tolower(chr));
+        });
+        write_file(path / name, line.substr(separator + 1));
+    }
+}
+
+/**
+ * @brief Create a device directory and link it into a class directory the way
+ * sysfs does (class/<class>/<name> -> ../../devices/.../<name>).
+ */
+fs::path add_device(const fs::path& sys_path,
+  const std::string& class_name,
+  const std::string& device_path,
+  const std::string& name) {
+    const fs::path path = sys_path / "devices" / device_path / name;
+    fs::create_directories(path);
+    fs::create_directory_symlink(
+      fs::path{ "../../devices" } / device_path / name,
+      sys_path / "class" / class_name / name);
+    return path;
+}
+
+std::string disk_name(size_t index) {
+    return "nvme" + std::to_string(index) + "n1";
+}
+
+std::string part_name(size_t disk, size_t part) {
+    return disk_name(disk) + "p" + std::to_string(part + 1);
+}
+
+void add_block_attributes(const fs::path& path, size_t index) {
+    write_file(path / "size", std::to_string(1000215216 + index));
+    write_file(path / "ro", "0");
+    write_file(path / "inflight", "       0        0");
+    write_file(path / "stat", make_block_stat(index));
+}
+
+void add_disks(const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "block");
+    fs::create_directories(sys_path / "class" / "block");
+
+    for (size_t disk = 0; disk < scale.disks; ++disk) {
+        const std::string name = disk_name(disk);
+        const std::string device_path =
+          "pci0000:00/nvme/nvme" + std::to_string(disk);
+
+        const fs::path path =
+          add_device(sys_path, "block", device_path, name);
+        fs::create_directory_symlink(
+          fs::path{ "../devices" } / device_path / name,
+          sys_path / "block" / name);
+
+        add_block_attributes(path, disk);
+        write_file(path / "removable", "0");
+        fs::create_directory(path / "queue");
+        write_file(path / "queue" / "rotational", "0");
+        write_file(path / "queue" / "iostats", "1");
+
+        for (size_t part = 0; part < scale.parts_per_disk; ++part) {
+            const fs::path part_path = path / part_name(disk, part);
+            fs::create_directory(part_path);
+            write_file(part_path / "partition", std::to_string(part + 1));
+            write_file(
+              part_path / "start", std::to_string(2048 + part * 1048576));
+            add_block_attributes(part_path, disk + part);
+            fs::create_directory_symlink(
+              fs::path{ "../../devices" } / device_path / name
+                / part_name(disk, part),
+              sys_path / "class" / "block" / part_name(disk, part));
+        }
+    }
+}
+
+void add_network_interfaces(
+  const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "class" / "net");
+
+    for (size_t idx = 0; idx < scale.network_interfaces; ++idx) {
+        // Half of the interfaces are virtual (bridges, veths, ...).
+        const bool physical = idx % 2 == 0;
+        const std::string name =
+          (physical ? "eth" : "veth") + std::to_string(idx);
+        const fs::path path = add_device(sys_path,
+          "net",
+          physical ? "pci0000:00/0000:00:1f.6/net" : "virtual/net",
+          name);
+
+        write_file(path / "operstate", idx % 3 == 0 ? "down" : "up");
+        write_file(path / "type", "1");
+        write_file(path / "mtu", "1500");
+        fs::create_directory(path / "statistics");
+        const std::string base = std::to_string(idx * 1000);
+        for (const char* stat : { "rx_bytes",
+               "tx_bytes",
+               "rx_packets",
+               "tx_packets",
+               "rx_errors",
+               "tx_errors",
+               "rx_dropped",
+               "tx_dropped" }) {
+            write_file(path / "statistics" / stat, base);
+        }
+    }
+}
+
+void add_hwmon_chips(const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "class" / "hwmon");
+
+    for (size_t idx = 0; idx < scale.hwmon_chips; ++idx) {
+        const fs::path path = add_device(sys_path,
+          "hwmon",
+          "platform/coretemp." + std::to_string(idx) + "/hwmon",
+          "hwmon" + std::to_string(idx));
+
+        write_file(path / "name", "coretemp");
+        for (size_t temp = 1; temp <= 8; ++temp) {
+            const std::string prefix = "temp" + std::to_string(temp);
+            write_file(
+              path / (prefix + "_input"), std::to_string(40000 + temp));
+            write_file(
+              path / (prefix + "_label"), "Core " + std::to_string(temp));
+            write_file(path / (prefix + "_max"), "80000");
+            write_file(path / (prefix + "_crit"), "100000");
+        }
+        for (size_t fan = 1; fan <= 4; ++fan) {
+            const std::string prefix = "fan" + std::to_string(fan);
+            write_file(path / (prefix + "_input"), std::to_string(1200 + fan));
+            write_file(path / (prefix + "_min"), "300");
+        }
+        for (size_t in = 0; in < 8; ++in) {
+            write_file(path / ("in" + std::to_string(in) + "_input"),
+              std::to_string(1000 + in));
+        }
+    }
+}
+
+void add_thermal_devices(
+  const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "class" / "thermal");
+
+    for (size_t idx = 0; idx < scale.thermal_zones; ++idx) {
+        const fs::path path = add_device(sys_path,
+          "thermal",
+          "virtual/thermal",
+          "thermal_zone" + std::to_string(idx));
+        write_file(path / "type", "x86_pkg_temp");
+        write_file(path / "temp", std::to_string(45000 + idx));
+    }
+
+    for (size_t idx = 0; idx < scale.cooling_devices; ++idx) {
+        const fs::path path = add_device(sys_path,
+          "thermal",
+          "virtual/thermal",
+          "cooling_device" + std::to_string(idx));
+        write_file(path / "type", "Processor");
+        write_file(path / "cur_state", "0");
+        write_file(path / "max_state", "10");
+    }
+}
+
+void add_power_supplies(
+  const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "class" / "power_supply");
+
+    for (size_t idx = 0; idx < scale.batteries; ++idx) {
+        const fs::path path = add_device(sys_path,
+          "power_supply",
+          "LNXSYSTM:00/PNP0C0A:0" + std::to_string(idx) + "/power_supply",
+          "BAT" + std::to_string(idx));
+        write_file(path / "type", "Battery");
+        write_power_supply_uevent(path, make_battery_uevent(idx));
+    }
+
+    // Power supplies that are not batteries are enumerated and skipped.
+    const fs::path path =
+      add_device(sys_path, "power_supply", "LNXSYSTM:00/ACPI0003:00", "AC");
+    write_file(path / "type", "Mains");
+    write_file(path / "uevent", "POWER_SUPPLY_NAME=AC\nPOWER_SUPPLY_ONLINE=1");
+}
+
+void add_backlights(const fs::path& sys_path, const fixture_scale_t& scale) {
+    fs::create_directories(sys_path / "class" / "backlight");
+
+    for (size_t idx = 0; idx < scale.backlights; ++idx) {
+        const fs::path path = add_device(sys_path,
+          "backlight",
+          "pci0000:00/0000:00:02.0/drm/card0-eDP-" + std::to_string(idx),
+          "intel_backlight" + std::to_string(idx));
+        write_file(path / "brightness", "250");
+        write_file(path / "max_brightness", "1000");
+    }
+}
+
+fixture_tree_t::fixture_tree_t(
+  const fs::path& root, const fixture_scale_t& scale)
+: root_(root), scale_(scale) {
+    fs::remove_all(this->root_);
+
+    const fs::path sys_path = this->get_sys_path();
+    add_disks(sys_path, scale);
+    add_network_interfaces(sys_path, scale);
+    add_hwmon_chips(sys_path, scale);
+    add_thermal_devices(sys_path, scale);
+    add_power_supplies(sys_path, scale);
+    add_backlights(sys_path, scale);
+
+    const fs::path proc_path = this->get_proc_path();
+    fs::create_directories(proc_path);
+    write_file(proc_path / "stat", make_proc_stat(scale.cpus));
+    write_file(
+      proc_path / "mounts", make_mounts(scale.disks, scale.parts_per_disk));
+
+    fs::create_directories(this->get_dev_path());
+}
+
+fixture_tree_t::~fixture_tree_t() {
+    std::error_code err;
+    fs::remove_all(this->root_, err);
+}
+
+const fs::path& fixture_tree_t::get_root() const {
+    return this->root_;
+}
+
+const fixture_scale_t& fixture_tree_t::get_scale() const {
+    return this->scale_;
+}
+
+fs::path fixture_tree_t::get_sys_path() const {
+    return this->root_ / "sys";
+}
+
+fs::path fixture_tree_t::get_proc_path() const {
+    return this->root_ / "proc";
+}
+
+fs::path fixture_tree_t::get_dev_path() const {
+    return this->root_ / "dev";
+}
+
+void set_fixture_parent(const fs::path& parent) {
+    fixture_parent = parent;
+}
+
+const fixture_tree_t& get_fixture_tree() {
+    if (fixture_tree == nullptr) {
+        fixture_tree = std::make_unique<fixture_tree_t>(fixture_parent
+            / ("system_state_benchmark_" + std::to_string(getpid())),
+          fixture_scale_t{});
+    }
+    return *fixture_tree;
+}
+
+res::result_t use_fixture_roots() {
+    const fixture_tree_t& tree = get_fixture_tree();
+
+    syst::roots_t roots;
+    roots.sys = tree.get_sys_path();
+    roots.proc = tree.get_proc_path();
+    roots.dev = tree.get_dev_path();
+
+    auto result = syst::set_roots(roots);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+void remove_fixture_tree() {
+    fixture_tree.reset();
+}
+
+std::string make_proc_stat(size_t cpus) {
+    std::string contents;
+
+    // The first line is the sum of the lines of every CPU.
+    const auto add_cpu = [&](const std::string& name, size_t scale) {
+        contents += name;
+        for (size_t field : { 10132153, 290696, 3084719, 46828483, 16683, 0,
+               25195, 0, 0, 0 }) {
+            contents += ' ' + std::to_string(field * scale);
+        }
+        contents += '\n';
+    };
+    add_cpu("cpu ", cpus);
+    for (size_t idx = 0; idx < cpus; ++idx) {
+        add_cpu("cpu" + std::to_string(idx), 1);
+    }
+
+    contents += "intr 1462898 0 9 0 0 0 0 0 0 1 0 0 0 0 0 0 0\n";
+    contents += "ctxt 2329862\n";
+    contents += "btime 1700000000\n";
+    contents += "processes 50000\n";
+    contents += "procs_running 4\n";
+    contents += "procs_blocked 0\n";
+    contents += "softirq 229245889 94 60001584 13619 5175704 2471304 0 "
+                "4032 0 0 0\n";
+    return contents;
+}
+
+std::string make_mounts(size_t disks, size_t parts_per_disk) {
+    std::string contents;
+    contents += "proc /proc proc rw,nosuid,nodev,noexec,relatime 0 0\n";
+    contents += "sysfs /sys sysfs rw,nosuid,nodev,noexec,relatime 0 0\n";
+    contents += "tmpfs /run tmpfs rw,nosuid,nodev,mode=755 0 0\n";
+
+    for (size_t disk = 0; disk < disks; ++disk) {
+        for (size_t part = 0; part < parts_per_disk; ++part) {
+            const std::string name = part_name(disk, part);
+            contents +=
+              "/dev/" + name + " /mnt/" + name + " ext4 rw,relatime 0 0\n";
+        }
+    }
+    return contents;
+}
+
+std::string make_block_stat(size_t index) {
+    std::string contents;
+    for (size_t field : { 90133, 4390, 6753154, 15722, 191004, 163383,
+           12394018, 142981, 0, 172604, 177018, 0, 0, 0, 0, 8321, 18314 }) {
+        contents += ' ' + std::to_string(field + index);
+    }
+    return contents;
+}
+
+std::string make_battery_uevent(size_t index) {
+    return "POWER_SUPPLY_NAME=BAT" + std::to_string(index)
+      + "\n"
+        "POWER_SUPPLY_TYPE=Battery\n"
+        "POWER_SUPPLY_STATUS=Discharging\n"
+        "POWER_SUPPLY_PRESENT=1\n"
+        "POWER_SUPPLY_TECHNOLOGY=Li-ion\n"
+        "POWER_SUPPLY_CYCLE_COUNT=120\n"
+        "POWER_SUPPLY_VOLTAGE_MIN_DESIGN=11400000\n"
+        "POWER_SUPPLY_VOLTAGE_NOW=12100000\n"
+        "POWER_SUPPLY_POWER_NOW=8500000\n"
+        "POWER_SUPPLY_ENERGY_FULL_DESIGN=57000000\n"
+        "POWER_SUPPLY_ENERGY_FULL=52000000\n"
+        "POWER_SUPPLY_ENERGY_NOW=31000000\n"
+        "POWER_SUPPLY_CAPACITY=59\n"
+        "POWER_SUPPLY_CAPACITY_LEVEL=Normal\n"
+        "POWER_SUPPLY_MODEL_NAME=5B10W13930\n"
+        "POWER_SUPPLY_MANUFACTURER=SMP\n"
+        "POWER_SUPPLY_SERIAL_NUMBER=  123";
+}
+
+std::string make_kernel_uevent(size_t index) {
+    const std::string devpath = "/devices/pci0000:00/nvme/nvme"
+      + std::to_string(index) + "/" + disk_name(index);
+
+    std::string message = "change@" + devpath;
+    message.push_back('\0');
+    const std::vector<std::string> properties{ "ACTION=change",
+      "DEVPATH=" + devpath,
+      "SUBSYSTEM=block",
+      "DEVNAME=" + disk_name(index),
+      "DEVTYPE=disk",
+      "DISKSEQ=9",
+      "SEQNUM=" + std::to_string(4000 + index),
+      "MAJOR=259",
+      "MINOR=" + std::to_string(index) };
+    for (const std::string& property : properties) {
+        message += property;
+        message.push_back('\0');
+    }
+    return message;
+}
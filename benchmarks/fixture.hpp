@@ -0,0 +1,132 @@
+#pragma once
+
+// Standard includes
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+/**
+ * @brief The number of devices of each kind in a generated fixture tree.
+ * The defaults describe a very large host.
+ */
+struct fixture_scale_t {
+    size_t cpus = 4096;
+    size_t disks = 1000;
+    size_t parts_per_disk = 2;
+    size_t network_interfaces = 2000;
+    size_t hwmon_chips = 200;
+    size_t thermal_zones = 64;
+    size_t cooling_devices = 64;
+    size_t batteries = 4;
+    size_t backlights = 4;
+};
+
+/**
+ * @brief A generated copy of the sysfs and procfs files read by this library,
+ * laid out like the real file systems (<root>/sys/... and <root>/proc/...),
+ * with an empty devfs (<root>/dev). The tree is removed when this object is
+ * destroyed.
+ */
+class fixture_tree_t {
+    std::filesystem::path root_;
+    fixture_scale_t scale_;
+
+  public:
+    /**
+     * @param[in] root - The directory to generate the tree in. It is replaced
+     * if it already exists.
+     * @param[in] scale - The number of devices of each kind.
+     */
+    fixture_tree_t(
+      const std::filesystem::path& root, const fixture_scale_t& scale);
+    fixture_tree_t(const fixture_tree_t&) = delete;
+    fixture_tree_t(fixture_tree_t&&) noexcept = delete;
+    fixture_tree_t& operator=(const fixture_tree_t&) = delete;
+    fixture_tree_t& operator=(fixture_tree_t&&) noexcept = delete;
+    ~fixture_tree_t();
+
+    /**
+     * @return the directory that the tree was generated in.
+     */
+    [[nodiscard]] const std::filesystem::path& get_root() const;
+
+    /**
+     * @return the number of devices of each kind in the tree.
+     */
+    [[nodiscard]] const fixture_scale_t& get_scale() const;
+
+    /**
+     * @return the root of the generated sysfs tree (like /sys).
+     */
+    [[nodiscard]] std::filesystem::path get_sys_path() const;
+
+    /**
+     * @return the root of the generated procfs tree (like /proc).
+     */
+    [[nodiscard]] std::filesystem::path get_proc_path() const;
+
+    /**
+     * @return the root of the generated devfs tree (like /dev).
+     */
+    [[nodiscard]] std::filesystem::path get_dev_path() const;
+};
+
+/**
+ * @brief Set the directory that the shared fixture tree is generated in. Must
+ * be called before the tree is first used.
+ *
+ * @param[in] parent - The parent directory of the tree. The temporary
+ * directory is used by default.
+ */
+void set_fixture_parent(const std::filesystem::path& parent);
+
+/**
+ * @brief Get the fixture tree shared by every benchmark of the process. The
+ * tree is generated at the default scale the first time it is used so that
+ * benchmarks that do not need it do not wait for it.
+ */
+[[nodiscard]] const fixture_tree_t& get_fixture_tree();
+
+/**
+ * @brief Resolve the procfs, sysfs, and devfs paths of the library against the
+ * shared fixture tree (see syst::set_roots) so that functions without path
+ * parameters read the fixture tree instead of the host.
+ *
+ * @return nothing if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::result_t use_fixture_roots();
+
+/**
+ * @brief Remove the shared fixture tree if it was generated.
+ */
+void remove_fixture_tree();
+
+/**
+ * @return the contents of /proc/stat on a host with the given number of CPUs.
+ */
+[[nodiscard]] std::string make_proc_stat(size_t cpus);
+
+/**
+ * @return the contents of /proc/mounts on a host whose partitions are all
+ * mounted.
+ */
+[[nodiscard]] std::string make_mounts(size_t disks, size_t parts_per_disk);
+
+/**
+ * @return the contents of the stat file of a block device.
+ */
+[[nodiscard]] std::string make_block_stat(size_t index);
+
+/**
+ * @return the contents of the uevent file of a battery.
+ */
+[[nodiscard]] std::string make_battery_uevent(size_t index);
+
+/**
+ * @return a kernel event message (null-separated properties) as received from
+ * the uevent multicast group.
+ */
+[[nodiscard]] std::string make_kernel_uevent(size_t index);
@@ -0,0 +1,36 @@
+// Standard includes
+#include <cstring>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "fixture.hpp"
+
+// The option that selects the directory the fixture tree is generated in.
+const char* const fixture_parent_option = "--fixture_parent=";
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    // Google Benchmark leaves the options it does not recognize in place.
+    int unused_argc = 1;
+    for (int idx = 1; idx < argc; ++idx) {
+        const size_t option_len = std::strlen(fixture_parent_option);
+        if (std::strncmp(argv[idx], fixture_parent_option, option_len) == 0) {
+            set_fixture_parent(argv[idx] + option_len);
+            continue;
+        }
+        argv[unused_argc++] = argv[idx];
+    }
+    argc = unused_argc;
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    remove_fixture_tree();
+
+    return 0;
+}
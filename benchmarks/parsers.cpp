@@ -0,0 +1,114 @@
+// Standard includes
+#include <string>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "../src/util.hpp"
+#include "fixture.hpp"
+
+// Each benchmark reads and parses one file or message of the given kind. The
+// files are cached by the kernel, so the time is dominated by parsing.
+
+void parse_kernel_uevent(benchmark::State& state) {
+    const std::string message = make_kernel_uevent(0);
+
+    for (auto _ : state) {
+        auto properties =
+          syst::parse_netlink_uevent(message.data(), message.size());
+        benchmark::DoNotOptimize(properties);
+    }
+    state.SetBytesProcessed(
+      state.iterations() * static_cast<int64_t>(message.size()));
+}
+BENCHMARK(parse_kernel_uevent);
+
+void parse_battery_uevent(benchmark::State& state) {
+    auto batteries = syst::get_batteries(
+      get_fixture_tree().get_sys_path() / "class" / "power_supply");
+    if (batteries.has_error()) {
+        state.SkipWithError(batteries.error().string().c_str());
+        return;
+    }
+
+    for (auto _ : state) {
+        auto snapshot = batteries->front().get_snapshot();
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(parse_battery_uevent);
+
+void parse_proc_stat(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    const syst::cpu_usage_t cpu_usage;
+
+    for (auto _ : state) {
+        auto result = cpu_usage.update();
+        if (result.failure()) {
+            state.SkipWithError(result.error().string().c_str());
+            return;
+        }
+    }
+}
+BENCHMARK(parse_proc_stat)->Unit(benchmark::kMicrosecond);
+
+void parse_block_stat(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    auto disks = syst::get_disks();
+    if (disks.has_error()) {
+        state.SkipWithError(disks.error().string().c_str());
+        return;
+    }
+    if (disks->empty()) {
+        state.SkipWithError("There are no disks.");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto io_stat = disks->front().get_io_stat();
+        benchmark::DoNotOptimize(io_stat);
+    }
+}
+BENCHMARK(parse_block_stat);
+
+void parse_mounts(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    auto disks = syst::get_disks();
+    if (disks.has_error()) {
+        state.SkipWithError(disks.error().string().c_str());
+        return;
+    }
+
+    for (const syst::disk_t& disk : disks.value()) {
+        auto parts = disk.get_parts();
+        if (parts.has_error() || parts->empty()) {
+            continue;
+        }
+
+        // The last partition is the last line searched in the mount table.
+        for (auto _ : state) {
+            auto mount_info = parts->back().get_mount_info();
+            benchmark::DoNotOptimize(mount_info);
+        }
+        return;
+    }
+    state.SkipWithError("There are no partitions.");
+}
+BENCHMARK(parse_mounts)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,111 @@
+// Standard includes
+#include <functional>
+#include <string>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+// Each benchmark records the reads of one parser from the fixture tree and
+// then parses the recorded contents, which leaves the parser without any file
+// system access. Compare with the benchmarks of the same name in parsers.cpp.
+
+/**
+ * @brief Record the reads made by a function into a capture file and replay
+ * it until the benchmark finishes.
+ *
+ * @param[in] state - The state of the benchmark.
+ * @param[in] name - The name of the capture file.
+ * @param[in] read - Reads the files to record and replay. Returns false if
+ * the read failed.
+ * @return true if the capture is being replayed and false if the benchmark
+ * was skipped.
+ */
+bool start_replay(benchmark::State& state,
+  const std::string& name,
+  const std::function<bool()>& read) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return false;
+    }
+
+    const std::filesystem::path capture_path =
+      get_fixture_tree().get_root() / ("capture_" + name);
+
+    auto result = syst::start_recording(capture_path);
+    if (result.failure()) {
+        state.SkipWithError(result.error().string().c_str());
+        return false;
+    }
+    const bool recorded = read();
+    result = syst::stop_recording();
+    if (result.failure()) {
+        state.SkipWithError(result.error().string().c_str());
+        return false;
+    }
+    if (! recorded) {
+        state.SkipWithError("Failed to read the files to record.");
+        return false;
+    }
+
+    result = syst::start_replay(capture_path);
+    if (result.failure()) {
+        state.SkipWithError(result.error().string().c_str());
+        return false;
+    }
+    return true;
+}
+
+void replay_proc_stat(benchmark::State& state) {
+    const syst::cpu_usage_t cpu_usage;
+    if (! start_replay(state, "proc_stat", [&] {
+            return cpu_usage.update().success();
+        })) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto result = cpu_usage.update();
+        if (result.failure()) {
+            state.SkipWithError(result.error().string().c_str());
+            break;
+        }
+    }
+    syst::stop_replay();
+}
+BENCHMARK(replay_proc_stat)->Unit(benchmark::kMicrosecond);
+
+void replay_block_stat(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+    auto disks = syst::get_disks();
+    if (disks.has_error()) {
+        state.SkipWithError(disks.error().string().c_str());
+        return;
+    }
+    if (disks->empty()) {
+        state.SkipWithError("There are no disks.");
+        return;
+    }
+
+    const syst::disk_t& disk = disks->front();
+    if (! start_replay(state, "block_stat", [&] {
+            return disk.get_io_stat().has_value();
+        })) {
+        return;
+    }
+
+    for (auto _ : state) {
+        auto io_stat = disk.get_io_stat();
+        benchmark::DoNotOptimize(io_stat);
+    }
+    syst::stop_replay();
+}
+BENCHMARK(replay_block_stat);
@@ -0,0 +1,68 @@
+// Standard includes
+#include <vector>
+
+// External includes
+#include <benchmark/benchmark.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+void snapshot_collect(benchmark::State& state) {
+    auto roots = use_fixture_roots();
+    if (roots.failure()) {
+        state.SkipWithError(roots.error().string().c_str());
+        return;
+    }
+
+    const fixture_tree_t& tree = get_fixture_tree();
+    const syst::cpu_usage_t cpu_usage;
+
+    syst::collect_options_t options;
+    options.cpu_usage = &cpu_usage;
+    options.parallel = state.range(0) != 0;
+    options.thermal_path = tree.get_sys_path() / "class" / "thermal";
+    options.power_supply_path = tree.get_sys_path() / "class" / "power_supply";
+    options.backlight_path = tree.get_sys_path() / "class" / "backlight";
+
+    for (auto _ : state) {
+        auto snapshot = syst::collect(options);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(snapshot_collect)
+  ->ArgName("parallel")
+  ->Arg(0)
+  ->Arg(1)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+void snapshot_hwmon(benchmark::State& state) {
+    auto chips = syst::get_hwmon_chips(
+      get_fixture_tree().get_sys_path() / "class" / "hwmon",
+      state.range(0) != 0);
+    if (chips.has_error()) {
+        state.SkipWithError(chips.error().string().c_str());
+        return;
+    }
+
+    size_t sensors = 0;
+    for (const syst::hwmon_chip_t& chip : chips.value()) {
+        sensors += chip.get_sensors().size();
+    }
+
+    for (auto _ : state) {
+        for (syst::hwmon_chip_t& chip : chips.value()) {
+            auto result = chip.update();
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(
+      state.iterations() * static_cast<int64_t>(sensors));
+    state.counters["sensors"] = static_cast<double>(sensors);
+}
+BENCHMARK(snapshot_hwmon)
+  ->ArgName("io_uring")
+  ->Arg(0)
+  ->Arg(1)
+  ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,65 @@
+// Standard includes
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main(int argc, char** argv) {
+    // Sweep the brightness of the first backlight from 0% to the given
+    // brightness (50% by default) as fast as possible, but write to the
+    // backlight at most once every 50 milliseconds.
+
+    double brightness = 50;
+    if (argc > 1) {
+        brightness = std::stod(argv[1]);
+    }
+
+    auto backlights = syst::get_backlights();
+    if (backlights.has_error()) {
+        std::cerr << backlights.error().string() << '\n';
+        return 1;
+    }
+    if (backlights->empty()) {
+        std::cerr << "No backlights found." << '\n';
+        return 1;
+    }
+
+    auto actuator =
+      syst::get_actuator(backlights->front(), std::chrono::milliseconds(50));
+    if (actuator.has_error()) {
+        std::cerr << actuator.error().string() << '\n';
+        return 1;
+    }
+
+    const double step = 0.1;
+
+    for (double value = 0; value <= brightness; value += step) {
+        auto result = actuator->set(value);
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            return 1;
+        }
+
+        // Pending changes are written once the minimum interval has passed.
+        result = actuator->dispatch();
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    auto result = actuator->flush();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    std::cout << "Brightness: " << actuator->get() << '\n';
+
+    return 0;
+}
@@ -16,7 +16,14 @@ int main() {
         std::cout << "sysfs path: " << device.get_sysfs_path().string() << '\n';
         std::cout << "Name: " << device.get_name() << '\n';
 
-        auto status = device.get_status();
+        // Read every attribute once so that all values below are consistent.
+        auto snapshot = device.get_snapshot();
+        if (snapshot.has_error()) {
+            std::cerr << snapshot.error().string() << '\n';
+            continue;
+        }
+
+        auto status = snapshot->get_status();
         if (status.has_value()) {
             std::cout << "Status: ";
             switch (status.value()) {
@@ -41,35 +48,35 @@ int main() {
             std::cerr << status.error().string() << '\n';
         }
 
-        auto current = device.get_current();
+        auto current = snapshot->get_current();
         if (current.has_value()) {
             std::cout << "Current: " << current.value() << " A" << '\n';
         } else {
             std::cerr << current.error().string() << '\n';
         }
 
-        auto power = device.get_power();
+        auto power = snapshot->get_power();
         if (power.has_value()) {
             std::cout << "Power: " << power.value() << " W" << '\n';
         } else {
             std::cerr << power.error().string() << '\n';
         }
 
-        auto charge = device.get_charge();
+        auto charge = snapshot->get_charge();
         if (charge.has_value()) {
             std::cout << "Charge: " << charge.value() << "%" << '\n';
         } else {
             std::cerr << charge.error().string() << '\n';
         }
 
-        auto capacity = device.get_capacity();
+        auto capacity = snapshot->get_capacity();
         if (capacity.has_value()) {
             std::cout << "Capacity: " << capacity.value() << "%" << '\n';
         } else {
             std::cerr << capacity.error().string() << '\n';
         }
 
-        auto time_remaining = device.get_time_remaining();
+        auto time_remaining = snapshot->get_time_remaining();
         if (time_remaining.has_value()) {
             const uint64_t hours = time_remaining->count() / 3600;
             const uint64_t minutes = (time_remaining->count() % 3600) / 60;
@@ -12,4 +12,13 @@
         return 1;                                                              \
     }
 
+// Print the message of the last error without allocating it.
+#define ASSERT_OK(call)                                                        \
+    if ((call) != syst_ok) {                                                   \
+        char message[512];                                                     \
+        syst_get_last_error(message, sizeof(message));                         \
+        fprintf(stderr, "%s\n", message);                                      \
+        return 1;                                                              \
+    }
+
 #endif // SYST_MACRO_H
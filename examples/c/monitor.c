@@ -0,0 +1,82 @@
+// Standard includes
+#include <stdio.h>
+#include <unistd.h>
+
+// External includes
+#include "../../system_state/system_state.h"
+#include "macro.h"
+
+#define SAMPLES 5
+#define MAX_CORES 256
+#define MAX_INTERFACES 64
+#define MAX_ZONES 64
+
+int main() {
+    char* error = NULL;
+
+    // Devices are enumerated once and sampled repeatedly. Every sample is
+    // written into arrays that are allocated once.
+
+    syst_cpu_usage_t* cpu_usage = syst_cpu_usage_new();
+    if (cpu_usage == NULL) {
+        return 1;
+    }
+    ASSERT_OK(syst_cpu_usage_update(cpu_usage));
+
+    syst_network_interface_list_t* interface_list =
+      syst_get_network_interfaces(&error);
+    ASSERT_SUCCESS();
+
+    syst_thermal_zone_list_t* zone_list = syst_get_thermal_zones(&error);
+    ASSERT_SUCCESS();
+
+    double per_core[MAX_CORES];
+    syst_network_interface_snapshot_t interfaces[MAX_INTERFACES];
+    syst_thermal_zone_snapshot_t zones[MAX_ZONES];
+
+    for (int sample = 0; sample < SAMPLES; ++sample) {
+        sleep(1);
+
+        syst_system_info_t info;
+        ASSERT_OK(syst_get_system_info(&info));
+        printf("ram: %.2f%%, load: %.2f\n", info.ram_usage, info.load_1);
+
+        ASSERT_OK(syst_cpu_usage_update(cpu_usage));
+        unsigned long core_count = MAX_CORES;
+        ASSERT_OK(
+          syst_cpu_usage_get_per_core(cpu_usage, per_core, &core_count));
+        for (unsigned long idx = 0; idx < core_count; ++idx) {
+            printf("cpu%lu: %.2f%%\n", idx, per_core[idx]);
+        }
+
+        unsigned long interface_count =
+          syst_network_interface_list_get_size(interface_list, &error);
+        ASSERT_SUCCESS();
+        ASSERT_OK(syst_network_interface_list_snapshot(
+          interface_list, interfaces, MAX_INTERFACES));
+        for (unsigned long idx = 0; idx < interface_count; ++idx) {
+            if (interfaces[idx].has_stat) {
+                printf("%s: %llu bytes down, %llu bytes up\n",
+                  interfaces[idx].name,
+                  (unsigned long long)interfaces[idx].bytes_down,
+                  (unsigned long long)interfaces[idx].bytes_up);
+            }
+        }
+
+        unsigned long zone_count =
+          syst_thermal_zone_list_get_size(zone_list, &error);
+        ASSERT_SUCCESS();
+        ASSERT_OK(syst_thermal_zone_list_snapshot(zone_list, zones, MAX_ZONES));
+        for (unsigned long idx = 0; idx < zone_count; ++idx) {
+            if (zones[idx].has_temperature) {
+                printf("%s: %.1f C\n", zones[idx].name, zones[idx].temperature);
+            }
+        }
+    }
+
+    syst_thermal_zone_list_free(zone_list);
+    syst_network_interface_list_free(interface_list);
+    syst_cpu_usage_free(cpu_usage);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Standard includes
+#include <stdio.h>
+
+// External includes
+#include "../../system_state/system_state.h"
+#include "macro.h"
+
+int main() {
+    char* error = NULL;
+
+    syst_backlight_list_t* backlight_list = syst_get_backlights(&error);
+    ASSERT_SUCCESS();
+
+    unsigned long backlight_count =
+      syst_backlight_list_get_size(backlight_list, &error);
+    ASSERT_SUCCESS();
+
+    for (unsigned long idx = 0; idx < backlight_count; ++idx) {
+        syst_backlight_t* backlight =
+          syst_backlight_list_get(backlight_list, idx, &error);
+        ASSERT_SUCCESS();
+
+        syst_backlight_snapshot_t snapshot;
+        ASSERT_OK(syst_backlight_snapshot(backlight, &snapshot));
+        printf("%s: %.2f%%\n", snapshot.name, snapshot.brightness);
+    }
+
+    syst_backlight_list_free(backlight_list);
+
+    syst_battery_list_t* battery_list = syst_get_batteries(&error);
+    ASSERT_SUCCESS();
+
+    unsigned long battery_count =
+      syst_battery_list_get_size(battery_list, &error);
+    ASSERT_SUCCESS();
+
+    for (unsigned long idx = 0; idx < battery_count; ++idx) {
+        syst_battery_t* battery =
+          syst_battery_list_get(battery_list, idx, &error);
+        ASSERT_SUCCESS();
+
+        syst_battery_snapshot_t snapshot;
+        ASSERT_OK(syst_battery_snapshot(battery, &snapshot));
+        printf("%s:", snapshot.name);
+        if (snapshot.has_charge) {
+            printf(" %.2f%%", snapshot.charge);
+        }
+        if (snapshot.has_power) {
+            printf(" %.3f W", snapshot.power);
+        }
+        if (snapshot.has_time_remaining) {
+            printf(" %lu s remaining", snapshot.time_remaining);
+        }
+        printf("\n");
+    }
+
+    syst_battery_list_free(battery_list);
+
+    return 0;
+}
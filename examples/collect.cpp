@@ -0,0 +1,80 @@
+// Standard includes
+#include <iostream>
+#include <thread>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main() {
+    // Collect every subsystem twice, one second apart, and print how long each
+    // subsystem took to collect.
+
+    syst::cpu_usage_t cpu_usage;
+
+    syst::collect_options_t options;
+    options.cpu_usage = &cpu_usage;
+
+    static_cast<void>(syst::collect(options));
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    auto snapshot = syst::collect(options);
+
+    const auto print_latency = [](const std::string& name,
+                                 std::chrono::nanoseconds latency) {
+        std::cout << name << ": "
+                  << std::chrono::duration<double, std::micro>(latency).count()
+                  << " us" << '\n';
+    };
+
+    if (snapshot.cpu_usage.has_value()) {
+        print_latency("cpu usage", snapshot.cpu_usage->latency);
+        const auto& collected = snapshot.cpu_usage->value;
+        if (collected.has_value() && collected->total.has_value()) {
+            std::cout << "\ttotal: " << collected->total.value() << "%" << '\n';
+        }
+    }
+
+    if (snapshot.system_info.has_value()) {
+        print_latency("system info", snapshot.system_info->latency);
+        const auto& system_info = snapshot.system_info->value;
+        if (system_info.has_value()) {
+            std::cout << "\tram usage: " << system_info->ram_usage << "%"
+                      << '\n';
+        }
+    }
+
+    if (snapshot.disks.has_value()) {
+        print_latency("disks", snapshot.disks->latency);
+    }
+
+    if (snapshot.network_interfaces.has_value()) {
+        print_latency(
+          "network interfaces", snapshot.network_interfaces->latency);
+        const auto& network_interfaces = snapshot.network_interfaces->value;
+        if (network_interfaces.has_value()) {
+            for (const auto& collected : network_interfaces.value()) {
+                if (collected.stat.has_value()) {
+                    std::cout << '\t'
+                              << collected.network_interface.get_name() << ": "
+                              << collected.stat->bytes_down << " bytes down"
+                              << '\n';
+                }
+            }
+        }
+    }
+
+    if (snapshot.thermal_zones.has_value()) {
+        print_latency("thermal zones", snapshot.thermal_zones->latency);
+    }
+
+    if (snapshot.batteries.has_value()) {
+        print_latency("batteries", snapshot.batteries->latency);
+    }
+
+    if (snapshot.backlights.has_value()) {
+        print_latency("backlights", snapshot.backlights->latency);
+    }
+
+    print_latency("total", snapshot.latency);
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Standard includes
+#include <iostream>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+void print_devices(const syst::device_registry_t& registry) {
+    const auto& disks = registry.get_disks();
+    const auto& network_interfaces = registry.get_network_interfaces();
+    const auto& batteries = registry.get_batteries();
+
+    std::cout << "Generation " << registry.get_generation() << ": ";
+    if (disks.has_value()) {
+        std::cout << disks->size() << " disks, ";
+    }
+    if (network_interfaces.has_value()) {
+        std::cout << network_interfaces->size() << " network interfaces, ";
+    }
+    if (batteries.has_value()) {
+        std::cout << batteries->size() << " batteries, ";
+    }
+    std::cout << registry.get_enumerations() << " enumerations" << '\n';
+}
+
+int main() {
+    // Keep the device lists up to date as devices are plugged in and removed
+    // without enumerating sysfs in between.
+
+    auto registry = syst::get_device_registry();
+    if (registry.has_error()) {
+        std::cerr << registry.error().string() << '\n';
+        return 1;
+    }
+    print_devices(registry.value());
+
+    auto event_loop = syst::get_event_loop();
+    if (event_loop.has_error()) {
+        std::cerr << event_loop.error().string() << '\n';
+        return 1;
+    }
+
+    uint64_t generation = registry->get_generation();
+    auto id =
+      event_loop->subscribe_fd(registry->get_fd(), [&]() -> res::result_t {
+          auto result = registry->dispatch();
+          if (result.failure()) {
+              return RES_TRACE(result.error());
+          }
+
+          if (registry->get_generation() != generation) {
+              generation = registry->get_generation();
+              print_devices(registry.value());
+          }
+          return res::success;
+      });
+    if (id.has_error()) {
+        std::cerr << id.error().string() << '\n';
+        return 1;
+    }
+
+    auto result = event_loop->run();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
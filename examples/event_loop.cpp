@@ -0,0 +1,71 @@
+// Standard includes
+#include <iostream>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main() {
+    // Print changes to the mount table, network interfaces, power supplies,
+    // and backlights as they happen without polling any of them.
+
+    auto event_loop = syst::get_event_loop();
+    if (event_loop.has_error()) {
+        std::cerr << event_loop.error().string() << '\n';
+        return 1;
+    }
+
+    auto mounts = event_loop->subscribe_mounts(
+      []() { std::cout << "The mount table changed." << '\n'; });
+    if (mounts.has_error()) {
+        std::cerr << mounts.error().string() << '\n';
+        return 1;
+    }
+
+    auto links =
+      event_loop->subscribe_links([](const syst::link_event_t& event) {
+          std::cout << event.name << ": "
+                    << (event.removed ? "removed"
+                         : event.up   ? "up"
+                                      : "down")
+                    << '\n';
+      });
+    if (links.has_error()) {
+        std::cerr << links.error().string() << '\n';
+        return 1;
+    }
+
+    auto power_supply = event_loop->subscribe_power_supply(
+      [](const syst::power_supply_event_t& event) {
+          std::cout << event.name << " changed." << '\n';
+      });
+    if (power_supply.has_error()) {
+        std::cerr << power_supply.error().string() << '\n';
+        return 1;
+    }
+
+    auto backlights = syst::get_backlights();
+    if (backlights.has_error()) {
+        std::cerr << backlights.error().string() << '\n';
+        return 1;
+    }
+
+    for (const syst::backlight_t& backlight : backlights.value()) {
+        const std::string name = backlight.get_name();
+        auto id = event_loop->subscribe_backlight(
+          backlight, [name](double brightness) {
+              std::cout << name << ": " << brightness << "%" << '\n';
+          });
+        if (id.has_error()) {
+            std::cerr << id.error().string() << '\n';
+            return 1;
+        }
+    }
+
+    auto result = event_loop->run();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Standard includes
+#include <iostream>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+const char* unit(syst::hwmon_sensor_t::type_t type) {
+    switch (type) {
+        case syst::hwmon_sensor_t::type_t::temperature:
+            return "°C";
+        case syst::hwmon_sensor_t::type_t::fan:
+            return " RPM";
+        case syst::hwmon_sensor_t::type_t::voltage:
+            return " V";
+        case syst::hwmon_sensor_t::type_t::power:
+            return " W";
+        case syst::hwmon_sensor_t::type_t::current:
+            return " A";
+        default:
+            return "";
+    }
+}
+
+int main() {
+    auto chips = syst::get_hwmon_chips();
+    if (chips.has_error()) {
+        std::cerr << chips.error().string() << '\n';
+        return 1;
+    }
+
+    for (auto& chip : chips.value()) {
+        std::cout << "sysfs path: " << chip.get_sysfs_path().string() << '\n';
+        std::cout << "\tName: " << chip.get_name() << '\n';
+
+        auto result = chip.update();
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            continue;
+        }
+
+        for (const auto& sensor : chip.get_sensors()) {
+            std::cout << "\t" << sensor.get_label() << ": ";
+
+            auto value = sensor.get_value();
+            if (value.has_value()) {
+                std::cout << value.value() << unit(sensor.get_type());
+            } else {
+                std::cout << "N/A";
+            }
+
+            auto limits = sensor.get_limits();
+            if (limits.max.has_value()) {
+                std::cout << " (max: " << limits.max.value() << ")";
+            }
+            if (limits.crit.has_value()) {
+                std::cout << " (crit: " << limits.crit.value() << ")";
+            }
+
+            std::cout << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+// Standard includes
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// External includes
+#include <poll.h>
+
+#include "../system_state/system_state.hpp"
+
+int main(int argc, char** argv) {
+    // Fade every backlight to the given brightness (50% by default) over one
+    // second.
+
+    double brightness = 50;
+    if (argc > 1) {
+        brightness = std::stod(argv[1]);
+    }
+
+    auto backlights = syst::get_backlights();
+    if (backlights.has_error()) {
+        std::cerr << backlights.error().string() << '\n';
+        return 1;
+    }
+
+    syst::ramp_engine_t engine;
+
+    auto result = engine.start();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    for (const syst::backlight_t& backlight : backlights.value()) {
+        auto ramp = engine.ramp_brightness(
+          backlight, brightness, std::chrono::seconds(1));
+        if (ramp.has_error()) {
+            std::cerr << ramp.error().string() << '\n';
+            return 1;
+        }
+    }
+
+    while (engine.get_ramp_count() > 0) {
+        struct pollfd poll_fd {};
+        poll_fd.fd = engine.get_fd();
+        poll_fd.events = POLLIN;
+        if (poll(&poll_fd, 1, -1) < 0) {
+            continue;
+        }
+
+        result = engine.dispatch();
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            return 1;
+        }
+
+        for (const syst::ramp_event_t& event : engine.take_events()) {
+            if (event.error.has_value()) {
+                std::cerr << event.error->string() << '\n';
+            }
+        }
+    }
+
+    return 0;
+}
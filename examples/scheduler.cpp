@@ -0,0 +1,94 @@
+// Standard includes
+#include <iostream>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main() {
+    // Sample CPU usage every second, network statistics ten times a second,
+    // and thermal zones every five seconds on a single timer. Collectors run
+    // on multiples of their interval, so this stops within ten seconds.
+
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(100);
+    options.timer_slack = std::chrono::milliseconds(10);
+
+    auto scheduler = syst::get_scheduler(options);
+    if (scheduler.has_error()) {
+        std::cerr << scheduler.error().string() << '\n';
+        return 1;
+    }
+
+    auto network_interfaces = syst::get_network_interfaces();
+    if (network_interfaces.has_error()) {
+        std::cerr << network_interfaces.error().string() << '\n';
+        return 1;
+    }
+
+    auto thermal_zones = syst::get_thermal_zones();
+    if (thermal_zones.has_error()) {
+        std::cerr << thermal_zones.error().string() << '\n';
+        return 1;
+    }
+
+    syst::cpu_usage_t cpu_usage;
+    uint64_t bytes_down = 0;
+
+    auto cpu = scheduler->add(std::chrono::seconds(1), [&]() -> res::result_t {
+        auto result = cpu_usage.update();
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+
+        auto total = cpu_usage.get_total();
+        if (total.has_value()) {
+            std::cout << "cpu: " << total.value() << "%" << '\n';
+        }
+        std::cout << "bytes down: " << bytes_down << '\n';
+        return res::success;
+    });
+
+    auto network = scheduler->add(std::chrono::milliseconds(100), [&]() {
+        bytes_down = 0;
+        for (const auto& network_interface : network_interfaces.value()) {
+            auto stat = network_interface.get_stat();
+            if (stat.has_value()) {
+                bytes_down += stat->bytes_down;
+            }
+        }
+        return res::success;
+    });
+
+    auto thermal = scheduler->add(std::chrono::seconds(5), [&]() {
+        for (const auto& thermal_zone : thermal_zones.value()) {
+            auto temperature = thermal_zone.get_temperature();
+            if (temperature.has_value()) {
+                std::cout << thermal_zone.get_sysfs_path().filename().string()
+                          << ": " << temperature.value() << " C" << '\n';
+            }
+        }
+        return res::success;
+    });
+
+    auto stop = scheduler->add(std::chrono::seconds(10), [&]() {
+        scheduler->stop();
+        return res::success;
+    });
+
+    for (const auto* id : { &cpu, &network, &thermal, &stop }) {
+        if (id->has_error()) {
+            std::cerr << id->error().string() << '\n';
+            return 1;
+        }
+    }
+
+    auto result = scheduler->run();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    std::cout << "wakeups: " << scheduler->get_wakeups() << '\n';
+
+    return 0;
+}
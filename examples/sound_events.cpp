@@ -0,0 +1,86 @@
+// Standard includes
+#include <cerrno>
+#include <iostream>
+
+// External includes
+#include <poll.h>
+#include "../system_state/system_state.hpp"
+
+void print_volume(const char* label, const syst::sound_control_t::volume_t& v) {
+    std::cout << "\n\t" << label << ":";
+    if (v.front_left.has_value()) {
+        std::cout << " FL " << v.front_left.value() << '%';
+    }
+    if (v.front_right.has_value()) {
+        std::cout << " FR " << v.front_right.value() << '%';
+    }
+}
+
+void print_status(const char* label, const syst::sound_control_t::status_t& s) {
+    std::cout << "\n\t" << label << ":";
+    if (s.front_left.has_value()) {
+        std::cout << " FL " << (s.front_left.value() ? "on" : "off");
+    }
+    if (s.front_right.has_value()) {
+        std::cout << " FR " << (s.front_right.value() ? "on" : "off");
+    }
+}
+
+int main() {
+    // Print every change to a sound control element until interrupted.
+
+    auto mixer = syst::get_sound_mixer();
+    if (mixer.has_error()) {
+        std::cerr << mixer.error().string() << '\n';
+        return 1;
+    }
+
+    while (true) {
+        struct pollfd mixer_poll{};
+        mixer_poll.fd = mixer->get_fd();
+        mixer_poll.events = POLLIN;
+
+        if (poll(&mixer_poll, 1, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Failed to wait for the sound mixer." << '\n';
+            return 1;
+        }
+
+        auto events = mixer->dispatch();
+        if (events.has_error()) {
+            std::cerr << events.error().string() << '\n';
+            return 1;
+        }
+
+        for (const auto& event : events.value()) {
+            switch (event.type) {
+                case syst::sound_event_t::type_t::changed:
+                    std::cout << "Changed: ";
+                    break;
+                case syst::sound_event_t::type_t::added:
+                    std::cout << "Added: ";
+                    break;
+                case syst::sound_event_t::type_t::removed:
+                    std::cout << "Removed: ";
+                    break;
+            }
+            std::cout << event.name << ',' << event.index;
+
+            if (event.playback_status.has_value()) {
+                print_status("Playback Status", event.playback_status.value());
+            }
+            if (event.playback_volume.has_value()) {
+                print_volume("Playback Volume", event.playback_volume.value());
+            }
+            if (event.capture_status.has_value()) {
+                print_status("Capture Status", event.capture_status.value());
+            }
+            if (event.capture_volume.has_value()) {
+                print_volume("Capture Volume", event.capture_volume.value());
+            }
+            std::cout << '\n';
+        }
+    }
+}
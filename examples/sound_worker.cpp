@@ -0,0 +1,52 @@
+// Standard includes
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main(int argc, char** argv) {
+    // Fade the playback volume of the given control element ("Master" by
+    // default) to the given volume (0% by default) over one second.
+
+    std::string name = "Master";
+    if (argc > 1) {
+        name = argv[1];
+    }
+
+    double volume = 0;
+    if (argc > 2) {
+        volume = std::stod(argv[2]);
+    }
+
+    auto worker = syst::get_sound_worker();
+    if (worker.has_error()) {
+        std::cerr << worker.error().string() << '\n';
+        return 1;
+    }
+
+    auto result = worker
+                    ->ramp_playback_volume_all(
+                      name, 0, volume, std::chrono::seconds(1))
+                    .get();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    auto new_volume = worker->get_playback_volume(name).get();
+    if (new_volume.has_error()) {
+        std::cerr << new_volume.error().string() << '\n';
+        return 1;
+    }
+
+    if (new_volume->front_left.has_value()) {
+        std::cout << "Front Left: " << new_volume->front_left.value() << '\n';
+    }
+    if (new_volume->front_right.has_value()) {
+        std::cout << "Front Right: " << new_volume->front_right.value() << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Standard includes
+#include <iostream>
+#include <string>
+
+// External includes
+#include "../system_state/system_state.hpp"
+
+int main(int argc, char** argv) {
+    // Bind every cooling device to the first thermal zone and keep the zone
+    // below the given temperature (60°C by default) until interrupted.
+
+    double trip_temperature = 60;
+    if (argc > 1) {
+        trip_temperature = std::stod(argv[1]);
+    }
+
+    auto thermal_zones = syst::get_thermal_zones();
+    if (thermal_zones.has_error()) {
+        std::cerr << thermal_zones.error().string() << '\n';
+        return 1;
+    }
+    if (thermal_zones->empty()) {
+        std::cerr << "No thermal zones found." << '\n';
+        return 1;
+    }
+
+    auto cooling_devices = syst::get_cooling_devices();
+    if (cooling_devices.has_error()) {
+        std::cerr << cooling_devices.error().string() << '\n';
+        return 1;
+    }
+
+    syst::thermal_governor_t governor;
+
+    const double hysteresis = 5;
+
+    for (auto& device : cooling_devices.value()) {
+        auto result = governor.bind(thermal_zones->front(),
+          device,
+          syst::step_policy_t{ trip_temperature, hysteresis });
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            return 1;
+        }
+    }
+
+    const std::chrono::milliseconds period{ 20 };
+
+    auto result = governor.start(period);
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    result = governor.run();
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Standard includes
+#include <iostream>
+
+// External includes
+#include <poll.h>
+
+#include "../system_state/system_state.hpp"
+
+const char* event_name(syst::thermal_event_t::type_t type) {
+    switch (type) {
+        case syst::thermal_event_t::type_t::approaching_trip:
+            return "Approaching trip point";
+        case syst::thermal_event_t::type_t::throttling_started:
+            return "Throttling started";
+        case syst::thermal_event_t::type_t::throttling_stopped:
+            return "Throttling stopped";
+        case syst::thermal_event_t::type_t::trip_reached:
+            return "Trip point reached";
+        default:
+            return "";
+    }
+}
+
+int main() {
+    // Sample every thermal zone ten times per second and print a summary of
+    // each zone once per second.
+
+    auto monitor = syst::get_thermal_monitor();
+    if (monitor.has_error()) {
+        std::cerr << monitor.error().string() << '\n';
+        return 1;
+    }
+
+    const std::chrono::milliseconds period{ 100 };
+    const uint64_t samples_per_summary = 10;
+
+    auto result = monitor->start(period);
+    if (result.failure()) {
+        std::cerr << result.error().string() << '\n';
+        return 1;
+    }
+
+    for (uint64_t sample = 1;; ++sample) {
+        struct pollfd timer_poll{};
+        timer_poll.fd = monitor->get_fd();
+        timer_poll.events = POLLIN;
+        if (poll(&timer_poll, 1, -1) < 0) {
+            continue;
+        }
+
+        result = monitor->dispatch();
+        if (result.failure()) {
+            std::cerr << result.error().string() << '\n';
+            return 1;
+        }
+
+        for (const auto& event : monitor->take_events()) {
+            const auto& zone = monitor->get_zones().at(event.zone);
+            std::cout << event_name(event.type) << ": " << zone.type << " at "
+                      << event.temperature << "°C (" << event.trip_point.type
+                      << " trip point at " << event.trip_point.temperature
+                      << "°C)" << '\n';
+        }
+
+        if (sample % samples_per_summary != 0) {
+            continue;
+        }
+
+        const auto& zones = monitor->get_zones();
+        for (size_t index = 0; index < zones.size(); ++index) {
+            const auto& zone = zones[index];
+            std::cout << zone.type << ": " << zone.current
+                      << "°C (min: " << zone.min << "°C, max: " << zone.max
+                      << "°C, average: " << zone.ewma << "°C";
+
+            const double percentile = 95;
+            auto p95 = monitor->get_percentile(index, percentile);
+            if (p95.has_value()) {
+                std::cout << ", 95th percentile: " << p95.value() << "°C";
+            }
+            std::cout << ")" << '\n';
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,318 @@
+// Standard includes
+#include <algorithm>
+
+// External includes
+#include <fcntl.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+struct actuator_state_t {
+    fs::path path;
+    fd_t fd;
+
+    // Read once when the actuator is created.
+    uint64_t max_value = 0;
+
+    // The value most recently written to (or read from) the file.
+    uint64_t written_value = 0;
+
+    // The most recently requested percentage and its raw value, which has not
+    // been written yet if a write is pending.
+    double requested = 0;
+    uint64_t requested_value = 0;
+    bool pending = false;
+
+    ch::nanoseconds min_interval{};
+    std::optional<ch::steady_clock::time_point> last_write;
+    fd_t timer;
+    bool armed = false;
+};
+
+struct actuator_t::impl_t {
+    actuator_state_t state;
+
+    impl_t() = default;
+    impl_t(const impl_t&) = delete;
+    impl_t(impl_t&&) noexcept = delete;
+    impl_t& operator=(const impl_t&) = delete;
+    impl_t& operator=(impl_t&&) noexcept = delete;
+
+    ~impl_t() {
+        if (! this->state.pending) {
+            return;
+        }
+
+        // The latest value is always written eventually. Destructors have no
+        // way of communicating failure.
+        int err = syst::write_int(this->state.fd, this->state.requested_value);
+        static_cast<void>(err);
+    }
+};
+
+[[nodiscard]] res::result_t arm_actuator(
+  actuator_state_t& state, ch::nanoseconds delay) {
+    auto result = syst::set_timer(state.timer, delay);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    state.armed = delay.count() > 0;
+    return res::success;
+}
+
+[[nodiscard]] res::result_t write_actuator(actuator_state_t& state) {
+    int err = syst::write_int(state.fd, state.requested_value);
+    if (err != 0) {
+        return RES_NEW_ERROR("Failed to write to an actuator.\n\tfile: '"
+          + state.path.string() + "'\n\tvalue: '"
+          + std::to_string(state.requested_value) + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    state.written_value = state.requested_value;
+    state.last_write = ch::steady_clock::now();
+    state.pending = false;
+
+    if (state.armed) {
+        auto result = syst::arm_actuator(state, ch::nanoseconds::zero());
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+    }
+
+    return res::success;
+}
+
+[[nodiscard]] res::result_t open_actuator(actuator_state_t& state,
+  const fs::path& path,
+  const fs::path& max_path,
+  ch::nanoseconds min_interval) {
+    if (min_interval.count() < 0) {
+        return RES_NEW_ERROR(
+          "The minimum interval between writes must not be negative."
+          "\n\tinterval: '"
+          + std::to_string(min_interval.count()) + "ns'");
+    }
+
+    state.path = path;
+    state.min_interval = min_interval;
+
+    read_error_t error = syst::read_int(max_path, state.max_value);
+    if (error.failed()) {
+        return error.to_error();
+    }
+
+    // The current value is only read once so that relative changes do not
+    // require a read.
+    uint64_t value = 0;
+    error = syst::read_int(path, value);
+    if (error.failed()) {
+        return error.to_error();
+    }
+    state.written_value = std::min(value, state.max_value);
+    state.requested_value = state.written_value;
+    state.requested = syst::value_to_percent(
+      static_cast<uint64_t>(0), state.max_value, state.written_value);
+
+    auto fd = syst::open_fd(path, O_WRONLY);
+    if (fd.has_error()) {
+        return RES_TRACE(fd.error());
+    }
+    state.fd = std::move(fd.value());
+
+    if (min_interval.count() > 0) {
+        auto timer = syst::create_timer(min_interval);
+        if (timer.has_error()) {
+            return RES_TRACE(timer.error());
+        }
+        state.timer = std::move(timer.value());
+        state.armed = true;
+
+        // The timer is only armed while a write is pending.
+        auto result = syst::arm_actuator(state, ch::nanoseconds::zero());
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+    }
+
+    return res::success;
+}
+
+res::optional_t<actuator_t> get_actuator(
+  const backlight_t& backlight, ch::nanoseconds min_interval) {
+    SYST_API("get_actuator");
+    // documentation for /sys/class/backlight
+    //     https://www.kernel.org/doc/html/latest/gpu/backlight.html
+
+    auto impl = std::make_unique<actuator_t::impl_t>();
+
+    auto result = syst::open_actuator(impl->state,
+      backlight.get_sysfs_path() / "brightness",
+      backlight.get_sysfs_path() / "max_brightness",
+      min_interval);
+    if (result.failure()) {
+        return RES_ERROR(result.error(),
+          "The 'brightness' and 'max_brightness' files are required to change "
+          "the brightness of a backlight.");
+    }
+
+    return actuator_t{ std::move(impl) };
+}
+
+res::optional_t<actuator_t> get_actuator(
+  const cooling_device_t& device, ch::nanoseconds min_interval) {
+    SYST_API("get_actuator");
+    // documentation for /sys/class/thermal
+    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
+
+    auto impl = std::make_unique<actuator_t::impl_t>();
+
+    auto result = syst::open_actuator(impl->state,
+      device.get_sysfs_path() / "cur_state",
+      device.get_sysfs_path() / "max_state",
+      min_interval);
+    if (result.failure()) {
+        return RES_ERROR(result.error(),
+          "The 'cur_state' and 'max_state' files are required to change the "
+          "state of a cooling device.");
+    }
+
+    return actuator_t{ std::move(impl) };
+}
+
+actuator_t::actuator_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+actuator_t::actuator_t(actuator_t&&) noexcept = default;
+
+actuator_t& actuator_t::operator=(actuator_t&&) noexcept = default;
+
+actuator_t::~actuator_t() = default;
+
+fs::path actuator_t::get_path() const {
+    return this->impl_->state.path;
+}
+
+double actuator_t::get() const {
+    return this->impl_->state.requested;
+}
+
+bool actuator_t::is_pending() const {
+    return this->impl_->state.pending;
+}
+
+res::result_t actuator_t::set(double percent) {
+    SYST_API("actuator_t::set");
+    actuator_state_t& state = this->impl_->state;
+
+    state.requested =
+      std::clamp(percent, static_cast<double>(0), static_cast<double>(100));
+    state.requested_value = syst::percent_to_value(
+      static_cast<uint64_t>(0), state.max_value, state.requested);
+
+    // Changes that cancel out before they are written are never written.
+    if (state.requested_value == state.written_value) {
+        state.pending = false;
+        return res::success;
+    }
+
+    const auto now = ch::steady_clock::now();
+    if (! state.last_write.has_value()
+      || now - state.last_write.value() >= state.min_interval) {
+        auto result = syst::write_actuator(state);
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+        return res::success;
+    }
+
+    // Rapid changes are combined and only the latest value is written once the
+    // minimum interval has passed.
+    state.pending = true;
+    if (! state.armed) {
+        auto result = syst::arm_actuator(
+          state, state.last_write.value() + state.min_interval - now);
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+    }
+
+    return res::success;
+}
+
+res::result_t actuator_t::set_relative(double percent) {
+    SYST_API("actuator_t::set_relative");
+    auto result = this->set(this->impl_->state.requested + percent);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+int actuator_t::get_fd() const {
+    return this->impl_->state.timer.get();
+}
+
+res::result_t actuator_t::dispatch() {
+    SYST_API("actuator_t::dispatch");
+    actuator_state_t& state = this->impl_->state;
+
+    if (! state.timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The actuator is not rate limited, so there is nothing to dispatch.");
+    }
+
+    auto expirations = syst::read_timer(state.timer);
+    if (expirations.has_error()) {
+        return RES_TRACE(expirations.error());
+    }
+
+    if (! state.pending) {
+        // The pending write was cancelled by a change back to the last value.
+        if (state.armed) {
+            auto result = syst::arm_actuator(state, ch::nanoseconds::zero());
+            if (result.failure()) {
+                return RES_TRACE(result.error());
+            }
+        }
+        return res::success;
+    }
+
+    const auto now = ch::steady_clock::now();
+    if (now - state.last_write.value() < state.min_interval) {
+        return res::success;
+    }
+
+    auto result = syst::write_actuator(state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::result_t actuator_t::flush() {
+    SYST_API("actuator_t::flush");
+    actuator_state_t& state = this->impl_->state;
+
+    if (! state.pending) {
+        return res::success;
+    }
+
+    auto result = syst::write_actuator(state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+} // namespace syst
@@ -3,6 +3,8 @@
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
 
 namespace syst {
@@ -10,31 +12,26 @@ namespace syst {
 backlight_t::backlight_t(const fs::path& sysfs_path) : sysfs_path_(sysfs_path) {
 }
 
-res::optional_t<std::vector<backlight_t>> get_backlights() {
+res::result_t append_backlight(
+  const class_entry_t& entry, std::vector<backlight_t>& backlights) {
+    backlights.push_back(backlight_t{ entry.class_path / entry.name });
+    return res::success;
+}
+
+res::optional_t<std::vector<backlight_t>> get_backlights(
+  const fs::path& backlight_path) {
+    SYST_API("get_backlights");
     // documentation for /sys/class/backlight
     //     https://www.kernel.org/doc/html/latest/gpu/backlight.html
 
-    const std::string backlights_path = "/sys/class/backlight";
-
-    if (! fs::is_directory(backlights_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + backlights_path + "'");
-    }
-
     std::vector<backlight_t> backlights;
 
-    for (const fs::directory_entry& backlight :
-      fs::directory_iterator(backlights_path)) {
-        if (! fs::is_directory(backlight)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(backlight)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        backlights.push_back(backlight_t{ backlight });
+    auto result = syst::for_each_class_entry(
+      backlight_path, "", [&](const class_entry_t& entry) {
+          return syst::append_backlight(entry, backlights);
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return backlights;
@@ -49,37 +46,46 @@ std::string backlight_t::get_name() const {
 }
 
 res::optional_t<double> backlight_t::get_brightness() const {
-    auto brightness = syst::get_int(this->sysfs_path_ / "brightness");
-    if (brightness.has_error()) {
-        return RES_ERROR(brightness.error(),
+    SYST_API("backlight_t::get_brightness");
+    const fs::path brightness_path = this->sysfs_path_ / "brightness";
+    uint64_t brightness = 0;
+    read_error_t error = syst::read_int(brightness_path, brightness);
+    if (error.failed()) {
+        return RES_ERROR(error.to_error(),
           "The 'brightness' file is required to calculate the brightness "
           "percentage of a backlight.");
     }
 
-    auto max_brightness = syst::get_int(this->sysfs_path_ / "max_brightness");
-    if (max_brightness.has_error()) {
-        return RES_ERROR(max_brightness.error(),
+    const fs::path max_brightness_path = this->sysfs_path_ / "max_brightness";
+    uint64_t max_brightness = 0;
+    error = syst::read_int(max_brightness_path, max_brightness);
+    if (error.failed()) {
+        return RES_ERROR(error.to_error(),
           "The 'max_brightness' file is required to calculate the brightness "
           "percentage of a backlight.");
     }
 
     return syst::value_to_percent(
-      static_cast<uint64_t>(0), max_brightness.value(), brightness.value());
+      static_cast<uint64_t>(0), max_brightness, brightness);
 }
 
 res::result_t backlight_t::set_brightness(double brightness) {
+    SYST_API("backlight_t::set_brightness");
     double clamped_brightness = std::clamp(
       brightness, static_cast<double>(0.F), static_cast<double>(100.F));
 
-    auto max_brightness = syst::get_int(this->sysfs_path_ / "max_brightness");
-    if (max_brightness.has_error()) {
-        return RES_ERROR(max_brightness.error(),
+    const fs::path max_brightness_path = this->sysfs_path_ / "max_brightness";
+    uint64_t max_brightness = 0;
+    const read_error_t error =
+      syst::read_int(max_brightness_path, max_brightness);
+    if (error.failed()) {
+        return RES_ERROR(error.to_error(),
           "The 'max_brightness' file is required to set the brightness "
           "percentage of a backlight.");
     }
 
     uint64_t value = syst::percent_to_value(
-      static_cast<uint64_t>(0), max_brightness.value(), clamped_brightness);
+      static_cast<uint64_t>(0), max_brightness, clamped_brightness);
 
     auto result = syst::write_int(this->sysfs_path_ / "brightness", value);
     if (result.failure()) {
@@ -90,6 +96,7 @@ res::result_t backlight_t::set_brightness(double brightness) {
 }
 
 res::result_t backlight_t::set_brightness_relative(double brightness) {
+    SYST_API("backlight_t::set_brightness_relative");
     auto old_brightness = this->get_brightness();
     if (old_brightness.has_error()) {
         return RES_TRACE(old_brightness.error());
@@ -0,0 +1,413 @@
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <string>
+
+// External includes
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Local includes
+#include "batch_reader.hpp"
+#include "capture.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+
+namespace syst {
+
+// Larger batches are submitted in several rounds that reuse the same entries.
+const unsigned int max_ring_entries = 256;
+
+// Marks files that have not been read yet.
+const ssize_t unread_result = std::numeric_limits<ssize_t>::min();
+
+// documentation for io_uring
+//     https://man7.org/linux/man-pages/man7/io_uring.7.html
+//     https://kernel.dk/io_uring.pdf
+
+// glibc does not provide wrappers for the io_uring system calls.
+
+[[nodiscard]] int io_uring_setup(
+  unsigned int entries, struct io_uring_params& params) {
+    return static_cast<int>(syscall(SYS_io_uring_setup, entries, &params));
+}
+
+[[nodiscard]] int io_uring_enter(
+  const fd_t& ring, unsigned int to_submit, unsigned int min_complete) {
+    return static_cast<int>(syscall(SYS_io_uring_enter,
+      ring.get(),
+      to_submit,
+      min_complete,
+      IORING_ENTER_GETEVENTS,
+      nullptr,
+      0));
+}
+
+[[nodiscard]] int io_uring_register(
+  const fd_t& ring, unsigned int opcode, const void* args, unsigned int count) {
+    return static_cast<int>(
+      syscall(SYS_io_uring_register, ring.get(), opcode, args, count));
+}
+
+/**
+ * @brief An io_uring instance with the files and buffers of one batch reader
+ * registered. The submission and completion queues are shared with the kernel
+ * through memory mappings.
+ */
+struct batch_ring_t {
+    fd_t fd;
+    unsigned int entries = 0;
+
+    void* sq_ring = MAP_FAILED;
+    size_t sq_ring_size = 0;
+    void* cq_ring = MAP_FAILED;
+    size_t cq_ring_size = 0;
+    struct io_uring_sqe* sqes = static_cast<struct io_uring_sqe*>(MAP_FAILED);
+    size_t sqes_size = 0;
+
+    unsigned int* sq_tail = nullptr;
+    unsigned int* sq_mask = nullptr;
+    unsigned int* sq_array = nullptr;
+    unsigned int* cq_head = nullptr;
+    unsigned int* cq_tail = nullptr;
+    unsigned int* cq_mask = nullptr;
+    struct io_uring_cqe* cqes = nullptr;
+
+    batch_ring_t() = default;
+    batch_ring_t(const batch_ring_t&) = delete;
+    batch_ring_t(batch_ring_t&&) noexcept = delete;
+    batch_ring_t& operator=(const batch_ring_t&) = delete;
+    batch_ring_t& operator=(batch_ring_t&&) noexcept = delete;
+
+    ~batch_ring_t() {
+        if (this->sqes != MAP_FAILED) {
+            munmap(this->sqes, this->sqes_size);
+        }
+        if (this->cq_ring != MAP_FAILED && this->cq_ring != this->sq_ring) {
+            munmap(this->cq_ring, this->cq_ring_size);
+        }
+        if (this->sq_ring != MAP_FAILED) {
+            munmap(this->sq_ring, this->sq_ring_size);
+        }
+    }
+};
+
+/**
+ * @brief Create an io_uring instance and register the files and buffers of a
+ * batch reader with it.
+ *
+ * @param[in] fds - The files to register.
+ * @param[in] buffers - The buffers to register as a single fixed buffer.
+ * @return the ring or null if io_uring is unavailable (old kernels, seccomp
+ * filters, io_uring_disabled, RLIMIT_MEMLOCK, ...).
+ */
+[[nodiscard]] std::unique_ptr<batch_ring_t> open_batch_ring(
+  const std::vector<int>& fds, std::vector<char>& buffers) {
+    auto ring = std::make_unique<batch_ring_t>();
+
+    struct io_uring_params params {};
+    ring->fd = fd_t{ syst::io_uring_setup(
+      std::min(static_cast<unsigned int>(fds.size()), max_ring_entries),
+      params) };
+    if (! ring->fd.is_open()) {
+        return nullptr;
+    }
+    ring->entries = params.sq_entries;
+
+    ring->sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+        ring->sq_ring_size = std::max(ring->sq_ring_size, ring->cq_ring_size);
+    }
+
+    ring->sq_ring = mmap(nullptr,
+      ring->sq_ring_size,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring->fd.get(),
+      IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        return nullptr;
+    }
+
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(nullptr,
+          ring->cq_ring_size,
+          PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE,
+          ring->fd.get(),
+          IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            return nullptr;
+        }
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = static_cast<struct io_uring_sqe*>(mmap(nullptr,
+      ring->sqes_size,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring->fd.get(),
+      IORING_OFF_SQES));
+    if (ring->sqes == MAP_FAILED) {
+        return nullptr;
+    }
+
+    char* sq_ring = static_cast<char*>(ring->sq_ring);
+    ring->sq_tail =
+      reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.tail);
+    ring->sq_mask =
+      reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.ring_mask);
+    ring->sq_array =
+      reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.array);
+
+    char* cq_ring = static_cast<char*>(ring->cq_ring);
+    ring->cq_head =
+      reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.head);
+    ring->cq_tail =
+      reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.tail);
+    ring->cq_mask =
+      reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.ring_mask);
+    ring->cqes =
+      reinterpret_cast<struct io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+
+    // Registered files and buffers are only looked up and pinned once instead
+    // of on every read.
+    if (syst::io_uring_register(ring->fd,
+          IORING_REGISTER_FILES,
+          fds.data(),
+          static_cast<unsigned int>(fds.size()))
+      != 0) {
+        return nullptr;
+    }
+
+    struct iovec buffer {};
+    buffer.iov_base = buffers.data();
+    buffer.iov_len = buffers.size();
+    if (syst::io_uring_register(ring->fd, IORING_REGISTER_BUFFERS, &buffer, 1)
+      != 0) {
+        return nullptr;
+    }
+
+    return ring;
+}
+
+/**
+ * @brief Read a range of the files of a batch reader with one submission.
+ *
+ * @param[in,out] ring - The ring of the batch reader.
+ * @param[in] first - The index of the first file to read.
+ * @param[in] count - The number of files to read. At most the number of
+ * entries of the ring.
+ * @param[in] buffers - The registered buffers.
+ * @param[in] buffer_size - The size of the buffer for each file.
+ * @param[out] results - The results of the reads.
+ * @return zero if every read completed or an errno value if the ring failed.
+ */
+[[nodiscard]] int read_batch(batch_ring_t& ring,
+  size_t first,
+  unsigned int count,
+  std::vector<char>& buffers,
+  size_t buffer_size,
+  std::vector<ssize_t>& results) {
+    // The kernel only reads the submission queue tail after it is released.
+    unsigned int tail = *ring.sq_tail;
+    for (unsigned int idx = 0; idx < count; ++idx) {
+        const size_t file = first + idx;
+        const unsigned int slot = tail & *ring.sq_mask;
+
+        struct io_uring_sqe& sqe = ring.sqes[slot];
+        sqe = {};
+        sqe.opcode = IORING_OP_READ_FIXED;
+        sqe.flags = IOSQE_FIXED_FILE;
+        sqe.fd = static_cast<int>(file);
+        sqe.addr =
+          reinterpret_cast<uint64_t>(buffers.data() + file * buffer_size);
+        // Leave room for the null terminator.
+        sqe.len = static_cast<uint32_t>(buffer_size - 1);
+        sqe.off = 0;
+        sqe.buf_index = 0;
+        sqe.user_data = file;
+
+        ring.sq_array[slot] = slot;
+        ++tail;
+    }
+    __atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+
+    unsigned int submitted = 0;
+    unsigned int completed = 0;
+    size_t bytes = 0;
+    while (completed < count) {
+        int result = syst::io_uring_enter(
+          ring.fd, count - submitted, count - completed);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        submitted += static_cast<unsigned int>(result);
+
+        unsigned int head = *ring.cq_head;
+        const unsigned int cq_tail =
+          __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != cq_tail; ++head) {
+            const struct io_uring_cqe& cqe = ring.cqes[head & *ring.cq_mask];
+            results[cqe.user_data] = cqe.res;
+            if (cqe.res > 0) {
+                bytes += static_cast<size_t>(cqe.res);
+            }
+            ++completed;
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    // The reads of a submission are reaped together and counted as one.
+    syst::count_read(bytes);
+
+    return 0;
+}
+
+/**
+ * @brief Copy the next recorded contents of a file from the capture being
+ * replayed into its buffer.
+ *
+ * @param[in] path - The path that identifies the file in the capture.
+ * @param[out] buffer - The buffer of the file.
+ * @param[in] len - The maximum number of bytes to copy.
+ * @return the number of bytes copied or the negated errno value of the
+ * failure.
+ */
+[[nodiscard]] ssize_t replay_file(
+  const std::string& path, char* buffer, size_t len) {
+    std::string contents;
+    if (! syst::replay_read(nullptr, path.c_str(), contents)) {
+        return -ENOENT;
+    }
+
+    len = std::min(len, contents.size());
+    std::memcpy(buffer, contents.data(), len);
+    return static_cast<ssize_t>(len);
+}
+
+batch_reader_t::batch_reader_t(
+  std::vector<const fd_t*> files, size_t buffer_size, bool use_io_uring)
+: files_(std::move(files))
+, buffer_size_(std::max(buffer_size, static_cast<size_t>(1)))
+, buffers_(this->files_.size() * this->buffer_size_)
+, results_(this->files_.size(), unread_result) {
+    if (use_io_uring && ! this->files_.empty()) {
+        std::vector<int> fds;
+        fds.reserve(this->files_.size());
+        for (const fd_t* file : this->files_) {
+            fds.push_back(file->get());
+        }
+        this->ring_ = syst::open_batch_ring(fds, this->buffers_);
+    }
+}
+
+batch_reader_t::batch_reader_t(batch_reader_t&&) noexcept = default;
+
+batch_reader_t& batch_reader_t::operator=(batch_reader_t&&) noexcept = default;
+
+batch_reader_t::~batch_reader_t() = default;
+
+bool batch_reader_t::uses_io_uring() const {
+    return this->ring_ != nullptr;
+}
+
+size_t batch_reader_t::size() const {
+    return this->files_.size();
+}
+
+void batch_reader_t::read() {
+    const capture_mode_t mode = syst::get_capture_mode();
+
+    if (this->ring_ != nullptr && mode != capture_mode_t::replay) {
+        int err = 0;
+        for (size_t first = 0; first < this->files_.size() && err == 0;
+             first += this->ring_->entries) {
+            const auto count = static_cast<unsigned int>(std::min(
+              this->files_.size() - first, size_t{ this->ring_->entries }));
+            err = syst::read_batch(*this->ring_,
+              first,
+              count,
+              this->buffers_,
+              this->buffer_size_,
+              this->results_);
+        }
+        if (err != 0) {
+            // The ring stopped working after it was created (for example, the
+            // kernel ran out of memory), so every file is read again.
+            this->ring_.reset();
+        }
+    }
+
+    if (this->ring_ == nullptr || mode == capture_mode_t::replay) {
+        for (size_t idx = 0; idx < this->files_.size(); ++idx) {
+            const fd_t& file = *this->files_[idx];
+            char* buffer = this->buffers_.data() + idx * this->buffer_size_;
+
+            // Files opened before the replay started are still read.
+            if (mode == capture_mode_t::replay
+              && ! file.get_capture_path().empty()) {
+                this->results_[idx] = syst::replay_file(
+                  file.get_capture_path(), buffer, this->buffer_size_ - 1);
+                continue;
+            }
+
+            ssize_t len = pread(file.get(), buffer, this->buffer_size_ - 1, 0);
+            this->results_[idx] = len < 0 ? -errno : len;
+            if (len >= 0) {
+                syst::count_read(static_cast<size_t>(len));
+            }
+        }
+    }
+
+    for (size_t idx = 0; idx < this->files_.size(); ++idx) {
+        if (this->results_[idx] < 0) {
+            continue;
+        }
+
+        char* buffer = this->buffers_.data() + idx * this->buffer_size_;
+        const auto len = static_cast<size_t>(this->results_[idx]);
+        buffer[len] = '\0';
+
+        const std::string& path = this->files_[idx]->get_capture_path();
+        if (mode == capture_mode_t::record && ! path.empty()) {
+            syst::record_read(nullptr, path.c_str(), { buffer, len });
+        }
+    }
+}
+
+int batch_reader_t::get_errno(size_t index) const {
+    const ssize_t result = this->results_[index];
+    if (result == unread_result) {
+        return -1;
+    }
+    if (result < 0) {
+        return static_cast<int>(-result);
+    }
+    return 0;
+}
+
+std::string_view batch_reader_t::get_contents(size_t index) const {
+    const ssize_t result = this->results_[index];
+    if (result < 0) {
+        return {};
+    }
+
+    return std::string_view{ this->buffers_.data() + index * this->buffer_size_,
+      static_cast<size_t>(result) };
+}
+
+} // namespace syst
@@ -0,0 +1,96 @@
+#pragma once
+
+// Standard includes
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// External includes
+#include <sys/types.h>
+
+namespace syst {
+
+class fd_t;
+
+// An io_uring instance with the files and buffers of a batch reader registered.
+struct batch_ring_t;
+
+/**
+ * @brief Reads the same set of small files (such as sysfs attributes) from the
+ * beginning once per sampling tick.
+ *
+ * When io_uring is available, the files and the buffers they are read into are
+ * registered once and every read of a tick is submitted as one batch whose
+ * completions are reaped with a single system call. Otherwise, or if io_uring
+ * fails at any point, each file is read with pread(2) instead.
+ *
+ * Files opened while reads are recorded or replayed (see capture.hpp) are
+ * recorded as they are read, or served by the capture being replayed.
+ */
+class batch_reader_t {
+    std::vector<const fd_t*> files_;
+    size_t buffer_size_;
+
+    // One buffer of 'buffer_size_' bytes for each file (same order as
+    // 'files_').
+    std::vector<char> buffers_;
+
+    // The number of bytes read into each buffer or the negated errno value of
+    // the failed read.
+    std::vector<ssize_t> results_;
+
+    // Null if reads are made with pread(2).
+    std::unique_ptr<batch_ring_t> ring_;
+
+  public:
+    /**
+     * @param[in] files - The open files to read. They are not owned by the
+     * reader and must stay open while it is used.
+     * @param[in] buffer_size - The size of the buffer for each file, including
+     * a null terminator. Longer contents are truncated.
+     * @param[in] use_io_uring - Attempt to read the files with io_uring.
+     */
+    batch_reader_t(
+      std::vector<const fd_t*> files, size_t buffer_size, bool use_io_uring);
+    batch_reader_t(const batch_reader_t&) = delete;
+    batch_reader_t(batch_reader_t&&) noexcept;
+    batch_reader_t& operator=(const batch_reader_t&) = delete;
+    batch_reader_t& operator=(batch_reader_t&&) noexcept;
+    // The destructor must be implemented where 'batch_ring_t' is defined.
+    ~batch_reader_t();
+
+    /**
+     * @return true if the files are read with io_uring and false if they are
+     * read with pread(2).
+     */
+    [[nodiscard]] bool uses_io_uring() const;
+
+    /**
+     * @return the number of files read by this reader.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Read every file from the beginning. Each read succeeds or fails
+     * independently of the others.
+     */
+    void read();
+
+    /**
+     * @param[in] index - The index of the file in the list given to the
+     * constructor.
+     * @return zero if the last read of the file succeeded, -1 if it has not
+     * been read yet, or the errno value of the failed read.
+     */
+    [[nodiscard]] int get_errno(size_t index) const;
+
+    /**
+     * @param[in] index - The index of the file in the list given to the
+     * constructor.
+     * @return the null-terminated contents of the file from the last read or
+     * an empty string if the read failed. Only valid until the next read.
+     */
+    [[nodiscard]] std::string_view get_contents(size_t index) const;
+};
+
+} // namespace syst
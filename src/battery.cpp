@@ -1,163 +1,324 @@
+// Standard includes
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+// External includes
+#include <fcntl.h>
+
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
+#include "strerror.hpp"
 
 namespace syst {
 
-[[nodiscard]] res::optional_t<double> energy(const fs::path& sysfs_path) {
-    // documentation for /sys/class/power_supply
-    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
-    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+[[nodiscard]] std::unordered_map<std::string, std::string>
+parse_power_supply_uevent(
+  const std::string& contents) {
+    // Each line of a power supply uevent file has the form
+    // POWER_SUPPLY_<ATTRIBUTE>=<value>, where <attribute> is the name of the
+    // corresponding file in the sysfs directory of the device.
 
-    auto energy_now = syst::get_int(sysfs_path / "energy_now");
-    if (energy_now.has_error()) {
-        return RES_TRACE(energy_now.error());
-    }
+    const std::string prefix = "POWER_SUPPLY_";
 
-    auto energy_empty = syst::get_int(sysfs_path / "energy_empty");
-    if (energy_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        energy_empty = 0;
-    }
+    std::unordered_map<std::string, std::string> attributes;
 
-    auto energy_full = syst::get_int(sysfs_path / "energy_full");
-    if (energy_full.has_error()) {
-        return RES_TRACE(energy_full.error());
+    size_t line_start = 0;
+    while (line_start < contents.size()) {
+        size_t line_end = contents.find('\n', line_start);
+        if (line_end == std::string::npos) {
+            line_end = contents.size();
+        }
+
+        const size_t separator = contents.find('=', line_start);
+        if (separator < line_end
+          && contents.compare(line_start, prefix.size(), prefix) == 0) {
+            std::string attribute = contents.substr(line_start + prefix.size(),
+              separator - line_start - prefix.size());
+            for (char& character : attribute) {
+                character = static_cast<char>(
+                  std::tolower(static_cast<unsigned char>(character)));
+            }
+
+            attributes[attribute] =
+              contents.substr(separator + 1, line_end - separator - 1);
+        }
+
+        line_start = line_end + 1;
     }
 
-    return syst::value_to_percent(
-      energy_empty.value(), energy_full.value(), energy_now.value());
+    return attributes;
 }
 
-[[nodiscard]] res::optional_t<double> charge(const fs::path& sysfs_path) {
-    // documentation for /sys/class/power_supply
-    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
-    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+/**
+ * @brief The names of the attributes of one quantity (energy or charge). Names
+ * are constants so that no string is built for attributes that are missing.
+ */
+struct battery_quantity_t {
+    const char* now;
+    const char* full;
+    const char* full_design;
+    const char* empty;
+    const char* empty_design;
+};
+
+// Measured in µWh (microwatt hours).
+const battery_quantity_t energy_quantity{ "energy_now",
+    "energy_full",
+    "energy_full_design",
+    "energy_empty",
+    "energy_empty_design" };
+
+// Measured in µAh (microampere hours).
+const battery_quantity_t charge_quantity{ "charge_now",
+    "charge_full",
+    "charge_full_design",
+    "charge_empty",
+    "charge_empty_design" };
+
+[[nodiscard]] std::optional<int64_t> get_integer(
+  const battery_t::snapshot_t& snapshot, const std::string& attribute) {
+    auto value = snapshot.get_attribute(attribute);
+    if (! value.has_value() || value->empty()) {
+        return std::nullopt;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    long long integer = std::strtoll(value->c_str(), &end, 10);
+    if (errno != 0 || *end != '\0') {
+        return std::nullopt;
+    }
+
+    return static_cast<int64_t>(integer);
+}
 
-    auto charge_now = syst::get_int(sysfs_path / "charge_now");
-    if (charge_now.has_error()) {
-        return RES_TRACE(charge_now.error());
+[[nodiscard]] std::optional<double> current(
+  const battery_t::snapshot_t& snapshot,
+  const battery_t::capabilities_t& capabilities) {
+    // Some drivers report a negative current while discharging, so only the
+    // magnitude is used.
+
+    auto current_now = capabilities.current
+      ? syst::get_integer(snapshot, "current_now")
+      : std::nullopt;
+    if (current_now.has_value()) {
+        const double microamperes_per_ampere = static_cast<double>(1e6);
+        return std::abs(static_cast<double>(current_now.value()))
+          / microamperes_per_ampere;
     }
 
-    auto charge_empty = syst::get_int(sysfs_path / "charge_empty");
-    if (charge_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        charge_empty = 0;
+    // If current_now is missing, dividing power_now by voltage_now produces
+    // the approximate current draw from the battery in amperes.
+
+    if (! capabilities.power || ! capabilities.voltage) {
+        return std::nullopt;
     }
 
-    auto charge_full = syst::get_int(sysfs_path / "charge_full");
-    if (charge_full.has_error()) {
-        return RES_TRACE(charge_full.error());
+    auto power_now = syst::get_integer(snapshot, "power_now");
+    auto voltage_now = syst::get_integer(snapshot, "voltage_now");
+    if (! power_now.has_value() || ! voltage_now.has_value()
+      || voltage_now.value() == 0) {
+        return std::nullopt;
     }
 
-    return syst::value_to_percent(
-      charge_empty.value(), charge_full.value(), charge_now.value());
+    return std::abs(static_cast<double>(power_now.value())
+      / static_cast<double>(voltage_now.value()));
 }
 
-[[nodiscard]] res::optional_t<double> energy_capacity(
-  const fs::path& sysfs_path) {
-    // documentation for /sys/class/power_supply
-    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
-    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+[[nodiscard]] std::optional<double> power(
+  const battery_t::snapshot_t& snapshot,
+  const battery_t::capabilities_t& capabilities) {
+    auto power_now = capabilities.power
+      ? syst::get_integer(snapshot, "power_now")
+      : std::nullopt;
+    if (power_now.has_value()) {
+        const double microwatts_per_watt = static_cast<double>(1e6);
+        return std::abs(static_cast<double>(power_now.value()))
+          / microwatts_per_watt;
+    }
+
+    // If power_now is missing, multiplying current_now by voltage_now produces
+    // the approximate power in picowatts.
 
-    auto energy_empty = syst::get_int(sysfs_path / "energy_empty");
-    if (energy_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        energy_empty = 0;
+    if (! capabilities.current || ! capabilities.voltage) {
+        return std::nullopt;
     }
 
-    auto energy_full = syst::get_int(sysfs_path / "energy_full");
-    if (energy_full.has_error()) {
-        return RES_TRACE(energy_full.error());
+    auto current_now = syst::get_integer(snapshot, "current_now");
+    auto voltage_now = syst::get_integer(snapshot, "voltage_now");
+    if (! current_now.has_value() || ! voltage_now.has_value()) {
+        return std::nullopt;
     }
 
-    auto energy_empty_design =
-      syst::get_int(sysfs_path / "energy_empty_design");
-    if (energy_empty_design.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        energy_empty_design = 0;
+    double approx_power_now_pico = static_cast<double>(current_now.value())
+      * static_cast<double>(voltage_now.value());
+
+    const double picowatts_per_watt = static_cast<double>(1e12);
+    return std::abs(approx_power_now_pico) / picowatts_per_watt;
+}
+
+[[nodiscard]] std::optional<double> level(
+  const battery_t::snapshot_t& snapshot, const battery_quantity_t& quantity) {
+    auto now = syst::get_integer(snapshot, quantity.now);
+    auto full = syst::get_integer(snapshot, quantity.full);
+    if (! now.has_value() || ! full.has_value()) {
+        return std::nullopt;
     }
 
-    auto energy_full_design = syst::get_int(sysfs_path / "energy_full_design");
-    if (energy_full_design.has_error()) {
-        return RES_TRACE(energy_full_design.error());
+    // If the empty attribute doesn't exist, assume its value is zero.
+    const int64_t empty =
+      syst::get_integer(snapshot, quantity.empty).value_or(0);
+
+    return syst::value_to_percent(empty, full.value(), now.value());
+}
+
+[[nodiscard]] std::optional<double> capacity(
+  const battery_t::snapshot_t& snapshot, const battery_quantity_t& quantity) {
+    auto full = syst::get_integer(snapshot, quantity.full);
+    auto full_design = syst::get_integer(snapshot, quantity.full_design);
+    if (! full.has_value() || ! full_design.has_value()) {
+        return std::nullopt;
     }
 
-    return syst::ratio_to_percent(energy_full.value() - energy_empty.value(),
-      energy_full_design.value() - energy_empty_design.value());
+    // If the empty attributes don't exist, assume their values are zero.
+    const int64_t empty =
+      syst::get_integer(snapshot, quantity.empty).value_or(0);
+    const int64_t empty_design =
+      syst::get_integer(snapshot, quantity.empty_design).value_or(0);
+
+    return syst::ratio_to_percent(
+      full.value() - empty, full_design.value() - empty_design);
 }
 
-[[nodiscard]] res::optional_t<double> charge_capacity(
-  const fs::path& sysfs_path) {
-    // documentation for /sys/class/power_supply
-    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
-    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+[[nodiscard]] std::optional<double> until_empty(
+  const battery_t::snapshot_t& snapshot, const battery_quantity_t& quantity) {
+    // The result is in watt hours for energy and in ampere hours for charge.
 
-    auto charge_empty = syst::get_int(sysfs_path / "charge_empty");
-    if (charge_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        charge_empty = 0;
+    auto now = syst::get_integer(snapshot, quantity.now);
+    if (! now.has_value()) {
+        return std::nullopt;
     }
 
-    auto charge_full = syst::get_int(sysfs_path / "charge_full");
-    if (charge_full.has_error()) {
-        return RES_TRACE(charge_full.error());
-    }
+    // If the empty attribute doesn't exist, assume its value is zero.
+    const int64_t empty =
+      syst::get_integer(snapshot, quantity.empty).value_or(0);
 
-    auto charge_empty_design =
-      syst::get_int(sysfs_path / "charge_empty_design");
-    if (charge_empty_design.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        charge_empty_design = 0;
+    const double micro_per_unit = static_cast<double>(1e6);
+    return static_cast<double>(now.value() - empty) / micro_per_unit;
+}
+
+[[nodiscard]] std::optional<double> until_full(
+  const battery_t::snapshot_t& snapshot, const battery_quantity_t& quantity) {
+    // The result is in watt hours for energy and in ampere hours for charge.
+
+    auto now = syst::get_integer(snapshot, quantity.now);
+    auto full = syst::get_integer(snapshot, quantity.full);
+    if (! now.has_value() || ! full.has_value()) {
+        return std::nullopt;
     }
 
-    auto charge_full_design = syst::get_int(sysfs_path / "charge_full_design");
-    if (charge_full_design.has_error()) {
-        return RES_TRACE(charge_full_design.error());
+    const double micro_per_unit = static_cast<double>(1e6);
+    return static_cast<double>(full.value() - now.value()) / micro_per_unit;
+}
+
+ch::seconds hours_to_seconds(double hours) {
+    const double seconds_per_minute = static_cast<double>(60);
+    const double minutes_per_hour = static_cast<double>(60);
+    const double seconds_per_hour = seconds_per_minute * minutes_per_hour;
+
+    uint64_t seconds = static_cast<uint64_t>(hours * seconds_per_hour);
+
+    return ch::seconds{ seconds };
+}
+
+[[nodiscard]] res::optional_t<std::unordered_map<std::string, std::string>>
+read_uevent(const fd_t& dir) {
+    auto contents = syst::read_attribute(dir, "uevent");
+    if (contents.has_error()) {
+        return RES_ERROR(
+          contents.error(), "Failed to read the uevent file of a battery.");
     }
 
-    return syst::ratio_to_percent(charge_full.value() - charge_empty.value(),
-      charge_full_design.value() - charge_empty_design.value());
+    return syst::parse_power_supply_uevent(contents.value());
 }
 
-battery_t::battery_t(const fs::path& sysfs_path) : sysfs_path_(sysfs_path) {
+[[nodiscard]] battery_t::capabilities_t battery_capabilities(
+  const fd_t& dir) {
+    // The attribute files are probed instead of the keys of the uevent file
+    // since the kernel omits properties that cannot be read at the moment
+    // (such as 'time_to_empty_now' while charging) from the uevent file.
+    auto has = [&dir](const char* attribute) {
+        return syst::has_attribute_at(dir, attribute);
+    };
+
+    battery_t::capabilities_t capabilities{};
+    capabilities.energy = has("energy_now") && has("energy_full");
+    capabilities.energy_design = has("energy_full_design");
+    capabilities.charge = has("charge_now") && has("charge_full");
+    capabilities.charge_design = has("charge_full_design");
+    capabilities.capacity = has("capacity");
+    capabilities.current = has("current_now");
+    capabilities.power = has("power_now");
+    capabilities.voltage = has("voltage_now");
+    capabilities.time_to_empty =
+      has("time_to_empty_now") || has("time_to_empty_avg");
+    capabilities.time_to_full =
+      has("time_to_full_now") || has("time_to_full_avg");
+
+    return capabilities;
 }
 
-res::optional_t<std::vector<battery_t>> get_batteries() {
-    // documentation for /sys/class/power_supply
-    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
-    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+battery_t::battery_t(const fs::path& sysfs_path,
+  std::shared_ptr<const fd_t> dir,
+  const capabilities_t& capabilities)
+: sysfs_path_(sysfs_path), dir_(std::move(dir)), capabilities_(capabilities) {
+}
 
-    const std::string power_supply_path = "/sys/class/power_supply";
+res::result_t append_battery(
+  const class_entry_t& entry, std::vector<battery_t>& batteries) {
+    // Attributes are read relative to the device directory so that no path is
+    // built for power supplies that are not batteries.
+    auto dir = syst::open_device_dir(&entry.dir, entry.name.data());
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
 
-    if (! fs::is_directory(power_supply_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + power_supply_path + "'");
+    auto type = syst::get_first_line_at(*dir.value(), "type");
+    if (type.has_error()) {
+        return RES_TRACE(type.error());
+    }
+    if (type.value() != "Battery") {
+        // Ignore power supply devices that are not batteries.
+        return res::success;
     }
 
-    std::vector<battery_t> batteries;
+    const auto capabilities = syst::battery_capabilities(*dir.value());
+    batteries.push_back(battery_t{
+      entry.class_path / entry.name, std::move(dir.value()), capabilities });
+    return res::success;
+}
 
-    for (const fs::directory_entry& battery :
-      fs::directory_iterator(power_supply_path)) {
-        if (! fs::is_directory(battery)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(battery)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
+res::optional_t<std::vector<battery_t>> get_batteries(
+  const fs::path& power_supply_path) {
+    SYST_API("get_batteries");
+    // documentation for /sys/class/power_supply
+    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
+    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
 
-        auto type = syst::get_first_line(battery.path() / "type");
-        if (type.has_error()) {
-            return RES_TRACE(type.error());
-        }
-        if (type.value() != "Battery") {
-            // Ignore power supply devices that are not batteries.
-            continue;
-        }
+    std::vector<battery_t> batteries;
 
-        batteries.push_back(battery_t{ battery });
+    auto result = syst::for_each_class_entry(power_supply_path,
+      "",
+      [&](const class_entry_t& entry) {
+          return syst::append_battery(entry, batteries);
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return batteries;
@@ -171,15 +332,131 @@ std::string battery_t::get_name() const {
     return this->sysfs_path_.filename();
 }
 
+battery_t::capabilities_t battery_t::get_capabilities() const {
+    return this->capabilities_;
+}
+
+res::optional_t<battery_t::snapshot_t> battery_t::get_snapshot() const {
+    SYST_API("battery_t::get_snapshot");
+    // documentation for /sys/class/power_supply
+    //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
+    //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
+
+    // The uevent file contains every attribute of the battery, so a single
+    // read replaces opening each attribute file separately.
+    auto attributes = syst::read_uevent(*this->dir_);
+    if (attributes.has_error()) {
+        return RES_TRACE(attributes.error());
+    }
+
+    return snapshot_t{ this->sysfs_path_,
+      this->capabilities_,
+      std::move(attributes.value()) };
+}
+
 res::optional_t<battery_t::status_t> battery_t::get_status() const {
+    SYST_API("battery_t::get_status");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_status();
+}
+
+res::optional_t<double> battery_t::get_current() const {
+    SYST_API("battery_t::get_current");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_current();
+}
+
+res::optional_t<double> battery_t::get_power() const {
+    SYST_API("battery_t::get_power");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_power();
+}
+
+res::optional_t<double> battery_t::get_charge() const {
+    SYST_API("battery_t::get_charge");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_charge();
+}
+
+res::optional_t<double> battery_t::get_capacity() const {
+    SYST_API("battery_t::get_capacity");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_capacity();
+}
+
+res::optional_t<ch::seconds> battery_t::get_time_remaining() const {
+    SYST_API("battery_t::get_time_remaining");
+    auto snapshot = this->get_snapshot();
+    if (snapshot.has_error()) {
+        return RES_TRACE(snapshot.error());
+    }
+
+    return snapshot->get_time_remaining();
+}
+
+battery_t::snapshot_t::snapshot_t(const fs::path& sysfs_path,
+  const capabilities_t& capabilities,
+  std::unordered_map<std::string, std::string>&& attributes)
+: sysfs_path_(sysfs_path)
+, capabilities_(capabilities)
+, attributes_(std::move(attributes)) {
+}
+
+res::error_t battery_t::snapshot_t::missing(
+  const std::vector<std::string>& attributes) const {
+    std::string list;
+    for (const std::string& attribute : attributes) {
+        if (! list.empty()) {
+            list += ", ";
+        }
+        list += attribute;
+    }
+
+    return RES_NEW_ERROR(
+      "The attributes required for a calculation are missing from a battery "
+      "uevent file.\n\tattributes: '"
+      + list + "'\n\tfile: '" + (this->sysfs_path_ / "uevent").string() + "'");
+}
+
+std::optional<std::string> battery_t::snapshot_t::get_attribute(
+  const std::string& attribute) const {
+    auto iter = this->attributes_.find(attribute);
+    if (iter == this->attributes_.end()) {
+        return std::nullopt;
+    }
+
+    return iter->second;
+}
+
+res::optional_t<battery_t::status_t> battery_t::snapshot_t::get_status()
+  const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
 
-    const fs::path status_path = this->sysfs_path_ / "status";
-    auto status = syst::get_first_line(status_path);
-    if (status.has_error()) {
-        return RES_TRACE(status.error());
+    auto status = this->get_attribute("status");
+    if (! status.has_value()) {
+        return this->missing({ "status" });
     }
 
     if (status.value() == "Unknown") {
@@ -199,77 +476,38 @@ res::optional_t<battery_t::status_t> battery_t::get_status() const {
     }
 
     return RES_NEW_ERROR(
-      "An invalid status was read from a battery status file.\n\tstatus: '"
-      + status.value() + "'\n\tfile: '" + status_path.string() + "'");
+      "An invalid status was read from a battery uevent file.\n\tstatus: '"
+      + status.value() + "'\n\tfile: '"
+      + (this->sysfs_path_ / "uevent").string() + "'");
 }
 
-res::optional_t<double> battery_t::get_current() const {
+res::optional_t<double> battery_t::snapshot_t::get_current() const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
 
-    auto current_now = syst::get_int(this->sysfs_path_ / "current_now");
-    if (current_now.has_value()) {
-        const double microamperes_per_ampere = static_cast<double>(1e6);
-        return static_cast<double>(current_now.value())
-          / microamperes_per_ampere;
-    }
-    res::error_t error = RES_TRACE(current_now.error());
-
-    // If the current_now file is missing, dividing power_now by voltage_now
-    // produces the approximate current draw from the battery in amperes.
-
-    auto power_now = syst::get_int(this->sysfs_path_ / "power_now");
-    if (power_now.has_error()) {
-        return RES_CONCAT(error, power_now.error());
-    }
-
-    auto voltage_now = syst::get_int(this->sysfs_path_ / "voltage_now");
-    if (voltage_now.has_error()) {
-        return RES_CONCAT(error, voltage_now.error());
+    auto current = syst::current(*this, this->capabilities_);
+    if (! current.has_value()) {
+        return this->missing({ "current_now", "power_now", "voltage_now" });
     }
 
-    const double approx_current_now = static_cast<double>(power_now.value())
-      / static_cast<double>(voltage_now.value());
-
-    return approx_current_now;
+    return current.value();
 }
 
-res::optional_t<double> battery_t::get_power() const {
+res::optional_t<double> battery_t::snapshot_t::get_power() const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
 
-    auto power_now = syst::get_int(this->sysfs_path_ / "power_now");
-    if (power_now.has_value()) {
-        const double microwatts_per_watt = static_cast<double>(1e6);
-        return static_cast<double>(power_now.value()) / microwatts_per_watt;
-    }
-    res::error_t error = RES_TRACE(power_now.error());
-
-    // If the power_now file is missing, multiplying current_now by voltage_now
-    // produces the approximate power in picowatts.
-
-    auto current_now = syst::get_int(this->sysfs_path_ / "current_now");
-    if (current_now.has_error()) {
-        return RES_CONCAT(error, current_now.error());
+    auto power = syst::power(*this, this->capabilities_);
+    if (! power.has_value()) {
+        return this->missing({ "power_now", "current_now", "voltage_now" });
     }
 
-    auto voltage_now = syst::get_int(this->sysfs_path_ / "voltage_now");
-    if (voltage_now.has_error()) {
-        return RES_CONCAT(error, voltage_now.error());
-    }
-
-    double approx_power_now_pico = static_cast<double>(current_now.value())
-      * static_cast<double>(voltage_now.value());
-
-    const double picowatts_per_watt = static_cast<double>(1e12);
-    double approx_power_now = approx_power_now_pico / picowatts_per_watt;
-
-    return approx_power_now;
+    return power.value();
 }
 
-res::optional_t<double> battery_t::get_charge() const {
+res::optional_t<double> battery_t::snapshot_t::get_charge() const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
@@ -277,31 +515,40 @@ res::optional_t<double> battery_t::get_charge() const {
     // Attempt to calculate the current charge level of this device with energy,
     // then charge, and finally with capacity if all else fails.
 
-    auto energy = syst::energy(this->sysfs_path_);
-    if (energy.has_value()) {
-        return energy.value();
+    // Methods that the battery does not support are skipped entirely.
+
+    if (this->capabilities_.energy) {
+        auto energy = syst::level(*this, energy_quantity);
+        if (energy.has_value()) {
+            return energy.value();
+        }
     }
-    res::error_t error = RES_TRACE(energy.error());
 
-    auto charge = syst::charge(this->sysfs_path_);
-    if (charge.has_value()) {
-        return charge.value();
+    if (this->capabilities_.charge) {
+        auto charge = syst::level(*this, charge_quantity);
+        if (charge.has_value()) {
+            return charge.value();
+        }
     }
-    error = RES_CONCAT(error, charge.error());
 
     // NOTE: This value is the just the current charge level of this device.
     // This is not the same as returned by the 'capacity' method!
     // https://www.kernel.org/doc/html/latest/power/power_supply_class.html#attributes-properties-detailed
-    auto capacity = syst::get_int(this->sysfs_path_ / "capacity");
-    if (capacity.has_value()) {
-        return static_cast<double>(capacity.value());
+    if (this->capabilities_.capacity) {
+        auto capacity = syst::get_integer(*this, "capacity");
+        if (capacity.has_value()) {
+            return static_cast<double>(capacity.value());
+        }
     }
-    error = RES_CONCAT(error, capacity.error());
 
-    return error;
+    return this->missing({ "energy_now",
+      "energy_full",
+      "charge_now",
+      "charge_full",
+      "capacity" });
 }
 
-res::optional_t<double> battery_t::get_capacity() const {
+res::optional_t<double> battery_t::snapshot_t::get_capacity() const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
@@ -309,116 +556,28 @@ res::optional_t<double> battery_t::get_capacity() const {
     // Attempt to calculate the capacity of this device (compared to original
     // capacity at manufacture) with energy and then charge if all else fails.
 
-    auto energy_capacity = syst::energy_capacity(this->sysfs_path_);
-    if (energy_capacity.has_value()) {
-        return energy_capacity.value();
-    }
-    res::error_t error = RES_TRACE(energy_capacity.error());
-
-    auto charge_capacity = syst::charge_capacity(this->sysfs_path_);
-    if (charge_capacity.has_value()) {
-        return charge_capacity.value();
-    }
-    error = RES_CONCAT(error, charge_capacity.error());
-
-    return error;
-}
-
-res::optional_t<double> energy_stored(const fs::path& sysfs_path) {
-    auto energy_empty = syst::get_int(sysfs_path / "energy_empty");
-    if (energy_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        energy_empty = 0;
-    }
-
-    auto energy_now = syst::get_int(sysfs_path / "energy_now");
-    if (energy_now.has_error()) {
-        return RES_TRACE(energy_now.error());
-    }
-
-    double energy_microwatt_hours =
-      static_cast<double>(energy_now.value() - energy_empty.value());
-
-    const double microwatt_hours_per_watt_hour = static_cast<double>(1e6);
-    double energy_watt_hours =
-      energy_microwatt_hours / microwatt_hours_per_watt_hour;
-
-    return energy_watt_hours;
-}
-
-res::optional_t<double> energy_missing(const fs::path& sysfs_path) {
-    auto energy_now = syst::get_int(sysfs_path / "energy_now");
-    if (energy_now.has_error()) {
-        return RES_TRACE(energy_now.error());
-    }
-
-    auto energy_full = syst::get_int(sysfs_path / "energy_full");
-    if (energy_full.has_error()) {
-        return RES_TRACE(energy_full.error());
-    }
-
-    double energy_microwatt_hours =
-      static_cast<double>(energy_full.value() - energy_now.value());
-
-    const double microwatt_hours_per_watt_hour = static_cast<double>(1e6);
-    double energy_watt_hours =
-      energy_microwatt_hours / microwatt_hours_per_watt_hour;
-
-    return energy_watt_hours;
-}
-
-res::optional_t<double> charge_stored(const fs::path& sysfs_path) {
-    auto charge_empty = syst::get_int(sysfs_path / "charge_empty");
-    if (charge_empty.has_error()) {
-        // If this file doesn't exist, assume its value is zero.
-        charge_empty = 0;
-    }
-
-    auto charge_now = syst::get_int(sysfs_path / "charge_now");
-    if (charge_now.has_error()) {
-        return RES_TRACE(charge_now.error());
-    }
-
-    double charge_microamperes =
-      static_cast<double>(charge_now.value() - charge_empty.value());
-
-    const double microamperes_per_ampere = static_cast<double>(1e6);
-    double charge_amperes = charge_microamperes / microamperes_per_ampere;
-
-    return charge_amperes;
-}
-
-res::optional_t<double> charge_missing(const fs::path& sysfs_path) {
-    auto charge_now = syst::get_int(sysfs_path / "charge_now");
-    if (charge_now.has_error()) {
-        return RES_TRACE(charge_now.error());
+    if (this->capabilities_.energy_design) {
+        auto energy_capacity = syst::capacity(*this, energy_quantity);
+        if (energy_capacity.has_value()) {
+            return energy_capacity.value();
+        }
     }
 
-    auto charge_full = syst::get_int(sysfs_path / "charge_full");
-    if (charge_full.has_error()) {
-        return RES_TRACE(charge_full.error());
+    if (this->capabilities_.charge_design) {
+        auto charge_capacity = syst::capacity(*this, charge_quantity);
+        if (charge_capacity.has_value()) {
+            return charge_capacity.value();
+        }
     }
 
-    double charge_microamperes =
-      static_cast<double>(charge_full.value() - charge_now.value());
-
-    const double microamperes_per_ampere = static_cast<double>(1e6);
-    double charge_amperes = charge_microamperes / microamperes_per_ampere;
-
-    return charge_amperes;
-}
-
-ch::seconds hours_to_seconds(double hours) {
-    const double seconds_per_minute = static_cast<double>(60);
-    const double minutes_per_hour = static_cast<double>(60);
-    const double seconds_per_hour = seconds_per_minute * minutes_per_hour;
-
-    uint64_t seconds = static_cast<uint64_t>(hours * seconds_per_hour);
-
-    return ch::seconds{ seconds };
+    return this->missing({ "energy_full",
+      "energy_full_design",
+      "charge_full",
+      "charge_full_design" });
 }
 
-res::optional_t<ch::seconds> battery_t::get_time_remaining() const {
+res::optional_t<ch::seconds> battery_t::snapshot_t::get_time_remaining()
+  const {
     // documentation for /sys/class/power_supply
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/power_supply.h
     //     https://www.kernel.org/doc/html/latest/power/power_supply_class.html
@@ -431,8 +590,8 @@ res::optional_t<ch::seconds> battery_t::get_time_remaining() const {
 
     // If this battery is discharging:
     // Method #1 for calculating time remaining:
-    //     time_to_empty contains the number of seconds remaining until this
-    //     battery is empty.
+    //     time_to_empty_now (or time_to_empty_avg) contains the number of
+    //     seconds remaining until this battery is empty.
     // Method #2 for calculating time remaining:
     //     When discharging, energy_now and power_now measure
     //     energy_now is measured in µWh (microwatt hours).
@@ -447,8 +606,8 @@ res::optional_t<ch::seconds> battery_t::get_time_remaining() const {
 
     // If this battery is charging:
     // Method #1 for calculating time remaining:
-    //     time_to_full contains the number of seconds remaining until this
-    //     battery is full.
+    //     time_to_full_now (or time_to_full_avg) contains the number of
+    //     seconds remaining until this battery is full.
     // Method #2 for calculating time remaining:
     //     energy_full is measured in µWh (microwatt hours).
     //     energy_now is measured in µWh (microwatt hours).
@@ -470,72 +629,64 @@ res::optional_t<ch::seconds> battery_t::get_time_remaining() const {
         return RES_TRACE(status.error());
     }
 
-    if (status.value() == status_t::discharging) {
-        // Method #1 for discharging
-        auto time_to_empty = syst::get_int(this->sysfs_path_ / "time_to_empty");
-        if (time_to_empty.has_value()) {
-            return ch::seconds{ time_to_empty.value() };
-        }
-        res::error_t error = RES_TRACE(time_to_empty.error());
-
-        // Method #2 for discharging
-        auto energy = syst::energy_stored(this->sysfs_path_);
-        if (energy.has_value()) {
-            auto power = this->get_power();
-            if (power.has_value()) {
-                return syst::hours_to_seconds(energy.value() / power.value());
-            }
-        }
-        error = RES_CONCAT(error, energy.error());
+    if (status.value() != status_t::discharging
+      && status.value() != status_t::charging) {
+        return RES_NEW_ERROR(
+          "Cannot calculate the time remaining for a battery that "
+          "is neither charging nor discharging.\n\tfile: '"
+          + (this->sysfs_path_ / "uevent").string() + "'");
+    }
 
-        // Method #3 for discharging
-        auto charge = syst::charge_stored(this->sysfs_path_);
-        if (charge.has_value()) {
-            auto current = this->get_current();
-            if (current.has_value()) {
-                return syst::hours_to_seconds(charge.value() / current.value());
-            }
-        }
-        error = RES_CONCAT(error, charge.error());
+    const bool discharging = status.value() == status_t::discharging;
 
-        return error;
-    }
+    // Methods that the battery does not support are skipped entirely.
 
-    if (status.value() == status_t::charging) {
-        // Method #1 for charging
-        auto time_to_full = syst::get_int(this->sysfs_path_ / "time_to_full");
-        if (time_to_full.has_value()) {
-            return ch::seconds{ time_to_full.value() };
+    // Method #1
+    if (discharging ? this->capabilities_.time_to_empty
+                    : this->capabilities_.time_to_full) {
+        auto time = syst::get_integer(
+          *this, discharging ? "time_to_empty_now" : "time_to_full_now");
+        if (! time.has_value()) {
+            time = syst::get_integer(
+              *this, discharging ? "time_to_empty_avg" : "time_to_full_avg");
         }
-        res::error_t error = RES_TRACE(time_to_full.error());
-
-        // Method #2 for charging
-        auto energy = syst::energy_missing(this->sysfs_path_);
-        if (energy.has_value()) {
-            auto power = this->get_power();
-            if (power.has_value()) {
-                return syst::hours_to_seconds(energy.value() / power.value());
-            }
+        if (time.has_value() && time.value() >= 0) {
+            return ch::seconds{ time.value() };
         }
-        error = RES_CONCAT(error, energy.error());
+    }
 
-        // Method #3 for charging
-        auto charge = syst::charge_missing(this->sysfs_path_);
-        if (charge.has_value()) {
-            auto current = this->get_current();
-            if (current.has_value()) {
-                return syst::hours_to_seconds(charge.value() / current.value());
-            }
+    // Method #2
+    if (this->capabilities_.energy) {
+        auto energy = discharging ? syst::until_empty(*this, energy_quantity)
+                                  : syst::until_full(*this, energy_quantity);
+        auto power = syst::power(*this, this->capabilities_);
+        if (energy.has_value() && power.has_value() && power.value() > 0) {
+            return syst::hours_to_seconds(energy.value() / power.value());
         }
-        error = RES_CONCAT(error, charge.error());
+    }
 
-        return error;
+    // Method #3
+    if (this->capabilities_.charge) {
+        auto charge = discharging ? syst::until_empty(*this, charge_quantity)
+                                  : syst::until_full(*this, charge_quantity);
+        auto current = syst::current(*this, this->capabilities_);
+        if (charge.has_value() && current.has_value() && current.value() > 0) {
+            return syst::hours_to_seconds(charge.value() / current.value());
+        }
     }
 
-    return RES_NEW_ERROR(
-      "Cannot calculate the time remaining for a battery that "
-      "is neither charging nor discharging.\n\tsysfs path: '"
-      + this->sysfs_path_.string() + "'");
+    if (discharging) {
+        return this->missing({ "time_to_empty_now",
+          "energy_now",
+          "power_now",
+          "charge_now",
+          "current_now" });
+    }
+    return this->missing({ "time_to_full_now",
+      "energy_full",
+      "power_now",
+      "charge_full",
+      "current_now" });
 }
 
 } // namespace syst
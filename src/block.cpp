@@ -1,224 +1,296 @@
 // Standard includes
-#include <fstream>
+#include <sstream>
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
 
 namespace syst {
 
-[[nodiscard]] res::optional_t<fs::path> devfs_path(const fs::path& sysfs_path) {
-    fs::path devfs_path = "/dev" / sysfs_path.filename();
+[[nodiscard]] res::optional_t<fs::path> devfs_path(std::string_view name) {
+    auto dev = syst::get_dev_root();
+    if (dev.has_error()) {
+        return RES_TRACE(dev.error());
+    }
 
-    if (! fs::is_block_file(devfs_path)) {
-        return RES_NEW_ERROR(
-          "The path to the devfs block device corresponding to a sysfs block "
-          "device does not exist or is not a block file.\n\tdevfs: '"
-          + devfs_path.string() + "'\n\tsysfs: '" + sysfs_path.string() + "'");
+    // The device node is not required to exist since devfs may be read from a
+    // directory without the nodes of the devices in sysfs, such as /dev in a
+    // container that reads the /sys of its host.
+    return dev.value()->path / name;
+}
+
+/**
+ * @brief Read the mount table.
+ *
+ * @param[out] proc - The procfs root that the mount table was read from. Only
+ * used to build the path to the mount table for error messages.
+ * @return every line of the mount table if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<std::vector<std::string>> get_mounts(
+  const root_t*& proc) {
+    auto proc_root = syst::get_proc_root();
+    if (proc_root.has_error()) {
+        return RES_TRACE(proc_root.error());
+    }
+    proc = proc_root.value();
+
+    auto mounts = syst::get_all_lines_in(*proc, "mounts");
+    if (mounts.has_error()) {
+        return RES_TRACE(mounts.error());
     }
 
-    return devfs_path;
+    return mounts;
 }
 
-[[nodiscard]] res::optional_t<uint64_t> size(const fs::path& sysfs_path) {
-    auto size = syst::get_int(sysfs_path / "size");
-    if (! size.has_value()) {
-        return RES_TRACE(size.error());
+[[nodiscard]] res::optional_t<uint64_t> size(const fd_t& dir) {
+    uint64_t size = 0;
+    const read_error_t error = syst::read_int_at(dir, "size", size);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     const uint64_t bytes_per_sector = 512; // UNIX sectors
-    size.value() *= bytes_per_sector;
-
-    return size;
+    return size * bytes_per_sector;
 }
 
-[[nodiscard]] res::optional_t<uint64_t> start(const fs::path& sysfs_path) {
-    auto start = syst::get_int(sysfs_path / "start");
-    if (! start.has_value()) {
-        return RES_TRACE(start.error());
+[[nodiscard]] res::optional_t<uint64_t> start(const fd_t& dir) {
+    uint64_t start = 0;
+    const read_error_t error = syst::read_int_at(dir, "start", start);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     const uint64_t bytes_per_sector = 512; // UNIX sectors
-    start.value() *= bytes_per_sector;
-
-    return start;
+    return start * bytes_per_sector;
 }
 
-[[nodiscard]] res::optional_t<bool> read_only(const fs::path& sysfs_path) {
-    auto read_only = syst::get_bool(sysfs_path / "ro");
-
-    if (read_only.has_error()) {
-        return RES_TRACE(read_only.error());
+[[nodiscard]] res::optional_t<bool> read_only(const fd_t& dir) {
+    bool read_only = false;
+    const read_error_t error = syst::read_bool_at(dir, "ro", read_only);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     return read_only;
 }
 
 [[nodiscard]] res::optional_t<inflight_stat_t> inflight_stat(
-  const fs::path& sysfs_path) {
+  const fd_t& dir) {
     // documentation for /sys/block/<dev>/inflight
     //     https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-block
 
-    const fs::path inflight_path = sysfs_path / "inflight";
-    if (! fs::is_regular_file(inflight_path)) {
-        return RES_NEW_ERROR("The path is not a regular file.\n\tpath: '"
-          + inflight_path.string() + "'");
-    }
+    const char* inflight_name = "inflight";
 
     inflight_stat_t inflight_stat{};
 
-    std::ifstream file{ inflight_path };
+    auto contents = syst::read_attribute(dir, inflight_name);
+    if (contents.has_error()) {
+        return RES_ERROR(
+          contents.error(), "Failed to read the inflight statistics file.");
+    }
+    std::istringstream file{ contents.value() };
 
     if ((file >> inflight_stat.reads).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'reads' statistic from the inflight "
           "statistics file.\n\tfile: '"
-          + inflight_path.string() + "'");
+          + syst::attribute_path(dir, inflight_name) + "'");
     }
     if ((file >> inflight_stat.writes).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'writes' statistic from the inflight "
           "statistics file.\n\tfile: '"
-          + inflight_path.string() + "'");
+          + syst::attribute_path(dir, inflight_name) + "'");
     }
 
     return inflight_stat;
 }
 
 [[nodiscard]] res::optional_t<io_stat_t> io_stat(
-  const fs::path& sysfs_path, const fs::path& disk_sysfs_path) {
+  const fd_t& dir, const fd_t& disk_dir) {
     // documentation for /sys/block/<dev>/stat
     //     https://www.kernel.org/doc/html/latest/block/stat.html
     //     https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-block
 
-    const fs::path io_stat_status_path = disk_sysfs_path / "queue/iostats";
-    const auto io_stat_status = syst::get_bool(io_stat_status_path);
-    if (io_stat_status.has_error()) {
-        return RES_TRACE(io_stat_status.error());
+    const char* io_stat_status_name = "queue/iostats";
+    bool io_stat_status = false;
+    const read_error_t error =
+      syst::read_bool_at(disk_dir, io_stat_status_name, io_stat_status);
+    if (error.failed()) {
+        return error.to_error();
     }
-    if (io_stat_status.has_error()) {
+    if (! io_stat_status) {
         return RES_NEW_ERROR(
           "The I/O statistics file is disabled. Write '1' to the "
           "I/O statistics status file to enable it.\n\tfile: '"
-          + io_stat_status_path.string() + "'");
+          + syst::attribute_path(disk_dir, io_stat_status_name) + "'");
     }
 
-    const fs::path io_stat_path = sysfs_path / "stat";
-    if (! fs::is_regular_file(io_stat_path)) {
-        return RES_NEW_ERROR("The path is not a regular file.\n\tpath: '"
-          + io_stat_path.string() + "'");
-    }
+    const char* io_stat_name = "stat";
 
     io_stat_t io_stat{};
 
     uint64_t temp_int = 0;
 
-    std::ifstream file{ io_stat_path };
+    auto contents = syst::read_attribute(dir, io_stat_name);
+    if (contents.has_error()) {
+        return RES_ERROR(
+          contents.error(), "Failed to read the I/O statistics file.");
+    }
+    std::istringstream file{ contents.value() };
 
     if ((file >> io_stat.reads_completed).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'reads_completed' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.reads_merged).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'reads_merged' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.sectors_read).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'sectors_read' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> temp_int).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'time_by_reads' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     io_stat.time_by_reads = ch::milliseconds(temp_int);
     if ((file >> io_stat.writes_completed).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'writes_completed' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.writes_merged).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'writes_merged' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.sectors_written).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'sectors_written' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> temp_int).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'time_by_writes' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     io_stat.time_by_writes = ch::milliseconds(temp_int);
     if ((file >> io_stat.io_in_flight).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'io_in_flight' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> temp_int).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'time_spent_queued' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     io_stat.time_spent_queued = ch::milliseconds(temp_int);
     if ((file >> temp_int).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'time_by_queued_io' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     io_stat.time_by_queued_io = ch::milliseconds(temp_int);
     if ((file >> io_stat.discards_completed).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'discards_completed' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.discards_merged).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'discards_merged' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> io_stat.sectors_discarded).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'sectors_discarded' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     if ((file >> temp_int).fail()) {
         return RES_NEW_ERROR(
           "Failed to read the 'time_by_discards' statistic from the "
           "I/O statistics file.\n\tfile: '"
-          + io_stat_path.string() + "'");
+          + syst::attribute_path(dir, io_stat_name) + "'");
     }
     io_stat.time_by_discards = ch::milliseconds(temp_int);
 
     return io_stat;
 }
 
-disk_t::disk_t(const fs::path& sysfs_path, const fs::path& devfs_path)
-: sysfs_path_(sysfs_path), devfs_path_(devfs_path) {
+[[nodiscard]] disk_t::capabilities_t disk_capabilities(const fd_t& dir) {
+    disk_t::capabilities_t capabilities{};
+
+    capabilities.rotational = syst::has_attribute_at(dir, "queue/rotational");
+    capabilities.inflight_stat = syst::has_attribute_at(dir, "inflight");
+    capabilities.io_stat = syst::has_attribute_at(dir, "stat")
+      && syst::has_attribute_at(dir, "queue/iostats");
+
+    return capabilities;
+}
+
+[[nodiscard]] res::error_t unsupported(
+  const fs::path& sysfs_path, const std::string& attribute) {
+    return RES_NEW_ERROR(
+      "The attribute is not supported by this block device.\n\tattribute: '"
+      + attribute + "'\n\tsysfs: '" + sysfs_path.string() + "'");
+}
+
+disk_t::disk_t(const fs::path& sysfs_path,
+  std::shared_ptr<const fd_t> dir,
+  const fs::path& devfs_path,
+  const capabilities_t& capabilities)
+: sysfs_path_(sysfs_path)
+, dir_(std::move(dir))
+, devfs_path_(devfs_path)
+, capabilities_(capabilities) {
+}
+
+res::result_t append_disk(
+  const class_entry_t& entry, std::vector<disk_t>& disks) {
+    const fs::path sysfs_path = entry.class_path / entry.name;
+
+    auto dir = syst::open_device_dir(&entry.dir, entry.name.data());
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
+
+    auto devfs_path = syst::devfs_path(entry.name);
+    if (devfs_path.has_error()) {
+        return RES_TRACE(devfs_path.error());
+    }
+
+    const auto capabilities = syst::disk_capabilities(*dir.value());
+    disks.push_back(disk_t{
+      sysfs_path, std::move(dir.value()), devfs_path.value(), capabilities });
+    return res::success;
 }
 
 res::optional_t<std::vector<disk_t>> get_disks() {
+    SYST_API("get_disks");
     // documentation for /sys/block/
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/types.h
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/linux/blk_types.h
@@ -227,82 +299,58 @@ res::optional_t<std::vector<disk_t>> get_disks() {
 
     std::vector<disk_t> disks;
 
-    const std::string blocks_path = "/sys/block";
-
-    if (! fs::is_directory(blocks_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + blocks_path + "'");
-    }
-
-    for (const auto& block : fs::directory_iterator(blocks_path)) {
-        if (! fs::is_directory(block)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(block)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        const fs::path& sysfs_path = block.path();
+    const fs::path blocks_path = "block";
 
-        auto devfs_path = syst::devfs_path(sysfs_path);
-        if (devfs_path.has_error()) {
-            return RES_TRACE(devfs_path.error());
-        }
-
-        disks.push_back(disk_t{ sysfs_path, devfs_path.value() });
+    auto result = syst::for_each_class_entry(
+      blocks_path, "", [&](const class_entry_t& entry) {
+          return syst::append_disk(entry, disks);
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return disks;
 }
 
 res::optional_t<std::vector<part_t>> disk_t::get_parts() const {
+    SYST_API("disk_t::get_parts");
     std::vector<part_t> parts;
 
-    const std::string blocks_path = "/sys/class/block";
-    if (! fs::is_directory(blocks_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + blocks_path + "'");
-    }
-
-    for (const auto& block : fs::directory_iterator(blocks_path)) {
-        if (! fs::is_directory(block)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(block)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        const fs::path disk_name = this->sysfs_path_.filename();
-        const fs::path part_name = block.path().filename();
-        if (disk_name == part_name) {
-            // Ignore this disk (it's a disk, not a partition).
-            continue;
-        }
-        if (! syst::has_prefix(part_name.string(), disk_name.string())) {
-            // Ignore block devices that are not associated with this disk.
-            continue;
-        }
-
-        if (! fs::is_regular_file(block.path() / "partition")) {
-            // Ignore block devices that are not partitions.
-            continue;
-        }
-
-        const fs::path& sysfs_path = block.path();
-
-        auto devfs_path = syst::devfs_path(sysfs_path);
-        if (! devfs_path.has_value()) {
-            return RES_TRACE(devfs_path.error());
-        }
-
-        parts.push_back(part_t{ sysfs_path,
-          devfs_path.value(),
-          this->sysfs_path_,
-          this->devfs_path_ });
+    const fs::path blocks_path = "class/block";
+    const std::string disk_name = this->sysfs_path_.filename();
+
+    // Block devices that are not associated with this disk are skipped by
+    // their name.
+    auto result = syst::for_each_class_entry(blocks_path,
+      disk_name,
+      [&](const class_entry_t& entry) -> res::result_t {
+          if (entry.name == disk_name) {
+              // Ignore this disk (it's a disk, not a partition).
+              return res::success;
+          }
+
+          auto dir = syst::open_device_dir(&entry.dir, entry.name.data());
+          if (dir.has_error()) {
+              return RES_TRACE(dir.error());
+          }
+          if (! syst::has_attribute_at(*dir.value(), "partition")) {
+              // Ignore block devices that are not partitions.
+              return res::success;
+          }
+
+          const fs::path sysfs_path = entry.class_path / entry.name;
+
+          auto devfs_path = syst::devfs_path(entry.name);
+          if (! devfs_path.has_value()) {
+              return RES_TRACE(devfs_path.error());
+          }
+
+          parts.push_back(part_t{
+            sysfs_path, std::move(dir.value()), devfs_path.value(), *this });
+          return res::success;
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return parts;
@@ -320,8 +368,13 @@ std::string disk_t::get_name() const {
     return this->sysfs_path_.filename();
 }
 
+disk_t::capabilities_t disk_t::get_capabilities() const {
+    return this->capabilities_;
+}
+
 res::optional_t<uint64_t> disk_t::get_size() const {
-    auto size = syst::size(this->sysfs_path_);
+    SYST_API("disk_t::get_size");
+    auto size = syst::size(*this->dir_);
 
     if (size.has_error()) {
         return RES_TRACE(size.error());
@@ -331,17 +384,20 @@ res::optional_t<uint64_t> disk_t::get_size() const {
 }
 
 res::optional_t<bool> disk_t::is_removable() const {
-    auto removable = syst::get_bool(this->sysfs_path_ / "removable");
-
-    if (removable.has_error()) {
-        return RES_TRACE(removable.error());
+    SYST_API("disk_t::is_removable");
+    bool removable = false;
+    const read_error_t error =
+      syst::read_bool_at(*this->dir_, "removable", removable);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     return removable;
 }
 
 res::optional_t<bool> disk_t::is_read_only() const {
-    auto read_only = syst::read_only(this->sysfs_path_);
+    SYST_API("disk_t::is_read_only");
+    auto read_only = syst::read_only(*this->dir_);
 
     if (read_only.has_error()) {
         return RES_TRACE(read_only.error());
@@ -351,17 +407,28 @@ res::optional_t<bool> disk_t::is_read_only() const {
 }
 
 res::optional_t<bool> disk_t::is_rotational() const {
-    auto rotational = syst::get_bool(this->sysfs_path_ / "queue/rotational");
+    SYST_API("disk_t::is_rotational");
+    if (! this->capabilities_.rotational) {
+        return syst::unsupported(this->sysfs_path_, "queue/rotational");
+    }
 
-    if (rotational.has_error()) {
-        return RES_TRACE(rotational.error());
+    bool rotational = false;
+    const read_error_t error =
+      syst::read_bool_at(*this->dir_, "queue/rotational", rotational);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     return rotational;
 }
 
 res::optional_t<inflight_stat_t> disk_t::get_inflight_stat() const {
-    auto inflight_stat = syst::inflight_stat(this->sysfs_path_);
+    SYST_API("disk_t::get_inflight_stat");
+    if (! this->capabilities_.inflight_stat) {
+        return syst::unsupported(this->sysfs_path_, "inflight");
+    }
+
+    auto inflight_stat = syst::inflight_stat(*this->dir_);
 
     if (inflight_stat.has_error()) {
         return RES_TRACE(inflight_stat.error());
@@ -371,7 +438,12 @@ res::optional_t<inflight_stat_t> disk_t::get_inflight_stat() const {
 }
 
 res::optional_t<io_stat_t> disk_t::get_io_stat() const {
-    auto io_stat = syst::io_stat(this->sysfs_path_, this->sysfs_path_);
+    SYST_API("disk_t::get_io_stat");
+    if (! this->capabilities_.io_stat) {
+        return syst::unsupported(this->sysfs_path_, "stat");
+    }
+
+    auto io_stat = syst::io_stat(*this->dir_, *this->dir_);
 
     if (io_stat.has_error()) {
         return RES_TRACE(io_stat.error());
@@ -381,13 +453,13 @@ res::optional_t<io_stat_t> disk_t::get_io_stat() const {
 }
 
 part_t::part_t(const fs::path& sysfs_path,
+  std::shared_ptr<const fd_t> dir,
   const fs::path& devfs_path,
-  const fs::path& disk_sysfs_path,
-  const fs::path& disk_devfs_path)
+  const disk_t& disk)
 : sysfs_path_(sysfs_path)
+, dir_(std::move(dir))
 , devfs_path_(devfs_path)
-, disk_sysfs_path_(disk_sysfs_path)
-, disk_devfs_path_(disk_devfs_path) {
+, disk_(disk) {
 }
 
 fs::path part_t::get_sysfs_path() const {
@@ -403,11 +475,12 @@ std::string part_t::get_name() const {
 }
 
 disk_t part_t::get_disk() const {
-    return disk_t{ this->disk_sysfs_path_, this->disk_devfs_path_ };
+    return this->disk_;
 }
 
 res::optional_t<uint64_t> part_t::get_size() const {
-    auto size = syst::size(this->sysfs_path_);
+    SYST_API("part_t::get_size");
+    auto size = syst::size(*this->dir_);
 
     if (size.has_error()) {
         return RES_TRACE(size.error());
@@ -417,7 +490,8 @@ res::optional_t<uint64_t> part_t::get_size() const {
 }
 
 res::optional_t<uint64_t> part_t::get_start_position() const {
-    auto start = syst::start(this->sysfs_path_);
+    SYST_API("part_t::get_start_position");
+    auto start = syst::start(*this->dir_);
 
     if (start.has_error()) {
         return RES_TRACE(start.error());
@@ -427,7 +501,8 @@ res::optional_t<uint64_t> part_t::get_start_position() const {
 }
 
 res::optional_t<bool> part_t::is_read_only() const {
-    auto read_only = syst::read_only(this->sysfs_path_);
+    SYST_API("part_t::is_read_only");
+    auto read_only = syst::read_only(*this->dir_);
 
     if (read_only.has_error()) {
         return RES_TRACE(read_only.error());
@@ -437,7 +512,8 @@ res::optional_t<bool> part_t::is_read_only() const {
 }
 
 res::optional_t<inflight_stat_t> part_t::get_inflight_stat() const {
-    auto inflight_stat = syst::inflight_stat(this->sysfs_path_);
+    SYST_API("part_t::get_inflight_stat");
+    auto inflight_stat = syst::inflight_stat(*this->dir_);
 
     if (inflight_stat.has_error()) {
         return RES_TRACE(inflight_stat.error());
@@ -447,7 +523,13 @@ res::optional_t<inflight_stat_t> part_t::get_inflight_stat() const {
 }
 
 res::optional_t<io_stat_t> part_t::get_io_stat() const {
-    auto io_stat = syst::io_stat(this->sysfs_path_, this->disk_sysfs_path_);
+    SYST_API("part_t::get_io_stat");
+    if (! this->disk_.capabilities_.io_stat) {
+        // Statistics for partitions depend on the status file of the disk.
+        return syst::unsupported(this->disk_.sysfs_path_, "stat");
+    }
+
+    auto io_stat = syst::io_stat(*this->dir_, *this->disk_.dir_);
 
     if (io_stat.has_error()) {
         return RES_TRACE(io_stat.error());
@@ -457,20 +539,22 @@ res::optional_t<io_stat_t> part_t::get_io_stat() const {
 }
 
 res::optional_t<bool> part_t::is_mounted() const {
+    SYST_API("part_t::is_mounted");
     // documentation for /proc/mounts
     //     man proc_pid_mounts
     //     https://docs.redhat.com/en/documentation/red_hat_enterprise_linux/4/html-single/introduction_to_system_administration/index#s4-storage-mounting-proc
 
-    std::string proc_mounts = "/proc/mounts";
-
-    auto mounts = syst::get_all_lines(proc_mounts);
+    const root_t* proc = nullptr;
+    auto mounts = syst::get_mounts(proc);
     if (! mounts.has_value()) {
         return RES_TRACE(mounts.error());
     }
 
     // Search for the devfs path of this partition in the mounts flie.
-    // All paths in the mounts file end with a space ' '.
-    auto devfs_path = this->devfs_path_.string() + ' ';
+    // All paths in the mounts file end with a space ' '. The kernel always
+    // names devices by their path in /dev, even if devfs is read from another
+    // directory.
+    auto devfs_path = "/dev/" + this->get_name() + ' ';
 
     for (const std::string& mount : mounts.value()) {
         if (! syst::has_prefix(mount, devfs_path)) {
@@ -484,13 +568,13 @@ res::optional_t<bool> part_t::is_mounted() const {
 }
 
 res::optional_t<mount_info_t> part_t::get_mount_info() const {
+    SYST_API("part_t::get_mount_info");
     // documentation for /proc/mounts
     //     man proc_pid_mounts
     //     https://docs.redhat.com/en/documentation/red_hat_enterprise_linux/4/html-single/introduction_to_system_administration/index#s4-storage-mounting-proc
 
-    std::string proc_mounts = "/proc/mounts";
-
-    auto mounts = syst::get_all_lines(proc_mounts);
+    const root_t* proc = nullptr;
+    auto mounts = syst::get_mounts(proc);
     if (! mounts.has_value()) {
         return RES_TRACE(mounts.error());
     }
@@ -498,8 +582,10 @@ res::optional_t<mount_info_t> part_t::get_mount_info() const {
     char space = ' ';
 
     // Search for the devfs path of this partition in the mounts flie.
-    // All paths in the mounts file end with a space.
-    std::string buffered_devfs_path = this->devfs_path_.string() + space;
+    // All paths in the mounts file end with a space. The kernel always names
+    // devices by their path in /dev, even if devfs is read from another
+    // directory.
+    std::string buffered_devfs_path = "/dev/" + this->get_name() + space;
 
     for (const std::string& mount : mounts.value()) {
         if (! syst::has_prefix(mount, buffered_devfs_path)) {
@@ -514,7 +600,8 @@ res::optional_t<mount_info_t> part_t::get_mount_info() const {
         if (unused_2_pos >= mount_info_str.size()) {
             return RES_NEW_ERROR(
               "Failed to find the 2nd unused field for a partition in '"
-              + proc_mounts + "'.\n\tdevfs: '" + this->devfs_path_.string()
+              + (proc->path / "mounts").string() + "'.\n\tdevfs: '"
+              + this->devfs_path_.string()
               + "'\n\tsysfs: '" + this->sysfs_path_.string()
               + "'\n\tmount_info_str: '" + mount_info_str + "'");
         }
@@ -525,7 +612,8 @@ res::optional_t<mount_info_t> part_t::get_mount_info() const {
         if (unused_1_pos >= mount_info_str.size()) {
             return RES_NEW_ERROR(
               "Failed to find the 1st unused field for a partition in '"
-              + proc_mounts + "'.\n\tdevfs: '" + this->devfs_path_.string()
+              + (proc->path / "mounts").string() + "'.\n\tdevfs: '"
+              + this->devfs_path_.string()
               + "'\n\tsysfs: '" + this->sysfs_path_.string()
               + "'\n\tmount_info_str: '" + mount_info_str + "'");
         }
@@ -536,7 +624,8 @@ res::optional_t<mount_info_t> part_t::get_mount_info() const {
         if (mount_options_pos >= mount_info_str.size()) {
             return RES_NEW_ERROR(
               "Failed to find the mount options for a partition in '"
-              + proc_mounts + "'.\n\tdevfs: '" + this->devfs_path_.string()
+              + (proc->path / "mounts").string() + "'.\n\tdevfs: '"
+              + this->devfs_path_.string()
               + "'\n\tsysfs: '" + this->sysfs_path_.string()
               + "'\n\tmount_info_str: '" + mount_info_str + "'");
         }
@@ -550,7 +639,8 @@ res::optional_t<mount_info_t> part_t::get_mount_info() const {
         if (fs_type_pos >= mount_info_str.size()) {
             return RES_NEW_ERROR(
               "Failed to find the filesystem type for a partition in '"
-              + proc_mounts + "'.\n\tdevfs: '" + this->devfs_path_.string()
+              + (proc->path / "mounts").string() + "'.\n\tdevfs: '"
+              + this->devfs_path_.string()
               + "'\n\tsysfs: '" + this->sysfs_path_.string()
               + "'\n\tmount_info_str: '" + mount_info_str + "'");
         }
@@ -3,8 +3,8 @@
 #define ASSERT_NOT_NULL(arg, return_val)                                       \
     if (arg == NULL) {                                                         \
         if (error != NULL) {                                                   \
-            *error = strdup(                                                   \
-              RES_NEW_ERROR("A required argument is null.").string().c_str()); \
+            *error = syst::duplicate_string(                                   \
+              RES_NEW_ERROR("A required argument is null.").string());         \
         }                                                                      \
         return return_val;                                                     \
     }
@@ -13,7 +13,7 @@
     auto result = call;                                                        \
     if (result.failure()) {                                                    \
         if (error != NULL) {                                                   \
-            *error = strdup(result.error().string().c_str());                  \
+            *error = syst::duplicate_string(result.error().string());          \
         }                                                                      \
         return return_val;                                                     \
     }
@@ -21,7 +21,7 @@
 #define ASSERT_HAS_VALUE(result, return_val)                                   \
     if (result.has_error()) {                                                  \
         if (error != NULL) {                                                   \
-            *error = strdup(result.error().string().c_str());                  \
+            *error = syst::duplicate_string(result.error().string());          \
         }                                                                      \
         return return_val;                                                     \
     }
@@ -29,8 +29,103 @@
 #define ASSERT_HAS_INDEX(list, index, return_val)                              \
     if (index >= list->size()) {                                               \
         if (error != NULL) {                                                   \
-            *error =                                                           \
-              strdup(RES_NEW_ERROR("Index out of range.").string().c_str());   \
+            *error = syst::duplicate_string(                                   \
+              RES_NEW_ERROR("Index out of range.").string());                  \
         }                                                                      \
         return return_val;                                                     \
     }
+
+// The following are used by functions that return an error code instead of
+// allocating an error message.
+
+#define CHECK_NOT_NULL(arg)                                                    \
+    if (arg == NULL) {                                                         \
+        return syst_error_null_argument;                                       \
+    }
+
+namespace syst {
+
+/**
+ * @brief Copy a string into memory allocated with malloc, which the caller
+ * frees with syst_string_free.
+ *
+ * @param[in] string - The string to copy.
+ * @return the copy or NULL if the allocation failed.
+ */
+[[nodiscard]] char* duplicate_string(const std::string& string);
+
+/**
+ * @brief Forget the last error of this thread. Called at the start of every
+ * function that returns an error code so that syst_get_last_error only
+ * reports errors of the most recent call.
+ */
+void clear_last_error();
+
+/**
+ * @brief Keep an error for syst_get_last_error. The error (including its
+ * trace) is only converted to a string if it is requested, but its message
+ * was already built by the function that failed.
+ *
+ * @param[in] error - The error to keep.
+ * @return syst_error_failed.
+ */
+syst_error_t set_last_error(const res::error_t& error);
+
+/**
+ * @brief Copy a string into a buffer provided by the caller. The string is
+ * truncated if it does not fit.
+ *
+ * @param[in] string - The string to copy.
+ * @param[out] buffer - The buffer to copy the string into.
+ * @param[in] size - The size of the buffer.
+ * @return syst_ok if the whole string was copied or
+ * syst_error_buffer_too_small otherwise.
+ */
+syst_error_t copy_string(
+  const std::string& string, char* buffer, unsigned long size);
+
+/**
+ * @brief Copy a name into a buffer of a snapshot. The name is truncated if it
+ * does not fit.
+ *
+ * @param[in] name - The name to copy.
+ * @param[out] buffer - The buffer to copy the name into.
+ * @return syst_ok if the whole name was copied or syst_error_buffer_too_small
+ * otherwise.
+ */
+syst_error_t copy_name(const std::string& name, char (&buffer)[SYST_NAME_SIZE]);
+
+/**
+ * @brief Fill one snapshot per element of a list. Every element is filled even
+ * if filling one of them fails.
+ *
+ * @param[in] list - The list of elements.
+ * @param[out] snapshots - The array of snapshots to fill.
+ * @param[in] count - The number of snapshots in the array.
+ * @param[in] fill - Fills the snapshot of one element and returns an error
+ * code.
+ * @return syst_error_buffer_too_small if the array is smaller than the list,
+ * the last error code returned by fill if any, or syst_ok otherwise.
+ */
+template<typename element_t, typename snapshot_t, typename fill_t>
+[[nodiscard]] syst_error_t fill_snapshots(const std::vector<element_t>& list,
+  snapshot_t* snapshots,
+  unsigned long count,
+  fill_t fill) {
+    if (count < list.size()) {
+        return syst_error_buffer_too_small;
+    }
+
+    syst_error_t status = syst_ok;
+    for (size_t idx = 0; idx < list.size(); ++idx) {
+        snapshots[idx] = snapshot_t{};
+        const syst_error_t element_status = fill(list[idx], snapshots[idx]);
+        if (element_status != syst_ok) {
+            status = element_status;
+        }
+    }
+
+    return status;
+}
+
+} // namespace syst
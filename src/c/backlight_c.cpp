@@ -32,12 +32,12 @@ void syst_backlight_list_free(syst_backlight_list_t* backlight_list) {
 
 char* syst_backlight_get_sysfs_path(syst_backlight_t* backlight, char** error) {
     ASSERT_NOT_NULL(backlight, NULL);
-    return strdup(backlight->get_sysfs_path().c_str());
+    return syst::duplicate_string(backlight->get_sysfs_path());
 }
 
 char* syst_backlight_get_name(syst_backlight_t* backlight, char** error) {
     ASSERT_NOT_NULL(backlight, NULL);
-    return strdup(backlight->get_name().c_str());
+    return syst::duplicate_string(backlight->get_name());
 }
 
 double syst_backlight_get_brightness(
@@ -60,4 +60,19 @@ void syst_backlight_set_brightness_relative(
     ASSERT_SUCCESS(backlight->set_brightness_relative(brightness), );
 }
 
+syst_error_t syst_backlight_snapshot(
+  syst_backlight_t* backlight, syst_backlight_snapshot_t* snapshot) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(backlight);
+    CHECK_NOT_NULL(snapshot);
+
+    auto brightness = backlight->get_brightness();
+    if (brightness.has_error()) {
+        return syst::set_last_error(brightness.error());
+    }
+    snapshot->brightness = brightness.value();
+
+    return syst::copy_name(backlight->get_name(), snapshot->name);
+}
+
 } // extern "C"
@@ -5,6 +5,28 @@
 #include "../../system_state/system_state.h"
 #include "assert_c.hpp"
 
+namespace syst {
+
+[[nodiscard]] syst_battery_status_t to_c_battery_status(
+  battery_t::status_t status) {
+    switch (status) {
+        case battery_t::status_t::unknown:
+            return syst_battery_status_unknown;
+        case battery_t::status_t::charging:
+            return syst_battery_status_charging;
+        case battery_t::status_t::discharging:
+            return syst_battery_status_discharging;
+        case battery_t::status_t::not_charging:
+            return syst_battery_status_not_charging;
+        case battery_t::status_t::full:
+            return syst_battery_status_full;
+        default:
+            return syst_battery_status_unknown;
+    }
+}
+
+} // namespace syst
+
 extern "C" {
 
 syst_battery_list_t* syst_get_batteries(char** error) {
@@ -32,12 +54,12 @@ void syst_battery_list_free(syst_battery_list_t* battery_list) {
 
 char* syst_battery_get_sysfs_path(syst_battery_t* battery, char** error) {
     ASSERT_NOT_NULL(battery, NULL);
-    return strdup(battery->get_sysfs_path().c_str());
+    return syst::duplicate_string(battery->get_sysfs_path());
 }
 
 char* syst_battery_get_name(syst_battery_t* battery, char** error) {
     ASSERT_NOT_NULL(battery, NULL);
-    return strdup(battery->get_name().c_str());
+    return syst::duplicate_string(battery->get_name());
 }
 
 syst_battery_status_t syst_battery_get_status(
@@ -45,20 +67,7 @@ syst_battery_status_t syst_battery_get_status(
     ASSERT_NOT_NULL(battery, syst_battery_status_unknown);
     auto result = battery->get_status();
     ASSERT_HAS_VALUE(result, syst_battery_status_unknown);
-    switch (result.value()) {
-        case syst::battery_t::status_t::unknown:
-            return syst_battery_status_unknown;
-        case syst::battery_t::status_t::charging:
-            return syst_battery_status_charging;
-        case syst::battery_t::status_t::discharging:
-            return syst_battery_status_discharging;
-        case syst::battery_t::status_t::not_charging:
-            return syst_battery_status_not_charging;
-        case syst::battery_t::status_t::full:
-            return syst_battery_status_full;
-        default:
-            return syst_battery_status_unknown;
-    }
+    return syst::to_c_battery_status(result.value());
 }
 
 double syst_battery_get_current(syst_battery_t* battery, char** error) {
@@ -97,4 +106,57 @@ unsigned long syst_battery_get_time_remaining(
     return result->count();
 }
 
+syst_error_t syst_battery_snapshot(
+  syst_battery_t* battery, syst_battery_snapshot_t* snapshot) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(battery);
+    CHECK_NOT_NULL(snapshot);
+
+    // Every value is calculated from a single read of the uevent file.
+    auto battery_snapshot = battery->get_snapshot();
+    if (battery_snapshot.has_error()) {
+        return syst::set_last_error(battery_snapshot.error());
+    }
+
+    *snapshot = syst_battery_snapshot_t{};
+
+    auto status = battery_snapshot->get_status();
+    if (status.has_value()) {
+        snapshot->has_status = 1;
+        snapshot->status = syst::to_c_battery_status(status.value());
+    }
+
+    auto current = battery_snapshot->get_current();
+    if (current.has_value()) {
+        snapshot->has_current = 1;
+        snapshot->current = current.value();
+    }
+
+    auto power = battery_snapshot->get_power();
+    if (power.has_value()) {
+        snapshot->has_power = 1;
+        snapshot->power = power.value();
+    }
+
+    auto charge = battery_snapshot->get_charge();
+    if (charge.has_value()) {
+        snapshot->has_charge = 1;
+        snapshot->charge = charge.value();
+    }
+
+    auto capacity = battery_snapshot->get_capacity();
+    if (capacity.has_value()) {
+        snapshot->has_capacity = 1;
+        snapshot->capacity = capacity.value();
+    }
+
+    auto time_remaining = battery_snapshot->get_time_remaining();
+    if (time_remaining.has_value()) {
+        snapshot->has_time_remaining = 1;
+        snapshot->time_remaining = time_remaining->count();
+    }
+
+    return syst::copy_name(battery->get_name(), snapshot->name);
+}
+
 } // extern "C"
@@ -0,0 +1,161 @@
+// Standard includes
+#include <cstring>
+
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+namespace syst {
+
+[[nodiscard]] syst_io_stat_t to_c_io_stat(const io_stat_t& io_stat) {
+    syst_io_stat_t c_io_stat{};
+    c_io_stat.reads_completed = io_stat.reads_completed;
+    c_io_stat.reads_merged = io_stat.reads_merged;
+    c_io_stat.sectors_read = io_stat.sectors_read;
+    c_io_stat.time_by_reads = io_stat.time_by_reads.count();
+    c_io_stat.writes_completed = io_stat.writes_completed;
+    c_io_stat.writes_merged = io_stat.writes_merged;
+    c_io_stat.sectors_written = io_stat.sectors_written;
+    c_io_stat.time_by_writes = io_stat.time_by_writes.count();
+    c_io_stat.io_in_flight = io_stat.io_in_flight;
+    c_io_stat.time_spent_queued = io_stat.time_spent_queued.count();
+    c_io_stat.time_by_queued_io = io_stat.time_by_queued_io.count();
+    c_io_stat.discards_completed = io_stat.discards_completed;
+    c_io_stat.discards_merged = io_stat.discards_merged;
+    c_io_stat.sectors_discarded = io_stat.sectors_discarded;
+    c_io_stat.time_by_discards = io_stat.time_by_discards.count();
+    return c_io_stat;
+}
+
+/**
+ * @brief Fill the snapshot of a disk or a partition.
+ *
+ * @param[in] block - The disk or partition.
+ * @param[in] inflight_stat - Whether the in-flight statistics are reported.
+ * @param[in] io_stat - Whether the I/O statistics are reported.
+ * @param[out] snapshot - The snapshot to fill.
+ * @return syst_ok or the code of the last error.
+ */
+template<typename block_t>
+[[nodiscard]] syst_error_t fill_block_snapshot(const block_t& block,
+  bool inflight_stat,
+  bool io_stat,
+  syst_block_snapshot_t& snapshot) {
+    syst_error_t status = syst::copy_name(block.get_name(), snapshot.name);
+
+    auto size = block.get_size();
+    if (size.has_value()) {
+        snapshot.has_size = 1;
+        snapshot.size = size.value();
+    } else {
+        status = syst::set_last_error(size.error());
+    }
+
+    if (inflight_stat) {
+        auto stat = block.get_inflight_stat();
+        if (stat.has_value()) {
+            snapshot.has_inflight_stat = 1;
+            snapshot.inflight_stat.reads = stat->reads;
+            snapshot.inflight_stat.writes = stat->writes;
+        } else {
+            status = syst::set_last_error(stat.error());
+        }
+    }
+
+    if (io_stat) {
+        auto stat = block.get_io_stat();
+        if (stat.has_value()) {
+            snapshot.has_io_stat = 1;
+            snapshot.io_stat = syst::to_c_io_stat(stat.value());
+        } else {
+            status = syst::set_last_error(stat.error());
+        }
+    }
+
+    return status;
+}
+
+} // namespace syst
+
+extern "C" {
+
+syst_disk_list_t* syst_get_disks(char** error) {
+    auto result = syst::get_disks();
+    ASSERT_HAS_VALUE(result, NULL);
+    return result.release();
+}
+
+unsigned long syst_disk_list_get_size(
+  syst_disk_list_t* disk_list, char** error) {
+    ASSERT_NOT_NULL(disk_list, 0);
+    return disk_list->size();
+}
+
+syst_disk_t* syst_disk_list_get(
+  syst_disk_list_t* disk_list, unsigned long index, char** error) {
+    ASSERT_NOT_NULL(disk_list, NULL);
+    ASSERT_HAS_INDEX(disk_list, index, NULL);
+    return &((*disk_list)[index]);
+}
+
+void syst_disk_list_free(syst_disk_list_t* disk_list) {
+    delete disk_list;
+}
+
+syst_part_list_t* syst_disk_get_parts(syst_disk_t* disk, char** error) {
+    ASSERT_NOT_NULL(disk, NULL);
+    auto result = disk->get_parts();
+    ASSERT_HAS_VALUE(result, NULL);
+    return result.release();
+}
+
+unsigned long syst_part_list_get_size(
+  syst_part_list_t* part_list, char** error) {
+    ASSERT_NOT_NULL(part_list, 0);
+    return part_list->size();
+}
+
+void syst_part_list_free(syst_part_list_t* part_list) {
+    delete part_list;
+}
+
+syst_error_t syst_disk_list_snapshot(syst_disk_list_t* disk_list,
+  syst_block_snapshot_t* snapshots,
+  unsigned long count) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(disk_list);
+    if (count > 0) {
+        CHECK_NOT_NULL(snapshots);
+    }
+
+    return syst::fill_snapshots(*disk_list,
+      snapshots,
+      count,
+      [](const syst::disk_t& disk, syst_block_snapshot_t& snapshot) {
+          // Statistics that the disk does not report are not read.
+          const auto capabilities = disk.get_capabilities();
+          return syst::fill_block_snapshot(disk,
+            capabilities.inflight_stat,
+            capabilities.io_stat,
+            snapshot);
+      });
+}
+
+syst_error_t syst_part_list_snapshot(syst_part_list_t* part_list,
+  syst_block_snapshot_t* snapshots,
+  unsigned long count) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(part_list);
+    if (count > 0) {
+        CHECK_NOT_NULL(snapshots);
+    }
+
+    return syst::fill_snapshots(*part_list,
+      snapshots,
+      count,
+      [](const syst::part_t& part, syst_block_snapshot_t& snapshot) {
+          return syst::fill_block_snapshot(part, true, true, snapshot);
+      });
+}
+
+} // extern "C"
@@ -0,0 +1,69 @@
+// Standard includes
+#include <algorithm>
+#include <new>
+
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+extern "C" {
+
+syst_cpu_usage_t* syst_cpu_usage_new(void) {
+    return new (std::nothrow) syst::cpu_usage_t{};
+}
+
+void syst_cpu_usage_free(syst_cpu_usage_t* cpu_usage) {
+    delete cpu_usage;
+}
+
+syst_error_t syst_cpu_usage_update(syst_cpu_usage_t* cpu_usage) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(cpu_usage);
+
+    auto result = cpu_usage->update();
+    if (result.failure()) {
+        return syst::set_last_error(result.error());
+    }
+
+    return syst_ok;
+}
+
+syst_error_t syst_cpu_usage_get_total(
+  syst_cpu_usage_t* cpu_usage, double* total) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(cpu_usage);
+    CHECK_NOT_NULL(total);
+
+    auto result = cpu_usage->get_total();
+    if (result.has_error()) {
+        return syst::set_last_error(result.error());
+    }
+    *total = result.value();
+
+    return syst_ok;
+}
+
+syst_error_t syst_cpu_usage_get_per_core(
+  syst_cpu_usage_t* cpu_usage, double* per_core, unsigned long* count) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(cpu_usage);
+    CHECK_NOT_NULL(count);
+
+    auto result = cpu_usage->get_per_core();
+    if (result.has_error()) {
+        return syst::set_last_error(result.error());
+    }
+
+    const unsigned long capacity = *count;
+    *count = result->size();
+    if (capacity < result->size()) {
+        return syst_error_buffer_too_small;
+    }
+    CHECK_NOT_NULL(per_core);
+
+    std::copy(result->begin(), result->end(), per_core);
+
+    return syst_ok;
+}
+
+} // extern "C"
@@ -0,0 +1,66 @@
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+namespace syst {
+
+// Each thread has its own last error so that threads do not observe each
+// other's errors.
+thread_local std::optional<res::error_t> last_error;
+
+void clear_last_error() {
+    last_error.reset();
+}
+
+syst_error_t set_last_error(const res::error_t& error) {
+    last_error = error;
+    return syst_error_failed;
+}
+
+syst_error_t copy_string(
+  const std::string& string, char* buffer, unsigned long size) {
+    if (size == 0) {
+        return syst_error_buffer_too_small;
+    }
+
+    const size_t length = std::min(string.size(), size - 1);
+    std::memcpy(buffer, string.data(), length);
+    buffer[length] = '\0';
+
+    if (length < string.size()) {
+        return syst_error_buffer_too_small;
+    }
+
+    return syst_ok;
+}
+
+syst_error_t copy_name(
+  const std::string& name, char (&buffer)[SYST_NAME_SIZE]) {
+    return syst::copy_string(name, buffer, sizeof(buffer));
+}
+
+} // namespace syst
+
+extern "C" {
+
+unsigned long syst_get_last_error(char* buffer, unsigned long size) {
+    if (! syst::last_error.has_value()) {
+        return 0;
+    }
+
+    const std::string message = syst::last_error->string();
+
+    if (buffer != NULL && size > 0) {
+        const size_t length = std::min(message.size(), size - 1);
+        std::memcpy(buffer, message.data(), length);
+        buffer[length] = '\0';
+    }
+
+    return message.size();
+}
+
+} // extern "C"
@@ -0,0 +1,96 @@
+// Standard includes
+#include <cstring>
+
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+namespace syst {
+
+[[nodiscard]] syst_network_interface_status_t to_c_network_interface_status(
+  network_interface_t::status_t status) {
+    switch (status) {
+        case network_interface_t::status_t::unknown:
+            return syst_network_interface_status_unknown;
+        case network_interface_t::status_t::up:
+            return syst_network_interface_status_up;
+        case network_interface_t::status_t::dormant:
+            return syst_network_interface_status_dormant;
+        case network_interface_t::status_t::down:
+            return syst_network_interface_status_down;
+        default:
+            return syst_network_interface_status_unknown;
+    }
+}
+
+} // namespace syst
+
+extern "C" {
+
+syst_network_interface_list_t* syst_get_network_interfaces(char** error) {
+    auto result = syst::get_network_interfaces();
+    ASSERT_HAS_VALUE(result, NULL);
+    return result.release();
+}
+
+unsigned long syst_network_interface_list_get_size(
+  syst_network_interface_list_t* network_interface_list, char** error) {
+    ASSERT_NOT_NULL(network_interface_list, 0);
+    return network_interface_list->size();
+}
+
+void syst_network_interface_list_free(
+  syst_network_interface_list_t* network_interface_list) {
+    delete network_interface_list;
+}
+
+syst_error_t syst_network_interface_list_snapshot(
+  syst_network_interface_list_t* network_interface_list,
+  syst_network_interface_snapshot_t* snapshots,
+  unsigned long count) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(network_interface_list);
+    if (count > 0) {
+        CHECK_NOT_NULL(snapshots);
+    }
+
+    return syst::fill_snapshots(*network_interface_list,
+      snapshots,
+      count,
+      [](const syst::network_interface_t& interface,
+        syst_network_interface_snapshot_t& snapshot) {
+          syst_error_t status =
+            syst::copy_name(interface.get_name(), snapshot.name);
+
+          // Values that the interface does not report are not read.
+          const auto capabilities = interface.get_capabilities();
+
+          if (capabilities.status) {
+              auto interface_status = interface.get_status();
+              if (interface_status.has_value()) {
+                  snapshot.has_status = 1;
+                  snapshot.status = syst::to_c_network_interface_status(
+                    interface_status.value());
+              } else {
+                  status = syst::set_last_error(interface_status.error());
+              }
+          }
+
+          if (capabilities.stat) {
+              auto stat = interface.get_stat();
+              if (stat.has_value()) {
+                  snapshot.has_stat = 1;
+                  snapshot.bytes_down = stat->bytes_down;
+                  snapshot.bytes_up = stat->bytes_up;
+                  snapshot.packets_down = stat->packets_down;
+                  snapshot.packets_up = stat->packets_up;
+              } else {
+                  status = syst::set_last_error(stat.error());
+              }
+          }
+
+          return status;
+      });
+}
+
+} // extern "C"
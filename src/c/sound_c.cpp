@@ -5,6 +5,82 @@
 #include "../../system_state/system_state.h"
 #include "assert_c.hpp"
 
+namespace syst {
+
+// Converts a sound_control_t::status_t or sound_control_t::volume_t.
+template<typename state_t, typename c_value_t>
+void to_c_sound_state(const state_t& state,
+  unsigned int& channels,
+  c_value_t (&values)[syst_sound_channel_count]) {
+    const decltype(state.front_left)* members[syst_sound_channel_count] = {
+        &state.front_left,
+        &state.front_right,
+        &state.rear_left,
+        &state.rear_right,
+        &state.front_center,
+        &state.woofer,
+        &state.side_left,
+        &state.side_right,
+        &state.rear_center,
+    };
+
+    channels = 0;
+    for (unsigned int channel = 0; channel < syst_sound_channel_count;
+         ++channel) {
+        values[channel] = 0;
+        if (members[channel]->has_value()) {
+            channels |= 1U << channel;
+            values[channel] = static_cast<c_value_t>(members[channel]->value());
+        }
+    }
+}
+
+[[nodiscard]] syst_error_t read_c_sound_volume(
+  syst_sound_control_t* sound_control,
+  bool playback,
+  syst_sound_volume_t* volume) {
+    *volume = syst_sound_volume_t{};
+
+    // Directions that are not supported are left empty without creating an
+    // error.
+    if (playback ? ! sound_control->has_playback_volume()
+                 : ! sound_control->has_capture_volume()) {
+        return syst_ok;
+    }
+
+    auto result = playback ? sound_control->get_playback_volume()
+                           : sound_control->get_capture_volume();
+    if (result.has_error()) {
+        return syst::set_last_error(result.error());
+    }
+
+    to_c_sound_state(result.value(), volume->channels, volume->volume);
+    return syst_ok;
+}
+
+[[nodiscard]] syst_error_t read_c_sound_status(
+  syst_sound_control_t* sound_control,
+  bool playback,
+  syst_sound_status_t* status) {
+    *status = syst_sound_status_t{};
+
+    if (playback ? ! sound_control->has_playback_status()
+                 : ! sound_control->has_capture_status()) {
+        return syst_ok;
+    }
+
+    auto result = playback ? sound_control->get_playback_status()
+                           : sound_control->get_capture_status();
+    if (result.has_error()) {
+        return syst::set_last_error(result.error());
+    }
+
+    to_c_sound_state(result.value(), status->channels, status->status);
+    return syst_ok;
+}
+
+} // namespace syst
+
 extern "C" {
 
 syst_sound_mixer_t* syst_get_sound_mixer(char** error) {
@@ -50,7 +126,7 @@ void syst_sound_control_list_free(
 char* syst_sound_control_get_name(
   syst_sound_control_t* sound_control, char** error) {
     ASSERT_NOT_NULL(sound_control, NULL);
-    return strdup(sound_control->get_name().c_str());
+    return syst::duplicate_string(sound_control->get_name());
 }
 
 int syst_sound_control_has_playback_status(
@@ -125,4 +201,58 @@ void syst_sound_control_set_capture_volume_all_relative(
     ASSERT_SUCCESS(sound_control->set_capture_volume_all_relative(volume), );
 }
 
+syst_error_t syst_sound_control_read(syst_sound_control_t* sound_control,
+  syst_sound_volume_t* playback_volume,
+  syst_sound_status_t* playback_status) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(sound_control);
+
+    if (playback_volume != NULL) {
+        syst_error_t error =
+          syst::read_c_sound_volume(sound_control, true, playback_volume);
+        if (error != syst_ok) {
+            return error;
+        }
+    }
+
+    if (playback_status != NULL) {
+        syst_error_t error =
+          syst::read_c_sound_status(sound_control, true, playback_status);
+        if (error != syst_ok) {
+            return error;
+        }
+    }
+
+    return syst_ok;
+}
+
+syst_error_t syst_sound_control_snapshot(
+  syst_sound_control_t* sound_control,
+  syst_sound_control_snapshot_t* snapshot) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(sound_control);
+    CHECK_NOT_NULL(snapshot);
+
+    syst_error_t error = syst_sound_control_read(
+      sound_control, &snapshot->playback_volume, &snapshot->playback_status);
+    if (error != syst_ok) {
+        return error;
+    }
+
+    error = syst::read_c_sound_volume(
+      sound_control, false, &snapshot->capture_volume);
+    if (error != syst_ok) {
+        return error;
+    }
+
+    error = syst::read_c_sound_status(
+      sound_control, false, &snapshot->capture_status);
+    if (error != syst_ok) {
+        return error;
+    }
+
+    snapshot->index = sound_control->get_index();
+    return syst::copy_name(sound_control->get_name(), snapshot->name);
+}
+
 } // extern "C"
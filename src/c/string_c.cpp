@@ -3,6 +3,19 @@
 
 // Local includes
 #include "../../system_state/system_state.h"
+#include "../instrument.hpp"
+#include "assert_c.hpp"
+
+namespace syst {
+
+char* duplicate_string(const std::string& string) {
+    // The copy is made with malloc since the caller frees it with
+    // syst_string_free, so the allocation is counted here.
+    syst::count_allocation();
+    return strdup(string.c_str());
+}
+
+} // namespace syst
 
 extern "C" {
 
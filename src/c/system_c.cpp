@@ -0,0 +1,33 @@
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+extern "C" {
+
+syst_error_t syst_get_system_info(syst_system_info_t* info) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(info);
+
+    auto system_info = syst::get_system_info();
+    if (system_info.has_error()) {
+        return syst::set_last_error(system_info.error());
+    }
+
+    info->uptime = system_info->uptime.count();
+    info->load_1 = system_info->load_1;
+    info->load_5 = system_info->load_5;
+    info->load_15 = system_info->load_15;
+    info->ram_total = system_info->ram_total;
+    info->ram_free = system_info->ram_free;
+    info->ram_shared = system_info->ram_shared;
+    info->ram_buffered = system_info->ram_buffered;
+    info->swap_total = system_info->swap_total;
+    info->swap_free = system_info->swap_free;
+    info->procs = system_info->procs;
+    info->ram_usage = system_info->ram_usage;
+    info->swap_usage = system_info->swap_usage;
+
+    return syst_ok;
+}
+
+} // extern "C"
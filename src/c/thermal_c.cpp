@@ -0,0 +1,79 @@
+// Standard includes
+#include <cstring>
+
+// Local includes
+#include "../../system_state/system_state.h"
+#include "assert_c.hpp"
+
+extern "C" {
+
+syst_thermal_zone_list_t* syst_get_thermal_zones(char** error) {
+    auto result = syst::get_thermal_zones();
+    ASSERT_HAS_VALUE(result, NULL);
+    return result.release();
+}
+
+unsigned long syst_thermal_zone_list_get_size(
+  syst_thermal_zone_list_t* thermal_zone_list, char** error) {
+    ASSERT_NOT_NULL(thermal_zone_list, 0);
+    return thermal_zone_list->size();
+}
+
+void syst_thermal_zone_list_free(syst_thermal_zone_list_t* thermal_zone_list) {
+    delete thermal_zone_list;
+}
+
+syst_error_t syst_thermal_zone_list_get_type(
+  syst_thermal_zone_list_t* thermal_zone_list,
+  unsigned long index,
+  char* buffer,
+  unsigned long size) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(thermal_zone_list);
+    CHECK_NOT_NULL(buffer);
+    if (index >= thermal_zone_list->size()) {
+        return syst::set_last_error(RES_NEW_ERROR("Index out of range."));
+    }
+
+    auto type = (*thermal_zone_list)[index].get_type();
+    if (type.has_error()) {
+        return syst::set_last_error(type.error());
+    }
+
+    return syst::copy_string(type.value(), buffer, size);
+}
+
+syst_error_t syst_thermal_zone_list_snapshot(
+  syst_thermal_zone_list_t* thermal_zone_list,
+  syst_thermal_zone_snapshot_t* snapshots,
+  unsigned long count) {
+    syst::clear_last_error();
+    CHECK_NOT_NULL(thermal_zone_list);
+    if (count > 0) {
+        CHECK_NOT_NULL(snapshots);
+    }
+
+    return syst::fill_snapshots(*thermal_zone_list,
+      snapshots,
+      count,
+      [](const syst::thermal_zone_t& zone,
+        syst_thermal_zone_snapshot_t& snapshot) {
+          syst_error_t status = syst::copy_name(
+            zone.get_sysfs_path().filename().string(), snapshot.name);
+
+          // The temperature is not read if the zone does not report it.
+          if (zone.get_capabilities().temperature) {
+              auto temperature = zone.get_temperature();
+              if (temperature.has_value()) {
+                  snapshot.has_temperature = 1;
+                  snapshot.temperature = temperature.value();
+              } else {
+                  status = syst::set_last_error(temperature.error());
+              }
+          }
+
+          return status;
+      });
+}
+
+} // extern "C"
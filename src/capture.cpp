@@ -0,0 +1,624 @@
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// External includes
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "capture.hpp"
+#include "instrument.hpp"
+#include "strerror.hpp"
+#include "util.hpp"
+
+namespace syst {
+
+// Capture files start with a magic string and a version, followed by
+// records. Every record starts with its kind (u8):
+//
+//     path:    u32 id, u32 length, path
+//     read:    u32 id, u64 timestamp (nanoseconds since the Unix epoch),
+//              u32 length, contents
+//     exists:  u32 id, u64 timestamp, u32 length, '0' or '1'
+//     listing: u32 id, u64 timestamp, u32 length, names each followed by a
+//              null character
+//
+// A path record gives an identifier to a path before its first other record,
+// so each path is stored once. Integers are in the byte order of the host.
+// Each record is appended with a single write, so a capture that was not
+// stopped properly only loses its last record.
+const std::string_view capture_magic{ "SYSTCAP", 8 };
+const uint32_t capture_version = 2;
+
+enum class record_kind_t : uint8_t {
+    path = 1,
+    read = 2,
+    exists = 3,
+    listing = 4,
+};
+
+/**
+ * @brief Paths within a root are recorded as if they were within the default
+ * root.
+ */
+struct root_prefix_t {
+    std::string prefix;
+    std::string replacement;
+};
+
+/**
+ * @brief Turns the files read by this library into the paths that they are
+ * recorded as.
+ */
+struct capture_keys_t {
+    std::vector<root_prefix_t> prefixes;
+
+    // The paths of the directories that files were read relative to by their
+    // device and inode numbers, so each path is only looked up once.
+    std::mutex mutex;
+    std::map<std::pair<dev_t, ino_t>, std::string> dir_paths;
+};
+
+struct recording_t {
+    fs::path path;
+    fd_t file;
+    capture_keys_t keys;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> path_ids;
+
+    // The errno value of the first failed write or 0.
+    int write_error = 0;
+};
+
+struct replay_file_t {
+    std::vector<std::string> contents;
+    std::atomic<size_t> next{ 0 };
+};
+
+struct replay_t {
+    capture_keys_t keys;
+    std::unordered_map<std::string, replay_file_t> reads;
+    std::unordered_map<std::string, replay_file_t> probes;
+    std::unordered_map<std::string, replay_file_t> listings;
+
+    /**
+     * @return the recorded files of one kind of record.
+     */
+    [[nodiscard]] std::unordered_map<std::string, replay_file_t>& get_files(
+      record_kind_t kind) {
+        if (kind == record_kind_t::exists) {
+            return this->probes;
+        }
+        if (kind == record_kind_t::listing) {
+            return this->listings;
+        }
+        return this->reads;
+    }
+};
+
+std::atomic<capture_mode_t> capture_mode{ capture_mode_t::off };
+std::shared_ptr<recording_t> recording;
+std::shared_ptr<replay_t> replay;
+std::mutex capture_mutex;
+
+/**
+ * @return the prefixes of the current roots and of their canonical paths.
+ */
+[[nodiscard]] std::vector<root_prefix_t> get_root_prefixes() {
+    const roots_t roots = syst::get_roots();
+    const roots_t default_roots{};
+
+    std::vector<root_prefix_t> prefixes;
+    const auto add = [&](const fs::path& root, const fs::path& default_root) {
+        std::error_code error;
+        const fs::path canonical = fs::canonical(root, error);
+
+        for (const fs::path& path : { root, canonical }) {
+            std::string prefix = path.lexically_normal().string();
+            while (prefix.size() > 1 && prefix.back() == '/') {
+                prefix.pop_back();
+            }
+            if (prefix.empty() || prefix == "/") {
+                continue;
+            }
+            prefixes.push_back(root_prefix_t{ prefix, default_root.string() });
+        }
+    };
+    add(roots.sys, default_roots.sys);
+    add(roots.proc, default_roots.proc);
+    add(roots.dev, default_roots.dev);
+
+    return prefixes;
+}
+
+/**
+ * @return the path of an open directory or an empty string if it is unknown.
+ */
+[[nodiscard]] std::string get_dir_path(capture_keys_t& keys, int dirfd) {
+    // Device directories are only known by their descriptors, and looking up
+    // the path of a descriptor costs more than reading a file.
+    struct stat status {};
+    syst::count_stat();
+    if (fstat(dirfd, &status) != 0) {
+        return syst::get_fd_path(dirfd);
+    }
+    const std::pair<dev_t, ino_t> id{ status.st_dev, status.st_ino };
+
+    {
+        const std::lock_guard<std::mutex> lock{ keys.mutex };
+        auto dir_path = keys.dir_paths.find(id);
+        if (dir_path != keys.dir_paths.end()) {
+            return dir_path->second;
+        }
+    }
+
+    std::string dir_path = syst::get_fd_path(dirfd);
+    if (! dir_path.empty()) {
+        const std::lock_guard<std::mutex> lock{ keys.mutex };
+        keys.dir_paths.emplace(id, dir_path);
+    }
+    return dir_path;
+}
+
+/**
+ * @return the path of a file relative to a directory, which is the path of
+ * the directory itself if the relative path is empty.
+ */
+[[nodiscard]] std::string get_path_in(
+  capture_keys_t* keys, const fd_t* dir, const char* path) {
+    if (dir == nullptr || path[0] == '/') {
+        return path;
+    }
+
+    std::string full_path = dir->get_capture_path();
+    if (full_path.empty()) {
+        full_path = keys != nullptr ? syst::get_dir_path(*keys, dir->get())
+                                    : syst::get_fd_path(*dir);
+    }
+    if (path[0] != '\0') {
+        full_path += '/';
+        full_path += path;
+    }
+    return full_path;
+}
+
+/**
+ * @return the path that a file is recorded as.
+ */
+[[nodiscard]] std::string get_capture_key(
+  capture_keys_t& keys, const fd_t* dir, const char* path) {
+    std::string key = syst::get_path_in(&keys, dir, path);
+
+    for (const root_prefix_t& root : keys.prefixes) {
+        if (key.compare(0, root.prefix.size(), root.prefix) == 0
+          && (key.size() == root.prefix.size()
+            || key[root.prefix.size()] == '/')) {
+            key.replace(0, root.prefix.size(), root.replacement);
+            break;
+        }
+    }
+
+    return key;
+}
+
+template<typename integral_t>
+void append_int(std::string& buffer, integral_t integer) {
+    char bytes[sizeof(integral_t)];
+    std::memcpy(bytes, &integer, sizeof(integral_t));
+    buffer.append(bytes, sizeof(integral_t));
+}
+
+/**
+ * @brief Write a whole buffer to a file.
+ *
+ * @return 0 if the operation succeeded or an errno value otherwise.
+ */
+[[nodiscard]] int write_all(const fd_t& file, const std::string& buffer) {
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        ssize_t len =
+          write(file.get(), buffer.data() + offset, buffer.size() - offset);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        offset += static_cast<size_t>(len);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads the integers and strings of a capture file in order.
+ */
+struct capture_reader_t {
+    const std::string& data;
+    size_t offset = 0;
+
+    [[nodiscard]] bool at_end() const {
+        return this->offset == this->data.size();
+    }
+
+    template<typename integral_t>
+    [[nodiscard]] bool read_int(integral_t& integer) {
+        if (this->data.size() - this->offset < sizeof(integral_t)) {
+            return false;
+        }
+        std::memcpy(
+          &integer, this->data.data() + this->offset, sizeof(integral_t));
+        this->offset += sizeof(integral_t);
+        return true;
+    }
+
+    [[nodiscard]] bool read_string(uint32_t len, std::string& string) {
+        if (this->data.size() - this->offset < len) {
+            return false;
+        }
+        string.assign(this->data, this->offset, len);
+        this->offset += len;
+        return true;
+    }
+};
+
+/**
+ * @brief Load every record of a capture file.
+ *
+ * @param[in] path - The path to the capture file.
+ * @return the recorded contents of each file if the operation succeeded or an
+ * error otherwise.
+ */
+[[nodiscard]] res::optional_t<std::shared_ptr<replay_t>> load_capture(
+  const fs::path& path) {
+    auto file = syst::open_fd(path, O_RDONLY);
+    if (file.has_error()) {
+        return RES_TRACE(file.error());
+    }
+
+    std::string data;
+    int err = syst::read_all(file.value(), data);
+    if (err != 0) {
+        return RES_NEW_ERROR("Failed to read the capture file.\n\tpath: '"
+          + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    capture_reader_t reader{ data };
+
+    std::string magic;
+    uint32_t version = 0;
+    const auto magic_len = static_cast<uint32_t>(capture_magic.size());
+    if (! reader.read_string(magic_len, magic) || magic != capture_magic
+      || ! reader.read_int(version)) {
+        return RES_NEW_ERROR(
+          "The file is not a capture file.\n\tpath: '" + path.string() + "'");
+    }
+    if (version != capture_version) {
+        return RES_NEW_ERROR(
+          "The version of the capture file is not supported.\n\tpath: '"
+          + path.string() + "'\n\tversion: '" + std::to_string(version) + "'");
+    }
+
+    auto replay = std::make_shared<replay_t>();
+    replay->keys.prefixes = syst::get_root_prefixes();
+
+    std::vector<std::string> paths;
+
+    // A truncated record can only be the last one, so it is ignored.
+    while (! reader.at_end()) {
+        uint8_t kind = 0;
+        uint32_t id = 0;
+        uint64_t timestamp = 0;
+        uint32_t len = 0;
+        std::string string;
+
+        if (! reader.read_int(kind) || ! reader.read_int(id)) {
+            break;
+        }
+
+        if (kind == static_cast<uint8_t>(record_kind_t::path)) {
+            if (! reader.read_int(len) || ! reader.read_string(len, string)) {
+                break;
+            }
+            if (id != paths.size()) {
+                return RES_NEW_ERROR(
+                  "The paths of the capture file are out of order.\n\tpath: '"
+                  + path.string() + "'\n\tfile: '" + string + "'");
+            }
+            paths.push_back(std::move(string));
+        } else if (kind == static_cast<uint8_t>(record_kind_t::read)
+          || kind == static_cast<uint8_t>(record_kind_t::exists)
+          || kind == static_cast<uint8_t>(record_kind_t::listing)) {
+            if (! reader.read_int(timestamp) || ! reader.read_int(len)
+              || ! reader.read_string(len, string)) {
+                break;
+            }
+            if (id >= paths.size()) {
+                return RES_NEW_ERROR(
+                  "A record of the capture file refers to an unknown "
+                  "path.\n\tpath: '"
+                  + path.string() + "'\n\tid: '" + std::to_string(id) + "'");
+            }
+            auto& files = replay->get_files(static_cast<record_kind_t>(kind));
+            files[paths[id]].contents.push_back(std::move(string));
+        } else {
+            return RES_NEW_ERROR(
+              "The capture file contains an unknown record.\n\tpath: '"
+              + path.string() + "'\n\tkind: '" + std::to_string(kind) + "'");
+        }
+    }
+
+    return replay;
+}
+
+capture_mode_t get_capture_mode() {
+    return capture_mode.load(std::memory_order_relaxed);
+}
+
+std::string get_capture_path(const fd_t* dir, const char* path) {
+    return syst::get_path_in(nullptr, dir, path);
+}
+
+/**
+ * @brief Append a record to the capture file if reads are being recorded.
+ *
+ * @param[in] kind - The kind of the record.
+ * @param[in] dir - The directory that the path is relative to or null.
+ * @param[in] path - The path to the file.
+ * @param[in] contents - The contents of the record.
+ */
+void append_record(record_kind_t kind,
+  const fd_t* dir,
+  const char* path,
+  std::string_view contents) {
+    if (syst::get_capture_mode() != capture_mode_t::record) {
+        return;
+    }
+
+    std::shared_ptr<recording_t> recording;
+    {
+        const std::lock_guard<std::mutex> lock{ capture_mutex };
+        recording = syst::recording;
+    }
+    if (recording == nullptr) {
+        return;
+    }
+
+    std::string key = syst::get_capture_key(recording->keys, dir, path);
+
+    const std::lock_guard<std::mutex> lock{ recording->mutex };
+    if (recording->write_error != 0) {
+        return;
+    }
+    if (contents.size() > std::numeric_limits<uint32_t>::max()
+      || key.size() > std::numeric_limits<uint32_t>::max()) {
+        recording->write_error = EFBIG;
+        return;
+    }
+
+    // Timestamps are taken while the lock is held so that they are in order.
+    const auto since_epoch = ch::system_clock::now().time_since_epoch();
+    const auto timestamp = static_cast<uint64_t>(
+      ch::duration_cast<ch::nanoseconds>(since_epoch).count());
+
+    std::string record;
+    auto [id, added] = recording->path_ids.try_emplace(
+      std::move(key), static_cast<uint32_t>(recording->path_ids.size()));
+    if (added) {
+        syst::append_int(record, static_cast<uint8_t>(record_kind_t::path));
+        syst::append_int(record, id->second);
+        syst::append_int(record, static_cast<uint32_t>(id->first.size()));
+        record += id->first;
+    }
+    syst::append_int(record, static_cast<uint8_t>(kind));
+    syst::append_int(record, id->second);
+    syst::append_int(record, timestamp);
+    syst::append_int(record, static_cast<uint32_t>(contents.size()));
+    record += contents;
+
+    recording->write_error = syst::write_all(recording->file, record);
+}
+
+/**
+ * @brief Get the next record of a file from the capture being replayed.
+ * Records are served in the order they were recorded and start over after
+ * the last one.
+ *
+ * @param[in] kind - The kind of the record.
+ * @param[in] dir - The directory that the path is relative to or null.
+ * @param[in] path - The path to the file.
+ * @param[out] contents - The contents of the record.
+ * @return true if the file was recorded and false otherwise.
+ */
+[[nodiscard]] bool next_record(record_kind_t kind,
+  const fd_t* dir,
+  const char* path,
+  std::string& contents) {
+    if (syst::get_capture_mode() != capture_mode_t::replay) {
+        return false;
+    }
+
+    std::shared_ptr<replay_t> replay;
+    {
+        const std::lock_guard<std::mutex> lock{ capture_mutex };
+        replay = syst::replay;
+    }
+    if (replay == nullptr) {
+        return false;
+    }
+
+    auto& files = replay->get_files(kind);
+    auto file = files.find(syst::get_capture_key(replay->keys, dir, path));
+    if (file == files.end() || file->second.contents.empty()) {
+        return false;
+    }
+
+    const size_t next =
+      file->second.next.fetch_add(1, std::memory_order_relaxed);
+    contents = file->second.contents[next % file->second.contents.size()];
+    return true;
+}
+
+void record_read(const fd_t* dir, const char* path, std::string_view contents) {
+    syst::append_record(record_kind_t::read, dir, path, contents);
+}
+
+bool replay_read(const fd_t* dir, const char* path, std::string& contents) {
+    return syst::next_record(record_kind_t::read, dir, path, contents);
+}
+
+void record_exists(const fd_t* dir, const char* path, bool exists) {
+    syst::append_record(record_kind_t::exists, dir, path, exists ? "1" : "0");
+}
+
+bool replay_exists(const fd_t* dir, const char* path, bool& exists) {
+    std::string contents;
+    if (! syst::next_record(record_kind_t::exists, dir, path, contents)) {
+        return false;
+    }
+
+    exists = contents == "1";
+    return true;
+}
+
+void record_listing(const fd_t& dir, const std::vector<std::string>& names) {
+    if (syst::get_capture_mode() != capture_mode_t::record) {
+        return;
+    }
+
+    std::string contents;
+    for (const std::string& name : names) {
+        contents += name;
+        contents += '\0';
+    }
+    syst::append_record(record_kind_t::listing, &dir, "", contents);
+}
+
+bool replay_listing(const fd_t& dir, std::vector<std::string>& names) {
+    std::string contents;
+    if (! syst::next_record(record_kind_t::listing, &dir, "", contents)) {
+        return false;
+    }
+
+    names.clear();
+    for (size_t start = 0; start < contents.size();) {
+        size_t end = contents.find('\0', start);
+        if (end == std::string::npos) {
+            end = contents.size();
+        }
+        names.emplace_back(contents, start, end - start);
+        start = end + 1;
+    }
+    return true;
+}
+
+res::error_t not_recorded(const std::string& path) {
+    return RES_NEW_ERROR(
+      "The file was not recorded in the capture being replayed.\n\tfile: '"
+      + path + "'");
+}
+
+res::result_t start_recording(const fs::path& capture_path) {
+    SYST_API("start_recording");
+    const std::lock_guard<std::mutex> lock{ capture_mutex };
+    if (syst::get_capture_mode() != capture_mode_t::off) {
+        return RES_NEW_ERROR("Reads are already being recorded or replayed.");
+    }
+
+    // The mode is required since the file may be created.
+    int fd = open(capture_path.c_str(),
+      O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC,
+      0666);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to open the capture file.\n\tpath: '"
+          + capture_path.string() + "'\n\treason: '" + syst::strerror(err)
+          + "'");
+    }
+
+    auto recording = std::make_shared<recording_t>();
+    recording->path = capture_path;
+    recording->file = fd_t{ fd };
+    recording->keys.prefixes = syst::get_root_prefixes();
+
+    std::string header{ capture_magic };
+    syst::append_int(header, capture_version);
+    int err = syst::write_all(recording->file, header);
+    if (err != 0) {
+        return RES_NEW_ERROR("Failed to write the capture file.\n\tpath: '"
+          + capture_path.string() + "'\n\treason: '" + syst::strerror(err)
+          + "'");
+    }
+
+    syst::recording = std::move(recording);
+    capture_mode.store(capture_mode_t::record, std::memory_order_relaxed);
+    return res::success;
+}
+
+res::result_t stop_recording() {
+    SYST_API("stop_recording");
+    std::shared_ptr<recording_t> recording;
+    {
+        const std::lock_guard<std::mutex> lock{ capture_mutex };
+        if (syst::recording == nullptr) {
+            return RES_NEW_ERROR("No reads are being recorded.");
+        }
+        recording = std::move(syst::recording);
+        capture_mode.store(capture_mode_t::off, std::memory_order_relaxed);
+    }
+
+    // Reads that started before recording stopped finish writing first.
+    const std::lock_guard<std::mutex> lock{ recording->mutex };
+    if (recording->write_error != 0) {
+        return RES_NEW_ERROR(
+          "Failed to write a read to the capture file.\n\tpath: '"
+          + recording->path.string() + "'\n\treason: '"
+          + syst::strerror(recording->write_error) + "'");
+    }
+
+    return res::success;
+}
+
+res::result_t start_replay(const fs::path& capture_path) {
+    SYST_API("start_replay");
+    const std::lock_guard<std::mutex> lock{ capture_mutex };
+    if (syst::get_capture_mode() != capture_mode_t::off) {
+        return RES_NEW_ERROR("Reads are already being recorded or replayed.");
+    }
+
+    auto replay = syst::load_capture(capture_path);
+    if (replay.has_error()) {
+        return RES_TRACE(replay.error());
+    }
+
+    syst::replay = std::move(replay.value());
+    capture_mode.store(capture_mode_t::replay, std::memory_order_relaxed);
+    return res::success;
+}
+
+void stop_replay() {
+    SYST_API("stop_replay");
+    const std::lock_guard<std::mutex> lock{ capture_mutex };
+    if (syst::replay == nullptr) {
+        return;
+    }
+
+    syst::replay.reset();
+    capture_mode.store(capture_mode_t::off, std::memory_order_relaxed);
+}
+
+} // namespace syst
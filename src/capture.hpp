@@ -0,0 +1,119 @@
+#pragma once
+
+// Standard includes
+#include <string>
+#include <string_view>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+namespace syst {
+
+enum class capture_mode_t {
+    off,    // Files are read.
+    record, // Files are read and their contents are recorded.
+    replay, // The recorded contents of files are served instead.
+};
+
+/**
+ * @return whether reads are being recorded or replayed. Cheap enough to be
+ * checked before every read.
+ */
+[[nodiscard]] capture_mode_t get_capture_mode();
+
+// Files are recorded by their path. Files and directories opened while reads
+// are recorded or replayed remember the path they were opened with (see
+// fd_t), so files read relative to them need no lookup. Files relative to a
+// directory that was opened earlier are recorded by the path of the directory
+// in /proc/self/fd.
+
+class fd_t;
+
+/**
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @return the path that identifies a file opened while reads are recorded or
+ * replayed.
+ */
+[[nodiscard]] std::string get_capture_path(const fd_t* dir, const char* path);
+
+/**
+ * @brief Record the contents of a file that was read whole. Does nothing if
+ * no reads are being recorded. Failures to write the capture file are
+ * reported by stop_recording.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[in] contents - The contents of the file.
+ */
+void record_read(const fd_t* dir, const char* path, std::string_view contents);
+
+/**
+ * @brief Get the next recorded contents of a file from the capture being
+ * replayed.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[out] contents - The recorded contents of the file.
+ * @return true if the file was recorded and false otherwise (including if no
+ * capture is being replayed).
+ */
+[[nodiscard]] bool replay_read(
+  const fd_t* dir, const char* path, std::string& contents);
+
+/**
+ * @brief Record whether a file exists. Does nothing if no reads are being
+ * recorded.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[in] exists - Whether the file exists.
+ */
+void record_exists(const fd_t* dir, const char* path, bool exists);
+
+/**
+ * @brief Get the next recorded existence of a file from the capture being
+ * replayed.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[out] exists - Whether the file existed when it was recorded.
+ * @return true if the file was recorded and false otherwise.
+ */
+[[nodiscard]] bool replay_exists(
+  const fd_t* dir, const char* path, bool& exists);
+
+/**
+ * @brief Record the names of the entries of a directory. Does nothing if no
+ * reads are being recorded.
+ *
+ * @param[in] dir - The directory.
+ * @param[in] names - The names of its entries.
+ */
+void record_listing(const fd_t& dir, const std::vector<std::string>& names);
+
+/**
+ * @brief Get the next recorded entries of a directory from the capture being
+ * replayed.
+ *
+ * @param[in] dir - The directory.
+ * @param[out] names - The names of its entries.
+ * @return true if the directory was recorded and false otherwise.
+ */
+[[nodiscard]] bool replay_listing(
+  const fd_t& dir, std::vector<std::string>& names);
+
+/**
+ * @param[in] path - The path to the file that was read.
+ * @return an error describing a file that is missing from the capture being
+ * replayed.
+ */
+[[nodiscard]] res::error_t not_recorded(const std::string& path);
+
+} // namespace syst
@@ -0,0 +1,259 @@
+// Standard includes
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+
+namespace syst {
+
+// More threads than this do not reduce latency since there are only a few
+// subsystems and most of their time is spent in the kernel.
+const unsigned int max_collect_threads = 4;
+
+struct collect_pool_t {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::packaged_task<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    collect_pool_t() {
+        const unsigned int count = std::clamp(
+          std::thread::hardware_concurrency(), 1U, max_collect_threads);
+
+        for (unsigned int idx = 0; idx < count; ++idx) {
+            this->threads.emplace_back([this]() { this->run(); });
+        }
+    }
+
+    collect_pool_t(const collect_pool_t&) = delete;
+    collect_pool_t(collect_pool_t&&) noexcept = delete;
+    collect_pool_t& operator=(const collect_pool_t&) = delete;
+    collect_pool_t& operator=(collect_pool_t&&) noexcept = delete;
+
+    ~collect_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock{ this->mutex };
+            this->stopping = true;
+        }
+        this->condition.notify_all();
+
+        for (std::thread& thread : this->threads) {
+            thread.join();
+        }
+    }
+
+    void run() {
+        while (true) {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock<std::mutex> lock{ this->mutex };
+                this->condition.wait(lock, [this]() {
+                    return this->stopping || ! this->tasks.empty();
+                });
+                if (this->tasks.empty()) {
+                    return;
+                }
+                task = std::move(this->tasks.front());
+                this->tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    [[nodiscard]] std::future<void> submit(std::function<void()>&& function) {
+        std::packaged_task<void()> task{ std::move(function) };
+        std::future<void> future = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock{ this->mutex };
+            this->tasks.push_back(std::move(task));
+        }
+        this->condition.notify_one();
+        return future;
+    }
+};
+
+[[nodiscard]] collect_pool_t& get_collect_pool() {
+    // Threads are only started the first time subsystems are collected
+    // concurrently.
+    static collect_pool_t pool;
+    return pool;
+}
+
+/**
+ * @brief Collect one subsystem and measure the time it takes.
+ *
+ * @param[out] snapshot - The snapshot of the subsystem to fill.
+ * @param[in] collector - Collects the subsystem.
+ */
+template<typename value_t, typename collector_t>
+void collect_subsystem(
+  std::optional<subsystem_snapshot_t<value_t>>& snapshot,
+  const collector_t& collector) {
+    const auto start = ch::steady_clock::now();
+    res::optional_t<value_t> value = collector();
+    const auto end = ch::steady_clock::now();
+
+    snapshot.emplace(subsystem_snapshot_t<value_t>{ std::move(value),
+      ch::duration_cast<ch::nanoseconds>(end - start) });
+}
+
+/**
+ * @brief Enumerate devices and collect the values of each one.
+ *
+ * @param[in] devices - The enumerated devices or an error.
+ * @param[in] collect_device - Collects the values of one device.
+ * @return the values of every device.
+ */
+template<typename device_t, typename collect_device_t>
+[[nodiscard]] auto collect_devices(
+  res::optional_t<std::vector<device_t>>&& devices,
+  const collect_device_t& collect_device)
+  -> res::optional_t<std::vector<decltype(collect_device(devices->front()))>> {
+    if (devices.has_error()) {
+        return RES_TRACE(devices.error());
+    }
+
+    std::vector<decltype(collect_device(devices->front()))> collected;
+    collected.reserve(devices->size());
+    for (const device_t& device : devices.value()) {
+        collected.push_back(collect_device(device));
+    }
+
+    return collected;
+}
+
+[[nodiscard]] res::optional_t<collected_cpu_usage_t> collect_cpu_usage(
+  const cpu_usage_t& cpu_usage) {
+    auto result = cpu_usage.update();
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return collected_cpu_usage_t{ cpu_usage.get_total(),
+      cpu_usage.get_per_core() };
+}
+
+system_snapshot_t collect(const collect_options_t& options) {
+    SYST_API("collect");
+    system_snapshot_t snapshot{};
+    snapshot.timestamp = ch::steady_clock::now();
+
+    std::vector<std::function<void()>> collectors;
+
+    if (options.system_info) {
+        collectors.emplace_back([&snapshot]() {
+            syst::collect_subsystem(
+              snapshot.system_info, []() { return syst::get_system_info(); });
+        });
+    }
+
+    if (options.cpu_usage != nullptr) {
+        collectors.emplace_back([&snapshot, &options]() {
+            syst::collect_subsystem(snapshot.cpu_usage, [&options]() {
+                return syst::collect_cpu_usage(*options.cpu_usage);
+            });
+        });
+    }
+
+    if (options.disks) {
+        collectors.emplace_back([&snapshot]() {
+            syst::collect_subsystem(snapshot.disks, []() {
+                return syst::collect_devices(
+                  syst::get_disks(), [](const disk_t& disk) {
+                      return collected_disk_t{ disk,
+                          disk.get_size(),
+                          disk.get_inflight_stat(),
+                          disk.get_io_stat() };
+                  });
+            });
+        });
+    }
+
+    if (options.network_interfaces) {
+        collectors.emplace_back([&snapshot]() {
+            syst::collect_subsystem(snapshot.network_interfaces, []() {
+                return syst::collect_devices(syst::get_network_interfaces(),
+                  [](const network_interface_t& network_interface) {
+                      return collected_network_interface_t{ network_interface,
+                          network_interface.get_status(),
+                          network_interface.get_stat() };
+                  });
+            });
+        });
+    }
+
+    if (options.thermal_zones) {
+        collectors.emplace_back([&snapshot, &options]() {
+            syst::collect_subsystem(snapshot.thermal_zones, [&options]() {
+                return syst::collect_devices(
+                  syst::get_thermal_zones(options.thermal_path),
+                  [](const thermal_zone_t& thermal_zone) {
+                      return collected_thermal_zone_t{ thermal_zone,
+                          thermal_zone.get_temperature() };
+                  });
+            });
+        });
+    }
+
+    if (options.batteries) {
+        collectors.emplace_back([&snapshot, &options]() {
+            syst::collect_subsystem(snapshot.batteries, [&options]() {
+                return syst::collect_devices(
+                  syst::get_batteries(options.power_supply_path),
+                  [](const battery_t& battery) {
+                      return collected_battery_t{ battery,
+                          battery.get_snapshot() };
+                  });
+            });
+        });
+    }
+
+    if (options.backlights) {
+        collectors.emplace_back([&snapshot, &options]() {
+            syst::collect_subsystem(snapshot.backlights, [&options]() {
+                return syst::collect_devices(
+                  syst::get_backlights(options.backlight_path),
+                  [](const backlight_t& backlight) {
+                      return collected_backlight_t{ backlight,
+                          backlight.get_brightness() };
+                  });
+            });
+        });
+    }
+
+    if (options.parallel && collectors.size() > 1) {
+        // This thread collects the first subsystem while the pool collects the
+        // others. Each collector only writes to its own member of the
+        // snapshot.
+        collect_pool_t& pool = syst::get_collect_pool();
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(collectors.size() - 1);
+        for (size_t idx = 1; idx < collectors.size(); ++idx) {
+            futures.push_back(pool.submit(std::move(collectors[idx])));
+        }
+
+        collectors.front()();
+
+        for (std::future<void>& future : futures) {
+            future.get();
+        }
+    } else {
+        for (const std::function<void()>& collector : collectors) {
+            collector();
+        }
+    }
+
+    snapshot.latency = ch::duration_cast<ch::nanoseconds>(
+      ch::steady_clock::now() - snapshot.timestamp);
+
+    return snapshot;
+}
+
+} // namespace syst
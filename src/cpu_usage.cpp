@@ -5,6 +5,7 @@
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
 
 namespace syst {
@@ -52,11 +53,17 @@ cpu_usage_t::cpu_usage_t() : impl_(std::make_unique<impl_t>()) {
 cpu_usage_t::~cpu_usage_t() = default;
 
 res::result_t cpu_usage_t::update() const {
+    SYST_API("cpu_usage_t::update");
     // documentation for /proc/stat
     //     https://www.kernel.org/doc/html/latest/filesystems/proc.html#miscellaneous-kernel-statistics-in-proc-stat
 
-    const fs::path proc_stat_path = "/proc/stat";
-    auto lines = syst::get_all_lines(proc_stat_path);
+    auto proc = syst::get_proc_root();
+    if (proc.has_error()) {
+        return RES_TRACE(proc.error());
+    }
+
+    const root_t& proc_root = *proc.value();
+    auto lines = syst::get_all_lines_in(proc_root, "stat");
     if (lines.has_error()) {
         return RES_TRACE(lines.error());
     }
@@ -65,7 +72,7 @@ res::result_t cpu_usage_t::update() const {
           "The process statistics file must contain at least two "
           "lines.\n\tlines: '"
           + std::to_string(lines->size()) + "'\n\tfile: '"
-          + proc_stat_path.string() + "'");
+          + (proc_root.path / "stat").string() + "'");
     }
 
     std::vector<cpu_usage_stat_t> temp_stats;
@@ -90,7 +97,7 @@ res::result_t cpu_usage_t::update() const {
         if ((stream >> cpu_name).fail()) {
             return RES_NEW_ERROR("Failed to read the cpu name from the "
                                  "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
 
         cpu_usage_stat_t temp{};
@@ -99,60 +106,60 @@ res::result_t cpu_usage_t::update() const {
             return RES_NEW_ERROR(
               "Failed to read the 'user_mode' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.low_priority_user_mode).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'low_priority_user_mode' "
               "statistic from the process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.system_mode).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'system_mode' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.idle).fail()) {
             return RES_NEW_ERROR("Failed to read the 'idle' statistic from the "
                                  "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.io_idle).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'io_idle' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.interrupt).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'interrupt' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.soft_interrupt).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'soft_interrupt' statistic from "
               "the process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.stolen).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'stolen' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.guest).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'guest' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
         if ((stream >> temp.niced_guest).fail()) {
             return RES_NEW_ERROR(
               "Failed to read the 'niced_guest' statistic from the "
               "process statistics file.\n\tfile: '"
-              + proc_stat_path.string() + "'");
+              + (proc_root.path / "stat").string() + "'");
         }
 
         temp_stats.push_back(temp);
@@ -163,7 +170,7 @@ res::result_t cpu_usage_t::update() const {
           "Failed to process at least two lines extracted from the "
           "process statistics file\n\tlines processed: '"
           + std::to_string(temp_stats.size()) + "'\n\tfile: '"
-          + proc_stat_path.string() + "'");
+          + (proc_root.path / "stat").string() + "'");
     }
 
     // Do not modify the internal state of this class unless all operations
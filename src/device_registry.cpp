@@ -0,0 +1,406 @@
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+
+// External includes
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+
+namespace syst {
+
+// Large enough to hold the burst of events sent when a dock or hub with many
+// devices is connected.
+const int uevent_receive_buffer_size = 1024 * 1024;
+
+/**
+ * @brief The subsystems that must be enumerated again after applying a batch
+ * of kernel events.
+ */
+struct registry_rescan_t {
+    bool disks = false;
+    bool network_interfaces = false;
+    bool thermal_zones = false;
+    bool batteries = false;
+    bool backlights = false;
+};
+
+struct device_registry_state_t {
+    device_registry_options_t options;
+
+    // Opened before the first enumeration so that no event is missed between
+    // enumerating a subsystem and listening for changes to it.
+    fd_t uevents;
+
+    res::optional_t<std::vector<disk_t>> disks = std::vector<disk_t>{};
+    res::optional_t<std::vector<network_interface_t>> network_interfaces =
+      std::vector<network_interface_t>{};
+    res::optional_t<std::vector<thermal_zone_t>> thermal_zones =
+      std::vector<thermal_zone_t>{};
+    res::optional_t<std::vector<battery_t>> batteries =
+      std::vector<battery_t>{};
+    res::optional_t<std::vector<backlight_t>> backlights =
+      std::vector<backlight_t>{};
+
+    uint64_t generation = 0;
+    uint64_t enumerations = 0;
+};
+
+struct device_registry_t::impl_t {
+    device_registry_state_t state;
+};
+
+/**
+ * @return true if both lists contain the same devices in the same order or
+ * failed to be enumerated, and false otherwise.
+ */
+template<typename device_t>
+[[nodiscard]] bool same_devices(
+  const res::optional_t<std::vector<device_t>>& lhs,
+  const res::optional_t<std::vector<device_t>>& rhs) {
+    if (lhs.has_error() || rhs.has_error()) {
+        return lhs.has_error() && rhs.has_error();
+    }
+
+    return std::equal(lhs->begin(),
+      lhs->end(),
+      rhs->begin(),
+      rhs->end(),
+      [](const device_t& lhs_device, const device_t& rhs_device) {
+          return lhs_device.get_sysfs_path() == rhs_device.get_sysfs_path();
+      });
+}
+
+/**
+ * @brief Replace the devices of one subsystem with a new enumeration of it.
+ *
+ * @param[in,out] state - The state of the registry.
+ * @param[out] devices - The devices of the subsystem.
+ * @param[in] enumerate - Enumerates the subsystem.
+ */
+template<typename device_t, typename enumerate_t>
+void enumerate_registry_devices(device_registry_state_t& state,
+  res::optional_t<std::vector<device_t>>& devices,
+  const enumerate_t& enumerate) {
+    res::optional_t<std::vector<device_t>> enumerated = enumerate();
+    ++state.enumerations;
+
+    if (! syst::same_devices(devices, enumerated)) {
+        ++state.generation;
+    }
+    devices = std::move(enumerated);
+}
+
+void rescan_registry(
+  device_registry_state_t& state, const registry_rescan_t& rescan) {
+    if (rescan.disks) {
+        syst::enumerate_registry_devices(
+          state, state.disks, []() { return syst::get_disks(); });
+    }
+    if (rescan.network_interfaces) {
+        syst::enumerate_registry_devices(state,
+          state.network_interfaces,
+          []() { return syst::get_network_interfaces(); });
+    }
+    if (rescan.thermal_zones) {
+        syst::enumerate_registry_devices(
+          state, state.thermal_zones, [&state]() {
+              return syst::get_thermal_zones(state.options.thermal_path);
+          });
+    }
+    if (rescan.batteries) {
+        syst::enumerate_registry_devices(state, state.batteries, [&state]() {
+            return syst::get_batteries(state.options.power_supply_path);
+        });
+    }
+    if (rescan.backlights) {
+        syst::enumerate_registry_devices(state, state.backlights, [&state]() {
+            return syst::get_backlights(state.options.backlight_path);
+        });
+    }
+}
+
+/**
+ * @brief Apply an addition, removal or rename to the devices of its
+ * subsystem. Added devices are created on their own without enumerating the
+ * rest of the subsystem.
+ *
+ * @param[in,out] state - The state of the registry.
+ * @param[in,out] devices - The devices of the subsystem.
+ * @param[in] action - The action of the event (add, remove or move).
+ * @param[in] name - The name of the device in sysfs.
+ * @param[in] old_name - The previous name of a device that was renamed.
+ * @param[in] class_path - The class directory of the subsystem.
+ * @param[in] append - Creates a device from its class directory entry.
+ * @param[out] rescan - Set if the subsystem must be enumerated again.
+ */
+template<typename device_t, typename append_t>
+void apply_registry_change(device_registry_state_t& state,
+  res::optional_t<std::vector<device_t>>& devices,
+  const std::string& action,
+  const std::string& name,
+  const std::string& old_name,
+  const fs::path& class_path,
+  const append_t& append,
+  bool& rescan) {
+    if (rescan || devices.has_error()) {
+        // If the previous enumeration failed, the devices are unknown.
+        rescan = true;
+        return;
+    }
+
+    const auto remove = [&](const std::string& removed_name) {
+        auto device = std::find_if(devices->begin(),
+          devices->end(),
+          [&removed_name](const device_t& device) {
+              return device.get_sysfs_path().filename() == removed_name;
+          });
+        if (device != devices->end()) {
+            devices->erase(device);
+            ++state.generation;
+        }
+    };
+
+    if (action == "remove") {
+        remove(name);
+        return;
+    }
+    if (action == "move") {
+        remove(old_name);
+    }
+
+    const bool known = std::any_of(
+      devices->begin(), devices->end(), [&name](const device_t& device) {
+          return device.get_sysfs_path().filename() == name;
+      });
+    if (known) {
+        return;
+    }
+
+    const size_t size = devices->size();
+    auto result = syst::handle_class_entry(
+      class_path, name, [&](const class_entry_t& entry) {
+          return append(entry, devices.value());
+      });
+    if (result.failure()) {
+        // The device may have been removed already or its class directory
+        // may have changed, so only a new enumeration is reliable.
+        rescan = true;
+        return;
+    }
+    if (devices->size() != size) {
+        ++state.generation;
+    }
+}
+
+/**
+ * @brief Apply one kernel event to the devices of the subsystem it belongs to.
+ *
+ * @param[in,out] state - The state of the registry.
+ * @param[in] properties - The properties of the event.
+ * @param[in,out] rescan - The subsystems to enumerate again once every
+ * pending event has been applied.
+ */
+void apply_uevent(device_registry_state_t& state,
+  const std::unordered_map<std::string, std::string>& properties,
+  registry_rescan_t& rescan) {
+    // documentation for uevents
+    //     https://www.kernel.org/doc/html/latest/core-api/kobject.html#uevents
+
+    const auto get = [&properties](const std::string& key) -> std::string {
+        auto property = properties.find(key);
+        if (property == properties.end()) {
+            return "";
+        }
+        return property->second;
+    };
+
+    const std::string action = get("ACTION");
+    const std::string subsystem = get("SUBSYSTEM");
+    const std::string name = fs::path{ get("DEVPATH") }.filename();
+    const std::string old_name = fs::path{ get("DEVPATH_OLD") }.filename();
+
+    // Other actions (change, bind, online, ...) do not add or remove devices.
+    if (action != "add" && action != "remove" && action != "move") {
+        return;
+    }
+
+    if (subsystem == "block") {
+        if (get("DEVTYPE") != "disk") {
+            // Partitions are enumerated from their disk when requested.
+            return;
+        }
+        syst::apply_registry_change(state,
+          state.disks,
+          action,
+          name,
+          old_name,
+          "block",
+          syst::append_disk,
+          rescan.disks);
+    } else if (subsystem == "net") {
+        // Renamed interfaces are reported with 'move'.
+        syst::apply_registry_change(state,
+          state.network_interfaces,
+          action,
+          name,
+          old_name,
+          "class/net",
+          syst::append_network_interface,
+          rescan.network_interfaces);
+    } else if (subsystem == "thermal") {
+        if (! syst::has_prefix(name, "thermal_zone")) {
+            // Cooling devices share the thermal subsystem.
+            return;
+        }
+        syst::apply_registry_change(state,
+          state.thermal_zones,
+          action,
+          name,
+          old_name,
+          state.options.thermal_path,
+          syst::append_thermal_zone,
+          rescan.thermal_zones);
+    } else if (subsystem == "power_supply") {
+        // Power supplies that are not batteries are not appended.
+        syst::apply_registry_change(state,
+          state.batteries,
+          action,
+          name,
+          old_name,
+          state.options.power_supply_path,
+          syst::append_battery,
+          rescan.batteries);
+    } else if (subsystem == "backlight") {
+        syst::apply_registry_change(state,
+          state.backlights,
+          action,
+          name,
+          old_name,
+          state.options.backlight_path,
+          syst::append_backlight,
+          rescan.backlights);
+    }
+}
+
+res::optional_t<device_registry_t> get_device_registry(
+  const device_registry_options_t& options) {
+    SYST_API("get_device_registry");
+    auto impl = std::make_unique<device_registry_t::impl_t>();
+    impl->state.options = options;
+
+    // Kernel events are sent to the first multicast group.
+    auto uevents = syst::open_netlink_socket(NETLINK_KOBJECT_UEVENT, 1);
+    if (uevents.has_error()) {
+        return RES_TRACE(uevents.error());
+    }
+    impl->state.uevents = std::move(uevents.value());
+
+    // Forcing the size past the system limit requires CAP_NET_ADMIN. Smaller
+    // buffers only make overflows (and therefore full rescans) more likely.
+    if (setsockopt(impl->state.uevents.get(),
+          SOL_SOCKET,
+          SO_RCVBUFFORCE,
+          &uevent_receive_buffer_size,
+          sizeof(uevent_receive_buffer_size))
+      != 0) {
+        int err = setsockopt(impl->state.uevents.get(),
+          SOL_SOCKET,
+          SO_RCVBUF,
+          &uevent_receive_buffer_size,
+          sizeof(uevent_receive_buffer_size));
+        static_cast<void>(err);
+    }
+
+    device_registry_t registry{ std::move(impl) };
+    registry.rescan();
+    return registry;
+}
+
+device_registry_t::device_registry_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+device_registry_t::device_registry_t(device_registry_t&&) noexcept = default;
+
+device_registry_t& device_registry_t::operator=(
+  device_registry_t&&) noexcept = default;
+
+device_registry_t::~device_registry_t() = default;
+
+const res::optional_t<std::vector<disk_t>>& device_registry_t::get_disks()
+  const {
+    return this->impl_->state.disks;
+}
+
+const res::optional_t<std::vector<network_interface_t>>&
+device_registry_t::get_network_interfaces() const {
+    return this->impl_->state.network_interfaces;
+}
+
+const res::optional_t<std::vector<thermal_zone_t>>&
+device_registry_t::get_thermal_zones() const {
+    return this->impl_->state.thermal_zones;
+}
+
+const res::optional_t<std::vector<battery_t>>&
+device_registry_t::get_batteries() const {
+    return this->impl_->state.batteries;
+}
+
+const res::optional_t<std::vector<backlight_t>>&
+device_registry_t::get_backlights() const {
+    return this->impl_->state.backlights;
+}
+
+uint64_t device_registry_t::get_generation() const {
+    return this->impl_->state.generation;
+}
+
+uint64_t device_registry_t::get_enumerations() const {
+    return this->impl_->state.enumerations;
+}
+
+int device_registry_t::get_fd() const {
+    return this->impl_->state.uevents.get();
+}
+
+res::result_t device_registry_t::dispatch() {
+    SYST_API("device_registry_t::dispatch");
+    device_registry_state_t& state = this->impl_->state;
+
+    // Subsystems whose devices cannot be updated from an event are only
+    // enumerated once every pending event has been received, so a burst of
+    // events enumerates each subsystem at most once.
+    registry_rescan_t rescan{};
+    auto overflowed = syst::receive_netlink(
+      state.uevents, [&](const char* message, size_t size) {
+          syst::apply_uevent(
+            state, syst::parse_netlink_uevent(message, size), rescan);
+      });
+    if (overflowed.has_error()) {
+        return RES_TRACE(overflowed.error());
+    }
+
+    if (overflowed.value()) {
+        // Dropped events may have added or removed devices anywhere.
+        this->rescan();
+        return res::success;
+    }
+
+    syst::rescan_registry(state, rescan);
+    return res::success;
+}
+
+void device_registry_t::rescan() {
+    SYST_API("device_registry_t::rescan");
+    syst::rescan_registry(this->impl_->state,
+      registry_rescan_t{ true, true, true, true, true });
+}
+
+} // namespace syst
@@ -0,0 +1,74 @@
+#pragma once
+
+// Standard includes
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "util.hpp"
+
+namespace syst {
+
+// Each function creates the device of one entry of a class directory and
+// appends it to a list. They are shared by the functions that enumerate a
+// whole class directory and by the device registry, which only creates the
+// devices reported by the kernel.
+
+/**
+ * @brief Attempt to create a disk from an entry of /sys/block.
+ *
+ * @param[in] entry - The entry of the disk.
+ * @param[in,out] disks - The list to append the disk to.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t append_disk(
+  const class_entry_t& entry, std::vector<disk_t>& disks);
+
+/**
+ * @brief Attempt to create a network interface from an entry of
+ * /sys/class/net.
+ *
+ * @param[in] entry - The entry of the network interface.
+ * @param[in,out] network_interfaces - The list to append the interface to.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t append_network_interface(
+  const class_entry_t& entry,
+  std::vector<network_interface_t>& network_interfaces);
+
+/**
+ * @brief Attempt to create a thermal zone from an entry of /sys/class/thermal.
+ * The entry must be a thermal zone (not a cooling device).
+ *
+ * @param[in] entry - The entry of the thermal zone.
+ * @param[in,out] thermal_zones - The list to append the zone to.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t append_thermal_zone(
+  const class_entry_t& entry, std::vector<thermal_zone_t>& thermal_zones);
+
+/**
+ * @brief Attempt to create a battery from an entry of /sys/class/power_supply.
+ * Nothing is appended if the power supply is not a battery.
+ *
+ * @param[in] entry - The entry of the power supply.
+ * @param[in,out] batteries - The list to append the battery to.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t append_battery(
+  const class_entry_t& entry, std::vector<battery_t>& batteries);
+
+/**
+ * @brief Create a backlight from an entry of /sys/class/backlight.
+ *
+ * @param[in] entry - The entry of the backlight.
+ * @param[in,out] backlights - The list to append the backlight to.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t append_backlight(
+  const class_entry_t& entry, std::vector<backlight_t>& backlights);
+
+} // namespace syst
@@ -0,0 +1,628 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+// External includes
+#include <fcntl.h>
+#include <linux/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+struct event_source_t {
+    // Closed when the subscription is removed. Not open for file descriptors
+    // owned by someone else.
+    fd_t fd;
+
+    // The file descriptor registered with epoll.
+    int watched_fd = -1;
+
+    // Called whenever the file descriptor is ready.
+    std::function<res::result_t()> handle;
+};
+
+struct event_loop_state_t {
+    fd_t epoll;
+
+    // Becomes readable when 'stop' is called. Not part of the epoll instance,
+    // so a pending stop does not make the epoll instance readable for loops
+    // that embed it.
+    fd_t wakeup;
+
+    // Sources are shared with 'dispatch' so that a callback can remove its own
+    // subscription while it runs.
+    std::unordered_map<uint64_t, std::shared_ptr<event_source_t>> sources;
+    uint64_t next_id = 0;
+};
+
+struct event_loop_t::impl_t {
+    event_loop_state_t state;
+};
+
+[[nodiscard]] res::optional_t<uint64_t> add_event_source(
+  event_loop_state_t& state,
+  std::shared_ptr<event_source_t>&& source,
+  uint32_t events) {
+    const uint64_t id = state.next_id++;
+
+    struct epoll_event event {};
+    event.events = events;
+    event.data.u64 = id;
+
+    if (epoll_ctl(state.epoll.get(), EPOLL_CTL_ADD, source->watched_fd, &event)
+      != 0) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to add a file descriptor to an event loop.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    state.sources.emplace(id, std::move(source));
+    return id;
+}
+
+[[nodiscard]] res::optional_t<std::shared_ptr<event_source_t>>
+open_event_source(const fs::path& path, int flags) {
+    auto fd = syst::open_fd(path, flags | O_CLOEXEC);
+    if (fd.has_error()) {
+        return RES_TRACE(fd.error());
+    }
+
+    auto source = std::make_shared<event_source_t>();
+    source->watched_fd = fd->get();
+    source->fd = std::move(fd.value());
+    return source;
+}
+
+[[nodiscard]] res::optional_t<std::shared_ptr<event_source_t>>
+open_netlink_source(int protocol, uint32_t groups) {
+    auto fd = syst::open_netlink_socket(protocol, groups);
+    if (fd.has_error()) {
+        return RES_TRACE(fd.error());
+    }
+
+    auto source = std::make_shared<event_source_t>();
+    source->watched_fd = fd->get();
+    source->fd = std::move(fd.value());
+    return source;
+}
+
+/**
+ * @brief Receive every pending message from a netlink source. Messages
+ * dropped by the kernel are not reported since subscribers only receive
+ * changes.
+ *
+ * @param[in] source - The netlink source.
+ * @param[in] handle_message - Called with each message and its size.
+ * @return a result indicating success or failure.
+ */
+[[nodiscard]] res::result_t receive_netlink_source(const event_source_t& source,
+  const std::function<void(const char*, size_t)>& handle_message) {
+    auto overflowed = syst::receive_netlink(source.fd, handle_message);
+    if (overflowed.has_error()) {
+        return RES_TRACE(overflowed.error());
+    }
+
+    return res::success;
+}
+
+[[nodiscard]] power_supply_event_t::action_t to_power_supply_action(
+  const std::string& action) {
+    if (action == "add") {
+        return power_supply_event_t::action_t::added;
+    }
+    if (action == "remove") {
+        return power_supply_event_t::action_t::removed;
+    }
+    if (action == "change") {
+        return power_supply_event_t::action_t::changed;
+    }
+    return power_supply_event_t::action_t::other;
+}
+
+/**
+ * @brief Parse the rtnetlink messages about network interfaces in one buffer.
+ *
+ * @param[in] message - The buffer received from the rtnetlink socket.
+ * @param[in] size - The size of the buffer.
+ * @return the link events in the buffer.
+ */
+[[nodiscard]] std::vector<link_event_t> parse_link_messages(
+  const char* message, size_t size) {
+    // documentation for rtnetlink
+    //     https://man7.org/linux/man-pages/man7/rtnetlink.7.html
+
+    std::vector<link_event_t> events;
+
+    int remaining = static_cast<int>(size);
+    for (auto* header = reinterpret_cast<const struct nlmsghdr*>(message);
+         NLMSG_OK(header, remaining);
+         header = NLMSG_NEXT(header, remaining)) {
+        if (header->nlmsg_type != RTM_NEWLINK
+          && header->nlmsg_type != RTM_DELLINK) {
+            continue;
+        }
+
+        const auto* info =
+          reinterpret_cast<const struct ifinfomsg*>(NLMSG_DATA(header));
+
+        link_event_t event{};
+        event.index = info->ifi_index;
+        event.removed = header->nlmsg_type == RTM_DELLINK;
+        event.up = (info->ifi_flags & IFF_UP) != 0;
+        event.lower_up = (info->ifi_flags & IFF_LOWER_UP) != 0;
+
+        int attributes_size = static_cast<int>(IFLA_PAYLOAD(header));
+        for (const auto* attribute = IFLA_RTA(info);
+             RTA_OK(attribute, attributes_size);
+             attribute = RTA_NEXT(attribute, attributes_size)) {
+            if (attribute->rta_type == IFLA_IFNAME) {
+                event.name = static_cast<const char*>(RTA_DATA(attribute));
+            }
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    return events;
+}
+
+[[nodiscard]] res::result_t handle_event_loop_events(
+  event_loop_state_t& state) {
+    std::array<struct epoll_event, 32> events{};
+
+    int count = epoll_wait(
+      state.epoll.get(), events.data(), static_cast<int>(events.size()), 0);
+    if (count < 0) {
+        int err = errno;
+        if (err == EINTR) {
+            return res::success;
+        }
+        return RES_NEW_ERROR(
+          "Failed to wait for events with 'epoll_wait'.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    std::optional<res::error_t> error;
+
+    for (int idx = 0; idx < count; ++idx) {
+        auto source = state.sources.find(events[idx].data.u64);
+        if (source == state.sources.end()) {
+            // Removed by a callback of an earlier event.
+            continue;
+        }
+
+        // Keeps the source alive even if the callback removes it.
+        std::shared_ptr<event_source_t> keep = source->second;
+        auto result = keep->handle();
+        if (result.failure() && ! error.has_value()) {
+            error = result.error();
+        }
+    }
+
+    if (error.has_value()) {
+        return RES_TRACE(error.value());
+    }
+
+    return res::success;
+}
+
+res::optional_t<event_loop_t> get_event_loop() {
+    SYST_API("get_event_loop");
+    auto impl = std::make_unique<event_loop_t::impl_t>();
+    event_loop_state_t& state = impl->state;
+
+    state.epoll = fd_t{ epoll_create1(EPOLL_CLOEXEC) };
+    if (! state.epoll.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create an epoll instance for an event loop.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    state.wakeup = fd_t{ eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) };
+    if (! state.wakeup.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create an eventfd for an event loop.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    return event_loop_t{ std::move(impl) };
+}
+
+event_loop_t::event_loop_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+event_loop_t::event_loop_t(event_loop_t&&) noexcept = default;
+
+event_loop_t& event_loop_t::operator=(event_loop_t&&) noexcept = default;
+
+event_loop_t::~event_loop_t() = default;
+
+res::optional_t<uint64_t> event_loop_t::subscribe_attribute(
+  const fs::path& path,
+  std::function<void(const std::string& contents)> callback) {
+    SYST_API("event_loop_t::subscribe_attribute");
+    // documentation for sysfs_notify
+    //     https://www.kernel.org/doc/html/latest/filesystems/sysfs.html
+
+    auto source = syst::open_event_source(path, O_RDONLY);
+    if (source.has_error()) {
+        return RES_TRACE(source.error());
+    }
+
+    // Attributes only notify pollers after they have been read once.
+    std::string contents;
+    int err = syst::read_all((*source)->fd, contents);
+    if (err != 0) {
+        return RES_NEW_ERROR("Failed to read an attribute.\n\tfile: '"
+          + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    event_source_t* raw_source = source->get();
+    (*source)->handle = [raw_source, path, callback]() -> res::result_t {
+        std::string contents;
+        int err = syst::read_all(raw_source->fd, contents);
+        if (err != 0) {
+            return RES_NEW_ERROR("Failed to read an attribute.\n\tfile: '"
+              + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+        }
+
+        callback(contents);
+        return res::success;
+    };
+
+    auto id = syst::add_event_source(
+      this->impl_->state, std::move(source.value()), EPOLLPRI | EPOLLERR);
+    if (id.has_error()) {
+        return RES_ERROR(id.error(),
+          "The attribute does not support notifications.\n\tfile: '"
+            + path.string() + "'");
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_backlight(
+  const backlight_t& backlight, std::function<void(double)> callback) {
+    SYST_API("event_loop_t::subscribe_backlight");
+    // documentation for /sys/class/backlight
+    //     https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-class-backlight
+
+    const fs::path max_brightness_path =
+      backlight.get_sysfs_path() / "max_brightness";
+    uint64_t max_value = 0;
+    const read_error_t error = syst::read_int(max_brightness_path, max_value);
+    if (error.failed()) {
+        return error.to_error();
+    }
+
+    // The kernel notifies pollers of 'actual_brightness' whenever the
+    // brightness changes, including changes made by the firmware.
+    const fs::path path = backlight.get_sysfs_path() / "actual_brightness";
+
+    auto id = this->subscribe_attribute(
+      path, [max_value, callback](const std::string& contents) {
+          uint64_t value = std::strtoull(contents.c_str(), nullptr, 10);
+          callback(syst::value_to_percent(
+            static_cast<uint64_t>(0), max_value, std::min(value, max_value)));
+      });
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_power_supply(
+  std::function<void(const power_supply_event_t&)> callback) {
+    SYST_API("event_loop_t::subscribe_power_supply");
+    // documentation for uevents
+    //     https://www.kernel.org/doc/html/latest/core-api/kobject.html#uevents
+
+    // Kernel events are sent to the first multicast group.
+    auto source = syst::open_netlink_source(NETLINK_KOBJECT_UEVENT, 1);
+    if (source.has_error()) {
+        return RES_TRACE(source.error());
+    }
+
+    // The handler is owned by the source, so the source outlives it.
+    const event_source_t* netlink = source->get();
+    (*source)->handle = [netlink, callback]() -> res::result_t {
+        return syst::receive_netlink_source(
+          *netlink, [&](const char* message, size_t size) {
+              auto properties = syst::parse_netlink_uevent(message, size);
+              if (properties["SUBSYSTEM"] != "power_supply") {
+                  return;
+              }
+
+              power_supply_event_t event{};
+              event.action = syst::to_power_supply_action(properties["ACTION"]);
+              event.name = fs::path{ properties["DEVPATH"] }.filename();
+              callback(event);
+          });
+    };
+
+    auto id = syst::add_event_source(
+      this->impl_->state, std::move(source.value()), EPOLLIN);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_mounts(
+  std::function<void()> callback, const fs::path& mountinfo_path) {
+    SYST_API("event_loop_t::subscribe_mounts");
+    // documentation for /proc/self/mountinfo
+    //     https://man7.org/linux/man-pages/man5/proc_pid_mountinfo.5.html
+
+    auto proc = syst::get_proc_root();
+    if (proc.has_error()) {
+        return RES_TRACE(proc.error());
+    }
+
+    const fs::path path = proc.value()->path / mountinfo_path;
+
+    auto source = syst::open_event_source(path, O_RDONLY);
+    if (source.has_error()) {
+        return RES_TRACE(source.error());
+    }
+
+    // The mount table stops reporting a change once it has been polled, so
+    // nothing has to be read.
+    (*source)->handle = [callback]() -> res::result_t {
+        callback();
+        return res::success;
+    };
+
+    auto id = syst::add_event_source(
+      this->impl_->state, std::move(source.value()), EPOLLPRI | EPOLLERR);
+    if (id.has_error()) {
+        return RES_ERROR(id.error(),
+          "The mount table does not support notifications.\n\tfile: '"
+            + path.string() + "'");
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_links(
+  std::function<void(const link_event_t&)> callback) {
+    SYST_API("event_loop_t::subscribe_links");
+    auto source = syst::open_netlink_source(NETLINK_ROUTE, RTMGRP_LINK);
+    if (source.has_error()) {
+        return RES_TRACE(source.error());
+    }
+
+    // The handler is owned by the source, so the source outlives it.
+    const event_source_t* netlink = source->get();
+    (*source)->handle = [netlink, callback]() -> res::result_t {
+        return syst::receive_netlink_source(
+          *netlink, [&](const char* message, size_t size) {
+              for (const link_event_t& event :
+                syst::parse_link_messages(message, size)) {
+                  callback(event);
+              }
+          });
+    };
+
+    auto id = syst::add_event_source(
+      this->impl_->state, std::move(source.value()), EPOLLIN);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_pressure(
+  const pressure_trigger_t& trigger, std::function<void()> callback) {
+    SYST_API("event_loop_t::subscribe_pressure");
+    // documentation for pressure stall information
+    //     https://www.kernel.org/doc/html/latest/accounting/psi.html
+
+    auto proc = syst::get_proc_root();
+    if (proc.has_error()) {
+        return RES_TRACE(proc.error());
+    }
+
+    fs::path path = proc.value()->path / "pressure";
+    switch (trigger.resource) {
+        case pressure_trigger_t::resource_t::cpu:
+            path /= "cpu";
+            break;
+        case pressure_trigger_t::resource_t::memory:
+            path /= "memory";
+            break;
+        case pressure_trigger_t::resource_t::io:
+            path /= "io";
+            break;
+    }
+
+    auto source = syst::open_event_source(path, O_RDWR | O_NONBLOCK);
+    if (source.has_error()) {
+        return RES_TRACE(source.error());
+    }
+
+    // The trigger is removed when the file is closed.
+    const std::string request = std::string{ trigger.full ? "full" : "some" }
+      + " " + std::to_string(trigger.stall.count()) + " "
+      + std::to_string(trigger.window.count());
+    if (write((*source)->watched_fd, request.c_str(), request.size() + 1) < 0) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create a pressure trigger.\n\tfile: '" + path.string()
+          + "'\n\ttrigger: '" + request + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    (*source)->handle = [callback]() -> res::result_t {
+        callback();
+        return res::success;
+    };
+
+    auto id = syst::add_event_source(
+      this->impl_->state, std::move(source.value()), EPOLLPRI);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_mixer(sound_mixer_t& mixer,
+  std::function<void(const std::vector<sound_event_t>&)> callback) {
+    SYST_API("event_loop_t::subscribe_mixer");
+    auto source = std::make_shared<event_source_t>();
+    source->watched_fd = mixer.get_fd();
+
+    sound_mixer_t* raw_mixer = &mixer;
+    source->handle = [raw_mixer, callback]() -> res::result_t {
+        auto events = raw_mixer->dispatch();
+        if (events.has_error()) {
+            return RES_TRACE(events.error());
+        }
+
+        if (! events->empty()) {
+            callback(events.value());
+        }
+        return res::success;
+    };
+
+    auto id =
+      syst::add_event_source(this->impl_->state, std::move(source), EPOLLIN);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> event_loop_t::subscribe_fd(
+  int fd, std::function<res::result_t()> callback) {
+    SYST_API("event_loop_t::subscribe_fd");
+    if (! callback) {
+        return RES_NEW_ERROR("The callback must not be empty.");
+    }
+
+    auto source = std::make_shared<event_source_t>();
+    source->watched_fd = fd;
+    source->handle = std::move(callback);
+
+    auto id =
+      syst::add_event_source(this->impl_->state, std::move(source), EPOLLIN);
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::result_t event_loop_t::unsubscribe(uint64_t id) {
+    event_loop_state_t& state = this->impl_->state;
+
+    auto source = state.sources.find(id);
+    if (source == state.sources.end()) {
+        return RES_NEW_ERROR(
+          "No subscription with the given identifier.\n\tid: '"
+          + std::to_string(id) + "'");
+    }
+
+    int err = 0;
+    if (epoll_ctl(state.epoll.get(),
+          EPOLL_CTL_DEL,
+          source->second->watched_fd,
+          nullptr)
+      != 0) {
+        err = errno;
+    }
+
+    // The subscription is removed even if epoll fails so that it never leaks.
+    // A file descriptor that was already closed (EBADF) or that epoll already
+    // dropped (ENOENT) is not watched anymore, so removing it succeeded.
+    state.sources.erase(source);
+    if (err != 0 && err != EBADF && err != ENOENT) {
+        return RES_NEW_ERROR(
+          "Failed to remove a file descriptor from an event loop.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    return res::success;
+}
+
+int event_loop_t::get_fd() const {
+    return this->impl_->state.epoll.get();
+}
+
+res::result_t event_loop_t::dispatch() {
+    SYST_API("event_loop_t::dispatch");
+    auto result = syst::handle_event_loop_events(this->impl_->state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::result_t event_loop_t::run() {
+    SYST_API("event_loop_t::run");
+    event_loop_state_t& state = this->impl_->state;
+
+    while (true) {
+        std::array<struct pollfd, 2> poll_fds{};
+        poll_fds[0].fd = state.epoll.get();
+        poll_fds[0].events = POLLIN;
+        poll_fds[1].fd = state.wakeup.get();
+        poll_fds[1].events = POLLIN;
+
+        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+            return RES_NEW_ERROR(
+              "Failed to wait for the event loop.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+
+        if ((poll_fds[1].revents & POLLIN) != 0) {
+            uint64_t count = 0;
+            ssize_t len = read(state.wakeup.get(), &count, sizeof(count));
+            static_cast<void>(len);
+            return res::success;
+        }
+
+        auto result = syst::handle_event_loop_events(state);
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+    }
+}
+
+void event_loop_t::stop() {
+    const uint64_t increment = 1;
+    ssize_t len =
+      write(this->impl_->state.wakeup.get(), &increment, sizeof(increment));
+    static_cast<void>(len);
+}
+
+} // namespace syst
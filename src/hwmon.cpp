@@ -0,0 +1,330 @@
+// Standard includes
+#include <array>
+#include <cerrno>
+#include <set>
+
+// External includes
+#include <fcntl.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "batch_reader.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+struct hwmon_type_info_t {
+    hwmon_sensor_t::type_t type;
+
+    // The prefix of all attributes of this type (temp, fan, in, ...).
+    const char* prefix;
+
+    // The number of raw units in one displayed unit.
+    double scale;
+};
+
+// documentation for /sys/class/hwmon
+//     https://www.kernel.org/doc/html/latest/hwmon/sysfs-interface.html
+const std::array<hwmon_type_info_t, 5> hwmon_type_infos{ {
+  // millidegrees Celsius
+  { hwmon_sensor_t::type_t::temperature, "temp", 1e3 },
+  // revolutions per minute
+  { hwmon_sensor_t::type_t::fan, "fan", 1 },
+  // millivolts
+  { hwmon_sensor_t::type_t::voltage, "in", 1e3 },
+  // microwatts
+  { hwmon_sensor_t::type_t::power, "power", 1e6 },
+  // milliamperes
+  { hwmon_sensor_t::type_t::current, "curr", 1e3 },
+} };
+
+[[nodiscard]] const hwmon_type_info_t& hwmon_type_info(
+  hwmon_sensor_t::type_t type) {
+    for (const hwmon_type_info_t& info : hwmon_type_infos) {
+        if (info.type == type) {
+            return info;
+        }
+    }
+
+    return hwmon_type_infos.front();
+}
+
+[[nodiscard]] std::optional<double> hwmon_limit(const fs::path& chip_path,
+  const std::set<std::string>& attributes,
+  const std::string& attribute,
+  double scale) {
+    if (attributes.count(attribute) == 0) {
+        return std::nullopt;
+    }
+
+    fd_t fd;
+    if (syst::open_input(chip_path / attribute, fd) != 0) {
+        return std::nullopt;
+    }
+
+    int64_t limit = 0;
+    if (syst::read_signed_int(fd, limit) != 0) {
+        return std::nullopt;
+    }
+
+    return static_cast<double>(limit) / scale;
+}
+
+hwmon_sensor_t::hwmon_sensor_t(type_t type,
+  uint64_t index,
+  const std::string& name,
+  const std::string& label,
+  const limits_t& limits)
+: type_(type), index_(index), name_(name), label_(label), limits_(limits) {
+}
+
+hwmon_sensor_t::type_t hwmon_sensor_t::get_type() const {
+    return this->type_;
+}
+
+uint64_t hwmon_sensor_t::get_index() const {
+    return this->index_;
+}
+
+std::string hwmon_sensor_t::get_name() const {
+    return this->name_;
+}
+
+std::string hwmon_sensor_t::get_label() const {
+    return this->label_;
+}
+
+hwmon_sensor_t::limits_t hwmon_sensor_t::get_limits() const {
+    return this->limits_;
+}
+
+res::optional_t<double> hwmon_sensor_t::get_value() const {
+    if (this->read_errno_ < 0) {
+        return RES_NEW_ERROR(
+          "This sensor has not been read yet. Call the 'update' method of the "
+          "corresponding chip before calling the 'get_value' "
+          "method.\n\tsensor: '"
+          + this->name_ + "'");
+    }
+    if (this->read_errno_ > 0) {
+        return RES_NEW_ERROR(
+          "Failed to read the value of a sensor.\n\tsensor: '" + this->name_
+          + "'\n\treason: '" + syst::strerror(this->read_errno_) + "'");
+    }
+
+    return this->value_;
+}
+
+struct hwmon_chip_t::impl_t {
+    fs::path sysfs_path;
+    std::string name;
+    std::vector<hwmon_sensor_t> sensors;
+
+    bool use_io_uring = false;
+
+    // One input file descriptor for each sensor (same order as 'sensors').
+    // Opened by the first call to 'update'.
+    std::vector<fd_t> input_fds;
+
+    // Reads every input that could be opened. Created with the inputs.
+    std::optional<batch_reader_t> reader;
+
+    // The index of the sensor of each file read by 'reader'.
+    std::vector<size_t> reader_sensors;
+};
+
+hwmon_chip_t::hwmon_chip_t(const fs::path& sysfs_path,
+  const std::string& name,
+  std::vector<hwmon_sensor_t>&& sensors,
+  bool use_io_uring)
+: impl_(std::make_unique<impl_t>()) {
+    this->impl_->sysfs_path = sysfs_path;
+    this->impl_->name = name;
+    this->impl_->sensors = std::move(sensors);
+    this->impl_->use_io_uring = use_io_uring;
+}
+
+hwmon_chip_t::hwmon_chip_t(hwmon_chip_t&&) noexcept = default;
+
+hwmon_chip_t& hwmon_chip_t::operator=(hwmon_chip_t&&) noexcept = default;
+
+hwmon_chip_t::~hwmon_chip_t() = default;
+
+res::optional_t<std::vector<hwmon_chip_t>> get_hwmon_chips(
+  const fs::path& hwmon_path, bool use_io_uring) {
+    SYST_API("get_hwmon_chips");
+    // documentation for /sys/class/hwmon
+    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-hwmon
+    //     https://www.kernel.org/doc/html/latest/hwmon/sysfs-interface.html
+
+    std::vector<fs::path> chip_paths;
+
+    auto result = syst::for_each_class_entry(
+      hwmon_path, "", [&](const class_entry_t& entry) -> res::result_t {
+          chip_paths.push_back(entry.class_path / entry.name);
+          return res::success;
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    std::vector<hwmon_chip_t> chips;
+
+    for (fs::path chip_path : chip_paths) {
+        // Drivers written before the hwmon class was introduced place their
+        // attributes in the parent device directory instead.
+        if (! syst::has_attribute(chip_path / "name")
+          && syst::has_attribute(chip_path / "device" / "name")) {
+            chip_path /= "device";
+        }
+
+        auto name = syst::get_first_line(chip_path / "name");
+        if (name.has_error()) {
+            return RES_TRACE(name.error());
+        }
+
+        // Collect all attribute names once so that the existence of optional
+        // attributes can be checked without touching the filesystem again.
+        auto names = syst::list_directory(chip_path);
+        if (names.has_error()) {
+            return RES_TRACE(names.error());
+        }
+        const std::set<std::string> attributes{ names->begin(),
+          names->end() };
+
+        std::vector<hwmon_sensor_t> sensors;
+
+        const std::string input_suffix = "_input";
+
+        for (const hwmon_type_info_t& info : hwmon_type_infos) {
+            for (const std::string& attribute : attributes) {
+                if (! syst::has_prefix(attribute, info.prefix)) {
+                    continue;
+                }
+                if (attribute.size() <= input_suffix.size()
+                  || attribute.compare(attribute.size() - input_suffix.size(),
+                       input_suffix.size(),
+                       input_suffix)
+                    != 0) {
+                    // Ignore attributes that are not sensor inputs.
+                    continue;
+                }
+
+                std::string sensor_name =
+                  attribute.substr(0, attribute.size() - input_suffix.size());
+                std::string index_str =
+                  syst::remove_prefix(sensor_name, info.prefix);
+                if (index_str.empty()
+                  || index_str.find_first_not_of("0123456789")
+                    != std::string::npos) {
+                    // Ignore attributes without a channel number, such as
+                    // 'power_average_input' on some drivers.
+                    continue;
+                }
+                uint64_t index = std::stoull(index_str);
+
+                std::string label = sensor_name;
+                if (attributes.count(sensor_name + "_label") != 0) {
+                    auto label_line = syst::get_first_line(
+                      chip_path / (sensor_name + "_label"));
+                    if (label_line.has_value()) {
+                        label = label_line.value();
+                    }
+                }
+
+                hwmon_sensor_t::limits_t limits{};
+                limits.min = syst::hwmon_limit(
+                  chip_path, attributes, sensor_name + "_min", info.scale);
+                limits.max = syst::hwmon_limit(
+                  chip_path, attributes, sensor_name + "_max", info.scale);
+                limits.lcrit = syst::hwmon_limit(
+                  chip_path, attributes, sensor_name + "_lcrit", info.scale);
+                limits.crit = syst::hwmon_limit(
+                  chip_path, attributes, sensor_name + "_crit", info.scale);
+
+                sensors.push_back(hwmon_sensor_t{
+                  info.type, index, sensor_name, label, limits });
+            }
+        }
+
+        chips.push_back(hwmon_chip_t{
+          chip_path, name.value(), std::move(sensors), use_io_uring });
+    }
+
+    return chips;
+}
+
+fs::path hwmon_chip_t::get_sysfs_path() const {
+    return this->impl_->sysfs_path;
+}
+
+std::string hwmon_chip_t::get_name() const {
+    return this->impl_->name;
+}
+
+const std::vector<hwmon_sensor_t>& hwmon_chip_t::get_sensors() const {
+    return this->impl_->sensors;
+}
+
+res::result_t hwmon_chip_t::update() {
+    SYST_API("hwmon_chip_t::update");
+    std::vector<hwmon_sensor_t>& sensors = this->impl_->sensors;
+    std::vector<fd_t>& input_fds = this->impl_->input_fds;
+
+    if (input_fds.size() != sensors.size()) {
+        input_fds.clear();
+        input_fds.reserve(sensors.size());
+
+        for (hwmon_sensor_t& sensor : sensors) {
+            const fs::path input_path =
+              this->impl_->sysfs_path / (sensor.name_ + "_input");
+            // Sensors that cannot be opened are never read. The reason is
+            // reported by the sensor itself.
+            sensor.read_errno_ =
+              syst::open_input(input_path, input_fds.emplace_back());
+        }
+
+        std::vector<const fd_t*> files;
+        this->impl_->reader_sensors.clear();
+        for (size_t i = 0; i < sensors.size(); ++i) {
+            if (sensors[i].read_errno_ == 0) {
+                files.push_back(&input_fds[i]);
+                this->impl_->reader_sensors.push_back(i);
+            }
+        }
+
+        // Integers exposed by sysfs are at most 20 digits long plus a sign
+        // and a trailing newline.
+        const size_t max_len = 32;
+        this->impl_->reader.emplace(
+          std::move(files), max_len, this->impl_->use_io_uring);
+    }
+
+    batch_reader_t& reader = this->impl_->reader.value();
+    reader.read();
+
+    for (size_t i = 0; i < reader.size(); ++i) {
+        hwmon_sensor_t& sensor = sensors[this->impl_->reader_sensors[i]];
+
+        int64_t raw_value = 0;
+        sensor.read_errno_ = reader.get_errno(i);
+        if (sensor.read_errno_ == 0) {
+            sensor.read_errno_ =
+              syst::parse_signed_int(reader.get_contents(i).data(), raw_value);
+        }
+        if (sensor.read_errno_ != 0) {
+            // Some sensors are temporarily unavailable (ENODATA, EAGAIN, ...).
+            // The reason is reported by the sensor itself.
+            continue;
+        }
+
+        sensor.value_ = static_cast<double>(raw_value)
+          / syst::hwmon_type_info(sensor.type_).scale;
+    }
+
+    return res::success;
+}
+
+} // namespace syst
@@ -0,0 +1,141 @@
+// Standard includes
+#include <array>
+#include <cstdint>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+
+namespace syst {
+
+[[nodiscard]] bool is_empty(const api_stats_t& api) {
+    return api.calls == 0 && api.opens == 0 && api.reads == 0 && api.stats == 0
+      && api.directory_entries == 0 && api.bytes_read == 0
+      && api.allocations == 0;
+}
+
+void add_stats(api_stats_t& sum, const api_stats_t& api) {
+    sum.calls += api.calls;
+    sum.opens += api.opens;
+    sum.reads += api.reads;
+    sum.stats += api.stats;
+    sum.directory_entries += api.directory_entries;
+    sum.bytes_read += api.bytes_read;
+    sum.allocations += api.allocations;
+}
+
+#ifdef SYST_INSTRUMENTATION
+
+// A public function and the work done by the calling thread within it.
+struct api_entry_t {
+    const char* name = nullptr;
+    api_stats_t stats;
+};
+
+// The number of public functions that can be counted by each thread. Work
+// done by functions called after the table is full is only added to the
+// total.
+constexpr size_t max_apis = 256;
+
+// Counting only touches trivially destructible variables, so it is safe at any
+// time, even from the destructors of other thread-local variables while the
+// thread is exiting.
+thread_local api_stats_t thread_total{};
+thread_local api_stats_t* thread_api = nullptr;
+thread_local api_stats_t thread_unlisted_api{};
+
+// An open addressing table keyed by the address of the name of each public
+// function. Entries are never erased so that 'thread_api' stays valid.
+thread_local std::array<api_entry_t, max_apis> thread_apis{};
+
+void count(uint64_t api_stats_t::*counter, uint64_t amount) {
+    thread_total.*counter += amount;
+    if (thread_api != nullptr) {
+        thread_api->*counter += amount;
+    }
+}
+
+[[nodiscard]] api_stats_t& find_api(const char* name) {
+    const size_t first = reinterpret_cast<uintptr_t>(name) % max_apis;
+    for (size_t probe = 0; probe < max_apis; ++probe) {
+        api_entry_t& entry = syst::thread_apis[(first + probe) % max_apis];
+        if (entry.name == nullptr) {
+            entry.name = name;
+        }
+        if (entry.name == name) {
+            return entry.stats;
+        }
+    }
+
+    return syst::thread_unlisted_api;
+}
+
+api_scope_t::api_scope_t(const char* name) : outermost_(thread_api == nullptr) {
+    if (! this->outermost_) {
+        return;
+    }
+
+    api_stats_t& api = syst::find_api(name);
+    ++api.calls;
+    syst::thread_api = &api;
+}
+
+api_scope_t::~api_scope_t() {
+    if (this->outermost_) {
+        syst::thread_api = nullptr;
+    }
+}
+
+void count_open() {
+    syst::count(&api_stats_t::opens, 1);
+}
+
+void count_read(size_t bytes) {
+    syst::count(&api_stats_t::reads, 1);
+    syst::count(&api_stats_t::bytes_read, bytes);
+}
+
+void count_stat() {
+    syst::count(&api_stats_t::stats, 1);
+}
+
+void count_directory_entries(size_t entries) {
+    syst::count(&api_stats_t::directory_entries, entries);
+}
+
+void count_allocation() {
+    syst::count(&api_stats_t::allocations, 1);
+}
+
+#endif
+
+stats_t stats() {
+    stats_t counters{};
+
+#ifdef SYST_INSTRUMENTATION
+    counters.enabled = true;
+    counters.total = syst::thread_total;
+
+    // The same name may be stored at several addresses (one per translation
+    // unit), so entries are merged by name.
+    for (const api_entry_t& entry : syst::thread_apis) {
+        if (entry.name != nullptr && ! syst::is_empty(entry.stats)) {
+            syst::add_stats(counters.apis[entry.name], entry.stats);
+        }
+    }
+#endif
+
+    return counters;
+}
+
+void reset_stats() {
+#ifdef SYST_INSTRUMENTATION
+    syst::thread_total = {};
+    syst::thread_unlisted_api = {};
+    for (api_entry_t& entry : syst::thread_apis) {
+        entry.stats = {};
+    }
+#endif
+}
+
+} // namespace syst
@@ -0,0 +1,88 @@
+#pragma once
+
+// Standard includes
+#include <cstddef>
+
+namespace syst {
+
+#ifdef SYST_INSTRUMENTATION
+
+/**
+ * @brief Attributes the work done by the calling thread to a public function
+ * until it is destroyed. Work done by public functions called from within
+ * another public function is attributed to the outermost function.
+ */
+class api_scope_t {
+    bool outermost_;
+
+  public:
+    /**
+     * @param[in] name - The name of the public function. Must be a string
+     * literal since it is used as a key without being copied.
+     */
+    explicit api_scope_t(const char* name);
+    api_scope_t(const api_scope_t&) = delete;
+    api_scope_t(api_scope_t&&) noexcept = delete;
+    api_scope_t& operator=(const api_scope_t&) = delete;
+    api_scope_t& operator=(api_scope_t&&) noexcept = delete;
+    ~api_scope_t();
+};
+
+/**
+ * @brief Count a file or directory opened by the calling thread.
+ */
+void count_open();
+
+/**
+ * @brief Count a read system call made by the calling thread.
+ *
+ * @param[in] bytes - The number of bytes read.
+ */
+void count_read(size_t bytes);
+
+/**
+ * @brief Count a stat-like system call made by the calling thread.
+ */
+void count_stat();
+
+/**
+ * @brief Count directory entries scanned by the calling thread.
+ *
+ * @param[in] entries - The number of entries.
+ */
+void count_directory_entries(size_t entries);
+
+/**
+ * @brief Count a heap allocation made by the calling thread. Called by the C
+ * API for strings allocated with malloc and by the replacement of operator new
+ * that tests and benchmarks link (see instrument_new.cpp).
+ */
+void count_allocation();
+
+// Attribute the rest of the enclosing block to a public function.
+#define SYST_API(name) const syst::api_scope_t syst_api_scope_{ name }
+
+#else
+
+// Without instrumentation, counting compiles to nothing.
+
+inline void count_open() {
+}
+
+inline void count_read(size_t /*bytes*/) {
+}
+
+inline void count_stat() {
+}
+
+inline void count_directory_entries(size_t /*entries*/) {
+}
+
+inline void count_allocation() {
+}
+
+#define SYST_API(name) static_cast<void>(0)
+
+#endif
+
+} // namespace syst
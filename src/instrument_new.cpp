@@ -0,0 +1,30 @@
+// Standard includes
+#include <cstdlib>
+#include <new>
+
+// Local includes
+#include "instrument.hpp"
+
+// Replacing the global allocation functions counts every allocation made by
+// the program, so this file is only linked into the tests and benchmarks and
+// never into the library, which would take over the allocator of every program
+// that loads it. Allocations made outside of public functions are only added
+// to the total of the thread that made them.
+
+void* operator new(std::size_t size) {
+    syst::count_allocation();
+
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
@@ -6,11 +6,13 @@
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "instrument.hpp"
 #include "strerror.hpp"
 
 namespace syst {
 
 res::optional_t<std::string> get_running_kernel() {
+    SYST_API("get_running_kernel");
     utsname utsname_info{};
 
     if (uname(&utsname_info) != 0) {
@@ -22,9 +24,11 @@ res::optional_t<std::string> get_running_kernel() {
 }
 
 res::optional_t<std::vector<std::string>> get_installed_kernels() {
+    SYST_API("get_installed_kernels");
     std::vector<std::string> installed_kernels;
 
     const fs::path modules_path = "/usr/lib/modules";
+    syst::count_stat();
     if (! fs::is_directory(modules_path)) {
         return RES_NEW_ERROR("The path is not a directory.\n\tpath: '"
           + modules_path.string() + "'");
@@ -32,6 +36,7 @@ res::optional_t<std::vector<std::string>> get_installed_kernels() {
 
     for (const fs::directory_entry& release :
       fs::directory_iterator(modules_path)) {
+        syst::count_directory_entries(1);
         if (! release.is_directory()) {
             continue;
         }
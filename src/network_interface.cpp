@@ -1,35 +1,45 @@
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
 
 namespace syst {
 
-network_interface_t::network_interface_t(const fs::path& sysfs_path)
-: sysfs_path_(sysfs_path) {
+network_interface_t::network_interface_t(const fs::path& sysfs_path,
+  std::shared_ptr<const fd_t> dir,
+  const capabilities_t& capabilities)
+: sysfs_path_(sysfs_path), dir_(std::move(dir)), capabilities_(capabilities) {
 }
 
-res::optional_t<std::vector<network_interface_t>> get_network_interfaces() {
-    const std::string net_path = "/sys/class/net";
-
-    if (! fs::is_directory(net_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + net_path + "'");
+res::result_t append_network_interface(const class_entry_t& entry,
+  std::vector<network_interface_t>& network_interfaces) {
+    auto dir = syst::open_device_dir(&entry.dir, entry.name.data());
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
     }
 
+    network_interface_t::capabilities_t capabilities{};
+    capabilities.status = syst::has_attribute_at(*dir.value(), "operstate");
+    capabilities.stat = syst::has_attribute_at(*dir.value(), "statistics");
+
+    network_interfaces.push_back(network_interface_t{
+      entry.class_path / entry.name, std::move(dir.value()), capabilities });
+    return res::success;
+}
+
+res::optional_t<std::vector<network_interface_t>> get_network_interfaces() {
+    SYST_API("get_network_interfaces");
+    const fs::path net_path = "class/net";
+
     std::vector<network_interface_t> network_interfaces;
 
-    for (const fs::directory_entry& interface :
-      fs::directory_iterator(net_path)) {
-        if (! fs::is_directory(interface)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(interface)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        network_interfaces.push_back(network_interface_t{ interface });
+    auto result = syst::for_each_class_entry(
+      net_path, "", [&](const class_entry_t& entry) {
+          return syst::append_network_interface(entry, network_interfaces);
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return network_interfaces;
@@ -43,8 +53,15 @@ std::string network_interface_t::get_name() const {
     return this->sysfs_path_.filename();
 }
 
+network_interface_t::capabilities_t network_interface_t::get_capabilities()
+  const {
+    return this->capabilities_;
+}
+
 res::optional_t<bool> network_interface_t::is_physical() const {
+    SYST_API("network_interface_t::is_physical");
     fs::path real_path;
+    syst::count_stat();
     try {
         real_path = fs::read_symlink(this->sysfs_path_);
     } catch (const fs::filesystem_error&) {
@@ -57,25 +74,34 @@ res::optional_t<bool> network_interface_t::is_physical() const {
 }
 
 res::optional_t<bool> network_interface_t::is_loopback() const {
+    SYST_API("network_interface_t::is_loopback");
     // documentation for /sys/class/net/<dev>/type
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/uapi/linux/if_arp.h
 
-    auto type = syst::get_int(this->sysfs_path_ / "type");
-    if (type.has_error()) {
-        return RES_TRACE(type.error());
+    uint64_t type = 0;
+    const read_error_t error = syst::read_int_at(*this->dir_, "type", type);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     const uint64_t loopback_type = 772;
-    return type.value() == loopback_type;
+    return type == loopback_type;
 }
 
 res::optional_t<network_interface_t::status_t> network_interface_t::get_status()
   const {
+    SYST_API("network_interface_t::get_status");
     // documentation for /sys/class/net/<dev>/operstate:
     //     https://git.kernel.org/pub/scm/linux/kernel/git/torvalds/linux.git/tree/include/uapi/linux/if.h
 
-    const fs::path status_path = this->sysfs_path_ / "operstate";
-    const auto status = syst::get_first_line(status_path);
+    const char* status_name = "operstate";
+    if (! this->capabilities_.status) {
+        return RES_NEW_ERROR(
+          "This network interface does not report its status.\n\tfile: '"
+          + (this->sysfs_path_ / status_name).string() + "'");
+    }
+
+    const auto status = syst::get_first_line_at(*this->dir_, status_name);
     if (status.has_error()) {
         return RES_TRACE(status.error());
     }
@@ -95,42 +121,44 @@ res::optional_t<network_interface_t::status_t> network_interface_t::get_status()
 
     return RES_NEW_ERROR("An invalid status was read from a network interface "
                          "status file.\n\tstatus: '"
-      + status.value() + "'\n\tfile: '" + status_path.string() + "'");
+      + status.value() + "'\n\tfile: '"
+      + syst::attribute_path(*this->dir_, status_name) + "'");
 }
 
 res::optional_t<network_interface_t::stat_t> network_interface_t::get_stat()
   const {
-    const fs::path stat_path = this->sysfs_path_ / "statistics";
-    if (! fs::is_directory(stat_path)) {
+    SYST_API("network_interface_t::get_stat");
+    if (! this->capabilities_.stat) {
         return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + stat_path.string() + "'");
+          "This network interface does not report statistics.\n\tpath: '"
+          + (this->sysfs_path_ / "statistics").string() + "'");
     }
 
     stat_t stat{};
 
-    auto rx_bytes = syst::get_int(stat_path / "rx_bytes");
-    if (rx_bytes.has_error()) {
-        return RES_TRACE(rx_bytes.error());
+    read_error_t error =
+      syst::read_int_at(*this->dir_, "statistics/rx_bytes", stat.bytes_down);
+    if (error.failed()) {
+        return error.to_error();
     }
-    stat.bytes_down = rx_bytes.value();
 
-    auto tx_bytes = syst::get_int(stat_path / "tx_bytes");
-    if (tx_bytes.has_error()) {
-        return RES_TRACE(tx_bytes.error());
+    error = syst::read_int_at(
+      *this->dir_, "statistics/tx_bytes", stat.bytes_up);
+    if (error.failed()) {
+        return error.to_error();
     }
-    stat.bytes_up = tx_bytes.value();
 
-    auto rx_packets = syst::get_int(stat_path / "rx_packets");
-    if (rx_packets.has_error()) {
-        return RES_TRACE(rx_packets.error());
+    error = syst::read_int_at(
+      *this->dir_, "statistics/rx_packets", stat.packets_down);
+    if (error.failed()) {
+        return error.to_error();
     }
-    stat.packets_down = rx_packets.value();
 
-    auto tx_packets = syst::get_int(stat_path / "tx_packets");
-    if (tx_packets.has_error()) {
-        return RES_TRACE(tx_packets.error());
+    error = syst::read_int_at(
+      *this->dir_, "statistics/tx_packets", stat.packets_up);
+    if (error.failed()) {
+        return error.to_error();
     }
-    stat.packets_up = tx_packets.value();
 
     return stat;
 }
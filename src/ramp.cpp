@@ -0,0 +1,526 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
+// External includes
+#include <fcntl.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+enum class ramp_target_t {
+    brightness,
+    playback_volume,
+    capture_volume,
+};
+
+struct ramp_state_t {
+    ramp_target_t target;
+
+    // Identifies the target so that a new ramp can replace an old one.
+    fs::path brightness_path;
+    sound_control_t* control = nullptr;
+
+    // Only used by brightness ramps.
+    fd_t brightness_fd;
+
+    // Raw brightness values or volume percentages.
+    double start_value = 0;
+    double end_value = 0;
+    double last_value = 0;
+
+    ch::steady_clock::time_point start_time;
+    ch::nanoseconds duration{};
+
+    // The number of distinct values between the start and the end of the
+    // ramp. The target is only written when the value changes.
+    uint64_t steps = 1;
+
+    // The tick at which the next step is due.
+    uint64_t due_tick = 0;
+};
+
+struct ramp_wheel_entry_t {
+    uint64_t ramp;
+    uint64_t due_tick;
+};
+
+// Ramps due further in the future than this many ticks wait in their slot for
+// the wheel to come around again.
+const size_t ramp_wheel_slots = 256;
+
+struct ramp_scheduler_t {
+    fd_t timer;
+    bool armed = false;
+    ch::nanoseconds resolution{};
+    ch::steady_clock::time_point epoch;
+    uint64_t last_tick = 0;
+
+    uint64_t next_ramp = 1;
+    std::unordered_map<uint64_t, ramp_state_t> ramps;
+
+    // Entries are not removed when a ramp ends or is rescheduled. Stale
+    // entries are recognized by their due tick and skipped.
+    std::array<std::vector<ramp_wheel_entry_t>, ramp_wheel_slots> wheel;
+
+    std::vector<ramp_event_t> events;
+};
+
+struct ramp_engine_t::impl_t {
+    ramp_scheduler_t scheduler;
+};
+
+[[nodiscard]] uint64_t ramp_tick(
+  const ramp_scheduler_t& scheduler, ch::steady_clock::time_point time) {
+    if (time <= scheduler.epoch) {
+        return 0;
+    }
+
+    return static_cast<uint64_t>(
+      (time - scheduler.epoch) / scheduler.resolution);
+}
+
+[[nodiscard]] double ramp_fraction(
+  const ramp_state_t& ramp, ch::steady_clock::time_point time) {
+    return std::clamp(ch::duration<double>(time - ramp.start_time).count()
+        / ch::duration<double>(ramp.duration).count(),
+      static_cast<double>(0),
+      static_cast<double>(1));
+}
+
+void schedule_ramp(ramp_scheduler_t& scheduler,
+  uint64_t id,
+  ramp_state_t& ramp,
+  double fraction,
+  uint64_t now_tick) {
+    // The next step is the first point at which the value changes again.
+    const double next_step =
+      std::floor(fraction * static_cast<double>(ramp.steps)) + 1;
+    const auto deadline = ramp.start_time
+      + ch::duration_cast<ch::nanoseconds>(
+        ramp.duration * (next_step / static_cast<double>(ramp.steps)));
+
+    uint64_t due_tick = syst::ramp_tick(scheduler, deadline);
+    if (deadline > scheduler.epoch + due_tick * scheduler.resolution) {
+        ++due_tick;
+    }
+    ramp.due_tick = std::max(due_tick, now_tick + 1);
+
+    scheduler.wheel[ramp.due_tick % ramp_wheel_slots].push_back(
+      ramp_wheel_entry_t{ id, ramp.due_tick });
+}
+
+[[nodiscard]] res::result_t write_ramp(ramp_state_t& ramp, double value) {
+    switch (ramp.target) {
+        case ramp_target_t::brightness: {
+            const auto raw = static_cast<uint64_t>(std::llround(value));
+            if (raw == static_cast<uint64_t>(std::llround(ramp.last_value))) {
+                return res::success;
+            }
+
+            int err = syst::write_int(ramp.brightness_fd, raw);
+            if (err != 0) {
+                return RES_NEW_ERROR(
+                  "Failed to set the brightness of a backlight.\n\tfile: '"
+                  + ramp.brightness_path.string() + "'\n\tbrightness: '"
+                  + std::to_string(raw) + "'\n\treason: '"
+                  + syst::strerror(err) + "'");
+            }
+            break;
+        }
+
+        case ramp_target_t::playback_volume: {
+            auto result = ramp.control->set_playback_volume_all(value);
+            if (result.failure()) {
+                return RES_TRACE(result.error());
+            }
+            break;
+        }
+
+        case ramp_target_t::capture_volume: {
+            auto result = ramp.control->set_capture_volume_all(value);
+            if (result.failure()) {
+                return RES_TRACE(result.error());
+            }
+            break;
+        }
+    }
+
+    ramp.last_value = value;
+    return res::success;
+}
+
+void step_ramp(ramp_scheduler_t& scheduler,
+  uint64_t id,
+  ch::steady_clock::time_point now,
+  uint64_t now_tick) {
+    ramp_state_t& ramp = scheduler.ramps.at(id);
+
+    // Steps that were missed are skipped since the value only depends on the
+    // current time.
+    const double fraction = syst::ramp_fraction(ramp, now);
+    const double value =
+      ramp.start_value + (ramp.end_value - ramp.start_value) * fraction;
+
+    auto result = syst::write_ramp(ramp, value);
+    if (result.failure()) {
+        scheduler.events.push_back(ramp_event_t{
+          ramp_event_t::type_t::failed, id, RES_TRACE(result.error()) });
+        scheduler.ramps.erase(id);
+        return;
+    }
+
+    if (fraction >= 1) {
+        scheduler.events.push_back(
+          ramp_event_t{ ramp_event_t::type_t::finished, id, std::nullopt });
+        scheduler.ramps.erase(id);
+        return;
+    }
+
+    syst::schedule_ramp(scheduler, id, ramp, fraction, now_tick);
+}
+
+[[nodiscard]] res::result_t update_ramp_timer(ramp_scheduler_t& scheduler) {
+    const bool armed = ! scheduler.ramps.empty();
+    if (armed == scheduler.armed) {
+        return res::success;
+    }
+
+    auto result = syst::set_timer(scheduler.timer,
+      armed ? scheduler.resolution : ch::nanoseconds::zero());
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    scheduler.armed = armed;
+    return res::success;
+}
+
+[[nodiscard]] bool same_ramp_target(
+  const ramp_state_t& ramp, const ramp_state_t& other) {
+    if (ramp.target != other.target) {
+        return false;
+    }
+    if (ramp.target == ramp_target_t::brightness) {
+        return ramp.brightness_path == other.brightness_path;
+    }
+    return ramp.control == other.control;
+}
+
+[[nodiscard]] res::optional_t<uint64_t> add_ramp(
+  ramp_scheduler_t& scheduler, ramp_state_t&& ramp) {
+    if (! scheduler.timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The ramp engine has not been started. Call the 'start' method "
+          "before starting any ramps.");
+    }
+
+    // Only one ramp may change a target at a time.
+    for (auto old_ramp = scheduler.ramps.begin();
+         old_ramp != scheduler.ramps.end();) {
+        if (! syst::same_ramp_target(old_ramp->second, ramp)) {
+            ++old_ramp;
+            continue;
+        }
+
+        scheduler.events.push_back(ramp_event_t{
+          ramp_event_t::type_t::cancelled, old_ramp->first, std::nullopt });
+        old_ramp = scheduler.ramps.erase(old_ramp);
+    }
+
+    const uint64_t id = scheduler.next_ramp++;
+    ramp.last_value = ramp.start_value;
+
+    if (ramp.duration.count() <= 0) {
+        auto result = syst::write_ramp(ramp, ramp.end_value);
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+
+        scheduler.events.push_back(
+          ramp_event_t{ ramp_event_t::type_t::finished, id, std::nullopt });
+        return id;
+    }
+
+    const auto now = ch::steady_clock::now();
+    ramp.start_time = now;
+
+    auto [inserted, success] = scheduler.ramps.emplace(id, std::move(ramp));
+    static_cast<void>(success);
+    syst::schedule_ramp(
+      scheduler, id, inserted->second, 0, syst::ramp_tick(scheduler, now));
+
+    auto result = syst::update_ramp_timer(scheduler);
+    if (result.failure()) {
+        scheduler.ramps.erase(id);
+        return RES_TRACE(result.error());
+    }
+
+    return id;
+}
+
+[[nodiscard]] double average_sound_volume(
+  const sound_control_t::volume_t& volume) {
+    double sum = 0;
+    size_t channels = 0;
+
+    for (const std::optional<double>& channel : { volume.front_left,
+           volume.front_right,
+           volume.rear_left,
+           volume.rear_right,
+           volume.front_center,
+           volume.woofer,
+           volume.side_left,
+           volume.side_right,
+           volume.rear_center }) {
+        if (channel.has_value()) {
+            sum += channel.value();
+            ++channels;
+        }
+    }
+
+    if (channels == 0) {
+        return 0;
+    }
+
+    return sum / static_cast<double>(channels);
+}
+
+[[nodiscard]] res::optional_t<uint64_t> add_volume_ramp(
+  ramp_scheduler_t& scheduler,
+  sound_control_t& control,
+  ramp_target_t target,
+  double volume,
+  ch::nanoseconds duration) {
+    if (volume < static_cast<double>(0) || volume > static_cast<double>(100)) {
+        return RES_NEW_ERROR(
+          "The final volume of a ramp is out of bounds.\n\tvolume: '"
+          + std::to_string(volume) + "'");
+    }
+
+    auto current_volume = target == ramp_target_t::playback_volume
+      ? control.get_playback_volume()
+      : control.get_capture_volume();
+    if (current_volume.has_error()) {
+        return RES_TRACE(current_volume.error());
+    }
+
+    ramp_state_t ramp{};
+    ramp.target = target;
+    ramp.control = &control;
+    ramp.start_value = syst::average_sound_volume(current_volume.value());
+    ramp.end_value = volume;
+    ramp.duration = duration;
+
+    // The raw volume range is not known here, so volume ramps are written in
+    // steps of one percent.
+    ramp.steps = std::max(static_cast<uint64_t>(1),
+      static_cast<uint64_t>(std::ceil(std::abs(volume - ramp.start_value))));
+
+    auto id = syst::add_ramp(scheduler, std::move(ramp));
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+ramp_engine_t::ramp_engine_t() : impl_(std::make_unique<impl_t>()) {
+}
+
+ramp_engine_t::ramp_engine_t(ramp_engine_t&&) noexcept = default;
+
+ramp_engine_t& ramp_engine_t::operator=(ramp_engine_t&&) noexcept = default;
+
+ramp_engine_t::~ramp_engine_t() = default;
+
+res::result_t ramp_engine_t::start(ch::nanoseconds resolution) {
+    SYST_API("ramp_engine_t::start");
+    ramp_scheduler_t& scheduler = this->impl_->scheduler;
+
+    // The timer is created with the given period to validate it and is only
+    // kept armed while ramps are running.
+    auto timer = syst::create_timer(resolution);
+    if (timer.has_error()) {
+        return RES_TRACE(timer.error());
+    }
+
+    scheduler.timer = std::move(timer.value());
+    scheduler.armed = true;
+    scheduler.resolution = resolution;
+    scheduler.epoch = ch::steady_clock::now();
+    scheduler.last_tick = 0;
+
+    auto result = syst::update_ramp_timer(scheduler);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+int ramp_engine_t::get_fd() const {
+    return this->impl_->scheduler.timer.get();
+}
+
+res::result_t ramp_engine_t::dispatch() {
+    SYST_API("ramp_engine_t::dispatch");
+    ramp_scheduler_t& scheduler = this->impl_->scheduler;
+
+    if (! scheduler.timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The ramp engine has not been started. Call the 'start' method "
+          "before calling the 'dispatch' method.");
+    }
+
+    auto expirations = syst::read_timer(scheduler.timer);
+    if (expirations.has_error()) {
+        return RES_TRACE(expirations.error());
+    }
+
+    const auto now = ch::steady_clock::now();
+    const uint64_t now_tick = syst::ramp_tick(scheduler, now);
+    if (now_tick <= scheduler.last_tick) {
+        return res::success;
+    }
+
+    // Every slot is visited at most once, even if the engine is far behind.
+    uint64_t first_tick = scheduler.last_tick + 1;
+    if (now_tick - first_tick >= ramp_wheel_slots) {
+        first_tick = now_tick - ramp_wheel_slots + 1;
+    }
+
+    for (uint64_t tick = first_tick; tick <= now_tick; ++tick) {
+        std::vector<ramp_wheel_entry_t> entries;
+        entries.swap(scheduler.wheel[tick % ramp_wheel_slots]);
+
+        for (const ramp_wheel_entry_t& entry : entries) {
+            auto ramp = scheduler.ramps.find(entry.ramp);
+            if (ramp == scheduler.ramps.end()
+              || ramp->second.due_tick != entry.due_tick) {
+                continue;
+            }
+
+            if (entry.due_tick > now_tick) {
+                scheduler.wheel[tick % ramp_wheel_slots].push_back(entry);
+                continue;
+            }
+
+            syst::step_ramp(scheduler, entry.ramp, now, now_tick);
+        }
+    }
+
+    scheduler.last_tick = now_tick;
+
+    auto result = syst::update_ramp_timer(scheduler);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::optional_t<uint64_t> ramp_engine_t::ramp_brightness(
+  const backlight_t& backlight, double brightness, ch::nanoseconds duration) {
+    SYST_API("ramp_engine_t::ramp_brightness");
+    ramp_state_t ramp{};
+    ramp.target = ramp_target_t::brightness;
+    ramp.brightness_path = backlight.get_sysfs_path() / "brightness";
+    ramp.duration = duration;
+
+    const fs::path max_brightness_path =
+      backlight.get_sysfs_path() / "max_brightness";
+    uint64_t max_brightness = 0;
+    const read_error_t error =
+      syst::read_int(max_brightness_path, max_brightness);
+    if (error.failed()) {
+        return RES_ERROR(error.to_error(),
+          "The 'max_brightness' file is required to ramp the brightness of a "
+          "backlight.");
+    }
+
+    auto brightness_fd = syst::open_fd(ramp.brightness_path, O_RDWR);
+    if (brightness_fd.has_error()) {
+        return RES_TRACE(brightness_fd.error());
+    }
+    ramp.brightness_fd = std::move(brightness_fd.value());
+
+    int64_t current_brightness = 0;
+    int err = syst::read_signed_int(ramp.brightness_fd, current_brightness);
+    if (err != 0) {
+        return RES_NEW_ERROR(
+          "Failed to read the brightness of a backlight.\n\tfile: '"
+          + ramp.brightness_path.string() + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    const auto end_brightness = syst::percent_to_value(
+      static_cast<uint64_t>(0),
+      max_brightness,
+      std::clamp(brightness, static_cast<double>(0), static_cast<double>(100)));
+
+    ramp.start_value = static_cast<double>(current_brightness);
+    ramp.end_value = static_cast<double>(end_brightness);
+    ramp.steps = std::max(static_cast<uint64_t>(1),
+      static_cast<uint64_t>(std::abs(ramp.end_value - ramp.start_value)));
+
+    auto id = syst::add_ramp(this->impl_->scheduler, std::move(ramp));
+    if (id.has_error()) {
+        return RES_TRACE(id.error());
+    }
+
+    return id.value();
+}
+
+res::optional_t<uint64_t> ramp_engine_t::ramp_playback_volume(
+  sound_control_t& control, double volume, ch::nanoseconds duration) {
+    SYST_API("ramp_engine_t::ramp_playback_volume");
+    return syst::add_volume_ramp(this->impl_->scheduler,
+      control,
+      ramp_target_t::playback_volume,
+      volume,
+      duration);
+}
+
+res::optional_t<uint64_t> ramp_engine_t::ramp_capture_volume(
+  sound_control_t& control, double volume, ch::nanoseconds duration) {
+    SYST_API("ramp_engine_t::ramp_capture_volume");
+    return syst::add_volume_ramp(this->impl_->scheduler,
+      control,
+      ramp_target_t::capture_volume,
+      volume,
+      duration);
+}
+
+bool ramp_engine_t::cancel(uint64_t ramp) {
+    ramp_scheduler_t& scheduler = this->impl_->scheduler;
+
+    if (scheduler.ramps.erase(ramp) == 0) {
+        return false;
+    }
+
+    scheduler.events.push_back(
+      ramp_event_t{ ramp_event_t::type_t::cancelled, ramp, std::nullopt });
+
+    // The timer is disarmed on the next dispatch if no ramps are left.
+    return true;
+}
+
+size_t ramp_engine_t::get_ramp_count() const {
+    return this->impl_->scheduler.ramps.size();
+}
+
+std::vector<ramp_event_t> ramp_engine_t::take_events() {
+    std::vector<ramp_event_t> events;
+    events.swap(this->impl_->scheduler.events);
+    return events;
+}
+
+} // namespace syst
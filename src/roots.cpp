@@ -0,0 +1,246 @@
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// External includes
+#include <fcntl.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "capture.hpp"
+#include "instrument.hpp"
+#include "roots.hpp"
+#include "util.hpp"
+
+namespace syst {
+
+struct root_dirs_t {
+    root_t sys;
+    root_t proc;
+    root_t dev;
+};
+
+// Null until the roots are first used or set. Readers load it without locking
+// or reference counting. Roots are rarely set (usually once at startup), so
+// replaced roots are kept open until the process exits, which keeps every
+// published pointer valid.
+std::atomic<const root_dirs_t*> root_dirs{ nullptr };
+
+// Owns every published root. Guarded by 'root_dirs_mutex'.
+std::vector<std::unique_ptr<const root_dirs_t>> published_root_dirs;
+std::mutex root_dirs_mutex;
+
+[[nodiscard]] res::optional_t<root_t> open_root(const fs::path& path) {
+    int fd = open(path.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to open a root directory.\n\tpath: '"
+          + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    return root_t{ path, std::make_shared<const fd_t>(fd) };
+}
+
+/**
+ * @brief Open roots and publish them as the current roots. The caller must
+ * hold 'root_dirs_mutex'.
+ *
+ * @param[in] roots - The paths to the roots.
+ * @return the published roots if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<const root_dirs_t*> publish_root_dirs(
+  const roots_t& roots) {
+    auto sys = syst::open_root(roots.sys);
+    if (sys.has_error()) {
+        return RES_TRACE(sys.error());
+    }
+    auto proc = syst::open_root(roots.proc);
+    if (proc.has_error()) {
+        return RES_TRACE(proc.error());
+    }
+    auto dev = syst::open_root(roots.dev);
+    if (dev.has_error()) {
+        return RES_TRACE(dev.error());
+    }
+
+    syst::published_root_dirs.push_back(std::make_unique<const root_dirs_t>(
+      root_dirs_t{ std::move(sys.value()),
+        std::move(proc.value()),
+        std::move(dev.value()) }));
+    const root_dirs_t* dirs = syst::published_root_dirs.back().get();
+    syst::root_dirs.store(dirs, std::memory_order_release);
+
+    return dirs;
+}
+
+/**
+ * @return the current roots, opening the default ones if no roots were set.
+ */
+[[nodiscard]] res::optional_t<const root_dirs_t*> get_root_dirs() {
+    const root_dirs_t* dirs = syst::root_dirs.load(std::memory_order_acquire);
+    if (dirs != nullptr) {
+        return dirs;
+    }
+
+    const std::lock_guard<std::mutex> lock{ root_dirs_mutex };
+
+    // Another thread may have opened the roots while this one was waiting.
+    dirs = syst::root_dirs.load(std::memory_order_acquire);
+    if (dirs != nullptr) {
+        return dirs;
+    }
+
+    auto default_dirs = syst::publish_root_dirs(roots_t{});
+    if (default_dirs.has_error()) {
+        return RES_TRACE(default_dirs.error());
+    }
+
+    return default_dirs.value();
+}
+
+res::result_t set_roots(const roots_t& roots) {
+    SYST_API("set_roots");
+    const std::lock_guard<std::mutex> lock{ root_dirs_mutex };
+
+    auto dirs = syst::publish_root_dirs(roots);
+    if (dirs.has_error()) {
+        return RES_TRACE(dirs.error());
+    }
+
+    return res::success;
+}
+
+roots_t get_roots() {
+    const root_dirs_t* dirs = syst::root_dirs.load(std::memory_order_acquire);
+    if (dirs == nullptr) {
+        return roots_t{};
+    }
+
+    return roots_t{ dirs->sys.path, dirs->proc.path, dirs->dev.path };
+}
+
+res::optional_t<const root_t*> get_sys_root() {
+    auto dirs = syst::get_root_dirs();
+    if (dirs.has_error()) {
+        return RES_TRACE(dirs.error());
+    }
+
+    return &dirs.value()->sys;
+}
+
+res::optional_t<const root_t*> get_proc_root() {
+    auto dirs = syst::get_root_dirs();
+    if (dirs.has_error()) {
+        return RES_TRACE(dirs.error());
+    }
+
+    return &dirs.value()->proc;
+}
+
+res::optional_t<const root_t*> get_dev_root() {
+    auto dirs = syst::get_root_dirs();
+    if (dirs.has_error()) {
+        return RES_TRACE(dirs.error());
+    }
+
+    return &dirs.value()->dev;
+}
+
+res::optional_t<fd_t> open_in(
+  const root_t& root, const fs::path& path, int flags) {
+    int fd = openat(root.dir->get(), path.c_str(), flags | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to open a file.\n\tpath: '"
+          + (root.path / path).string() + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    return fd_t{ fd };
+}
+
+/**
+ * @brief Read a file until its end. Unlike read_all, a short read is not
+ * taken as the end of the file.
+ *
+ * @param[in] fd - The open file descriptor to read from.
+ * @param[out] contents - The contents of the file.
+ * @return 0 if the operation succeeded or an errno value otherwise.
+ */
+[[nodiscard]] int read_until_end(const fd_t& fd, std::string& contents) {
+    // Large enough for most procfs files to be read in a few calls.
+    const size_t chunk_size = 65536;
+
+    contents.clear();
+    for (;;) {
+        const size_t offset = contents.size();
+        contents.resize(offset + chunk_size);
+
+        ssize_t len = read(fd.get(), contents.data() + offset, chunk_size);
+        if (len < 0) {
+            int err = errno;
+            contents.resize(offset);
+            if (err == EINTR) {
+                continue;
+            }
+            return err;
+        }
+        syst::count_read(static_cast<size_t>(len));
+
+        contents.resize(offset + static_cast<size_t>(len));
+        if (len == 0) {
+            return 0;
+        }
+    }
+}
+
+res::optional_t<std::vector<std::string>> get_all_lines_in(
+  const root_t& root, const fs::path& path) {
+    std::string contents;
+
+    // Files are recorded and replayed by the path of the root, which avoids
+    // looking up the path of its directory.
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        const fs::path full_path = root.path / path;
+        if (! syst::replay_read(nullptr, full_path.c_str(), contents)) {
+            return syst::not_recorded(full_path.string());
+        }
+    } else {
+        auto fd = syst::open_in(root, path, O_RDONLY);
+        if (fd.has_error()) {
+            return RES_TRACE(fd.error());
+        }
+
+        int err = syst::read_until_end(fd.value(), contents);
+        if (err != 0) {
+            return RES_NEW_ERROR("Failed to read a file.\n\tpath: '"
+              + (root.path / path).string() + "'\n\treason: '"
+              + syst::strerror(err) + "'");
+        }
+
+        if (syst::get_capture_mode() == capture_mode_t::record) {
+            const fs::path full_path = root.path / path;
+            syst::record_read(nullptr, full_path.c_str(), contents);
+        }
+    }
+
+    // Like std::getline, a last line without a newline is not extracted.
+    std::vector<std::string> lines;
+    size_t line_start = 0;
+    for (size_t line_end = contents.find('\n'); line_end != std::string::npos;
+         line_end = contents.find('\n', line_start)) {
+        lines.emplace_back(contents, line_start, line_end - line_start);
+        line_start = line_end + 1;
+    }
+
+    return lines;
+}
+
+} // namespace syst
@@ -0,0 +1,76 @@
+#pragma once
+
+// Standard includes
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// External includes
+#include <cpp_result/all.hpp>
+
+namespace syst {
+
+class fd_t;
+
+/**
+ * @brief A directory that procfs, sysfs, or devfs paths are resolved against
+ * (see set_roots).
+ */
+struct root_t {
+    // The path to the directory. Only used for error messages and by
+    // functions that do not accept directories.
+    std::filesystem::path path;
+
+    // The directory opened with O_PATH.
+    std::shared_ptr<const fd_t> dir;
+};
+
+/**
+ * @return the root that sysfs paths are resolved against or an error if the
+ * default root could not be opened. The root stays valid until the process
+ * exits, even if other roots are set.
+ */
+[[nodiscard]] res::optional_t<const root_t*> get_sys_root();
+
+/**
+ * @return the root that procfs paths are resolved against or an error if the
+ * default root could not be opened. The root stays valid until the process
+ * exits, even if other roots are set.
+ */
+[[nodiscard]] res::optional_t<const root_t*> get_proc_root();
+
+/**
+ * @return the root that devfs paths are resolved against or an error if the
+ * default root could not be opened. The root stays valid until the process
+ * exits, even if other roots are set.
+ */
+[[nodiscard]] res::optional_t<const root_t*> get_dev_root();
+
+/**
+ * @brief Open a file relative to a root. Absolute paths are opened as they
+ * are, like openat(2) does.
+ *
+ * @param[in] root - The root to resolve relative paths against.
+ * @param[in] path - The path to the file.
+ * @param[in] flags - Flags passed to openat(2) in addition to O_CLOEXEC.
+ * @return the file descriptor if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_in(
+  const root_t& root, const std::filesystem::path& path, int flags);
+
+/**
+ * @brief Extract all lines from a file relative to a root. Unlike the
+ * attributes of sysfs, procfs files may be returned in several short reads,
+ * so the file is read until its end.
+ *
+ * @param[in] root - The root to resolve relative paths against.
+ * @param[in] path - The path to the file.
+ * @return every line of the file (without newlines) if the operation
+ * succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<std::vector<std::string>> get_all_lines_in(
+  const root_t& root, const std::filesystem::path& path);
+
+} // namespace syst
@@ -0,0 +1,389 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cerrno>
+
+// External includes
+#include <poll.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+struct scheduled_collector_t {
+    uint64_t id;
+    ch::nanoseconds interval;
+    ch::steady_clock::time_point due;
+    scheduler_t::collector_t collector;
+};
+
+struct scheduler_state_t {
+    scheduler_options_t options;
+
+    // Only armed while at least one collector is registered.
+    fd_t timer;
+
+    // Becomes readable when 'stop' is called.
+    fd_t wakeup;
+
+    // There are only a few collectors, so finding the next one that is due is
+    // cheaper than maintaining a heap.
+    std::vector<scheduled_collector_t> collectors;
+    uint64_t next_id = 0;
+    uint64_t wakeups = 0;
+};
+
+struct scheduler_t::impl_t {
+    scheduler_state_t state;
+};
+
+/**
+ * @brief Restores the timer slack and scheduling policy of the calling thread
+ * when destroyed.
+ */
+struct thread_settings_guard_t {
+    std::optional<int> timer_slack;
+    std::optional<int> policy;
+    struct sched_param param {};
+
+    thread_settings_guard_t() = default;
+    thread_settings_guard_t(const thread_settings_guard_t&) = delete;
+    thread_settings_guard_t(thread_settings_guard_t&&) noexcept = delete;
+    thread_settings_guard_t& operator=(const thread_settings_guard_t&) = delete;
+    thread_settings_guard_t& operator=(
+      thread_settings_guard_t&&) noexcept = delete;
+
+    ~thread_settings_guard_t() {
+        // Destructors have no way of communicating failure.
+        if (this->timer_slack.has_value()) {
+            int err = prctl(PR_SET_TIMERSLACK,
+              static_cast<unsigned long>(this->timer_slack.value()),
+              0,
+              0,
+              0);
+            static_cast<void>(err);
+        }
+        if (this->policy.has_value()) {
+            int err = sched_setscheduler(0, this->policy.value(), &this->param);
+            static_cast<void>(err);
+        }
+    }
+};
+
+[[nodiscard]] res::result_t apply_thread_settings(
+  const scheduler_options_t& options, thread_settings_guard_t& guard) {
+    // documentation for timer slack and SCHED_IDLE
+    //     https://man7.org/linux/man-pages/man2/PR_SET_TIMERSLACK.2const.html
+    //     https://man7.org/linux/man-pages/man7/sched.7.html
+
+    if (options.timer_slack.count() > 0) {
+        int timer_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+        if (timer_slack < 0) {
+            int err = errno;
+            return RES_NEW_ERROR(
+              "Failed to get the timer slack of the current thread."
+              "\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+
+        if (prctl(PR_SET_TIMERSLACK,
+              static_cast<unsigned long>(options.timer_slack.count()),
+              0,
+              0,
+              0)
+          != 0) {
+            int err = errno;
+            return RES_NEW_ERROR(
+              "Failed to set the timer slack of the current thread.\n\tslack: '"
+              + std::to_string(options.timer_slack.count())
+              + "ns'\n\treason: '" + std::string{ syst::strerror(err) } + "'");
+        }
+        guard.timer_slack = timer_slack;
+    }
+
+    if (options.idle_priority) {
+        int policy = sched_getscheduler(0);
+        if (policy < 0 || sched_getparam(0, &guard.param) != 0) {
+            int err = errno;
+            return RES_NEW_ERROR(
+              "Failed to get the scheduling policy of the current thread."
+              "\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+
+        struct sched_param param {};
+        if (sched_setscheduler(0, SCHED_IDLE, &param) != 0) {
+            int err = errno;
+            return RES_NEW_ERROR(
+              "Failed to set the scheduling policy of the current thread to "
+              "SCHED_IDLE.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+        guard.policy = policy;
+    }
+
+    return res::success;
+}
+
+/**
+ * @return the first multiple of the interval on the monotonic clock that is
+ * after the given time.
+ */
+[[nodiscard]] ch::steady_clock::time_point next_multiple(
+  ch::steady_clock::time_point time, ch::nanoseconds interval) {
+    const auto since_epoch =
+      ch::duration_cast<ch::nanoseconds>(time.time_since_epoch());
+    return ch::steady_clock::time_point{ (since_epoch / interval + 1)
+      * interval };
+}
+
+[[nodiscard]] res::result_t arm_scheduler(const scheduler_state_t& state) {
+    if (state.collectors.empty()) {
+        auto result = syst::set_timer(state.timer, ch::nanoseconds::zero());
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+        return res::success;
+    }
+
+    const auto next = std::min_element(state.collectors.begin(),
+      state.collectors.end(),
+      [](const scheduled_collector_t& lhs, const scheduled_collector_t& rhs) {
+          return lhs.due < rhs.due;
+      });
+
+    // The kernel does not apply the timer slack of the thread to timerfd, so
+    // the deadline is delayed by up to the slack instead until the last
+    // collector that falls due within it. They all run in the same wakeup.
+    const auto latest = next->due + state.options.timer_slack;
+    auto deadline = next->due;
+    for (const scheduled_collector_t& collector : state.collectors) {
+        if (collector.due <= latest) {
+            deadline = std::max(deadline, collector.due);
+        }
+    }
+
+    auto result = syst::set_timer_deadline(state.timer, deadline);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::optional_t<scheduler_t> get_scheduler(
+  const scheduler_options_t& options) {
+    SYST_API("get_scheduler");
+    if (options.tick.count() <= 0) {
+        return RES_NEW_ERROR(
+          "The tick of a scheduler must be positive.\n\ttick: '"
+          + std::to_string(options.tick.count()) + "ns'");
+    }
+    if (options.timer_slack.count() < 0) {
+        return RES_NEW_ERROR(
+          "The timer slack of a scheduler must not be negative.\n\tslack: '"
+          + std::to_string(options.timer_slack.count()) + "ns'");
+    }
+
+    auto impl = std::make_unique<scheduler_t::impl_t>();
+    impl->state.options = options;
+
+    auto timer = syst::create_timer(options.tick);
+    if (timer.has_error()) {
+        return RES_TRACE(timer.error());
+    }
+    impl->state.timer = std::move(timer.value());
+
+    auto result = syst::arm_scheduler(impl->state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    impl->state.wakeup = fd_t{ eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) };
+    if (! impl->state.wakeup.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create an eventfd for a scheduler.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    return scheduler_t{ std::move(impl) };
+}
+
+scheduler_t::scheduler_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+scheduler_t::scheduler_t(scheduler_t&&) noexcept = default;
+
+scheduler_t& scheduler_t::operator=(scheduler_t&&) noexcept = default;
+
+scheduler_t::~scheduler_t() = default;
+
+res::optional_t<uint64_t> scheduler_t::add(
+  ch::nanoseconds interval, collector_t collector) {
+    SYST_API("scheduler_t::add");
+    scheduler_state_t& state = this->impl_->state;
+
+    if (interval.count() <= 0) {
+        return RES_NEW_ERROR(
+          "The interval of a collector must be positive.\n\tinterval: '"
+          + std::to_string(interval.count()) + "ns'");
+    }
+    if (! collector) {
+        return RES_NEW_ERROR("The collector must not be empty.");
+    }
+
+    // Intervals that are multiples of the tick are always due on a tick, so
+    // collectors with different intervals share wakeups.
+    const ch::nanoseconds tick = state.options.tick;
+    interval = ((interval + tick - ch::nanoseconds{ 1 }) / tick) * tick;
+
+    const uint64_t id = state.next_id++;
+    state.collectors.push_back(scheduled_collector_t{ id,
+      interval,
+      syst::next_multiple(ch::steady_clock::now(), interval),
+      std::move(collector) });
+
+    auto result = syst::arm_scheduler(state);
+    if (result.failure()) {
+        state.collectors.pop_back();
+        return RES_TRACE(result.error());
+    }
+
+    return id;
+}
+
+res::result_t scheduler_t::remove(uint64_t id) {
+    scheduler_state_t& state = this->impl_->state;
+
+    auto collector = std::find_if(state.collectors.begin(),
+      state.collectors.end(),
+      [id](const scheduled_collector_t& collector) {
+          return collector.id == id;
+      });
+    if (collector == state.collectors.end()) {
+        return RES_NEW_ERROR(
+          "No collector with the given identifier.\n\tid: '"
+          + std::to_string(id) + "'");
+    }
+    state.collectors.erase(collector);
+
+    auto result = syst::arm_scheduler(state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+int scheduler_t::get_fd() const {
+    return this->impl_->state.timer.get();
+}
+
+res::result_t scheduler_t::dispatch() {
+    SYST_API("scheduler_t::dispatch");
+    scheduler_state_t& state = this->impl_->state;
+
+    auto expirations = syst::read_timer(state.timer);
+    if (expirations.has_error()) {
+        return RES_TRACE(expirations.error());
+    }
+
+    // Every collector that is due at the same time runs in this wakeup.
+    const auto now = ch::steady_clock::now();
+    std::optional<res::error_t> error;
+    bool ran = false;
+
+    for (scheduled_collector_t& collector : state.collectors) {
+        if (collector.due > now) {
+            continue;
+        }
+        ran = true;
+
+        auto result = collector.collector();
+        if (result.failure() && ! error.has_value()) {
+            error = result.error();
+        }
+
+        // Runs that were missed are skipped instead of run late.
+        collector.due = syst::next_multiple(now, collector.interval);
+    }
+
+    if (ran) {
+        ++state.wakeups;
+    }
+
+    auto result = syst::arm_scheduler(state);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    if (error.has_value()) {
+        return RES_TRACE(error.value());
+    }
+
+    return res::success;
+}
+
+uint64_t scheduler_t::get_wakeups() const {
+    return this->impl_->state.wakeups;
+}
+
+res::result_t scheduler_t::run() {
+    SYST_API("scheduler_t::run");
+    scheduler_state_t& state = this->impl_->state;
+
+    thread_settings_guard_t guard;
+    auto result = syst::apply_thread_settings(state.options, guard);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    while (true) {
+        std::array<struct pollfd, 2> poll_fds{};
+        poll_fds[0].fd = state.timer.get();
+        poll_fds[0].events = POLLIN;
+        poll_fds[1].fd = state.wakeup.get();
+        poll_fds[1].events = POLLIN;
+
+        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+            return RES_NEW_ERROR(
+              "Failed to wait for the scheduler timer.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+
+        if ((poll_fds[1].revents & POLLIN) != 0) {
+            uint64_t count = 0;
+            ssize_t len = read(state.wakeup.get(), &count, sizeof(count));
+            static_cast<void>(len);
+            return res::success;
+        }
+
+        result = this->dispatch();
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+    }
+}
+
+void scheduler_t::stop() {
+    const uint64_t increment = 1;
+    ssize_t len =
+      write(this->impl_->state.wakeup.get(), &increment, sizeof(increment));
+    static_cast<void>(len);
+}
+
+} // namespace syst
@@ -1,58 +1,183 @@
 // Standard includes
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <unordered_map>
 
 // External includes
 #include <alsa/asoundlib.h>
 #include <alsa/mixer.h>
+#include <sys/epoll.h>
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "sound_events.hpp"
 #include "util.hpp"
+#include "strerror.hpp"
 
 namespace syst {
 
+struct sound_control_key_t {
+    std::string name;
+    unsigned int index;
+
+    [[nodiscard]] bool operator==(const sound_control_key_t& key) const {
+        return this->index == key.index && this->name == key.name;
+    }
+};
+
+struct sound_control_key_hash_t {
+    [[nodiscard]] size_t operator()(const sound_control_key_t& key) const {
+        return std::hash<std::string>{}(key.name) ^ key.index;
+    }
+};
+
+// Shared with the ALSA callbacks of a mixer.
+struct sound_registry_t {
+    // Elements added while the mixer is loaded are not reported.
+    bool loaded = false;
+    std::vector<pending_sound_event_t> events;
+
+    // Maintained by the mixer callback as elements are added and removed.
+    std::unordered_map<sound_control_key_t,
+      snd_mixer_elem_t*,
+      sound_control_key_hash_t>
+      elems;
+
+    // Created on the first lookup of each element.
+    std::unordered_map<sound_control_key_t,
+      std::unique_ptr<sound_control_t>,
+      sound_control_key_hash_t>
+      controls;
+};
+
 struct sound_mixer_t::impl_t {
     snd_mixer_t* mixer = nullptr;
+
+    // Aggregates all ALSA poll descriptors of this mixer.
+    fd_t epoll;
+
+    // The name of the attached HCTL device.
+    std::string device;
+
+    sound_registry_t registry;
+
+    impl_t() = default;
+    impl_t(const impl_t&) = delete;
+    impl_t(impl_t&&) noexcept = delete;
+    impl_t& operator=(const impl_t&) = delete;
+    impl_t& operator=(impl_t&&) noexcept = delete;
+
+    ~impl_t() {
+        if (this->mixer == nullptr) {
+            return;
+        }
+
+        // Assume that this function always succeeds. Destructors have no way
+        // of communicating failure.
+        snd_mixer_close(this->mixer);
+    }
 };
 
-sound_mixer_t::sound_mixer_t(const impl_t& impl)
-: impl_(std::make_unique<impl_t>(impl)) {
+int handle_sound_elem_event(snd_mixer_elem_t* elem, unsigned int mask) {
+    auto* registry = static_cast<sound_registry_t*>(
+      snd_mixer_elem_get_callback_private(elem));
+    if (registry == nullptr) {
+        return 0;
+    }
+
+    auto& events = registry->events;
+
+    if (mask == SND_CTL_EVENT_MASK_REMOVE) {
+        sound_control_key_t key{ snd_mixer_selem_get_name(elem),
+            snd_mixer_selem_get_index(elem) };
+        registry->elems.erase(key);
+        registry->controls.erase(key);
+
+        // The element is freed after this callback returns, so earlier events
+        // for it must not be dispatched.
+        events.erase(std::remove_if(events.begin(),
+                       events.end(),
+                       [elem](const pending_sound_event_t& event) {
+                           return event.elem == elem;
+                       }),
+          events.end());
+
+        events.push_back(pending_sound_event_t{ nullptr,
+          sound_event_t::type_t::removed,
+          std::move(key.name),
+          key.index });
+        return 0;
+    }
+
+    // Report each element at most once per dispatch.
+    for (const pending_sound_event_t& event : events) {
+        if (event.elem == elem) {
+            return 0;
+        }
+    }
+
+    events.push_back(pending_sound_event_t{ elem,
+      sound_event_t::type_t::changed,
+      snd_mixer_selem_get_name(elem),
+      snd_mixer_selem_get_index(elem) });
+    return 0;
 }
 
-sound_mixer_t::sound_mixer_t(sound_mixer_t&& sound_mixer) noexcept {
-    if (sound_mixer.impl_ == nullptr || sound_mixer.impl_->mixer == nullptr) {
-        return;
+int handle_sound_mixer_event(
+  snd_mixer_t* mixer, unsigned int mask, snd_mixer_elem_t* elem) {
+    auto* registry =
+      static_cast<sound_registry_t*>(snd_mixer_get_callback_private(mixer));
+    if (registry == nullptr || (mask & SND_CTL_EVENT_MASK_ADD) == 0) {
+        return 0;
     }
 
-    this->impl_ = std::make_unique<impl_t>(impl_t{ sound_mixer.impl_->mixer });
-    sound_mixer.impl_->mixer = nullptr;
-}
+    snd_mixer_elem_set_callback(elem, syst::handle_sound_elem_event);
+    snd_mixer_elem_set_callback_private(elem, registry);
 
-sound_mixer_t::~sound_mixer_t() {
-    if (this->impl_ == nullptr || this->impl_->mixer == nullptr) {
-        return;
+    registry->elems.insert_or_assign(
+      sound_control_key_t{
+        snd_mixer_selem_get_name(elem), snd_mixer_selem_get_index(elem) },
+      elem);
+
+    if (registry->loaded) {
+        registry->events.push_back(pending_sound_event_t{ elem,
+          sound_event_t::type_t::added,
+          snd_mixer_selem_get_name(elem),
+          snd_mixer_selem_get_index(elem) });
     }
 
-    // Assume that this function always succeeds. Destructors have no way of
-    // communicating failure.
-    snd_mixer_close(this->impl_->mixer);
+    return 0;
+}
+
+sound_mixer_t::sound_mixer_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
 }
 
-res::optional_t<sound_mixer_t> get_sound_mixer() {
+sound_mixer_t::sound_mixer_t(sound_mixer_t&&) noexcept = default;
+
+sound_mixer_t& sound_mixer_t::operator=(sound_mixer_t&&) noexcept = default;
+
+sound_mixer_t::~sound_mixer_t() = default;
+
+res::optional_t<sound_mixer_t> get_sound_mixer(const std::string& device) {
+    SYST_API("get_sound_mixer");
     // This solution was derived from the first half of the answer to this Stack
     // Overflow post:
     // https://stackoverflow.com/questions/6787318/set-alsa-master-volume-from-c-code
 
     int snd_errno = 0;
 
-    sound_mixer_t::impl_t impl;
+    auto impl = std::make_unique<sound_mixer_t::impl_t>();
+    impl->device = device;
 
     // NOTE: Mixer mode is an unused attribute and can be any value.
     // https://stackoverflow.com/questions/45716092/alsa-snd-mixer-open-open-mode
     // https://git.alsa-project.org/?p=alsa-lib.git;a=blob;f=src/mixer/mixer.c;h=3a79c8e91efb0f6c67c0ba365b54eb6f72679d69;hb=HEAD#l68
     const int mixer_mode = 0;
 
-    snd_errno = snd_mixer_open(&impl.mixer, mixer_mode);
+    snd_errno = snd_mixer_open(&impl->mixer, mixer_mode);
     if (snd_errno != 0) {
         return RES_NEW_ERROR(std::string{ "ALSA error: snd_mixer_open: " }
           + snd_strerror(snd_errno));
@@ -60,1130 +185,715 @@ res::optional_t<sound_mixer_t> get_sound_mixer() {
 
     // NOTE: I was unable to find documentation for the "default" HCTL
     // interface. This code assumes that it is always available.
-    const std::string default_hctl_name = "default";
     // HCTL = High level ConTroL interface
     // https://www.alsa-project.org/alsa-doc/alsa-lib/group___h_control.html
 
-    snd_errno = snd_mixer_attach(impl.mixer, default_hctl_name.data());
+    snd_errno = snd_mixer_attach(impl->mixer, device.data());
     if (snd_errno != 0) {
         return RES_NEW_ERROR(std::string{ "ALSA error: snd_mixer_attach: " }
-          + snd_strerror(snd_errno));
+          + snd_strerror(snd_errno) + "\n\tdevice: '" + device + "'");
     }
 
-    snd_errno = snd_mixer_selem_register(impl.mixer, nullptr, nullptr);
+    snd_errno = snd_mixer_selem_register(impl->mixer, nullptr, nullptr);
     if (snd_errno != 0) {
         return RES_NEW_ERROR(
           std::string{ "ALSA error: snd_mixer_selem_register: " }
           + snd_strerror(snd_errno));
     }
 
-    snd_errno = snd_mixer_load(impl.mixer);
+    // Every element is announced to the mixer callback when it is loaded, which
+    // is where the element callbacks are registered.
+    snd_mixer_set_callback(impl->mixer, syst::handle_sound_mixer_event);
+    snd_mixer_set_callback_private(impl->mixer, &impl->registry);
+
+    snd_errno = snd_mixer_load(impl->mixer);
     if (snd_errno != 0) {
         return RES_NEW_ERROR(std::string{ "ALSA error: snd_mixer_load: " }
           + snd_strerror(snd_errno));
     }
 
-    return sound_mixer_t{ impl };
-}
-
-struct sound_control_t::impl_t {
-    snd_mixer_elem_t* elem = nullptr;
-};
+    impl->registry.loaded = true;
 
-std::vector<sound_control_t> sound_mixer_t::get_controls() const {
-    snd_mixer_elem_t* first_elem = snd_mixer_first_elem(this->impl_->mixer);
-    snd_mixer_elem_t* last_elem = snd_mixer_last_elem(this->impl_->mixer);
+    int poll_count = snd_mixer_poll_descriptors_count(impl->mixer);
+    if (poll_count < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "ALSA error: snd_mixer_poll_descriptors_count: " }
+          + snd_strerror(poll_count));
+    }
 
-    std::vector<sound_control_t> controls;
+    std::vector<struct pollfd> poll_fds(static_cast<size_t>(poll_count));
+    poll_count = snd_mixer_poll_descriptors(
+      impl->mixer, poll_fds.data(), static_cast<unsigned int>(poll_fds.size()));
+    if (poll_count < 0) {
+        return RES_NEW_ERROR(
+          std::string{ "ALSA error: snd_mixer_poll_descriptors: " }
+          + snd_strerror(poll_count));
+    }
 
-    if (first_elem == nullptr || snd_mixer_selem_is_active(first_elem) == 0) {
-        return controls;
+    impl->epoll = fd_t{ epoll_create1(EPOLL_CLOEXEC) };
+    if (! impl->epoll.is_open()) {
+        return RES_NEW_ERROR(
+          "Failed to create an epoll instance for a sound mixer.\n\treason: '"
+          + std::string{ syst::strerror(errno) } + "'");
     }
 
-    controls.push_back(
-      sound_control_t{ sound_control_t::impl_t{ first_elem } });
-    while (controls.back().impl_->elem != last_elem) {
-        snd_mixer_elem_t* next_elem =
-          snd_mixer_elem_next(controls.back().impl_->elem);
+    for (int index = 0; index < poll_count; ++index) {
+        struct epoll_event event{};
+        event.events = static_cast<uint32_t>(poll_fds[index].events);
+        event.data.fd = poll_fds[index].fd;
 
-        if (snd_mixer_selem_is_active(first_elem) == 0) {
-            continue;
+        if (epoll_ctl(impl->epoll.get(), EPOLL_CTL_ADD, event.data.fd, &event)
+          != 0) {
+            return RES_NEW_ERROR(
+              "Failed to watch an ALSA poll descriptor.\n\tfd: '"
+              + std::to_string(event.data.fd) + "'\n\treason: '"
+              + syst::strerror(errno) + "'");
         }
-
-        controls.emplace_back(
-          sound_control_t{ sound_control_t::impl_t{ next_elem } });
     }
 
-    return controls;
+    return sound_mixer_t{ std::move(impl) };
 }
 
-sound_control_t::sound_control_t(const impl_t& impl)
-: impl_(std::make_unique<impl_t>(impl)) {
-}
+res::optional_t<std::vector<sound_mixer_t>> get_sound_mixers() {
+    SYST_API("get_sound_mixers");
+    std::vector<sound_mixer_t> mixers;
 
-sound_control_t::~sound_control_t() {
-}
+    int card = -1;
+    while (true) {
+        int snd_errno = snd_card_next(&card);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(std::string{ "ALSA error: snd_card_next: " }
+              + snd_strerror(snd_errno));
+        }
+        if (card < 0) {
+            break;
+        }
 
-std::string sound_control_t::get_name() const {
-    return snd_mixer_selem_get_name(this->impl_->elem);
-}
+        auto mixer = syst::get_sound_mixer("hw:" + std::to_string(card));
+        if (mixer.has_error()) {
+            return RES_TRACE(mixer.error());
+        }
 
-bool sound_control_t::has_playback_status() const {
-    return snd_mixer_selem_has_playback_switch(this->impl_->elem) != 0;
-}
+        mixers.push_back(std::move(mixer.value()));
+    }
 
-bool sound_control_t::has_playback_volume() const {
-    return snd_mixer_selem_has_playback_volume(this->impl_->elem) != 0;
+    return mixers;
 }
 
-bool sound_control_t::has_capture_status() const {
-    return snd_mixer_selem_has_capture_switch(this->impl_->elem) != 0;
-}
+// The channels of a simple mixer element in the same order as the members of
+// 'sound_control_t::state_t'.
+constexpr std::array<snd_mixer_selem_channel_id_t, 9> sound_channels{
+    SND_MIXER_SCHN_FRONT_LEFT,
+    SND_MIXER_SCHN_FRONT_RIGHT,
+    SND_MIXER_SCHN_REAR_LEFT,
+    SND_MIXER_SCHN_REAR_RIGHT,
+    SND_MIXER_SCHN_FRONT_CENTER,
+    SND_MIXER_SCHN_WOOFER,
+    SND_MIXER_SCHN_SIDE_LEFT,
+    SND_MIXER_SCHN_SIDE_RIGHT,
+    SND_MIXER_SCHN_REAR_CENTER,
+};
 
-bool sound_control_t::has_capture_volume() const {
-    return snd_mixer_selem_has_capture_volume(this->impl_->elem) != 0;
-}
+template<typename state_type_t>
+constexpr std::array<decltype(&state_type_t::front_left), sound_channels.size()>
+  sound_channel_members{
+      &state_type_t::front_left,
+      &state_type_t::front_right,
+      &state_type_t::rear_left,
+      &state_type_t::rear_right,
+      &state_type_t::front_center,
+      &state_type_t::woofer,
+      &state_type_t::side_left,
+      &state_type_t::side_right,
+      &state_type_t::rear_center,
+  };
+
+// The ALSA functions for either the playback or the capture half of a simple
+// mixer element. Both halves have identical signatures.
+struct sound_api_t {
+    const char* direction;
+
+    int (*has_switch)(snd_mixer_elem_t*);
+    int (*has_volume)(snd_mixer_elem_t*);
+    int (*has_channel)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t);
+    int (*get_switch)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, int*);
+    int (*set_switch)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, int);
+    int (*set_switch_all)(snd_mixer_elem_t*, int);
+    int (*get_volume)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, long*);
+    int (*set_volume)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, long);
+    int (*set_volume_all)(snd_mixer_elem_t*, long);
+    int (*get_volume_range)(snd_mixer_elem_t*, long*, long*);
+    int (*get_db_range)(snd_mixer_elem_t*, long*, long*);
+};
 
-res::result_t get_channel_playback_status(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  std::optional<bool>& status) {
-    if (snd_mixer_selem_has_playback_channel(control, channel) == 0) {
-        status = std::nullopt;
-        return res::success;
-    }
+const sound_api_t playback_sound_api{
+    "playback",
+    snd_mixer_selem_has_playback_switch,
+    snd_mixer_selem_has_playback_volume,
+    snd_mixer_selem_has_playback_channel,
+    snd_mixer_selem_get_playback_switch,
+    snd_mixer_selem_set_playback_switch,
+    snd_mixer_selem_set_playback_switch_all,
+    snd_mixer_selem_get_playback_volume,
+    snd_mixer_selem_set_playback_volume,
+    snd_mixer_selem_set_playback_volume_all,
+    snd_mixer_selem_get_playback_volume_range,
+    snd_mixer_selem_get_playback_dB_range,
+};
 
-    int value = 0;
-    int snd_errno =
-      snd_mixer_selem_get_playback_switch(control, channel, &value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_get_playback_switch: " }
-          + snd_strerror(snd_errno));
-    }
+const sound_api_t capture_sound_api{
+    "capture",
+    snd_mixer_selem_has_capture_switch,
+    snd_mixer_selem_has_capture_volume,
+    snd_mixer_selem_has_capture_channel,
+    snd_mixer_selem_get_capture_switch,
+    snd_mixer_selem_set_capture_switch,
+    snd_mixer_selem_set_capture_switch_all,
+    snd_mixer_selem_get_capture_volume,
+    snd_mixer_selem_set_capture_volume,
+    snd_mixer_selem_set_capture_volume_all,
+    snd_mixer_selem_get_capture_volume_range,
+    snd_mixer_selem_get_capture_dB_range,
+};
 
-    status = (value != 0);
-    return res::success;
-}
+// The capabilities of either the playback or the capture half of a simple
+// mixer element. Read once when a sound control object is created.
+struct sound_direction_t {
+    bool has_switch = false;
+    bool has_volume = false;
 
-res::optional_t<sound_control_t::status_t>
-sound_control_t::get_playback_status() const {
-    status_t status{};
+    // Bit N is set if the channel at index N of 'sound_channels' is present.
+    uint32_t channels = 0;
 
-    res::result_t result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_LEFT, status.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    // Zero if the volume range was read successfully.
+    int range_errno = 0;
+    long min_volume = 0;
+    long max_volume = 0;
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_RIGHT, status.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    std::optional<sound_control_t::db_range_t> db_range;
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_LEFT, status.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+    [[nodiscard]] bool has_channel(size_t index) const {
+        return (this->channels & (1U << index)) != 0;
     }
+};
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_RIGHT, status.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_CENTER, status.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+[[nodiscard]] std::string sound_error(
+  const sound_api_t& api, const char* action, const char* attribute, int err) {
+    return std::string{ "ALSA error: snd_mixer_selem_" } + action + "_"
+      + api.direction + "_" + attribute + ": " + snd_strerror(err);
+}
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_WOOFER, status.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+[[nodiscard]] sound_direction_t probe_sound_direction(
+  snd_mixer_elem_t* elem, const sound_api_t& api) {
+    sound_direction_t direction{};
+    direction.has_switch = api.has_switch(elem) != 0;
+    direction.has_volume = api.has_volume(elem) != 0;
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_LEFT, status.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        if (api.has_channel(elem, sound_channels[index]) != 0) {
+            direction.channels |= 1U << index;
+        }
     }
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_RIGHT, status.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+    if (! direction.has_volume) {
+        return direction;
     }
 
-    result = syst::get_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_CENTER, status.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+    direction.range_errno = api.get_volume_range(
+      elem, &direction.min_volume, &direction.max_volume);
+
+    // Not all elements provide decibel information.
+    long min_db = 0;
+    long max_db = 0;
+    if (api.get_db_range(elem, &min_db, &max_db) == 0) {
+        // ALSA reports decibels in hundredths.
+        const double centibels_per_decibel = 1e2;
+        direction.db_range = sound_control_t::db_range_t{
+            static_cast<double>(min_db) / centibels_per_decibel,
+            static_cast<double>(max_db) / centibels_per_decibel,
+        };
     }
 
-    return status;
+    return direction;
 }
 
-res::result_t get_channel_playback_volume(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  long min_value,
-  long max_value,
-  std::optional<double>& status) {
-    if (snd_mixer_selem_has_playback_channel(control, channel) == 0) {
-        status = std::nullopt;
-        return res::success;
+struct sound_control_t::impl_t {
+    snd_mixer_elem_t* elem = nullptr;
+    sound_direction_t playback;
+    sound_direction_t capture;
+
+    // The channels and ranges of an element are assumed not to change, so they
+    // are only read once.
+    explicit impl_t(snd_mixer_elem_t* elem)
+    : elem(elem)
+    , playback(syst::probe_sound_direction(elem, playback_sound_api))
+    , capture(syst::probe_sound_direction(elem, capture_sound_api)) {
     }
+};
 
-    long value = 0;
-    int snd_errno =
-      snd_mixer_selem_get_playback_volume(control, channel, &value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_get_playback_switch: " }
-          + snd_strerror(snd_errno));
+[[nodiscard]] res::result_t check_volume_range(
+  const sound_api_t& api, const sound_direction_t& direction) {
+    if (direction.range_errno != 0) {
+        return RES_NEW_ERROR(syst::sound_error(
+          api, "get", "volume_range", direction.range_errno));
     }
 
-    status = syst::value_to_percent(min_value, max_value, value);
     return res::success;
 }
 
-res::optional_t<sound_control_t::volume_t>
-sound_control_t::get_playback_volume() const {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_playback_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_playback_volume_range: " }
-          + snd_strerror(snd_errno));
+[[nodiscard]] res::result_t check_volume_bounds(
+  const sound_api_t& api, double volume) {
+    if (volume < static_cast<double>(0) || volume > static_cast<double>(100)) {
+        return RES_NEW_ERROR(std::string{ "The new status given for the " }
+          + api.direction + " volume is out of bounds.\n\tstatus: '"
+          + std::to_string(volume) + "'");
     }
 
-    volume_t volume{};
+    return res::success;
+}
 
-    res::result_t result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_LEFT,
-      min_value,
-      max_value,
-      volume.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+[[nodiscard]] res::optional_t<sound_control_t::status_t> get_sound_status(
+  snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction) {
+    const auto& members = sound_channel_members<sound_control_t::status_t>;
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_RIGHT,
-      min_value,
-      max_value,
-      volume.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    sound_control_t::status_t status{};
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_LEFT,
-      min_value,
-      max_value,
-      volume.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        if (! direction.has_channel(index)) {
+            continue;
+        }
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_RIGHT,
-      min_value,
-      max_value,
-      volume.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+        int value = 0;
+        int snd_errno = api.get_switch(elem, sound_channels[index], &value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "get", "switch", snd_errno));
+        }
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_CENTER,
-      min_value,
-      max_value,
-      volume.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+        status.*members[index] = (value != 0);
     }
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_WOOFER,
-      min_value,
-      max_value,
-      volume.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    return status;
+}
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_LEFT,
-      min_value,
-      max_value,
-      volume.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+[[nodiscard]] res::optional_t<sound_control_t::volume_t> get_sound_volume(
+  snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction) {
+    const auto& members = sound_channel_members<sound_control_t::volume_t>;
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_RIGHT,
-      min_value,
-      max_value,
-      volume.side_right);
+    auto result = syst::check_volume_range(api, direction);
     if (result.failure()) {
         return RES_TRACE(result.error());
     }
 
-    result = syst::get_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_CENTER,
-      min_value,
-      max_value,
-      volume.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+    sound_control_t::volume_t volume{};
+
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        if (! direction.has_channel(index)) {
+            continue;
+        }
+
+        long value = 0;
+        int snd_errno = api.get_volume(elem, sound_channels[index], &value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "get", "volume", snd_errno));
+        }
+
+        volume.*members[index] = syst::value_to_percent(
+          direction.min_volume, direction.max_volume, value);
     }
 
     return volume;
 }
 
-res::result_t get_channel_capture_status(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  std::optional<bool>& status) {
-    if (snd_mixer_selem_has_capture_channel(control, channel) == 0) {
-        status = std::nullopt;
-        return res::success;
+[[nodiscard]] res::optional_t<sound_control_t::db_range_t> get_sound_db_range(
+  const sound_api_t& api, const sound_direction_t& direction) {
+    if (! direction.db_range.has_value()) {
+        return RES_NEW_ERROR(std::string{ "The " } + api.direction
+          + " volume of this sound control element has no decibel range.");
+    }
+
+    return direction.db_range.value();
+}
+
+[[nodiscard]] res::result_t set_sound_status(snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction,
+  const sound_control_t::status_t& status) {
+    const auto& members = sound_channel_members<sound_control_t::status_t>;
+
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        const std::optional<bool>& channel_status = status.*members[index];
+        if (! channel_status.has_value() || ! direction.has_channel(index)) {
+            continue;
+        }
+
+        int snd_errno = api.set_switch(
+          elem, sound_channels[index], channel_status.value() ? 1 : 0);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "set", "switch", snd_errno));
+        }
     }
 
-    int value = 0;
-    int snd_errno =
-      snd_mixer_selem_get_capture_switch(control, channel, &value);
+    return res::success;
+}
+
+[[nodiscard]] res::result_t set_sound_status_all(
+  snd_mixer_elem_t* elem, const sound_api_t& api, bool status) {
+    int snd_errno = api.set_switch_all(elem, status ? 1 : 0);
     if (snd_errno != 0) {
         return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_get_capture_switch: " }
-          + snd_strerror(snd_errno));
+          syst::sound_error(api, "set", "switch_all", snd_errno));
     }
 
-    status = (value != 0);
     return res::success;
 }
 
-res::optional_t<sound_control_t::status_t> sound_control_t::get_capture_status()
-  const {
-    status_t status{};
+[[nodiscard]] res::result_t toggle_sound_status(snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction) {
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        if (! direction.has_channel(index)) {
+            continue;
+        }
 
-    res::result_t result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_LEFT, status.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+        int value = 0;
+        int snd_errno = api.get_switch(elem, sound_channels[index], &value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "get", "switch", snd_errno));
+        }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_RIGHT, status.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+        snd_errno =
+          api.set_switch(elem, sound_channels[index], value != 0 ? 0 : 1);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "set", "switch", snd_errno));
+        }
     }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_LEFT, status.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    return res::success;
+}
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_RIGHT, status.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+[[nodiscard]] res::result_t set_sound_volume(snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction,
+  const sound_control_t::volume_t& volume) {
+    const auto& members = sound_channel_members<sound_control_t::volume_t>;
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_CENTER, status.front_center);
+    auto result = syst::check_volume_range(api, direction);
     if (result.failure()) {
         return RES_TRACE(result.error());
     }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_WOOFER, status.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        const std::optional<double>& channel_volume = volume.*members[index];
+        if (! channel_volume.has_value() || ! direction.has_channel(index)) {
+            continue;
+        }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_LEFT, status.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+        result = syst::check_volume_bounds(api, channel_volume.value());
+        if (result.failure()) {
+            return RES_TRACE(result.error());
+        }
+
+        long value = syst::percent_to_value(
+          direction.min_volume, direction.max_volume, channel_volume.value());
+        int snd_errno = api.set_volume(elem, sound_channels[index], value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "set", "volume", snd_errno));
+        }
     }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_RIGHT, status.side_right);
+    return res::success;
+}
+
+[[nodiscard]] res::result_t set_sound_volume_all(snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction,
+  double volume) {
+    auto result = syst::check_volume_range(api, direction);
     if (result.failure()) {
         return RES_TRACE(result.error());
     }
 
-    result = syst::get_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_CENTER, status.rear_center);
+    result = syst::check_volume_bounds(api, volume);
     if (result.failure()) {
         return RES_TRACE(result.error());
     }
 
-    return status;
-}
-
-res::result_t get_channel_capture_volume(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  long min_value,
-  long max_value,
-  std::optional<double>& status) {
-    if (snd_mixer_selem_has_capture_channel(control, channel) == 0) {
-        status = std::nullopt;
-        return res::success;
-    }
-
-    long value = 0;
-    int snd_errno =
-      snd_mixer_selem_get_capture_volume(control, channel, &value);
+    long value = syst::percent_to_value(
+      direction.min_volume, direction.max_volume, volume);
+    int snd_errno = api.set_volume_all(elem, value);
     if (snd_errno != 0) {
         return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_get_capture_volume: " }
-          + snd_strerror(snd_errno));
+          syst::sound_error(api, "set", "volume_all", snd_errno));
     }
 
-    status = syst::value_to_percent(min_value, max_value, value);
     return res::success;
 }
 
-res::optional_t<sound_control_t::volume_t> sound_control_t::get_capture_volume()
-  const {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_capture_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_capture_volume_range: " }
-          + snd_strerror(snd_errno));
-    }
-
-    volume_t volume{};
-
-    res::result_t result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_LEFT,
-      min_value,
-      max_value,
-      volume.front_left);
+[[nodiscard]] res::result_t set_sound_volume_all_relative(
+  snd_mixer_elem_t* elem,
+  const sound_api_t& api,
+  const sound_direction_t& direction,
+  double volume) {
+    auto result = syst::check_volume_range(api, direction);
     if (result.failure()) {
         return RES_TRACE(result.error());
     }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_RIGHT,
-      min_value,
-      max_value,
-      volume.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    for (size_t index = 0; index < sound_channels.size(); ++index) {
+        if (! direction.has_channel(index)) {
+            continue;
+        }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_LEFT,
-      min_value,
-      max_value,
-      volume.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+        long value = 0;
+        int snd_errno = api.get_volume(elem, sound_channels[index], &value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "get", "volume", snd_errno));
+        }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_RIGHT,
-      min_value,
-      max_value,
-      volume.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+        const double percent = std::clamp(
+          syst::value_to_percent(
+            direction.min_volume, direction.max_volume, value)
+            + volume,
+          static_cast<double>(0),
+          static_cast<double>(100));
+
+        value = syst::percent_to_value(
+          direction.min_volume, direction.max_volume, percent);
+        snd_errno = api.set_volume(elem, sound_channels[index], value);
+        if (snd_errno != 0) {
+            return RES_NEW_ERROR(
+              syst::sound_error(api, "set", "volume", snd_errno));
+        }
     }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_CENTER,
-      min_value,
-      max_value,
-      volume.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    return res::success;
+}
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_WOOFER,
-      min_value,
-      max_value,
-      volume.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+std::vector<sound_control_t> sound_mixer_t::get_controls() const {
+    std::vector<sound_control_t> controls;
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_LEFT,
-      min_value,
-      max_value,
-      volume.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    for (snd_mixer_elem_t* elem = snd_mixer_first_elem(this->impl_->mixer);
+         elem != nullptr;
+         elem = snd_mixer_elem_next(elem)) {
+        if (snd_mixer_selem_is_active(elem) == 0) {
+            continue;
+        }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_RIGHT,
-      min_value,
-      max_value,
-      volume.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
+        controls.emplace_back(
+          sound_control_t{ sound_control_t::impl_t{ elem } });
     }
 
-    result = syst::get_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_CENTER,
-      min_value,
-      max_value,
-      volume.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+    return controls;
+}
 
-    return volume;
+std::string sound_mixer_t::get_device() const {
+    return this->impl_->device;
 }
 
-res::result_t set_channel_playback_status(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  const std::optional<bool>& status) {
-    if (! status.has_value()) {
-        return res::success;
-    }
+sound_control_t* sound_mixer_t::find_control(
+  const std::string& name, unsigned int index) {
+    SYST_API("sound_mixer_t::find_control");
+    sound_registry_t& registry = this->impl_->registry;
+    sound_control_key_t key{ name, index };
 
-    if (snd_mixer_selem_has_playback_channel(control, channel) == 0) {
-        return res::success;
+    auto control = registry.controls.find(key);
+    if (control != registry.controls.end()) {
+        return control->second.get();
     }
 
-    int value = 0;
-    if (status.value()) {
-        value = 1;
+    auto elem = registry.elems.find(key);
+    if (elem == registry.elems.end()
+      || snd_mixer_selem_is_active(elem->second) == 0) {
+        return nullptr;
     }
 
-    int snd_errno =
-      snd_mixer_selem_set_playback_switch(control, channel, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_playback_switch: " }
-          + snd_strerror(snd_errno));
-    }
+    // The control object is allocated separately so that its address does not
+    // change when the table is rehashed.
+    auto new_control = std::make_unique<sound_control_t>(
+      sound_control_t{ sound_control_t::impl_t{ elem->second } });
+    sound_control_t* handle = new_control.get();
+    registry.controls.emplace(std::move(key), std::move(new_control));
 
-    return res::success;
+    return handle;
 }
 
-res::result_t sound_control_t::set_playback_status(const status_t& status) {
-    res::result_t result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_LEFT, status.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_RIGHT, status.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_LEFT, status.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_RIGHT, status.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_CENTER, status.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_WOOFER, status.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_LEFT, status.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_RIGHT, status.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_CENTER, status.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
+int sound_mixer_t::get_fd() const {
+    return this->impl_->epoll.get();
 }
 
-res::result_t sound_control_t::set_playback_status_all(bool status) {
-    int value = 0;
-    if (status) {
-        value = 1;
-    }
-
-    int snd_errno =
-      snd_mixer_selem_set_playback_switch_all(this->impl_->elem, value);
-    if (snd_errno != 0) {
+res::optional_t<std::vector<sound_event_t>> sound_mixer_t::dispatch() {
+    SYST_API("sound_mixer_t::dispatch");
+    // Reads the pending events from every poll descriptor and invokes the
+    // callbacks, which queue the changed elements.
+    int snd_errno = snd_mixer_handle_events(this->impl_->mixer);
+    if (snd_errno < 0) {
         return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_playback_switch_all: " }
+          std::string{ "ALSA error: snd_mixer_handle_events: " }
           + snd_strerror(snd_errno));
     }
 
-    return res::success;
-}
+    std::vector<pending_sound_event_t> pending;
+    pending.swap(this->impl_->registry.events);
 
-void toggle_channel_status(std::optional<bool>& channel_status) {
-    if (channel_status.has_value()) {
-        channel_status = ! channel_status.value();
-    }
+    return syst::make_sound_events(
+      pending, [this](const std::string& name, unsigned int index) {
+          return this->find_control(name, index);
+      });
 }
 
-[[nodiscard]] sound_control_t::status_t toggle_status(
-  const sound_control_t::status_t& status) {
-    sound_control_t::status_t new_status = status;
-
-    syst::toggle_channel_status(new_status.front_left);
-    syst::toggle_channel_status(new_status.front_right);
-    syst::toggle_channel_status(new_status.rear_left);
-    syst::toggle_channel_status(new_status.rear_right);
-    syst::toggle_channel_status(new_status.front_center);
-    syst::toggle_channel_status(new_status.woofer);
-    syst::toggle_channel_status(new_status.side_left);
-    syst::toggle_channel_status(new_status.side_right);
-    syst::toggle_channel_status(new_status.rear_center);
-
-    return new_status;
+sound_control_t::sound_control_t(const impl_t& impl)
+: impl_(std::make_unique<impl_t>(impl)) {
 }
 
-res::result_t sound_control_t::toggle_playback_status() {
-    auto status = this->get_playback_status();
-    if (status.has_error()) {
-        return RES_TRACE(status.error());
-    }
-
-    auto new_status = syst::toggle_status(status.value());
-
-    auto result = this->set_playback_status(new_status);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
+sound_control_t::~sound_control_t() {
 }
 
-res::result_t set_channel_playback_volume(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  long min_value,
-  long max_value,
-  const std::optional<double>& status) {
-    if (! status.has_value()) {
-        return res::success;
-    }
-
-    if (snd_mixer_selem_has_playback_channel(control, channel) == 0) {
-        return res::success;
-    }
-
-    if (status.value() < static_cast<double>(0)
-      || status.value() > static_cast<double>(100)) {
-        return RES_NEW_ERROR(
-          "The new status given for the playback volume is out of "
-          "bounds.\n\tstatus: '"
-          + std::to_string(status.value()) + "'");
-    }
-
-    long value = syst::percent_to_value(min_value, max_value, status.value());
-    int snd_errno =
-      snd_mixer_selem_set_playback_volume(control, channel, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_playback_volume: " }
-          + snd_strerror(snd_errno));
-    }
-
-    return res::success;
+std::string sound_control_t::get_name() const {
+    return snd_mixer_selem_get_name(this->impl_->elem);
 }
 
-res::result_t sound_control_t::set_playback_volume(const volume_t& volume) {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_playback_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_playback_volume_range: " }
-          + snd_strerror(snd_errno));
-    }
-
-    res::result_t result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_LEFT,
-      min_value,
-      max_value,
-      volume.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_RIGHT,
-      min_value,
-      max_value,
-      volume.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_LEFT,
-      min_value,
-      max_value,
-      volume.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_RIGHT,
-      min_value,
-      max_value,
-      volume.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_CENTER,
-      min_value,
-      max_value,
-      volume.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_WOOFER,
-      min_value,
-      max_value,
-      volume.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_LEFT,
-      min_value,
-      max_value,
-      volume.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+unsigned int sound_control_t::get_index() const {
+    return snd_mixer_selem_get_index(this->impl_->elem);
+}
 
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_RIGHT,
-      min_value,
-      max_value,
-      volume.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+bool sound_control_t::has_playback_status() const {
+    return this->impl_->playback.has_switch;
+}
 
-    result = syst::set_channel_playback_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_CENTER,
-      min_value,
-      max_value,
-      volume.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+bool sound_control_t::has_playback_volume() const {
+    return this->impl_->playback.has_volume;
+}
 
-    return res::success;
+bool sound_control_t::has_capture_status() const {
+    return this->impl_->capture.has_switch;
 }
 
-res::result_t sound_control_t::set_playback_volume_all(double volume) {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_playback_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_playback_volume_range: " }
-          + snd_strerror(snd_errno));
-    }
+bool sound_control_t::has_capture_volume() const {
+    return this->impl_->capture.has_volume;
+}
 
-    if (volume < static_cast<double>(0) || volume > static_cast<double>(100)) {
-        return RES_NEW_ERROR(
-          "The new status given for the playback volume is out of "
-          "bounds.\n\tstatus: '"
-          + std::to_string(volume) + "'");
-    }
+res::optional_t<sound_control_t::status_t>
+sound_control_t::get_playback_status() const {
+    SYST_API("sound_control_t::get_playback_status");
+    return syst::get_sound_status(
+      this->impl_->elem, playback_sound_api, this->impl_->playback);
+}
 
-    long value = syst::percent_to_value(min_value, max_value, volume);
-    snd_errno =
-      snd_mixer_selem_set_playback_volume_all(this->impl_->elem, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_playback_volume_all: " }
-          + snd_strerror(snd_errno));
-    }
+res::optional_t<sound_control_t::volume_t>
+sound_control_t::get_playback_volume() const {
+    SYST_API("sound_control_t::get_playback_volume");
+    return syst::get_sound_volume(
+      this->impl_->elem, playback_sound_api, this->impl_->playback);
+}
 
-    return res::success;
+res::optional_t<sound_control_t::db_range_t>
+sound_control_t::get_playback_db_range() const {
+    SYST_API("sound_control_t::get_playback_db_range");
+    return syst::get_sound_db_range(playback_sound_api, this->impl_->playback);
 }
 
-void set_channel_volume_relative(
-  std::optional<double>& volume, double relative_volume) {
-    if (volume.has_value()) {
-        volume.value() = std::clamp(volume.value() + relative_volume,
-          static_cast<double>(0.F),
-          static_cast<double>(100.F));
-    }
+res::optional_t<sound_control_t::status_t> sound_control_t::get_capture_status()
+  const {
+    SYST_API("sound_control_t::get_capture_status");
+    return syst::get_sound_status(
+      this->impl_->elem, capture_sound_api, this->impl_->capture);
 }
 
-res::result_t sound_control_t::set_playback_volume_all_relative(double volume) {
-    auto playback_volume = this->get_playback_volume();
-    if (playback_volume.has_error()) {
-        return RES_TRACE(playback_volume.error());
-    }
+res::optional_t<sound_control_t::volume_t> sound_control_t::get_capture_volume()
+  const {
+    SYST_API("sound_control_t::get_capture_volume");
+    return syst::get_sound_volume(
+      this->impl_->elem, capture_sound_api, this->impl_->capture);
+}
 
-    syst::set_channel_volume_relative(playback_volume->front_left, volume);
-    syst::set_channel_volume_relative(playback_volume->front_right, volume);
-    syst::set_channel_volume_relative(playback_volume->rear_left, volume);
-    syst::set_channel_volume_relative(playback_volume->rear_right, volume);
-    syst::set_channel_volume_relative(playback_volume->front_center, volume);
-    syst::set_channel_volume_relative(playback_volume->woofer, volume);
-    syst::set_channel_volume_relative(playback_volume->side_left, volume);
-    syst::set_channel_volume_relative(playback_volume->side_right, volume);
-    syst::set_channel_volume_relative(playback_volume->rear_center, volume);
-
-    auto result = this->set_playback_volume(playback_volume.value());
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
+res::optional_t<sound_control_t::db_range_t>
+sound_control_t::get_capture_db_range() const {
+    SYST_API("sound_control_t::get_capture_db_range");
+    return syst::get_sound_db_range(capture_sound_api, this->impl_->capture);
+}
 
-    return res::success;
+res::result_t sound_control_t::set_playback_status(const status_t& status) {
+    SYST_API("sound_control_t::set_playback_status");
+    return syst::set_sound_status(
+      this->impl_->elem, playback_sound_api, this->impl_->playback, status);
 }
 
-res::result_t set_channel_capture_status(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  const std::optional<bool>& status) {
-    if (! status.has_value()) {
-        return res::success;
-    }
+res::result_t sound_control_t::set_playback_status_all(bool status) {
+    SYST_API("sound_control_t::set_playback_status_all");
+    return syst::set_sound_status_all(
+      this->impl_->elem, playback_sound_api, status);
+}
 
-    if (snd_mixer_selem_has_capture_channel(control, channel) == 0) {
-        return res::success;
-    }
+res::result_t sound_control_t::toggle_playback_status() {
+    SYST_API("sound_control_t::toggle_playback_status");
+    return syst::toggle_sound_status(
+      this->impl_->elem, playback_sound_api, this->impl_->playback);
+}
 
-    int value = 0;
-    if (status.value()) {
-        value = 1;
-    }
+res::result_t sound_control_t::set_playback_volume(const volume_t& volume) {
+    SYST_API("sound_control_t::set_playback_volume");
+    return syst::set_sound_volume(
+      this->impl_->elem, playback_sound_api, this->impl_->playback, volume);
+}
 
-    int snd_errno = snd_mixer_selem_set_capture_switch(control, channel, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_capture_switch: " }
-          + snd_strerror(snd_errno));
-    }
+res::result_t sound_control_t::set_playback_volume_all(double volume) {
+    SYST_API("sound_control_t::set_playback_volume_all");
+    return syst::set_sound_volume_all(
+      this->impl_->elem, playback_sound_api, this->impl_->playback, volume);
+}
 
-    return res::success;
+res::result_t sound_control_t::set_playback_volume_all_relative(double volume) {
+    SYST_API("sound_control_t::set_playback_volume_all_relative");
+    return syst::set_sound_volume_all_relative(
+      this->impl_->elem, playback_sound_api, this->impl_->playback, volume);
 }
 
 res::result_t sound_control_t::set_capture_status(const status_t& status) {
-    res::result_t result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_LEFT, status.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_RIGHT, status.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_LEFT, status.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_RIGHT, status.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_FRONT_CENTER, status.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_WOOFER, status.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_LEFT, status.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_SIDE_RIGHT, status.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_status(
-      this->impl_->elem, SND_MIXER_SCHN_REAR_CENTER, status.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::set_capture_status");
+    return syst::set_sound_status(
+      this->impl_->elem, capture_sound_api, this->impl_->capture, status);
 }
 
 res::result_t sound_control_t::set_capture_status_all(bool status) {
-    int value = 0;
-    if (status) {
-        value = 1;
-    }
-
-    int snd_errno =
-      snd_mixer_selem_set_capture_switch_all(this->impl_->elem, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_capture_switch_all: " }
-          + snd_strerror(snd_errno));
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::set_capture_status_all");
+    return syst::set_sound_status_all(
+      this->impl_->elem, capture_sound_api, status);
 }
 
 res::result_t sound_control_t::toggle_capture_status() {
-    auto status = this->get_capture_status();
-    if (status.has_error()) {
-        return RES_TRACE(status.error());
-    }
-
-    auto new_status = syst::toggle_status(status.value());
-
-    auto result = this->set_capture_status(new_status);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
-}
-
-res::result_t set_channel_capture_volume(snd_mixer_elem_t* control,
-  snd_mixer_selem_channel_id_t channel,
-  long min_value,
-  long max_value,
-  const std::optional<double>& status) {
-    if (! status.has_value()) {
-        return res::success;
-    }
-
-    if (snd_mixer_selem_has_capture_channel(control, channel) == 0) {
-        return res::success;
-    }
-
-    if (status.value() < static_cast<double>(0)
-      || status.value() > static_cast<double>(100)) {
-        return RES_NEW_ERROR(
-          "The new status given for the capture volume is out of "
-          "bounds.\n\tstatus: '"
-          + std::to_string(status.value()) + "'");
-    }
-
-    long value = syst::percent_to_value(min_value, max_value, status.value());
-    int snd_errno = snd_mixer_selem_set_capture_volume(control, channel, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_capture_volume: " }
-          + snd_strerror(snd_errno));
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::toggle_capture_status");
+    return syst::toggle_sound_status(
+      this->impl_->elem, capture_sound_api, this->impl_->capture);
 }
 
 res::result_t sound_control_t::set_capture_volume(const volume_t& volume) {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_capture_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_capture_volume_range: " }
-          + snd_strerror(snd_errno));
-    }
-
-    res::result_t result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_LEFT,
-      min_value,
-      max_value,
-      volume.front_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_RIGHT,
-      min_value,
-      max_value,
-      volume.front_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_LEFT,
-      min_value,
-      max_value,
-      volume.rear_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_RIGHT,
-      min_value,
-      max_value,
-      volume.rear_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_FRONT_CENTER,
-      min_value,
-      max_value,
-      volume.front_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_WOOFER,
-      min_value,
-      max_value,
-      volume.woofer);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_LEFT,
-      min_value,
-      max_value,
-      volume.side_left);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_SIDE_RIGHT,
-      min_value,
-      max_value,
-      volume.side_right);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    result = syst::set_channel_capture_volume(this->impl_->elem,
-      SND_MIXER_SCHN_REAR_CENTER,
-      min_value,
-      max_value,
-      volume.rear_center);
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::set_capture_volume");
+    return syst::set_sound_volume(
+      this->impl_->elem, capture_sound_api, this->impl_->capture, volume);
 }
 
 res::result_t sound_control_t::set_capture_volume_all(double volume) {
-    long max_value = 0;
-    long min_value = 0;
-    int snd_errno = snd_mixer_selem_get_capture_volume_range(
-      this->impl_->elem, &min_value, &max_value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{
-            "ALSA error: snd_mixer_selem_get_capture_volume_range: " }
-          + snd_strerror(snd_errno));
-    }
-
-    if (volume < static_cast<double>(0) || volume > static_cast<double>(100)) {
-        return RES_NEW_ERROR(
-          "The new status given for the capture volume is out of "
-          "bounds.\n\tstatus: '"
-          + std::to_string(volume) + "'");
-    }
-
-    long value = syst::percent_to_value(min_value, max_value, volume);
-    snd_errno =
-      snd_mixer_selem_set_capture_volume_all(this->impl_->elem, value);
-    if (snd_errno != 0) {
-        return RES_NEW_ERROR(
-          std::string{ "ALSA error: snd_mixer_selem_set_capture_volume_all: " }
-          + snd_strerror(snd_errno));
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::set_capture_volume_all");
+    return syst::set_sound_volume_all(
+      this->impl_->elem, capture_sound_api, this->impl_->capture, volume);
 }
 
 res::result_t sound_control_t::set_capture_volume_all_relative(double volume) {
-    auto capture_volume = this->get_capture_volume();
-    if (capture_volume.has_error()) {
-        return RES_TRACE(capture_volume.error());
-    }
-
-    syst::set_channel_volume_relative(capture_volume->front_left, volume);
-    syst::set_channel_volume_relative(capture_volume->front_right, volume);
-    syst::set_channel_volume_relative(capture_volume->rear_left, volume);
-    syst::set_channel_volume_relative(capture_volume->rear_right, volume);
-    syst::set_channel_volume_relative(capture_volume->front_center, volume);
-    syst::set_channel_volume_relative(capture_volume->woofer, volume);
-    syst::set_channel_volume_relative(capture_volume->side_left, volume);
-    syst::set_channel_volume_relative(capture_volume->side_right, volume);
-    syst::set_channel_volume_relative(capture_volume->rear_center, volume);
-
-    auto result = this->set_capture_volume(capture_volume.value());
-    if (result.failure()) {
-        return RES_TRACE(result.error());
-    }
-
-    return res::success;
+    SYST_API("sound_control_t::set_capture_volume_all_relative");
+    return syst::set_sound_volume_all_relative(
+      this->impl_->elem, capture_sound_api, this->impl_->capture, volume);
 }
 
 } // namespace syst
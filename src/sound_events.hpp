@@ -0,0 +1,100 @@
+#pragma once
+
+// Standard includes
+#include <optional>
+#include <string>
+#include <vector>
+
+// External includes
+#include <alsa/asoundlib.h>
+#include <cpp_result/all.hpp>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+
+namespace syst {
+
+struct pending_sound_event_t {
+    snd_mixer_elem_t* elem;
+    sound_event_t::type_t type;
+
+    // Captured when the event is received since removed elements are freed
+    // before the event is dispatched.
+    std::string name;
+    unsigned int index;
+};
+
+/**
+ * @brief Set a state of a sound event if it was read.
+ *
+ * @param[in] value - The state read from the control element.
+ * @param[out] state - The state of the event, left empty if the read failed.
+ */
+template<typename state_t>
+void set_sound_event_state(
+  res::optional_t<state_t>&& value, std::optional<state_t>& state) {
+    if (value.has_value()) {
+        state = std::move(value.value());
+    }
+}
+
+/**
+ * @brief Turn the changes queued by the ALSA callbacks of a mixer into events
+ * with the new state of each control element. A state that fails to be read
+ * is left empty, so a failed read never loses an event that was already
+ * dequeued.
+ *
+ * @param[in,out] pending - The queued changes in the order they were received.
+ * @param[in] find_control - Returns the control element with the given name
+ * and index or null if it does not exist anymore.
+ * @return one event for each queued change.
+ */
+template<typename find_control_t>
+[[nodiscard]] std::vector<sound_event_t> make_sound_events(
+  std::vector<pending_sound_event_t>& pending,
+  const find_control_t& find_control) {
+    std::vector<sound_event_t> events;
+    events.reserve(pending.size());
+
+    for (pending_sound_event_t& pending_event : pending) {
+        sound_event_t event{};
+        event.type = pending_event.type;
+        event.name = std::move(pending_event.name);
+        event.index = pending_event.index;
+
+        if (pending_event.type == sound_event_t::type_t::removed) {
+            events.push_back(std::move(event));
+            continue;
+        }
+
+        // Reuses the cached channels and ranges of the control element.
+        const auto* control = find_control(event.name, event.index);
+        if (control == nullptr) {
+            events.push_back(std::move(event));
+            continue;
+        }
+
+        if (control->has_playback_status()) {
+            syst::set_sound_event_state(
+              control->get_playback_status(), event.playback_status);
+        }
+        if (control->has_playback_volume()) {
+            syst::set_sound_event_state(
+              control->get_playback_volume(), event.playback_volume);
+        }
+        if (control->has_capture_status()) {
+            syst::set_sound_event_state(
+              control->get_capture_status(), event.capture_status);
+        }
+        if (control->has_capture_volume()) {
+            syst::set_sound_event_state(
+              control->get_capture_volume(), event.capture_volume);
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    return events;
+}
+
+} // namespace syst
@@ -0,0 +1,755 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+// External includes
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+enum class sound_command_type_t {
+    get_volume,
+    set_volume_all,
+    set_volume_all_relative,
+    ramp_volume_all,
+    get_status,
+    set_status_all,
+    toggle_status,
+    submit,
+};
+
+struct sound_command_t {
+    // The command that was pushed before this one.
+    sound_command_t* next = nullptr;
+
+    sound_command_type_t type = sound_command_type_t::submit;
+    bool playback = true;
+    std::string name;
+    unsigned int index = 0;
+
+    // Arguments (depending on the type of the command).
+    double volume = 0;
+    bool status = false;
+    ch::nanoseconds duration{};
+    std::function<void(sound_mixer_t&)> function;
+
+    std::variant<std::promise<res::result_t>,
+      std::promise<res::optional_t<sound_control_t::volume_t>>,
+      std::promise<res::optional_t<sound_control_t::status_t>>,
+      std::promise<void>>
+      promise;
+};
+
+struct sound_ramp_t {
+    bool playback;
+    std::string name;
+    unsigned int index;
+
+    // The control element changed by the ramp engine.
+    sound_control_t* control;
+
+    std::promise<res::result_t> promise;
+};
+
+struct sound_worker_state_t {
+    // Commands are pushed by any thread (newest first) and the worker thread
+    // takes the whole list at once, so the queue is not affected by the ABA
+    // problem.
+    std::atomic<sound_command_t*> queue = nullptr;
+
+    // Becomes readable when a command is pushed onto an empty queue.
+    fd_t wakeup;
+
+    std::atomic<bool> running = true;
+
+    // Set once the worker thread exits because it can no longer wait for
+    // commands. The error is written before the flag and never changes after.
+    std::atomic<bool> failed = false;
+    std::optional<res::error_t> error;
+
+    // Only accessed by the worker thread.
+    ramp_engine_t engine;
+    std::unordered_map<uint64_t, sound_ramp_t> ramps;
+};
+
+void wake_sound_worker(sound_worker_state_t& state) {
+    // Writes to an eventfd only fail if the counter would overflow, in which
+    // case the worker is already awake.
+    const uint64_t increment = 1;
+    ssize_t len = write(state.wakeup.get(), &increment, sizeof(increment));
+    static_cast<void>(len);
+}
+
+struct sound_worker_t::impl_t {
+    sound_worker_state_t state;
+    std::thread thread;
+
+    impl_t() = default;
+    impl_t(const impl_t&) = delete;
+    impl_t(impl_t&&) noexcept = delete;
+    impl_t& operator=(const impl_t&) = delete;
+    impl_t& operator=(impl_t&&) noexcept = delete;
+
+    ~impl_t() {
+        if (! this->thread.joinable()) {
+            return;
+        }
+
+        this->state.running = false;
+        syst::wake_sound_worker(this->state);
+        this->thread.join();
+    }
+};
+
+void push_sound_command(
+  sound_worker_state_t& state, std::unique_ptr<sound_command_t>&& command) {
+    sound_command_t* node = command.release();
+    sound_command_t* head = state.queue.load(std::memory_order_relaxed);
+
+    do {
+        node->next = head;
+    } while (! state.queue.compare_exchange_weak(
+      head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    // The worker takes every queued command when it wakes up, so it only
+    // needs to be woken for the first command.
+    if (head == nullptr) {
+        syst::wake_sound_worker(state);
+    }
+}
+
+[[nodiscard]] std::vector<std::unique_ptr<sound_command_t>> take_sound_commands(
+  sound_worker_state_t& state) {
+    sound_command_t* head =
+      state.queue.exchange(nullptr, std::memory_order_acquire);
+
+    std::vector<std::unique_ptr<sound_command_t>> commands;
+    while (head != nullptr) {
+        sound_command_t* next = head->next;
+        commands.emplace_back(head);
+        head = next;
+    }
+
+    // The queue is newest first.
+    std::reverse(commands.begin(), commands.end());
+    return commands;
+}
+
+[[nodiscard]] std::unique_ptr<sound_command_t> make_sound_command(
+  sound_command_type_t type,
+  bool playback,
+  const std::string& name,
+  unsigned int index) {
+    auto command = std::make_unique<sound_command_t>();
+    command->type = type;
+    command->playback = playback;
+    command->name = name;
+    command->index = index;
+    return command;
+}
+
+void fail_sound_commands(sound_worker_state_t& state) {
+    const res::error_t& error = state.error.value();
+
+    for (auto& command : syst::take_sound_commands(state)) {
+        std::visit(
+          [&error](auto& promise) {
+              using promise_t = std::decay_t<decltype(promise)>;
+              if constexpr (std::is_same_v<promise_t, std::promise<void>>) {
+                  promise.set_exception(std::make_exception_ptr(
+                    std::runtime_error{ error.string() }));
+              } else {
+                  promise.set_value(RES_TRACE(error));
+              }
+          },
+          command->promise);
+    }
+}
+
+template<typename value_t>
+[[nodiscard]] std::future<value_t> submit_sound_command(
+  sound_worker_state_t& state, std::unique_ptr<sound_command_t>&& command) {
+    std::future<value_t> future =
+      command->promise.template emplace<std::promise<value_t>>().get_future();
+    syst::push_sound_command(state, std::move(command));
+
+    // Either the worker takes this command after it failed or this thread
+    // sees that it failed, so no command is left in the queue.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (state.failed.load(std::memory_order_acquire)) {
+        syst::fail_sound_commands(state);
+    }
+
+    return future;
+}
+
+[[nodiscard]] res::optional_t<sound_control_t*> find_sound_control(
+  sound_mixer_t& mixer, const std::string& name, unsigned int index) {
+    sound_control_t* control = mixer.find_control(name, index);
+    if (control == nullptr) {
+        return RES_NEW_ERROR(
+          "The sound control element does not exist.\n\tname: '" + name
+          + "'\n\tindex: '" + std::to_string(index) + "'");
+    }
+
+    return control;
+}
+
+[[nodiscard]] res::result_t set_worker_volume_all(
+  sound_control_t& control, bool playback, double volume) {
+    if (playback) {
+        return control.set_playback_volume_all(volume);
+    }
+    return control.set_capture_volume_all(volume);
+}
+
+[[nodiscard]] res::optional_t<sound_control_t::volume_t> get_worker_volume(
+  const sound_control_t& control, bool playback) {
+    if (playback) {
+        return control.get_playback_volume();
+    }
+    return control.get_capture_volume();
+}
+
+void cancel_sound_ramp(sound_worker_state_t& state,
+  bool playback,
+  const std::string& name,
+  unsigned int index) {
+    auto ramp = std::find_if(state.ramps.begin(),
+      state.ramps.end(),
+      [&](const auto& ramp) {
+          return ramp.second.playback == playback
+            && ramp.second.index == index && ramp.second.name == name;
+      });
+    if (ramp == state.ramps.end()) {
+        return;
+    }
+
+    state.engine.cancel(ramp->first);
+    ramp->second.promise.set_value(RES_NEW_ERROR(
+      "The volume ramp was cancelled.\n\tname: '" + name + "'\n\tindex: '"
+      + std::to_string(index) + "'"));
+    state.ramps.erase(ramp);
+}
+
+void finish_sound_ramps(sound_worker_state_t& state) {
+    for (ramp_event_t& event : state.engine.take_events()) {
+        auto ramp = state.ramps.find(event.ramp);
+        if (ramp == state.ramps.end()) {
+            continue;
+        }
+
+        if (event.type == ramp_event_t::type_t::finished) {
+            ramp->second.promise.set_value(res::success);
+        } else if (event.error.has_value()) {
+            ramp->second.promise.set_value(RES_TRACE(event.error.value()));
+        } else {
+            ramp->second.promise.set_value(
+              RES_NEW_ERROR("The volume ramp was cancelled.\n\tname: '"
+                + ramp->second.name + "'\n\tindex: '"
+                + std::to_string(ramp->second.index) + "'"));
+        }
+        state.ramps.erase(ramp);
+    }
+}
+
+void prune_sound_ramps(sound_worker_state_t& state, sound_mixer_t& mixer) {
+    // Control elements are destroyed when they are removed from the mixer, so
+    // ramps of removed control elements must be stopped before the engine
+    // writes to them again.
+    for (auto ramp = state.ramps.begin(); ramp != state.ramps.end();) {
+        if (mixer.find_control(ramp->second.name, ramp->second.index)
+          == ramp->second.control) {
+            ++ramp;
+            continue;
+        }
+
+        state.engine.cancel(ramp->first);
+        ramp->second.promise.set_value(RES_NEW_ERROR(
+          "The sound control element was removed during a volume ramp."
+          "\n\tname: '"
+          + ramp->second.name + "'\n\tindex: '"
+          + std::to_string(ramp->second.index) + "'"));
+        ramp = state.ramps.erase(ramp);
+    }
+}
+
+[[nodiscard]] res::result_t start_sound_ramp(sound_worker_state_t& state,
+  sound_mixer_t& mixer,
+  sound_command_t& command) {
+    syst::cancel_sound_ramp(
+      state, command.playback, command.name, command.index);
+
+    auto control =
+      syst::find_sound_control(mixer, command.name, command.index);
+    if (control.has_error()) {
+        return RES_TRACE(control.error());
+    }
+
+    auto ramp = command.playback
+      ? state.engine.ramp_playback_volume(
+        *control.value(), command.volume, command.duration)
+      : state.engine.ramp_capture_volume(
+        *control.value(), command.volume, command.duration);
+    if (ramp.has_error()) {
+        return RES_TRACE(ramp.error());
+    }
+
+    // Ramps without a duration finish immediately and are reported by the
+    // next call to 'finish_sound_ramps'.
+    state.ramps.emplace(ramp.value(),
+      sound_ramp_t{ command.playback,
+        command.name,
+        command.index,
+        control.value(),
+        std::move(std::get<std::promise<res::result_t>>(command.promise)) });
+
+    return res::success;
+}
+
+[[nodiscard]] res::result_t run_sound_command(
+  sound_worker_state_t& state, sound_mixer_t& mixer, sound_command_t& command) {
+    auto control =
+      syst::find_sound_control(mixer, command.name, command.index);
+    if (control.has_error()) {
+        return RES_TRACE(control.error());
+    }
+
+    sound_control_t& sound_control = *control.value();
+
+    switch (command.type) {
+        case sound_command_type_t::set_volume_all:
+            syst::cancel_sound_ramp(
+              state, command.playback, command.name, command.index);
+            return syst::set_worker_volume_all(
+              sound_control, command.playback, command.volume);
+
+        case sound_command_type_t::set_volume_all_relative:
+            syst::cancel_sound_ramp(
+              state, command.playback, command.name, command.index);
+            if (command.playback) {
+                return sound_control.set_playback_volume_all_relative(
+                  command.volume);
+            }
+            return sound_control.set_capture_volume_all_relative(
+              command.volume);
+
+        case sound_command_type_t::set_status_all:
+            if (command.playback) {
+                return sound_control.set_playback_status_all(command.status);
+            }
+            return sound_control.set_capture_status_all(command.status);
+
+        case sound_command_type_t::toggle_status:
+            if (command.playback) {
+                return sound_control.toggle_playback_status();
+            }
+            return sound_control.toggle_capture_status();
+
+        default:
+            return RES_NEW_ERROR("Unexpected sound command.");
+    }
+}
+
+void run_sound_commands(sound_worker_state_t& state, sound_mixer_t& mixer) {
+    auto commands = syst::take_sound_commands(state);
+
+    for (size_t index = 0; index < commands.size();) {
+        sound_command_t& command = *commands[index];
+
+        switch (command.type) {
+            case sound_command_type_t::get_volume: {
+                auto control =
+                  syst::find_sound_control(mixer, command.name, command.index);
+                auto& promise = std::get<
+                  std::promise<res::optional_t<sound_control_t::volume_t>>>(
+                  command.promise);
+                if (control.has_error()) {
+                    promise.set_value(RES_TRACE(control.error()));
+                } else {
+                    promise.set_value(syst::get_worker_volume(
+                      *control.value(), command.playback));
+                }
+                ++index;
+                continue;
+            }
+
+            case sound_command_type_t::get_status: {
+                auto control =
+                  syst::find_sound_control(mixer, command.name, command.index);
+                auto& promise = std::get<
+                  std::promise<res::optional_t<sound_control_t::status_t>>>(
+                  command.promise);
+                if (control.has_error()) {
+                    promise.set_value(RES_TRACE(control.error()));
+                } else if (command.playback) {
+                    promise.set_value(control.value()->get_playback_status());
+                } else {
+                    promise.set_value(control.value()->get_capture_status());
+                }
+                ++index;
+                continue;
+            }
+
+            case sound_command_type_t::ramp_volume_all: {
+                res::result_t result =
+                  syst::start_sound_ramp(state, mixer, command);
+                // The promise was moved into the ramp if it was started.
+                if (result.failure()) {
+                    std::get<std::promise<res::result_t>>(command.promise)
+                      .set_value(std::move(result));
+                }
+                ++index;
+                continue;
+            }
+
+            case sound_command_type_t::submit: {
+                auto& promise = std::get<std::promise<void>>(command.promise);
+                // The function is not part of this library, so any exception
+                // it throws is passed on to the caller.
+                try {
+                    command.function(mixer);
+                    promise.set_value();
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
+                }
+                // The function may have dispatched events of the mixer.
+                syst::prune_sound_ramps(state, mixer);
+                ++index;
+                continue;
+            }
+
+            default:
+                break;
+        }
+
+        // Consecutive relative changes to the same control element are
+        // combined into a single write.
+        size_t end = index + 1;
+        if (command.type == sound_command_type_t::set_volume_all_relative) {
+            while (end < commands.size()
+              && commands[end]->type == command.type
+              && commands[end]->playback == command.playback
+              && commands[end]->index == command.index
+              && commands[end]->name == command.name) {
+                command.volume += commands[end]->volume;
+                ++end;
+            }
+        }
+
+        res::result_t result = syst::run_sound_command(state, mixer, command);
+
+        for (; index < end; ++index) {
+            auto& promise =
+              std::get<std::promise<res::result_t>>(commands[index]->promise);
+            if (result.success()) {
+                promise.set_value(res::success);
+            } else {
+                promise.set_value(RES_TRACE(result.error()));
+            }
+        }
+    }
+}
+
+void run_sound_worker(sound_worker_state_t& state,
+  const std::string& device,
+  std::promise<res::result_t>& started) {
+    // The mixer is opened by the worker thread so that it is never accessed by
+    // any other thread.
+    auto mixer = syst::get_sound_mixer(device);
+    if (mixer.has_error()) {
+        started.set_value(RES_TRACE(mixer.error()));
+        return;
+    }
+
+    auto result = state.engine.start();
+    if (result.failure()) {
+        started.set_value(RES_TRACE(result.error()));
+        return;
+    }
+
+    started.set_value(res::success);
+
+    while (true) {
+        std::array<struct pollfd, 3> poll_fds{};
+        poll_fds[0].fd = state.wakeup.get();
+        poll_fds[0].events = POLLIN;
+        poll_fds[1].fd = mixer->get_fd();
+        poll_fds[1].events = POLLIN;
+        poll_fds[2].fd = state.engine.get_fd();
+        poll_fds[2].events = POLLIN;
+
+        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+
+            // The worker cannot wait for commands anymore. Every queued and
+            // future command fails with the same error.
+            state.error = RES_NEW_ERROR(
+              "Failed to wait for the sound worker.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+            state.failed.store(true, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            syst::fail_sound_commands(state);
+            break;
+        }
+
+        if (poll_fds[1].revents != 0) {
+            // Refresh the values cached by ALSA. The events themselves are not
+            // needed.
+            auto events = mixer->dispatch();
+            static_cast<void>(events);
+            syst::prune_sound_ramps(state, mixer.value());
+        }
+
+        if (poll_fds[0].revents != 0) {
+            uint64_t count = 0;
+            ssize_t len = read(state.wakeup.get(), &count, sizeof(count));
+            static_cast<void>(len);
+
+            syst::run_sound_commands(state, mixer.value());
+        }
+
+        if (poll_fds[2].revents != 0) {
+            // Errors writing a single ramp are reported by its event.
+            auto result = state.engine.dispatch();
+            static_cast<void>(result);
+        }
+
+        syst::finish_sound_ramps(state);
+
+        if (! state.running) {
+            break;
+        }
+    }
+
+    // Commands pushed before the worker was stopped are still executed.
+    if (! state.failed.load(std::memory_order_relaxed)) {
+        syst::run_sound_commands(state, mixer.value());
+    }
+    syst::finish_sound_ramps(state);
+
+    for (auto& [id, ramp] : state.ramps) {
+        state.engine.cancel(id);
+        if (state.failed.load(std::memory_order_relaxed)) {
+            ramp.promise.set_value(RES_TRACE(state.error.value()));
+            continue;
+        }
+        ramp.promise.set_value(RES_NEW_ERROR(
+          "The volume ramp was cancelled because the sound worker stopped."
+          "\n\tname: '"
+          + ramp.name + "'\n\tindex: '" + std::to_string(ramp.index) + "'"));
+    }
+    state.ramps.clear();
+}
+
+res::optional_t<sound_worker_t> get_sound_worker(const std::string& device) {
+    SYST_API("get_sound_worker");
+    auto impl = std::make_unique<sound_worker_t::impl_t>();
+
+    impl->state.wakeup = fd_t{ eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) };
+    if (! impl->state.wakeup.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create an eventfd for a sound worker.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    std::promise<res::result_t> started;
+    std::future<res::result_t> started_future = started.get_future();
+
+    sound_worker_state_t* state = &impl->state;
+    impl->thread = std::thread{ [state, device, &started]() {
+        syst::run_sound_worker(*state, device, started);
+    } };
+
+    res::result_t result = started_future.get();
+    if (result.failure()) {
+        impl->thread.join();
+        return RES_TRACE(result.error());
+    }
+
+    return sound_worker_t{ std::move(impl) };
+}
+
+sound_worker_t::sound_worker_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+sound_worker_t::sound_worker_t(sound_worker_t&&) noexcept = default;
+
+sound_worker_t& sound_worker_t::operator=(sound_worker_t&&) noexcept = default;
+
+sound_worker_t::~sound_worker_t() = default;
+
+std::future<res::optional_t<sound_control_t::volume_t>>
+sound_worker_t::get_playback_volume(const std::string& name,
+  unsigned int index) {
+    SYST_API("sound_worker_t::get_playback_volume");
+    return syst::submit_sound_command<
+      res::optional_t<sound_control_t::volume_t>>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::get_volume, true, name, index));
+}
+
+std::future<res::result_t> sound_worker_t::set_playback_volume_all(
+  const std::string& name, unsigned int index, double volume) {
+    SYST_API("sound_worker_t::set_playback_volume_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_volume_all, true, name, index);
+    command->volume = volume;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::set_playback_volume_all_relative(
+  const std::string& name, unsigned int index, double volume) {
+    SYST_API("sound_worker_t::set_playback_volume_all_relative");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_volume_all_relative, true, name, index);
+    command->volume = volume;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::ramp_playback_volume_all(
+  const std::string& name,
+  unsigned int index,
+  double volume,
+  ch::nanoseconds duration) {
+    SYST_API("sound_worker_t::ramp_playback_volume_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::ramp_volume_all, true, name, index);
+    command->volume = volume;
+    command->duration = duration;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::optional_t<sound_control_t::status_t>>
+sound_worker_t::get_playback_status(const std::string& name,
+  unsigned int index) {
+    SYST_API("sound_worker_t::get_playback_status");
+    return syst::submit_sound_command<
+      res::optional_t<sound_control_t::status_t>>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::get_status, true, name, index));
+}
+
+std::future<res::result_t> sound_worker_t::set_playback_status_all(
+  const std::string& name, unsigned int index, bool status) {
+    SYST_API("sound_worker_t::set_playback_status_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_status_all, true, name, index);
+    command->status = status;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::toggle_playback_status(
+  const std::string& name, unsigned int index) {
+    SYST_API("sound_worker_t::toggle_playback_status");
+    return syst::submit_sound_command<res::result_t>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::toggle_status, true, name, index));
+}
+
+std::future<res::optional_t<sound_control_t::volume_t>>
+sound_worker_t::get_capture_volume(const std::string& name,
+  unsigned int index) {
+    SYST_API("sound_worker_t::get_capture_volume");
+    return syst::submit_sound_command<
+      res::optional_t<sound_control_t::volume_t>>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::get_volume, false, name, index));
+}
+
+std::future<res::result_t> sound_worker_t::set_capture_volume_all(
+  const std::string& name, unsigned int index, double volume) {
+    SYST_API("sound_worker_t::set_capture_volume_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_volume_all, false, name, index);
+    command->volume = volume;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::set_capture_volume_all_relative(
+  const std::string& name, unsigned int index, double volume) {
+    SYST_API("sound_worker_t::set_capture_volume_all_relative");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_volume_all_relative, false, name, index);
+    command->volume = volume;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::ramp_capture_volume_all(
+  const std::string& name,
+  unsigned int index,
+  double volume,
+  ch::nanoseconds duration) {
+    SYST_API("sound_worker_t::ramp_capture_volume_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::ramp_volume_all, false, name, index);
+    command->volume = volume;
+    command->duration = duration;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::optional_t<sound_control_t::status_t>>
+sound_worker_t::get_capture_status(const std::string& name,
+  unsigned int index) {
+    SYST_API("sound_worker_t::get_capture_status");
+    return syst::submit_sound_command<
+      res::optional_t<sound_control_t::status_t>>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::get_status, false, name, index));
+}
+
+std::future<res::result_t> sound_worker_t::set_capture_status_all(
+  const std::string& name, unsigned int index, bool status) {
+    SYST_API("sound_worker_t::set_capture_status_all");
+    auto command = syst::make_sound_command(
+      sound_command_type_t::set_status_all, false, name, index);
+    command->status = status;
+    return syst::submit_sound_command<res::result_t>(
+      this->impl_->state, std::move(command));
+}
+
+std::future<res::result_t> sound_worker_t::toggle_capture_status(
+  const std::string& name, unsigned int index) {
+    SYST_API("sound_worker_t::toggle_capture_status");
+    return syst::submit_sound_command<res::result_t>(this->impl_->state,
+      syst::make_sound_command(
+        sound_command_type_t::toggle_status, false, name, index));
+}
+
+std::future<void> sound_worker_t::submit(
+  std::function<void(sound_mixer_t&)> function) {
+    auto command = std::make_unique<sound_command_t>();
+    command->type = sound_command_type_t::submit;
+    command->function = std::move(function);
+    return syst::submit_sound_command<void>(
+      this->impl_->state, std::move(command));
+}
+
+} // namespace syst
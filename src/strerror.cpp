@@ -13,8 +13,10 @@ namespace syst {
 
 char* strerror(int errnum) {
     const size_t max_len = 100;
-    char* buffer = nullptr;
-    strerror_r(errnum, buffer, max_len);
+    thread_local char buffer[max_len];
+    if (strerror_r(errnum, buffer, max_len) != 0) {
+        buffer[0] = '\0';
+    }
     return buffer;
 }
 
@@ -1,11 +1,14 @@
 // Standard includes
 #include <cstring>
+#include <sstream>
 
 // External includes
 #include <sys/sysinfo.h>
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "roots.hpp"
 #include "util.hpp"
 #include "strerror.hpp"
 
@@ -27,7 +30,127 @@ template<typename integral_lhs_t, typename integral_rhs_t>
     return static_cast<uint64_t>(mem) * static_cast<uint64_t>(mem_unit);
 }
 
+/**
+ * @brief Read the first line of a procfs file.
+ *
+ * @param[in] proc_root - The root that procfs paths are resolved against.
+ * @param[in] path - The path to the file relative to the root.
+ * @return the first line of the file if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<std::string> get_first_line_in(
+  const root_t& proc_root, const fs::path& path) {
+    auto lines = syst::get_all_lines_in(proc_root, path);
+    if (lines.has_error()) {
+        return RES_TRACE(lines.error());
+    }
+    if (lines->empty()) {
+        return RES_NEW_ERROR("The file is empty.\n\tfile: '"
+          + (proc_root.path / path).string() + "'");
+    }
+
+    return lines->front();
+}
+
+/**
+ * @brief Get system information from the uptime, loadavg, and meminfo files
+ * of a procfs root that is not the one of this system, which sysinfo(2)
+ * cannot read from.
+ *
+ * @param[in] proc_root - The root that procfs paths are resolved against.
+ * @return system information if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<system_info_t> get_system_info_in(
+  const root_t& proc_root) {
+    // documentation for /proc/uptime, /proc/loadavg, and /proc/meminfo
+    //     https://www.kernel.org/doc/html/latest/filesystems/proc.html
+
+    system_info_t system_info{};
+
+    auto uptime_line = syst::get_first_line_in(proc_root, "uptime");
+    if (uptime_line.has_error()) {
+        return RES_TRACE(uptime_line.error());
+    }
+
+    std::istringstream uptime_stream{ uptime_line.value() };
+    double uptime = 0;
+    if ((uptime_stream >> uptime).fail()) {
+        return RES_NEW_ERROR("Failed to read the uptime.\n\tfile: '"
+          + (proc_root.path / "uptime").string() + "'");
+    }
+    system_info.uptime = ch::seconds(static_cast<int64_t>(uptime));
+
+    auto load_line = syst::get_first_line_in(proc_root, "loadavg");
+    if (load_line.has_error()) {
+        return RES_TRACE(load_line.error());
+    }
+
+    // The fourth field is the number of runnable scheduling entities and
+    // the total number of them, which sysinfo(2) reports as 'procs'.
+    std::istringstream load_stream{ load_line.value() };
+    uint64_t running = 0;
+    char separator = 0;
+    if ((load_stream >> system_info.load_1 >> system_info.load_5
+          >> system_info.load_15 >> running >> separator >> system_info.procs)
+          .fail()
+      || separator != '/') {
+        return RES_NEW_ERROR("Failed to read the load averages.\n\tfile: '"
+          + (proc_root.path / "loadavg").string() + "'");
+    }
+
+    auto lines = syst::get_all_lines_in(proc_root, "meminfo");
+    if (lines.has_error()) {
+        return RES_TRACE(lines.error());
+    }
+
+    // Each line is '<name>: <value> kB'. Missing fields are left as zero.
+    for (const std::string& line : lines.value()) {
+        std::istringstream stream{ line };
+        std::string name;
+        uint64_t kibibytes = 0;
+        if ((stream >> name >> kibibytes).fail()) {
+            continue;
+        }
+
+        const uint64_t bytes = mem_to_bytes(kibibytes, 1024);
+        if (name == "MemTotal:") {
+            system_info.ram_total = bytes;
+        } else if (name == "MemFree:") {
+            system_info.ram_free = bytes;
+        } else if (name == "Shmem:") {
+            system_info.ram_shared = bytes;
+        } else if (name == "Buffers:") {
+            system_info.ram_buffered = bytes;
+        } else if (name == "SwapTotal:") {
+            system_info.swap_total = bytes;
+        } else if (name == "SwapFree:") {
+            system_info.swap_free = bytes;
+        }
+    }
+
+    system_info.ram_usage = ratio_to_percent(
+      system_info.ram_total - system_info.ram_free, system_info.ram_total);
+    system_info.swap_usage = ratio_to_percent(
+      system_info.swap_total - system_info.swap_free, system_info.swap_total);
+
+    return system_info;
+}
+
 res::optional_t<system_info_t> get_system_info() {
+    SYST_API("get_system_info");
+    auto proc = syst::get_proc_root();
+    if (proc.has_error()) {
+        return RES_TRACE(proc.error());
+    }
+
+    // sysinfo(2) always describes this system, so other procfs roots are
+    // read from their files instead.
+    const root_t& proc_root = *proc.value();
+    if (proc_root.path != roots_t{}.proc) {
+        return syst::get_system_info_in(proc_root);
+    }
+
     struct sysinfo raw_info{};
     if (sysinfo(&raw_info) != 0) {
         int err = errno;
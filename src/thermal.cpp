@@ -3,46 +3,57 @@
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "devices.hpp"
+#include "instrument.hpp"
 #include "util.hpp"
 
 namespace syst {
 
-thermal_zone_t::thermal_zone_t(const fs::path& sysfs_path)
-: sysfs_path_(sysfs_path) {
+thermal_zone_t::thermal_zone_t(const fs::path& sysfs_path,
+  std::shared_ptr<const fd_t> dir,
+  const capabilities_t& capabilities)
+: sysfs_path_(sysfs_path), dir_(std::move(dir)), capabilities_(capabilities) {
 }
 
-res::optional_t<std::vector<thermal_zone_t>> get_thermal_zones() {
-    // documentation for /sys/class/thermal
-    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
-    //     https://www.kernel.org/doc/html/latest/driver-api/thermal/sysfs-api.html
+res::result_t append_thermal_zone(
+  const class_entry_t& entry, std::vector<thermal_zone_t>& thermal_zones) {
+    auto dir = syst::open_device_dir(&entry.dir, entry.name.data());
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
 
-    const std::string thermal_path = "/sys/class/thermal";
+    thermal_zone_t::capabilities_t capabilities{};
+    capabilities.temperature = syst::has_attribute_at(*dir.value(), "temp");
 
-    if (! fs::is_directory(thermal_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + thermal_path + "'");
+    // Trip points are numbered consecutively starting from zero.
+    while (syst::has_attribute_at(*dir.value(),
+      ("trip_point_" + std::to_string(capabilities.trip_points) + "_temp")
+        .c_str())) {
+        ++capabilities.trip_points;
     }
 
+    thermal_zones.push_back(thermal_zone_t{
+      entry.class_path / entry.name, std::move(dir.value()), capabilities });
+    return res::success;
+}
+
+res::optional_t<std::vector<thermal_zone_t>> get_thermal_zones(
+  const fs::path& thermal_path) {
+    SYST_API("get_thermal_zones");
+    // documentation for /sys/class/thermal
+    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
+    //     https://www.kernel.org/doc/html/latest/driver-api/thermal/sysfs-api.html
+
     std::vector<thermal_zone_t> thermal_zones;
 
-    for (const fs::directory_entry& zone :
-      fs::directory_iterator(thermal_path)) {
-        if (! fs::is_directory(zone)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(zone)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        const std::string thermal_zone_prefix = "thermal_zone";
-        if (! syst::has_prefix(zone.path().filename(), thermal_zone_prefix)) {
-            // Ignore devices that are not thermal zones.
-            continue;
-        }
-
-        thermal_zones.push_back(thermal_zone_t{ zone });
+    // Cooling devices share the class directory with thermal zones.
+    auto result = syst::for_each_class_entry(thermal_path,
+      "thermal_zone",
+      [&](const class_entry_t& entry) {
+          return syst::append_thermal_zone(entry, thermal_zones);
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return thermal_zones;
@@ -52,8 +63,13 @@ fs::path thermal_zone_t::get_sysfs_path() const {
     return this->sysfs_path_;
 }
 
+thermal_zone_t::capabilities_t thermal_zone_t::get_capabilities() const {
+    return this->capabilities_;
+}
+
 res::optional_t<std::string> thermal_zone_t::get_type() const {
-    auto type = syst::get_first_line(this->sysfs_path_ / "type");
+    SYST_API("thermal_zone_t::get_type");
+    auto type = syst::get_first_line_at(*this->dir_, "type");
 
     if (type.has_error()) {
         return RES_TRACE(type.error());
@@ -63,14 +79,23 @@ res::optional_t<std::string> thermal_zone_t::get_type() const {
 }
 
 res::optional_t<double> thermal_zone_t::get_temperature() const {
-    auto temp_millicelsius = syst::get_int(this->sysfs_path_ / "temp");
-    if (temp_millicelsius.has_error()) {
-        return RES_TRACE(temp_millicelsius.error());
+    SYST_API("thermal_zone_t::get_temperature");
+    if (! this->capabilities_.temperature) {
+        return RES_NEW_ERROR(
+          "This thermal zone does not report its temperature.\n\tsysfs: '"
+          + this->sysfs_path_.string() + "'");
+    }
+
+    uint64_t temp_millicelsius = 0;
+    const read_error_t error =
+      syst::read_int_at(*this->dir_, "temp", temp_millicelsius);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     const double millicelsius_per_celsius = 1e3;
     double temp_celsius =
-      static_cast<double>(temp_millicelsius.value()) / millicelsius_per_celsius;
+      static_cast<double>(temp_millicelsius) / millicelsius_per_celsius;
 
     return temp_celsius;
 }
@@ -79,39 +104,25 @@ cooling_device_t::cooling_device_t(const fs::path& sysfs_path)
 : sysfs_path_(sysfs_path) {
 }
 
-res::optional_t<std::vector<cooling_device_t>> get_cooling_devices() {
+res::optional_t<std::vector<cooling_device_t>> get_cooling_devices(
+  const fs::path& thermal_path) {
+    SYST_API("get_cooling_devices");
     // documentation for /sys/class/thermal
     //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
     //     https://www.kernel.org/doc/html/latest/driver-api/thermal/sysfs-api.html
 
-    const std::string thermal_path = "/sys/class/thermal";
-
-    if (! fs::is_directory(thermal_path)) {
-        return RES_NEW_ERROR(
-          "The path is not a directory.\n\tpath: '" + thermal_path + "'");
-    }
-
     std::vector<cooling_device_t> cooling_devices;
 
-    for (const fs::directory_entry& device :
-      fs::directory_iterator(thermal_path)) {
-        if (! fs::is_directory(device)) {
-            // Ignore paths that are not directories.
-            continue;
-        }
-        if (! fs::is_symlink(device)) {
-            // Ignore paths that are not symbolic links.
-            continue;
-        }
-
-        const std::string cooling_device_prefix = "cooling_device";
-        if (! syst::has_prefix(
-              device.path().filename(), cooling_device_prefix)) {
-            // Ignore devices that are not cooling devices.
-            continue;
-        }
-
-        cooling_devices.push_back(cooling_device_t{ device });
+    // Thermal zones share the class directory with cooling devices.
+    auto result = syst::for_each_class_entry(thermal_path,
+      "cooling_device",
+      [&](const class_entry_t& entry) -> res::result_t {
+          cooling_devices.push_back(
+            cooling_device_t{ entry.class_path / entry.name });
+          return res::success;
+      });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
     }
 
     return cooling_devices;
@@ -122,6 +133,7 @@ fs::path cooling_device_t::get_sysfs_path() const {
 }
 
 res::optional_t<std::string> cooling_device_t::get_type() const {
+    SYST_API("cooling_device_t::get_type");
     auto type = syst::get_first_line(this->sysfs_path_ / "type");
 
     if (type.has_error()) {
@@ -132,30 +144,39 @@ res::optional_t<std::string> cooling_device_t::get_type() const {
 }
 
 res::optional_t<double> cooling_device_t::get_state() const {
-    auto current_state = syst::get_int(this->sysfs_path_ / "cur_state");
-    if (current_state.has_error()) {
-        return RES_TRACE(current_state.error());
+    SYST_API("cooling_device_t::get_state");
+    const fs::path current_state_path = this->sysfs_path_ / "cur_state";
+    uint64_t current_state = 0;
+    read_error_t error = syst::read_int(current_state_path, current_state);
+    if (error.failed()) {
+        return error.to_error();
     }
 
-    auto maximum_state = syst::get_int(this->sysfs_path_ / "max_state");
-    if (maximum_state.has_error()) {
-        return RES_TRACE(maximum_state.error());
+    const fs::path maximum_state_path = this->sysfs_path_ / "max_state";
+    uint64_t maximum_state = 0;
+    error = syst::read_int(maximum_state_path, maximum_state);
+    if (error.failed()) {
+        return error.to_error();
     }
 
-    return ratio_to_percent(current_state.value(), maximum_state.value());
+    return ratio_to_percent(current_state, maximum_state);
 }
 
 res::result_t cooling_device_t::set_state(double state) {
+    SYST_API("cooling_device_t::set_state");
     double clamped_state =
       std::clamp(state, static_cast<double>(0.F), static_cast<double>(100.F));
 
-    auto maximum_state = get_int(this->sysfs_path_ / "max_state");
-    if (maximum_state.has_error()) {
-        return RES_TRACE(maximum_state.error());
+    const fs::path maximum_state_path = this->sysfs_path_ / "max_state";
+    uint64_t maximum_state = 0;
+    const read_error_t error =
+      syst::read_int(maximum_state_path, maximum_state);
+    if (error.failed()) {
+        return error.to_error();
     }
 
     const uint64_t current_state = percent_to_value(
-      static_cast<uint64_t>(0), maximum_state.value(), clamped_state);
+      static_cast<uint64_t>(0), maximum_state, clamped_state);
 
     res::result_t result =
       write_int(this->sysfs_path_ / "cur_state", current_state);
@@ -0,0 +1,366 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <variant>
+
+// External includes
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+struct pid_state_t {
+    double integral = 0;
+    std::optional<double> last_temperature;
+    std::optional<ch::steady_clock::time_point> last_time;
+};
+
+struct thermal_binding_t {
+    fs::path temp_path;
+    fs::path state_path;
+
+    fd_t temp_fd;
+    fd_t state_fd;
+
+    // Read once when the binding is created.
+    uint64_t max_state;
+
+    // The state most recently written to (or read from) 'cur_state'.
+    uint64_t last_state;
+
+    std::variant<step_policy_t, pid_policy_t> policy;
+    pid_state_t pid_state;
+};
+
+struct thermal_governor_t::impl_t {
+    std::vector<thermal_binding_t> bindings;
+    fd_t timer;
+
+    // Becomes readable when 'stop' is called.
+    fd_t wakeup;
+};
+
+[[nodiscard]] res::optional_t<thermal_binding_t> make_binding(
+  const thermal_zone_t& zone, const cooling_device_t& device) {
+    // documentation for /sys/class/thermal
+    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
+    //     https://www.kernel.org/doc/html/latest/driver-api/thermal/sysfs-api.html
+
+    thermal_binding_t binding{};
+    binding.temp_path = zone.get_sysfs_path() / "temp";
+    binding.state_path = device.get_sysfs_path() / "cur_state";
+
+    const fs::path max_state_path = device.get_sysfs_path() / "max_state";
+    const read_error_t error =
+      syst::read_int(max_state_path, binding.max_state);
+    if (error.failed()) {
+        return error.to_error();
+    }
+
+    int err = syst::open_input(binding.temp_path, binding.temp_fd);
+    if (err != 0) {
+        return RES_NEW_ERROR(
+          "Failed to open the temperature of a thermal zone.\n\tfile: '"
+          + binding.temp_path.string() + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    auto state_fd = syst::open_fd(binding.state_path, O_RDWR);
+    if (state_fd.has_error()) {
+        return RES_TRACE(state_fd.error());
+    }
+    binding.state_fd = std::move(state_fd.value());
+
+    int64_t current_state = 0;
+    err = syst::read_signed_int(binding.state_fd, current_state);
+    if (err != 0) {
+        return RES_NEW_ERROR(
+          "Failed to read the current state of a cooling device.\n\tfile: '"
+          + binding.state_path.string() + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+    binding.last_state = static_cast<uint64_t>(std::clamp(current_state,
+      static_cast<int64_t>(0),
+      static_cast<int64_t>(binding.max_state)));
+
+    return binding;
+}
+
+[[nodiscard]] uint64_t next_state(
+  const step_policy_t& policy, thermal_binding_t& binding, double temperature) {
+    if (temperature > policy.trip_temperature) {
+        return std::min(binding.last_state + 1, binding.max_state);
+    }
+    if (temperature < policy.trip_temperature - policy.hysteresis
+      && binding.last_state > 0) {
+        return binding.last_state - 1;
+    }
+
+    return binding.last_state;
+}
+
+[[nodiscard]] uint64_t next_state(
+  const pid_policy_t& policy, thermal_binding_t& binding, double temperature) {
+    pid_state_t& state = binding.pid_state;
+    const auto now = ch::steady_clock::now();
+
+    // Positive errors require more cooling.
+    const double error = temperature - policy.target_temperature;
+
+    double elapsed_seconds = 0;
+    if (state.last_time.has_value()) {
+        elapsed_seconds =
+          ch::duration<double>(now - state.last_time.value()).count();
+    }
+
+    double derivative = 0;
+    if (state.last_temperature.has_value() && elapsed_seconds > 0) {
+        derivative =
+          (temperature - state.last_temperature.value()) / elapsed_seconds;
+    }
+
+    const double max_percent = 1e2;
+
+    double integral = state.integral + error * elapsed_seconds;
+    double output = policy.proportional * error + policy.integral * integral
+      + policy.derivative * derivative;
+
+    // Only accumulate error while the output is not saturated so that the
+    // integral term does not wind up while the device is already fully on or
+    // fully off.
+    if (output >= 0 && output <= max_percent) {
+        state.integral = integral;
+    }
+
+    state.last_temperature = temperature;
+    state.last_time = now;
+
+    return syst::percent_to_value(static_cast<uint64_t>(0),
+      binding.max_state,
+      std::clamp(output, static_cast<double>(0), max_percent));
+}
+
+thermal_governor_t::thermal_governor_t() : impl_(std::make_unique<impl_t>()) {
+}
+
+thermal_governor_t::thermal_governor_t(thermal_governor_t&&) noexcept =
+  default;
+
+thermal_governor_t& thermal_governor_t::operator=(
+  thermal_governor_t&&) noexcept = default;
+
+thermal_governor_t::~thermal_governor_t() = default;
+
+res::result_t thermal_governor_t::bind(const thermal_zone_t& zone,
+  const cooling_device_t& device,
+  const step_policy_t& policy) {
+    SYST_API("thermal_governor_t::bind");
+    auto binding = syst::make_binding(zone, device);
+    if (binding.has_error()) {
+        return RES_TRACE(binding.error());
+    }
+
+    binding->policy = policy;
+    this->impl_->bindings.push_back(std::move(binding.value()));
+
+    return res::success;
+}
+
+res::result_t thermal_governor_t::bind(const thermal_zone_t& zone,
+  const cooling_device_t& device,
+  const pid_policy_t& policy) {
+    SYST_API("thermal_governor_t::bind");
+    auto binding = syst::make_binding(zone, device);
+    if (binding.has_error()) {
+        return RES_TRACE(binding.error());
+    }
+
+    binding->policy = policy;
+    this->impl_->bindings.push_back(std::move(binding.value()));
+
+    return res::success;
+}
+
+res::result_t thermal_governor_t::start(ch::nanoseconds period) {
+    SYST_API("thermal_governor_t::start");
+    auto timer = syst::create_timer(period);
+    if (timer.has_error()) {
+        return RES_TRACE(timer.error());
+    }
+
+    this->impl_->timer = std::move(timer.value());
+
+    if (! this->impl_->wakeup.is_open()) {
+        this->impl_->wakeup = fd_t{ eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) };
+        if (! this->impl_->wakeup.is_open()) {
+            int err = errno;
+            return RES_NEW_ERROR(
+              "Failed to create an eventfd for a governor.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+    }
+
+    return res::success;
+}
+
+int thermal_governor_t::get_fd() const {
+    return this->impl_->timer.get();
+}
+
+res::result_t thermal_governor_t::dispatch() {
+    SYST_API("thermal_governor_t::dispatch");
+    if (! this->impl_->timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The governor has not been started. Call the 'start' method before "
+          "calling the 'dispatch' method.");
+    }
+
+    auto expirations = syst::read_timer(this->impl_->timer);
+    if (expirations.has_error()) {
+        return RES_TRACE(expirations.error());
+    }
+    if (expirations.value() == 0) {
+        return res::success;
+    }
+
+    // Missed periods are not replayed. Only the most recent temperature
+    // matters.
+    auto result = this->step();
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::result_t thermal_governor_t::step() {
+    SYST_API("thermal_governor_t::step");
+    const double millicelsius_per_celsius = 1e3;
+
+    // A binding that fails does not prevent the others from being controlled.
+    std::optional<res::error_t> error;
+
+    for (thermal_binding_t& binding : this->impl_->bindings) {
+        int64_t temp_millicelsius = 0;
+        int err = syst::read_signed_int(binding.temp_fd, temp_millicelsius);
+        if (err != 0) {
+            if (! error.has_value()) {
+                error = RES_NEW_ERROR(
+                  "Failed to read the temperature of a thermal zone.\n\tfile: '"
+                  + binding.temp_path.string() + "'\n\treason: '"
+                  + syst::strerror(err) + "'");
+            }
+            continue;
+        }
+
+        const double temperature =
+          static_cast<double>(temp_millicelsius) / millicelsius_per_celsius;
+
+        const uint64_t state = std::visit(
+          [&](const auto& policy) {
+              return syst::next_state(policy, binding, temperature);
+          },
+          binding.policy);
+
+        if (state == binding.last_state) {
+            continue;
+        }
+
+        err = syst::write_int(binding.state_fd, state);
+        if (err != 0) {
+            if (! error.has_value()) {
+                error = RES_NEW_ERROR(
+                  "Failed to set the state of a cooling device.\n\tfile: '"
+                  + binding.state_path.string() + "'\n\tstate: '"
+                  + std::to_string(state) + "'\n\treason: '"
+                  + syst::strerror(err) + "'");
+            }
+            continue;
+        }
+
+        binding.last_state = state;
+    }
+
+    if (error.has_value()) {
+        return RES_TRACE(error.value());
+    }
+
+    return res::success;
+}
+
+res::result_t thermal_governor_t::run() {
+    SYST_API("thermal_governor_t::run");
+    if (! this->impl_->timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The governor has not been started. Call the 'start' method before "
+          "calling the 'run' method.");
+    }
+
+    // Steps keep running after a binding fails. The first failure is
+    // reported when the governor stops.
+    std::optional<res::error_t> error;
+
+    while (true) {
+        std::array<struct pollfd, 2> poll_fds{};
+        poll_fds[0].fd = this->impl_->timer.get();
+        poll_fds[0].events = POLLIN;
+        poll_fds[1].fd = this->impl_->wakeup.get();
+        poll_fds[1].events = POLLIN;
+
+        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+            int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+            return RES_NEW_ERROR(
+              "Failed to wait for the governor timer.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+
+        if ((poll_fds[1].revents & POLLIN) != 0) {
+            uint64_t count = 0;
+            ssize_t len =
+              read(this->impl_->wakeup.get(), &count, sizeof(count));
+            static_cast<void>(len);
+            break;
+        }
+
+        auto expirations = syst::read_timer(this->impl_->timer);
+        if (expirations.has_error()) {
+            return RES_TRACE(expirations.error());
+        }
+        if (expirations.value() == 0) {
+            continue;
+        }
+
+        auto result = this->step();
+        if (result.failure() && ! error.has_value()) {
+            error = result.error();
+        }
+    }
+
+    if (error.has_value()) {
+        return RES_TRACE(error.value());
+    }
+
+    return res::success;
+}
+
+void thermal_governor_t::stop() {
+    const uint64_t increment = 1;
+    ssize_t len =
+      write(this->impl_->wakeup.get(), &increment, sizeof(increment));
+    static_cast<void>(len);
+}
+
+} // namespace syst
@@ -0,0 +1,394 @@
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// External includes
+#include <fcntl.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "batch_reader.hpp"
+#include "instrument.hpp"
+#include "util.hpp"
+#include "strerror.hpp"
+
+namespace syst {
+
+// Samples are counted in half degree buckets from -40°C to 150°C. Samples
+// outside of this range are counted in the first or last bucket.
+const double histogram_min_celsius = -40;
+const double histogram_bucket_celsius = 0.5;
+const size_t histogram_buckets = 380;
+
+enum class trip_level_t {
+    below,
+    approaching,
+    reached,
+};
+
+struct monitored_zone_t {
+    fs::path temp_path;
+    fd_t temp_fd;
+
+    // The level of each trip point (in the same order as the summary).
+    std::vector<trip_level_t> trip_levels;
+
+    std::array<uint64_t, histogram_buckets> histogram{};
+};
+
+struct thermal_monitor_t::impl_t {
+    thermal_monitor_options_t options;
+    std::vector<monitored_zone_t> zones;
+    std::vector<thermal_zone_summary_t> summaries;
+    std::vector<thermal_event_t> events;
+    fd_t timer;
+
+    // Reads the 'temp' file of every zone (same order as 'zones'). Created by
+    // the first call to 'update'.
+    std::optional<batch_reader_t> reader;
+};
+
+[[nodiscard]] std::optional<double> read_celsius(const fs::path& path) {
+    fd_t fd;
+    if (syst::open_input(path, fd) != 0) {
+        return std::nullopt;
+    }
+
+    int64_t millicelsius = 0;
+    if (syst::read_signed_int(fd, millicelsius) != 0) {
+        return std::nullopt;
+    }
+
+    const double millicelsius_per_celsius = 1e3;
+    return static_cast<double>(millicelsius) / millicelsius_per_celsius;
+}
+
+[[nodiscard]] std::vector<thermal_trip_point_t> read_trip_points(
+  const thermal_zone_t& zone) {
+    const fs::path zone_path = zone.get_sysfs_path();
+    const uint64_t count = zone.get_capabilities().trip_points;
+
+    std::vector<thermal_trip_point_t> trip_points;
+
+    for (uint64_t index = 0; index < count; ++index) {
+        const std::string prefix = "trip_point_" + std::to_string(index);
+
+        auto temperature = syst::read_celsius(zone_path / (prefix + "_temp"));
+        if (! temperature.has_value()) {
+            break;
+        }
+
+        auto type = syst::get_first_line(zone_path / (prefix + "_type"));
+        if (type.has_error()) {
+            break;
+        }
+
+        trip_points.push_back(
+          thermal_trip_point_t{ type.value(), temperature.value() });
+    }
+
+    return trip_points;
+}
+
+[[nodiscard]] size_t histogram_bucket(double temperature) {
+    const double offset =
+      (temperature - histogram_min_celsius) / histogram_bucket_celsius;
+    if (offset <= 0) {
+        return 0;
+    }
+
+    return std::min(static_cast<size_t>(offset), histogram_buckets - 1);
+}
+
+[[nodiscard]] trip_level_t trip_level(
+  const thermal_trip_point_t& trip_point, double temperature, double margin) {
+    if (temperature >= trip_point.temperature) {
+        return trip_level_t::reached;
+    }
+    if (temperature >= trip_point.temperature - margin) {
+        return trip_level_t::approaching;
+    }
+
+    return trip_level_t::below;
+}
+
+res::optional_t<thermal_monitor_t> get_thermal_monitor(
+  const thermal_monitor_options_t& options, const fs::path& thermal_path) {
+    SYST_API("get_thermal_monitor");
+    // documentation for /sys/class/thermal
+    //     https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-thermal
+    //     https://www.kernel.org/doc/html/latest/driver-api/thermal/sysfs-api.html
+
+    if (options.ewma_weight <= 0 || options.ewma_weight > 1) {
+        return RES_NEW_ERROR(
+          "The weight of the moving average must be greater than zero and no "
+          "greater than one.\n\tweight: '"
+          + std::to_string(options.ewma_weight) + "'");
+    }
+
+    auto thermal_zones = syst::get_thermal_zones(thermal_path);
+    if (thermal_zones.has_error()) {
+        return RES_TRACE(thermal_zones.error());
+    }
+
+    auto impl = std::make_unique<thermal_monitor_t::impl_t>();
+    impl->options = options;
+
+    for (const thermal_zone_t& thermal_zone : thermal_zones.value()) {
+        const fs::path zone_path = thermal_zone.get_sysfs_path();
+
+        thermal_zone_summary_t summary{};
+        summary.sysfs_path = zone_path;
+
+        auto type = thermal_zone.get_type();
+        if (type.has_error()) {
+            return RES_TRACE(type.error());
+        }
+        summary.type = type.value();
+        summary.trip_points = syst::read_trip_points(thermal_zone);
+
+        monitored_zone_t zone{};
+        zone.temp_path = zone_path / "temp";
+        zone.trip_levels.resize(
+          summary.trip_points.size(), trip_level_t::below);
+
+        int err = syst::open_input(zone.temp_path, zone.temp_fd);
+        if (err != 0) {
+            return RES_NEW_ERROR(
+              "Failed to open the temperature of a thermal zone.\n\tfile: '"
+              + zone.temp_path.string() + "'\n\treason: '"
+              + syst::strerror(err) + "'");
+        }
+
+        impl->zones.push_back(std::move(zone));
+        impl->summaries.push_back(std::move(summary));
+    }
+
+    return thermal_monitor_t{ std::move(impl) };
+}
+
+thermal_monitor_t::thermal_monitor_t(std::unique_ptr<impl_t>&& impl)
+: impl_(std::move(impl)) {
+}
+
+thermal_monitor_t::thermal_monitor_t(thermal_monitor_t&&) noexcept = default;
+
+thermal_monitor_t& thermal_monitor_t::operator=(
+  thermal_monitor_t&&) noexcept = default;
+
+thermal_monitor_t::~thermal_monitor_t() = default;
+
+res::result_t thermal_monitor_t::start(ch::nanoseconds period) {
+    SYST_API("thermal_monitor_t::start");
+    auto timer = syst::create_timer(period);
+    if (timer.has_error()) {
+        return RES_TRACE(timer.error());
+    }
+
+    this->impl_->timer = std::move(timer.value());
+
+    return res::success;
+}
+
+int thermal_monitor_t::get_fd() const {
+    return this->impl_->timer.get();
+}
+
+res::result_t thermal_monitor_t::dispatch() {
+    SYST_API("thermal_monitor_t::dispatch");
+    if (! this->impl_->timer.is_open()) {
+        return RES_NEW_ERROR(
+          "The monitor has not been started. Call the 'start' method before "
+          "calling the 'dispatch' method.");
+    }
+
+    auto expirations = syst::read_timer(this->impl_->timer);
+    if (expirations.has_error()) {
+        return RES_TRACE(expirations.error());
+    }
+    if (expirations.value() == 0) {
+        return res::success;
+    }
+
+    // Missed periods are not replayed since the temperature at those times is
+    // unknown.
+    auto result = this->update();
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+res::result_t thermal_monitor_t::update() {
+    SYST_API("thermal_monitor_t::update");
+    const double millicelsius_per_celsius = 1e3;
+    const double weight = this->impl_->options.ewma_weight;
+    const double margin = this->impl_->options.trip_margin;
+
+    if (! this->impl_->reader.has_value()) {
+        std::vector<const fd_t*> files;
+        for (const monitored_zone_t& zone : this->impl_->zones) {
+            files.push_back(&zone.temp_fd);
+        }
+
+        // Integers exposed by sysfs are at most 20 digits long plus a sign
+        // and a trailing newline.
+        const size_t max_len = 32;
+        this->impl_->reader.emplace(
+          std::move(files), max_len, this->impl_->options.use_io_uring);
+    }
+
+    batch_reader_t& reader = this->impl_->reader.value();
+    reader.read();
+
+    // A zone that fails to be read does not prevent the others from being
+    // sampled.
+    std::optional<res::error_t> error;
+
+    for (size_t index = 0; index < this->impl_->zones.size(); ++index) {
+        monitored_zone_t& zone = this->impl_->zones[index];
+        thermal_zone_summary_t& summary = this->impl_->summaries[index];
+
+        int64_t temp_millicelsius = 0;
+        int err = reader.get_errno(index);
+        if (err == 0) {
+            err = syst::parse_signed_int(
+              reader.get_contents(index).data(), temp_millicelsius);
+        }
+        if (err != 0) {
+            if (! error.has_value()) {
+                error = RES_NEW_ERROR(
+                  "Failed to read the temperature of a thermal zone.\n\tfile: '"
+                  + zone.temp_path.string() + "'\n\treason: '"
+                  + syst::strerror(err) + "'");
+            }
+            continue;
+        }
+
+        const double temperature =
+          static_cast<double>(temp_millicelsius) / millicelsius_per_celsius;
+
+        if (summary.samples == 0) {
+            summary.min = temperature;
+            summary.max = temperature;
+            summary.ewma = temperature;
+        } else {
+            summary.min = std::min(summary.min, temperature);
+            summary.max = std::max(summary.max, temperature);
+            summary.ewma = weight * temperature + (1 - weight) * summary.ewma;
+        }
+        summary.current = temperature;
+        ++summary.samples;
+        ++zone.histogram[syst::histogram_bucket(temperature)];
+
+        // Events are only generated when the level of a trip point changes.
+        for (size_t trip = 0; trip < summary.trip_points.size(); ++trip) {
+            const thermal_trip_point_t& trip_point = summary.trip_points[trip];
+            const trip_level_t last_level = zone.trip_levels[trip];
+            const trip_level_t level =
+              syst::trip_level(trip_point, temperature, margin);
+            zone.trip_levels[trip] = level;
+
+            if (level == last_level) {
+                continue;
+            }
+
+            const bool passive = trip_point.type == "passive";
+
+            // The temperature may rise past the margin and the trip point
+            // between two samples.
+            if (last_level == trip_level_t::below) {
+                this->impl_->events.push_back(
+                  thermal_event_t{ thermal_event_t::type_t::approaching_trip,
+                    index,
+                    trip_point,
+                    temperature });
+            }
+            if (level == trip_level_t::reached) {
+                this->impl_->events.push_back(thermal_event_t{ passive
+                    ? thermal_event_t::type_t::throttling_started
+                    : thermal_event_t::type_t::trip_reached,
+                  index,
+                  trip_point,
+                  temperature });
+            }
+            if (passive && last_level == trip_level_t::reached) {
+                this->impl_->events.push_back(
+                  thermal_event_t{ thermal_event_t::type_t::throttling_stopped,
+                    index,
+                    trip_point,
+                    temperature });
+            }
+        }
+    }
+
+    if (error.has_value()) {
+        return RES_TRACE(error.value());
+    }
+
+    return res::success;
+}
+
+const std::vector<thermal_zone_summary_t>& thermal_monitor_t::get_zones()
+  const {
+    return this->impl_->summaries;
+}
+
+res::optional_t<double> thermal_monitor_t::get_percentile(
+  size_t zone, double percentile) const {
+    if (zone >= this->impl_->zones.size()) {
+        return RES_NEW_ERROR("The zone index is out of range.\n\tindex: '"
+          + std::to_string(zone) + "'\n\tzones: '"
+          + std::to_string(this->impl_->zones.size()) + "'");
+    }
+    if (percentile < 0 || percentile > 1e2) {
+        return RES_NEW_ERROR(
+          "The percentile must be between 0 and 100.\n\tpercentile: '"
+          + std::to_string(percentile) + "'");
+    }
+
+    const uint64_t samples = this->impl_->summaries[zone].samples;
+    if (samples == 0) {
+        return RES_NEW_ERROR(
+          "No samples have been taken. Call the 'update' method first.");
+    }
+
+    // The extremes are known exactly.
+    const thermal_zone_summary_t& summary = this->impl_->summaries[zone];
+    if (percentile == 0) {
+        return summary.min;
+    }
+    if (percentile == 1e2) {
+        return summary.max;
+    }
+
+    // The rank of the requested sample (starting from one).
+    const auto rank = std::max(static_cast<uint64_t>(1),
+      static_cast<uint64_t>(
+        std::ceil(percentile / 1e2 * static_cast<double>(samples))));
+
+    const auto& histogram = this->impl_->zones[zone].histogram;
+    uint64_t count = 0;
+    size_t bucket = 0;
+    for (; bucket < histogram_buckets; ++bucket) {
+        count += histogram[bucket];
+        if (count >= rank) {
+            break;
+        }
+    }
+
+    // Report the middle of the bucket, but never beyond the observed range.
+    const double temperature = histogram_min_celsius
+      + (static_cast<double>(bucket) + 0.5) * histogram_bucket_celsius;
+    return std::clamp(temperature, summary.min, summary.max);
+}
+
+std::vector<thermal_event_t> thermal_monitor_t::take_events() {
+    std::vector<thermal_event_t> events;
+    events.swap(this->impl_->events);
+    return events;
+}
+
+} // namespace syst
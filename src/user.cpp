@@ -5,11 +5,13 @@
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "instrument.hpp"
 #include "strerror.hpp"
 
 namespace syst {
 
 res::optional_t<std::string> get_username() {
+    SYST_API("get_username");
     auto uid = geteuid();
     struct passwd* passwd_info = getpwuid(uid);
 
@@ -1,108 +1,948 @@
 // Standard includes
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+// External includes
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 // Local includes
 #include "util.hpp"
+#include "capture.hpp"
+#include "instrument.hpp"
+#include "strerror.hpp"
 
 namespace syst {
 
-res::optional_t<std::vector<std::string>> get_all_lines(
-  const std::filesystem::path& path) {
-    if (! std::filesystem::is_regular_file(path)) {
+res::optional_t<std::string> get_first_line(const std::filesystem::path& path) {
+    std::string contents;
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        if (! syst::replay_read(nullptr, path.c_str(), contents)) {
+            return syst::not_recorded(path.string());
+        }
+    } else {
+        syst::count_stat();
+        if (! std::filesystem::is_regular_file(path)) {
+            return RES_NEW_ERROR("The path is not a regular file.\n\tpath: '"
+              + path.string() + "'");
+        }
+
+        auto fd = syst::open_fd(path, O_RDONLY);
+        if (fd.has_error()) {
+            return RES_TRACE(fd.error());
+        }
+
+        // The whole file is read so that it can be recorded. Files read by
+        // their first line are small.
+        int err = syst::read_all(fd.value(), contents);
+        if (err != 0) {
+            return RES_NEW_ERROR("Failed to read a file.\n\tfile: '"
+              + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+        }
+        syst::record_read(nullptr, path.c_str(), contents);
+    }
+
+    const size_t end = contents.find('\n');
+    if (end == std::string::npos) {
         return RES_NEW_ERROR(
-          "The path is not a regular file.\n\tpath: '" + path.string() + "'");
+          "Failed to read the first line of a file.\n\tfile: '" + path.string()
+          + "'");
     }
+    contents.resize(end);
+
+    return contents;
+}
 
-    std::ifstream file{ path };
-    std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(file, line).good()) {
-        lines.push_back(line);
+/**
+ * @brief Parse an unsigned integer from the first line of the contents of a
+ * file.
+ *
+ * @param[in] buffer - The null-terminated contents of the file.
+ * @param[in] len - The length of the contents.
+ * @param[out] integer - The integer read from the file.
+ * @param[out] error - Describes the failure if the contents are invalid.
+ */
+void parse_int_line(
+  const char* buffer, size_t len, uint64_t& integer, read_error_t& error) {
+    if (std::memchr(buffer, '\n', len) == nullptr) {
+        error.code = read_error_t::code_t::no_line;
+        return;
     }
 
-    return lines;
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(buffer, &end, 10);
+    if (end == buffer) {
+        error.code = read_error_t::code_t::not_integer;
+        return;
+    }
+    if (errno == ERANGE) {
+        error.code = read_error_t::code_t::out_of_range;
+        return;
+    }
+
+    integer = static_cast<uint64_t>(value);
 }
 
-res::optional_t<std::string> get_first_line(const std::filesystem::path& path) {
-    if (! std::filesystem::is_regular_file(path)) {
+/**
+ * @brief Read an unsigned integer from the first line of a file relative to a
+ * directory.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[out] integer - The integer read from the file.
+ * @param[out] error - Describes the failure if the read failed.
+ */
+void read_int_file(
+  const fd_t* dir, const char* path, uint64_t& integer, read_error_t& error) {
+    // Integers exposed by sysfs are at most 20 digits long plus a trailing
+    // newline, so only the beginning of a file is parsed.
+    const size_t max_len = 32;
+
+    const capture_mode_t mode = syst::get_capture_mode();
+    if (mode == capture_mode_t::replay) {
+        std::string contents;
+        if (! syst::replay_read(dir, path, contents)) {
+            error.code = read_error_t::code_t::not_recorded;
+            return;
+        }
+        syst::parse_int_line(contents.c_str(),
+          std::min(contents.size(), max_len - 1),
+          integer,
+          error);
+        return;
+    }
+
+    fd_t fd{ openat(
+      dir == nullptr ? AT_FDCWD : dir->get(), path, O_RDONLY | O_CLOEXEC) };
+    syst::count_open();
+    if (! fd.is_open()) {
+        error.code = read_error_t::code_t::open;
+        error.errnum = errno;
+        return;
+    }
+
+    if (mode == capture_mode_t::record) {
+        // The whole file is read so that the capture holds its exact contents.
+        std::string contents;
+        int err = syst::read_all(fd, contents);
+        if (err != 0) {
+            error.code = read_error_t::code_t::read;
+            error.errnum = err;
+            return;
+        }
+        syst::record_read(dir, path, contents);
+        syst::parse_int_line(contents.c_str(),
+          std::min(contents.size(), max_len - 1),
+          integer,
+          error);
+        return;
+    }
+
+    char buffer[max_len];
+
+    ssize_t len = pread(fd.get(), buffer, max_len - 1, 0);
+    if (len < 0) {
+        error.code = read_error_t::code_t::read;
+        error.errnum = errno;
+        return;
+    }
+    syst::count_read(static_cast<size_t>(len));
+    buffer[len] = '\0';
+
+    syst::parse_int_line(buffer, static_cast<size_t>(len), integer, error);
+}
+
+/**
+ * @brief Convert an integer read from a file to a boolean.
+ *
+ * @param[in] integer - The integer read from the file.
+ * @param[out] boolean - The boolean.
+ * @param[out] error - Describes the failure if the integer is not 0 or 1.
+ */
+void int_to_bool(uint64_t integer, bool& boolean, read_error_t& error) {
+    if (integer != 0 && integer != 1) {
+        error.code = read_error_t::code_t::not_boolean;
+        error.value = integer;
+        return;
+    }
+
+    boolean = integer == 1;
+}
+
+bool read_error_t::failed() const {
+    return this->code != code_t::none;
+}
+
+res::error_t read_error_t::to_error() const {
+    std::string message = this->context != nullptr
+      ? this->context
+      : "Failed to read a value from a file.";
+
+    message += "\n\tfile: '";
+    if (this->path != nullptr) {
+        message += this->path->string();
+    } else if (this->dir != nullptr) {
+        message += syst::attribute_path(*this->dir, this->name);
+    }
+    message += "'";
+
+    switch (this->code) {
+        case code_t::none:
+            break;
+        case code_t::open:
+            message += "\n\treason: 'Failed to open the file: ";
+            message += syst::strerror(this->errnum);
+            message += "'";
+            break;
+        case code_t::read:
+            message += "\n\treason: 'Failed to read the file: ";
+            message += syst::strerror(this->errnum);
+            message += "'";
+            break;
+        case code_t::not_recorded:
+            message += "\n\treason: 'The file was not recorded in the "
+                       "capture being replayed.'";
+            break;
+        case code_t::no_line:
+            message += "\n\treason: 'The file does not contain a line.'";
+            break;
+        case code_t::not_integer:
+            message += "\n\treason: 'The first line is not an integer.'";
+            break;
+        case code_t::out_of_range:
+            message += "\n\treason: 'The integer does not fit in 64 bits.'";
+            break;
+        case code_t::not_boolean:
+            message += "\n\tvalue: '" + std::to_string(this->value)
+              + "'\n\treason: 'Expected a boolean value (either 0 or 1).'";
+            break;
+    }
+
+    return RES_NEW_ERROR(message);
+}
+
+read_error_t read_int(const std::filesystem::path& path, uint64_t& integer) {
+    read_error_t error{};
+    error.context = "Failed to read an integer from a file.";
+    error.path = &path;
+
+    syst::read_int_file(nullptr, path.c_str(), integer, error);
+    return error;
+}
+
+read_error_t read_bool(const std::filesystem::path& path, bool& boolean) {
+    read_error_t error{};
+    error.context = "Failed to read a boolean from a file.";
+    error.path = &path;
+
+    uint64_t integer = 0;
+    syst::read_int_file(nullptr, path.c_str(), integer, error);
+    if (! error.failed()) {
+        syst::int_to_bool(integer, boolean, error);
+    }
+    return error;
+}
+
+res::result_t write_int(const std::filesystem::path& path, uint64_t integer) {
+    // Truncate like a shell redirection so that regular files are never left
+    // with trailing characters. Truncation is ignored by sysfs attributes.
+    auto fd = syst::open_fd(path, O_WRONLY | O_TRUNC);
+    if (fd.has_error()) {
+        return RES_TRACE(fd.error());
+    }
+
+    int err = syst::write_int(fd.value(), integer);
+    if (err != 0) {
+        return RES_NEW_ERROR("Failed to write an integer to a file.\n\tpath: '"
+          + path.string() + "'\n\tinteger: '" + std::to_string(integer)
+          + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    return res::success;
+}
+
+fd_t::fd_t(int fd) : fd_(fd) {
+}
+
+fd_t::fd_t(int fd, std::string capture_path)
+: fd_(fd), capture_path_(std::move(capture_path)) {
+}
+
+fd_t::fd_t(fd_t&& fd) noexcept
+: fd_(fd.fd_), capture_path_(std::move(fd.capture_path_)) {
+    fd.fd_ = -1;
+}
+
+fd_t& fd_t::operator=(fd_t&& fd) noexcept {
+    if (this != &fd) {
+        if (this->fd_ >= 0) {
+            close(this->fd_);
+        }
+        this->fd_ = fd.fd_;
+        this->capture_path_ = std::move(fd.capture_path_);
+        fd.fd_ = -1;
+    }
+    return *this;
+}
+
+fd_t::~fd_t() {
+    if (this->fd_ < 0) {
+        return;
+    }
+
+    // Assume that this function always succeeds. Destructors have no way of
+    // communicating failure.
+    close(this->fd_);
+}
+
+int fd_t::get() const {
+    return this->fd_;
+}
+
+bool fd_t::is_open() const {
+    return this->fd_ >= 0;
+}
+
+const std::string& fd_t::get_capture_path() const {
+    return this->capture_path_;
+}
+
+/**
+ * @brief Check whether a file relative to a directory exists and record the
+ * answer, or serve it from the capture being replayed.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the file.
+ * @param[in] check - Checks whether the file exists on the filesystem.
+ * @return true if the file exists and false otherwise.
+ */
+template<typename check_t>
+[[nodiscard]] bool probe(const fd_t* dir, const char* path, check_t check) {
+    bool exists = false;
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        // Files that were never probed did not exist as far as the capture
+        // knows.
+        return syst::replay_exists(dir, path, exists) && exists;
+    }
+
+    exists = check();
+    syst::record_exists(dir, path, exists);
+    return exists;
+}
+
+bool has_attribute(const std::filesystem::path& path) {
+    return syst::probe(nullptr, path.c_str(), [&] {
+        syst::count_stat();
+        return access(path.c_str(), F_OK) == 0;
+    });
+}
+
+res::optional_t<fd_t> open_fd(const std::filesystem::path& path, int flags) {
+    int fd = open(path.c_str(), flags | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to open a file.\n\tpath: '"
+          + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    if (syst::get_capture_mode() != capture_mode_t::off) {
+        return fd_t{ fd, path.string() };
+    }
+    return fd_t{ fd };
+}
+
+int open_input(const std::filesystem::path& path, fd_t& file) {
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        file = fd_t{ -1, path.string() };
+        return 0;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        return errno;
+    }
+
+    if (syst::get_capture_mode() == capture_mode_t::record) {
+        file = fd_t{ fd, path.string() };
+    } else {
+        file = fd_t{ fd };
+    }
+    return 0;
+}
+
+res::optional_t<fd_t> open_directory(const std::filesystem::path& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("The path is not a directory.\n\tpath: '"
+          + path.string() + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    if (syst::get_capture_mode() != capture_mode_t::off) {
+        return fd_t{ fd, path.string() };
+    }
+    return fd_t{ fd };
+}
+
+int read_directory(const fd_t& dir, char* buffer, size_t size, size_t& len) {
+    // glibc only provides a wrapper for getdents64 since version 2.30.
+    long result = syscall(SYS_getdents64, dir.get(), buffer, size);
+    if (result < 0) {
+        return errno;
+    }
+
+    len = static_cast<size_t>(result);
+    return 0;
+}
+
+bool is_symlink_entry(const fd_t& dir, const struct dirent64& entry) {
+    if (entry.d_type != DT_UNKNOWN) {
+        return entry.d_type == DT_LNK;
+    }
+
+    struct stat status {};
+    syst::count_stat();
+    if (fstatat(dir.get(), entry.d_name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+        return false;
+    }
+    return S_ISLNK(status.st_mode);
+}
+
+bool has_class_entry(const fd_t& dir, const char* name) {
+    return syst::probe(&dir, name, [&] {
+        struct stat status {};
+        syst::count_stat();
+        if (fstatat(dir.get(), name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+            return false;
+        }
+        return S_ISLNK(status.st_mode);
+    });
+}
+
+res::optional_t<fd_t> open_class_dir(
+  const root_t& root, const std::filesystem::path& class_path) {
+    const capture_mode_t mode = syst::get_capture_mode();
+    if (mode == capture_mode_t::replay) {
+        return fd_t{ -1, (root.path / class_path).string() };
+    }
+
+    if (mode == capture_mode_t::off) {
+        return syst::open_in(root, class_path, O_RDONLY | O_DIRECTORY);
+    }
+
+    const std::string path = (root.path / class_path).string();
+    int fd = openat(
+      root.dir->get(), class_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to open a file.\n\tpath: '" + path
+          + "'\n\treason: '" + syst::strerror(err) + "'");
+    }
+
+    return fd_t{ fd, path };
+}
+
+/**
+ * @brief Read the names of the entries of an open directory, except for '.'
+ * and '..'.
+ *
+ * @param[in] dir - The directory opened by open_directory.
+ * @param[in] only_links - Only read the names of symbolic links.
+ * @param[out] names - The names of the entries.
+ * @return zero if the operation succeeded or an errno value otherwise.
+ */
+[[nodiscard]] int read_entry_names(
+  const fd_t& dir, bool only_links, std::vector<std::string>& names) {
+    alignas(struct dirent64) std::array<char, 16384> buffer{};
+    for (;;) {
+        size_t len = 0;
+        int err = syst::read_directory(dir, buffer.data(), buffer.size(), len);
+        if (err != 0) {
+            return err;
+        }
+        if (len == 0) {
+            return 0;
+        }
+
+        for (size_t offset = 0; offset < len;) {
+            const auto* entry =
+              reinterpret_cast<const struct dirent64*>(buffer.data() + offset);
+            offset += entry->d_reclen;
+            syst::count_directory_entries(1);
+
+            const std::string_view name{ entry->d_name };
+            if (name == "." || name == "..") {
+                continue;
+            }
+            if (only_links && ! syst::is_symlink_entry(dir, *entry)) {
+                continue;
+            }
+            names.emplace_back(name);
+        }
+    }
+}
+
+/**
+ * @brief List the entries of an open directory and record them, or serve
+ * them from the capture being replayed.
+ *
+ * @param[in] dir - The directory.
+ * @param[in] only_links - Only list symbolic links.
+ * @return the names of the entries if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<std::vector<std::string>> list_entries(
+  const fd_t& dir, bool only_links) {
+    std::vector<std::string> names;
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        if (! syst::replay_listing(dir, names)) {
+            return syst::not_recorded(dir.get_capture_path());
+        }
+        return names;
+    }
+
+    int err = syst::read_entry_names(dir, only_links, names);
+    if (err != 0) {
         return RES_NEW_ERROR(
-          "The path is not a regular file.\n\tpath: '" + path.string() + "'");
+          "Failed to read the entries of a directory.\n\tpath: '"
+          + syst::get_capture_path(&dir, "") + "'\n\treason: '"
+          + syst::strerror(err) + "'");
     }
 
-    std::ifstream file{ path };
-    std::string first_line;
-    if (! std::getline(file, first_line).good()) {
+    syst::record_listing(dir, names);
+    return names;
+}
+
+res::optional_t<std::vector<std::string>> list_class_entries(const fd_t& dir) {
+    // Every device is recorded regardless of the prefix that it is listed by.
+    return syst::list_entries(dir, true);
+}
+
+res::optional_t<std::vector<std::string>> list_directory(
+  const std::filesystem::path& path) {
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        return syst::list_entries(fd_t{ -1, path.string() }, false);
+    }
+
+    auto dir = syst::open_directory(path);
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
+
+    return syst::list_entries(dir.value(), false);
+}
+
+res::optional_t<std::shared_ptr<const fd_t>> open_device_dir(
+  const fd_t* dir, const char* path) {
+    const capture_mode_t mode = syst::get_capture_mode();
+    if (mode == capture_mode_t::replay) {
+        return std::make_shared<const fd_t>(
+          -1, syst::get_capture_path(dir, path));
+    }
+
+    int fd = openat(dir == nullptr ? AT_FDCWD : dir->get(),
+      path,
+      O_PATH | O_DIRECTORY | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
         return RES_NEW_ERROR(
-          "Failed to read the first line of a file.\n\tfile: '" + path.string()
+          "Failed to open the directory of a device.\n\tpath: '"
+          + std::string{ path } + "'\n\treason: '" + syst::strerror(err)
           + "'");
     }
 
-    return first_line;
+    if (mode == capture_mode_t::record) {
+        return std::make_shared<const fd_t>(
+          fd, syst::get_capture_path(dir, path));
+    }
+    return std::make_shared<const fd_t>(fd);
+}
+
+std::string get_fd_path(const fd_t& fd) {
+    return syst::get_fd_path(fd.get());
 }
 
-res::optional_t<uint64_t> get_int(const std::filesystem::path& path) {
-    res::optional_t<std::string> value_str = syst::get_first_line(path);
-    if (value_str.has_error()) {
-        return RES_ERROR(value_str.error(),
-          "Failed to read an integer from a file.\n\tfile: '" + path.string()
-            + "'");
+std::string get_fd_path(int fd) {
+    std::error_code error;
+    syst::count_stat();
+    auto path = std::filesystem::read_symlink(
+      "/proc/self/fd/" + std::to_string(fd), error);
+    if (error) {
+        return "";
     }
 
-    unsigned long value = 0;
-    try {
-        value = std::stoul(value_str.value());
-    } catch (const std::invalid_argument& exception) {
+    return path.string();
+}
+
+std::string attribute_path(const fd_t& dir, const char* name) {
+    return syst::get_capture_path(&dir, name);
+}
+
+bool has_attribute_at(const fd_t& dir, const char* name) {
+    return syst::probe(&dir, name, [&] {
+        syst::count_stat();
+        return faccessat(dir.get(), name, F_OK, 0) == 0;
+    });
+}
+
+res::optional_t<fd_t> open_attribute(
+  const fd_t& dir, const char* name, int flags) {
+    int fd = openat(dir.get(), name, flags | O_CLOEXEC);
+    syst::count_open();
+    if (fd < 0) {
+        int err = errno;
+        // A removed device keeps its directory open, but its attributes are
+        // gone.
         return RES_NEW_ERROR(
-          "Encountered a std::invalid_argument exception while "
-          "attempting to convert a value to an integer which was "
-          "read from a file.\n\tvalue: '"
-          + value_str.value() + "'\n\tfile: '" + path.string()
-          + "'\n\texception: '" + exception.what() + "'");
-    } catch (const std::out_of_range& exception) {
+          "Failed to open an attribute of a device.\n\tfile: '"
+          + syst::attribute_path(dir, name) + "'\n\treason: '"
+          + syst::strerror(err) + "'");
+    }
+
+    return fd_t{ fd };
+}
+
+res::optional_t<std::string> read_attribute(const fd_t& dir, const char* name) {
+    std::string contents;
+    if (syst::get_capture_mode() == capture_mode_t::replay) {
+        if (! syst::replay_read(&dir, name, contents)) {
+            return syst::not_recorded(syst::attribute_path(dir, name));
+        }
+        return contents;
+    }
+
+    auto fd = syst::open_attribute(dir, name, O_RDONLY);
+    if (fd.has_error()) {
+        return RES_TRACE(fd.error());
+    }
+
+    int err = syst::read_all(fd.value(), contents);
+    if (err != 0) {
         return RES_NEW_ERROR(
-          "Encountered a std::out_of_range exception while "
-          "attempting to convert a value to an integer which was "
-          "read from a file.\n\tvalue: '"
-          + value_str.value() + "'\n\tfile: '" + path.string()
-          + "'\n\texception: '" + exception.what() + "'");
+          "Failed to read an attribute of a device.\n\tfile: '"
+          + syst::attribute_path(dir, name) + "'\n\treason: '"
+          + syst::strerror(err) + "'");
     }
+    syst::record_read(&dir, name, contents);
 
-    return value;
+    return contents;
 }
 
-res::optional_t<bool> get_bool(const std::filesystem::path& path) {
-    res::optional_t<uint64_t> integer = syst::get_int(path);
-    if (integer.has_error()) {
-        return RES_ERROR(integer.error(),
-          "Failed to read a boolean from a file.\n\tpath: '" + path.string()
-            + "'");
+res::optional_t<std::string> get_first_line_at(
+  const fd_t& dir, const char* name) {
+    auto contents = syst::read_attribute(dir, name);
+    if (contents.has_error()) {
+        return RES_TRACE(contents.error());
     }
 
-    if (integer.value() != 0 && integer.value() != 1) {
+    const size_t end = contents->find('\n');
+    if (end == std::string::npos) {
         return RES_NEW_ERROR(
-          "Expected a boolean value (either 0 or 1) from a file.\n\tvalue: '"
-          + std::to_string(integer.value()) + "'\n\tfile: '" + path.string()
-          + "'");
+          "Failed to read the first line of a file.\n\tfile: '"
+          + syst::attribute_path(dir, name) + "'");
     }
+    contents->resize(end);
 
-    return integer.value() == 1UL;
+    return contents;
 }
 
-res::result_t write_int(const std::filesystem::path& path, uint64_t integer) {
-    if (! std::filesystem::is_regular_file(path)) {
+read_error_t read_int_at(const fd_t& dir, const char* name, uint64_t& integer) {
+    read_error_t error{};
+    error.context = "Failed to read an integer from an attribute of a device.";
+    error.dir = &dir;
+    error.name = name;
+
+    syst::read_int_file(&dir, name, integer, error);
+    return error;
+}
+
+read_error_t read_bool_at(const fd_t& dir, const char* name, bool& boolean) {
+    read_error_t error{};
+    error.context = "Failed to read a boolean from an attribute of a device.";
+    error.dir = &dir;
+    error.name = name;
+
+    uint64_t integer = 0;
+    syst::read_int_file(&dir, name, integer, error);
+    if (! error.failed()) {
+        syst::int_to_bool(integer, boolean, error);
+    }
+    return error;
+}
+
+int parse_signed_int(const char* buffer, int64_t& integer) {
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(buffer, &end, 10);
+    if (errno != 0) {
+        return errno;
+    }
+    if (end == buffer) {
+        return EINVAL;
+    }
+
+    integer = static_cast<int64_t>(value);
+    return 0;
+}
+
+int read_signed_int(const fd_t& fd, int64_t& integer) {
+    const std::string& path = fd.get_capture_path();
+    if (! path.empty()) {
+        std::string contents;
+        if (syst::get_capture_mode() == capture_mode_t::replay) {
+            if (! syst::replay_read(nullptr, path.c_str(), contents)) {
+                return ENOENT;
+            }
+            return syst::parse_signed_int(contents.c_str(), integer);
+        }
+        if (syst::get_capture_mode() == capture_mode_t::record) {
+            // The whole file is read so that the capture holds its exact
+            // contents.
+            int err = syst::read_all(fd, contents);
+            if (err != 0) {
+                return err;
+            }
+            syst::record_read(nullptr, path.c_str(), contents);
+            return syst::parse_signed_int(contents.c_str(), integer);
+        }
+    }
+
+    // Integers exposed by sysfs are at most 20 digits long plus a sign and a
+    // trailing newline.
+    const size_t max_len = 32;
+    char buffer[max_len];
+
+    ssize_t len = pread(fd.get(), buffer, max_len - 1, 0);
+    if (len < 0) {
+        return errno;
+    }
+    syst::count_read(static_cast<size_t>(len));
+    buffer[len] = '\0';
+
+    return syst::parse_signed_int(buffer, integer);
+}
+
+int read_all(const fd_t& fd, std::string& contents) {
+    // Most sysfs files fit within a single page.
+    const size_t chunk_size = 4096;
+
+    contents.clear();
+    for (;;) {
+        const size_t offset = contents.size();
+        contents.resize(offset + chunk_size);
+
+        ssize_t len = pread(fd.get(),
+          contents.data() + offset,
+          chunk_size,
+          static_cast<off_t>(offset));
+        if (len < 0) {
+            int err = errno;
+            contents.clear();
+            return err;
+        }
+        syst::count_read(static_cast<size_t>(len));
+
+        contents.resize(offset + static_cast<size_t>(len));
+        if (static_cast<size_t>(len) < chunk_size) {
+            // A short read means the end of the file was reached, which saves
+            // a second read for files smaller than one chunk.
+            return 0;
+        }
+    }
+}
+
+int write_int(const fd_t& fd, uint64_t integer) {
+    std::string integer_str = std::to_string(integer);
+
+    ssize_t len = pwrite(fd.get(), integer_str.data(), integer_str.size(), 0);
+    if (len < 0) {
+        return errno;
+    }
+    if (static_cast<size_t>(len) != integer_str.size()) {
+        return EIO;
+    }
+
+    return 0;
+}
+
+res::optional_t<fd_t> create_timer(std::chrono::nanoseconds period) {
+    if (period.count() <= 0) {
         return RES_NEW_ERROR(
-          "The path is not a regular file.\n\tpath: '" + path.string() + "'");
+          "The period of a timer must be positive.\n\tperiod: '"
+          + std::to_string(period.count()) + "ns'");
     }
 
-    std::ofstream file{ path };
-    if ((file << integer).fail()) {
-        return RES_NEW_ERROR("Failed to write an integer to a file.\n\tpath: '"
-          + path.string() + "'\n\tinteger: '" + std::to_string(integer) + "'");
+    fd_t timer{ timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC) };
+    if (! timer.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to create a timer with 'timerfd_create'.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    auto result = syst::set_timer(timer, period);
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return timer;
+}
+
+res::result_t set_timer(const fd_t& timer, std::chrono::nanoseconds period) {
+    const int64_t nanoseconds_per_second = 1000000000;
+
+    struct itimerspec spec{};
+    spec.it_interval.tv_sec = period.count() / nanoseconds_per_second;
+    spec.it_interval.tv_nsec = period.count() % nanoseconds_per_second;
+    spec.it_value = spec.it_interval;
+
+    if (timerfd_settime(timer.get(), 0, &spec, nullptr) != 0) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to arm a timer with 'timerfd_settime'.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
     }
 
     return res::success;
 }
 
+res::result_t set_timer_deadline(
+  const fd_t& timer, std::chrono::steady_clock::time_point deadline) {
+    const int64_t nanoseconds_per_second = 1000000000;
+
+    // The steady clock is the monotonic clock, so the deadline can be used as
+    // an absolute time. A zero time would disarm the timer.
+    const auto since_epoch =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        deadline.time_since_epoch());
+    const int64_t nanoseconds =
+      std::max(static_cast<int64_t>(since_epoch.count()), int64_t{ 1 });
+
+    struct itimerspec spec{};
+    spec.it_value.tv_sec = nanoseconds / nanoseconds_per_second;
+    spec.it_value.tv_nsec = nanoseconds % nanoseconds_per_second;
+
+    if (timerfd_settime(timer.get(), TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+        int err = errno;
+        return RES_NEW_ERROR(
+          "Failed to arm a timer with 'timerfd_settime'.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    return res::success;
+}
+
+res::optional_t<uint64_t> read_timer(const fd_t& timer) {
+    uint64_t expirations = 0;
+    ssize_t len = read(timer.get(), &expirations, sizeof(expirations));
+    if (len < 0) {
+        int err = errno;
+        if (err == EAGAIN) {
+            return static_cast<uint64_t>(0);
+        }
+        return RES_NEW_ERROR("Failed to read from a timer.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+    syst::count_read(static_cast<size_t>(len));
+
+    return expirations;
+}
+
+res::optional_t<fd_t> open_netlink_socket(int protocol, uint32_t groups) {
+    fd_t fd{ socket(
+      AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol) };
+    if (! fd.is_open()) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to create a netlink socket.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    struct sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = groups;
+
+    if (bind(fd.get(),
+          reinterpret_cast<struct sockaddr*>(&address),
+          sizeof(address))
+      != 0) {
+        int err = errno;
+        return RES_NEW_ERROR("Failed to bind a netlink socket.\n\treason: '"
+          + std::string{ syst::strerror(err) } + "'");
+    }
+
+    return fd;
+}
+
+res::optional_t<bool> receive_netlink(const fd_t& fd,
+  const std::function<void(const char*, size_t)>& handle_message) {
+    // Large enough for any single uevent or rtnetlink link message.
+    std::array<char, 16384> buffer{};
+    bool overflowed = false;
+
+    while (true) {
+        ssize_t len = recv(fd.get(), buffer.data(), buffer.size(), 0);
+        if (len < 0) {
+            int err = errno;
+            if (err == EAGAIN || err == EWOULDBLOCK) {
+                return overflowed;
+            }
+            if (err == EINTR) {
+                continue;
+            }
+            if (err == ENOBUFS) {
+                // Messages that did not fit into the receive buffer were
+                // dropped by the kernel. Later messages are still delivered.
+                overflowed = true;
+                continue;
+            }
+            return RES_NEW_ERROR(
+              "Failed to receive from a netlink socket.\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+        syst::count_read(static_cast<size_t>(len));
+
+        handle_message(buffer.data(), static_cast<size_t>(len));
+    }
+}
+
+std::unordered_map<std::string, std::string> parse_netlink_uevent(
+  const char* message, size_t size) {
+    std::unordered_map<std::string, std::string> properties;
+
+    size_t offset = 0;
+    while (offset < size) {
+        const size_t length = strnlen(message + offset, size - offset);
+        const std::string line{ message + offset, length };
+        offset += length + 1;
+
+        const size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            // The header, which repeats ACTION and DEVPATH.
+            continue;
+        }
+        properties.emplace(
+          line.substr(0, separator), line.substr(separator + 1));
+    }
+
+    return properties;
+}
+
 bool has_prefix(const std::string& target, const std::string& prefix) {
     return target.find(prefix, 0) == 0;
 }
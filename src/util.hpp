@@ -1,61 +1,661 @@
 #pragma once
 
 // Standard includes
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 // External includes
 #include <cpp_result/all.hpp>
+#include <dirent.h>
+#include <fcntl.h>
+
+// Local includes
+#include "capture.hpp"
+#include "instrument.hpp"
+#include "roots.hpp"
+#include "strerror.hpp"
 
 namespace syst {
 
 /**
- * @brief Extract all lines from the file at the given path.
+ * @brief Extract the first line from the file at the given path.
  *
- * @param[in] path - The path to the file to extract all lines from.
- * @return a dynamic array of string with each string corresponding to one line
- * if the operation succeeded or an error otherwise.
+ * @param[in] path - The path to the file to extract the first line from.
+ * @return a string if the operation succeeded or an error otherwise.
  */
-[[nodiscard]] res::optional_t<std::vector<std::string>> get_all_lines(
+[[nodiscard]] res::optional_t<std::string> get_first_line(
   const std::filesystem::path& path);
 
 /**
- * @brief Extract the first line from the file at the given path.
+ * @brief Write an integer to the file at the given path.
  *
- * @param[in] path - The path to the file to extract the first line from.
- * @return a string if the operation succeeded or an error otherwise.
+ * @param[in] path - The path to the file to write to.
+ * @param[in] integer - The integer to write to the given file.
+ * @return success if the given integer was successfully written to the given
+ * file and failure otherwise.
  */
-[[nodiscard]] res::optional_t<std::string> get_first_line(
+res::result_t write_int(const std::filesystem::path& path, uint64_t integer);
+
+/**
+ * @brief Owns a file descriptor and closes it when destroyed. Used for files
+ * that are read or written repeatedly so that they only need to be opened
+ * once.
+ */
+class fd_t {
+    int fd_ = -1;
+
+    // The path that the file was opened with while reads were recorded or
+    // replayed, which identifies it in the capture (see capture.hpp). Empty
+    // otherwise. Files and directories that are served by the capture being
+    // replayed are never opened and only have this path.
+    std::string capture_path_;
+
+  public:
+    fd_t() = default;
+    explicit fd_t(int fd);
+
+    /**
+     * @param[in] fd - The file descriptor to own or -1 if the file is served
+     * by the capture being replayed.
+     * @param[in] capture_path - The path that identifies the file in captures.
+     */
+    fd_t(int fd, std::string capture_path);
+    fd_t(const fd_t&) = delete;
+    fd_t(fd_t&& fd) noexcept;
+    fd_t& operator=(const fd_t&) = delete;
+    fd_t& operator=(fd_t&& fd) noexcept;
+    ~fd_t();
+
+    /**
+     * @return the underlying file descriptor or -1 if no file is open.
+     */
+    [[nodiscard]] int get() const;
+
+    /**
+     * @return true if this object owns an open file descriptor and false
+     * otherwise.
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @return the path that identifies the file in captures or an empty string
+     * if it was opened while no reads were recorded or replayed.
+     */
+    [[nodiscard]] const std::string& get_capture_path() const;
+};
+
+/**
+ * @brief A failure to read a value from a file whose message has not been
+ * formatted yet. It only holds a code, an errno value, a static description
+ * and a handle to the file, so probes that are expected to fail create and
+ * discard it without allocating. Public functions call 'to_error' only where
+ * they return the failure, so its message is formatted once and only when it
+ * is reported.
+ */
+struct read_error_t {
+    enum class code_t {
+        none,         // The read succeeded.
+        open,         // The file could not be opened.
+        read,         // The file could not be read.
+        not_recorded, // The file is missing from the capture being replayed.
+        no_line,      // The file does not contain a complete line.
+        not_integer,  // The first line does not start with an integer.
+        out_of_range, // The integer does not fit in 64 bits.
+        not_boolean,  // The integer is neither 0 nor 1.
+    };
+
+    code_t code = code_t::none;
+
+    // The errno value of failed opens and reads.
+    int errnum = 0;
+
+    // A static description of the operation that failed.
+    const char* context = nullptr;
+
+    // The file is either a path or an attribute relative to a device
+    // directory. Both must outlive the error until it is formatted.
+    const std::filesystem::path* path = nullptr;
+    const fd_t* dir = nullptr;
+    const char* name = nullptr;
+
+    // The integer that is not a boolean.
+    uint64_t value = 0;
+
+    /**
+     * @return true if the read failed and false otherwise.
+     */
+    [[nodiscard]] bool failed() const;
+
+    /**
+     * @brief Format the message of this failure.
+     *
+     * @return an error describing this failure.
+     */
+    [[nodiscard]] res::error_t to_error() const;
+};
+
+/**
+ * @brief Read an unsigned integer from the first line of the file at the given
+ * path without formatting an error if the read fails.
+ *
+ * @param[in] path - The path to the file.
+ * @param[out] integer - The integer read from the file.
+ * @return the failure, which refers to the given path.
+ */
+[[nodiscard]] read_error_t read_int(
+  const std::filesystem::path& path, uint64_t& integer);
+
+/**
+ * @brief Read a boolean (0 or 1) from the first line of the file at the given
+ * path without formatting an error if the read fails.
+ *
+ * @param[in] path - The path to the file.
+ * @param[out] boolean - The boolean read from the file.
+ * @return the failure, which refers to the given path.
+ */
+[[nodiscard]] read_error_t read_bool(
+  const std::filesystem::path& path, bool& boolean);
+
+/**
+ * @brief Check whether a file exists without opening it. Used to probe
+ * optional attributes once when a device is enumerated.
+ *
+ * @param[in] path - The path to the file.
+ * @return true if the file exists and false otherwise.
+ */
+[[nodiscard]] bool has_attribute(const std::filesystem::path& path);
+
+/**
+ * @brief Open the file at the given path.
+ *
+ * @param[in] path - The path to the file to open.
+ * @param[in] flags - The flags to pass to open(2). O_CLOEXEC is always added.
+ * @return the open file descriptor if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_fd(
+  const std::filesystem::path& path, int flags);
+
+/**
+ * @brief Open a file that is sampled repeatedly with read_signed_int or a
+ * batch_reader_t. While a capture is replayed, the file is not opened since
+ * its reads are served by the capture.
+ *
+ * @param[in] path - The path to the file.
+ * @param[out] file - The open file.
+ * @return zero if the operation succeeded or an errno value otherwise.
+ */
+[[nodiscard]] int open_input(const std::filesystem::path& path, fd_t& file);
+
+/**
+ * @brief Open the sysfs directory of a device with O_PATH so that its
+ * attributes can be opened relative to it without resolving the whole path
+ * again. The directory stays pinned while it is open, so attributes of a
+ * device that was removed fail to open instead of resolving to a new device
+ * with the same name. While a capture is replayed, the directory is not
+ * opened since everything read relative to it is served by the capture.
+ *
+ * @param[in] dir - The directory that the path is relative to or null if the
+ * path is absolute or relative to the working directory.
+ * @param[in] path - The path to the device directory. Symbolic links are
+ * followed.
+ * @return the shared directory if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<std::shared_ptr<const fd_t>> open_device_dir(
+  const fd_t* dir, const char* path);
+
+/**
+ * @brief Get the path of an open file descriptor from /proc/self/fd. Only used
+ * to describe errors, so the path is never built when reads succeed.
+ *
+ * @param[in] fd - The open file descriptor.
+ * @return the path of the file or an empty string if it is unknown.
+ */
+[[nodiscard]] std::string get_fd_path(const fd_t& fd);
+
+/**
+ * @brief Get the path of an open file descriptor from /proc/self/fd.
+ *
+ * @param[in] fd - The open file descriptor.
+ * @return the path of the file or an empty string if it is unknown.
+ */
+[[nodiscard]] std::string get_fd_path(int fd);
+
+/**
+ * @brief Get the path to an attribute of a device. Only used to describe
+ * errors.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @return the path to the attribute.
+ */
+[[nodiscard]] std::string attribute_path(const fd_t& dir, const char* name);
+
+/**
+ * @brief Check whether an attribute of a device exists without opening it.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @return true if the attribute exists and false otherwise.
+ */
+[[nodiscard]] bool has_attribute_at(const fd_t& dir, const char* name);
+
+/**
+ * @brief Open an attribute of a device with openat(2).
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @param[in] flags - The flags to pass to openat(2). O_CLOEXEC is always
+ * added.
+ * @return the open attribute if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_attribute(
+  const fd_t& dir, const char* name, int flags);
+
+/**
+ * @brief Read the entire contents of an attribute of a device.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @return the contents if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<std::string> read_attribute(
+  const fd_t& dir, const char* name);
+
+/**
+ * @brief Extract the first line from an attribute of a device.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @return the first line if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<std::string> get_first_line_at(
+  const fd_t& dir, const char* name);
+
+/**
+ * @brief Read an unsigned integer from an attribute of a device without
+ * formatting an error if the read fails.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @param[out] integer - The integer read from the attribute.
+ * @return the failure, which refers to the given directory and name.
+ */
+[[nodiscard]] read_error_t read_int_at(
+  const fd_t& dir, const char* name, uint64_t& integer);
+
+/**
+ * @brief Read a boolean (0 or 1) from an attribute of a device without
+ * formatting an error if the read fails.
+ *
+ * @param[in] dir - The device directory opened by open_device_dir.
+ * @param[in] name - The path to the attribute relative to the directory.
+ * @param[out] boolean - The boolean read from the attribute.
+ * @return the failure, which refers to the given directory and name.
+ */
+[[nodiscard]] read_error_t read_bool_at(
+  const fd_t& dir, const char* name, bool& boolean);
+
+/**
+ * @brief Open a directory for reading its entries with read_directory.
+ *
+ * @param[in] path - The path to the directory.
+ * @return the open directory if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_directory(
   const std::filesystem::path& path);
 
 /**
- * @brief Extract an integer from the file at the given path.
+ * @brief List the names of the entries of a directory, except for '.' and
+ * '..', and record them, or serve them from the capture being replayed.
  *
- * @param[in] path - The path to the file to extract an integer from.
- * @return an integer if the operation succeeded or an error otherwise.
+ * @param[in] path - The path to the directory.
+ * @return the names of the entries if the operation succeeded or an error
+ * otherwise.
  */
-[[nodiscard]] res::optional_t<uint64_t> get_int(
+[[nodiscard]] res::optional_t<std::vector<std::string>> list_directory(
   const std::filesystem::path& path);
 
 /**
- * @brief Extract a boolean (0 or 1) from the file at the given path.
+ * @brief Read the next batch of entries from an open directory with
+ * getdents64(2). The buffer holds consecutive dirent64 records.
  *
- * @param[in] path - The path to the file to extract a boolean from.
- * @return a boolean if the operation succeeded or an error otherwise.
+ * @param[in] dir - The directory opened by open_directory.
+ * @param[out] buffer - The buffer to read the entries into. Must be aligned
+ * for dirent64.
+ * @param[in] size - The size of the buffer.
+ * @param[out] len - The number of bytes read. Zero at the end of the
+ * directory.
+ * @return zero if the operation succeeded or an errno value otherwise.
  */
-[[nodiscard]] res::optional_t<bool> get_bool(const std::filesystem::path& path);
+[[nodiscard]] int read_directory(
+  const fd_t& dir, char* buffer, size_t size, size_t& len);
 
 /**
- * @brief Write an integer to the file at the given path.
+ * @brief Check whether a directory entry is a symbolic link. Only calls
+ * fstatat(2) if the filesystem does not report the type of its entries.
  *
- * @param[in] path - The path to the file to write to.
+ * @param[in] dir - The directory containing the entry.
+ * @param[in] entry - The entry read by read_directory.
+ * @return true if the entry is a symbolic link and false otherwise.
+ */
+[[nodiscard]] bool is_symlink_entry(
+  const fd_t& dir, const struct dirent64& entry);
+
+/**
+ * @brief Check whether a name in a class directory is a device, which is a
+ * symbolic link to the device directory.
+ *
+ * @param[in] dir - The class directory.
+ * @param[in] name - The name of the device.
+ * @return true if the device exists and false otherwise.
+ */
+[[nodiscard]] bool has_class_entry(const fd_t& dir, const char* name);
+
+/**
+ * @brief Open a sysfs class directory for reading its entries. While a capture
+ * is replayed, the directory is not opened since its entries are served by
+ * the capture.
+ *
+ * @param[in] root - The sysfs root.
+ * @param[in] class_path - The path to the class directory relative to the
+ * root.
+ * @return the open directory if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_class_dir(
+  const root_t& root, const std::filesystem::path& class_path);
+
+/**
+ * @brief List the names of the devices in a class directory and record them,
+ * or serve them from the capture being replayed.
+ *
+ * @param[in] dir - The class directory opened by open_class_dir.
+ * @return the names of the devices if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<std::vector<std::string>> list_class_entries(
+  const fd_t& dir);
+
+/**
+ * @brief An entry of a class directory passed to the handler of
+ * for_each_class_entry.
+ */
+struct class_entry_t {
+    // The class directory, for opening the device relative to it with
+    // open_device_dir.
+    const fd_t& dir;
+
+    // The name of the device. Null-terminated and only valid while the handler
+    // runs.
+    std::string_view name;
+
+    // The path to the class directory with relative paths resolved against
+    // the sysfs root.
+    const std::filesystem::path& class_path;
+};
+
+/**
+ * @brief Call a handler for every device in a sysfs class directory (such as
+ * /sys/class/net) whose name has the given prefix. Devices are the symbolic
+ * links in the directory. Names are filtered in the buffer the entries are
+ * read into, so skipped entries cost no allocations or system calls. While
+ * reads are recorded or replayed, the devices are listed by the capture
+ * instead.
+ *
+ * @param[in] class_path - The path to the class directory. Relative paths are
+ * resolved against the sysfs root.
+ * @param[in] prefix - The prefix of the names of the devices to handle.
+ * @param[in] handle_entry - Called with each device. Enumeration stops if it
+ * fails.
+ * @return a result indicating success or failure.
+ */
+template<typename handle_entry_t>
+[[nodiscard]] res::result_t for_each_class_entry(
+  const std::filesystem::path& class_path,
+  std::string_view prefix,
+  const handle_entry_t& handle_entry) {
+    auto root = syst::get_sys_root();
+    if (root.has_error()) {
+        return RES_TRACE(root.error());
+    }
+    const std::filesystem::path path = root.value()->path / class_path;
+
+    auto dir = syst::open_class_dir(*root.value(), class_path);
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
+
+    if (syst::get_capture_mode() != capture_mode_t::off) {
+        auto names = syst::list_class_entries(dir.value());
+        if (names.has_error()) {
+            return RES_TRACE(names.error());
+        }
+
+        for (const std::string& name : names.value()) {
+            if (name.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+
+            auto result =
+              handle_entry(class_entry_t{ dir.value(), name, path });
+            if (result.failure()) {
+                return RES_TRACE(result.error());
+            }
+        }
+        return res::success;
+    }
+
+    // Large enough for most class directories to be read in one call.
+    alignas(struct dirent64) std::array<char, 16384> buffer{};
+
+    while (true) {
+        size_t len = 0;
+        int err =
+          syst::read_directory(dir.value(), buffer.data(), buffer.size(), len);
+        if (err != 0) {
+            return RES_NEW_ERROR(
+              "Failed to read the entries of a directory.\n\tpath: '"
+              + path.string() + "'\n\treason: '"
+              + std::string{ syst::strerror(err) } + "'");
+        }
+        if (len == 0) {
+            return res::success;
+        }
+
+        for (size_t offset = 0; offset < len;) {
+            const auto* entry =
+              reinterpret_cast<const struct dirent64*>(buffer.data() + offset);
+            offset += entry->d_reclen;
+            syst::count_directory_entries(1);
+
+            const std::string_view name{ entry->d_name };
+            if (name.substr(0, prefix.size()) != prefix) {
+                continue;
+            }
+            if (! syst::is_symlink_entry(dir.value(), *entry)) {
+                // Ignore entries that are not links to devices, such as
+                // 'bonding_masters' in /sys/class/net.
+                continue;
+            }
+
+            auto result =
+              handle_entry(class_entry_t{ dir.value(), name, path });
+            if (result.failure()) {
+                return RES_TRACE(result.error());
+            }
+        }
+    }
+}
+
+/**
+ * @brief Call a handler for one device in a sysfs class directory without
+ * reading the other entries of the directory.
+ *
+ * @param[in] class_path - The path to the class directory. Relative paths are
+ * resolved against the sysfs root.
+ * @param[in] name - The name of the device.
+ * @param[in] handle_entry - Called with the device.
+ * @return a result indicating success or failure.
+ */
+template<typename handle_entry_t>
+[[nodiscard]] res::result_t handle_class_entry(
+  const std::filesystem::path& class_path,
+  const std::string& name,
+  const handle_entry_t& handle_entry) {
+    auto root = syst::get_sys_root();
+    if (root.has_error()) {
+        return RES_TRACE(root.error());
+    }
+    const std::filesystem::path path = root.value()->path / class_path;
+
+    auto dir = syst::open_class_dir(*root.value(), class_path);
+    if (dir.has_error()) {
+        return RES_TRACE(dir.error());
+    }
+
+    if (! syst::has_class_entry(dir.value(), name.c_str())) {
+        return RES_NEW_ERROR(
+          "The device does not exist in its class directory.\n\tpath: '"
+          + (path / name).string() + "'");
+    }
+
+    auto result = handle_entry(class_entry_t{ dir.value(), name, path });
+    if (result.failure()) {
+        return RES_TRACE(result.error());
+    }
+
+    return res::success;
+}
+
+/**
+ * @brief Parse a signed integer from the contents of a sysfs attribute.
+ *
+ * @param[in] buffer - The contents of the attribute. Must be null-terminated.
+ * @param[out] integer - The parsed integer.
+ * @return zero if the operation succeeded or an errno value otherwise. EINVAL
+ * is returned if the contents do not start with an integer.
+ */
+[[nodiscard]] int parse_signed_int(const char* buffer, int64_t& integer);
+
+/**
+ * @brief Read a signed integer from the beginning of an open file. The file
+ * offset is not modified, so the same file descriptor can be read repeatedly.
+ * Files opened while reads are recorded or replayed are recorded or served by
+ * the capture.
+ *
+ * @param[in] fd - The open file descriptor to read from.
+ * @param[out] integer - The integer read from the file.
+ * @return zero if the operation succeeded or an errno value otherwise. EINVAL
+ * is returned if the file does not contain an integer.
+ */
+[[nodiscard]] int read_signed_int(const fd_t& fd, int64_t& integer);
+
+/**
+ * @brief Read the entire contents of an open file starting from the beginning.
+ * The file offset is not modified, so the same file descriptor can be read
+ * repeatedly.
+ *
+ * @param[in] fd - The open file descriptor to read from.
+ * @param[out] contents - The contents of the file.
+ * @return zero if the operation succeeded or an errno value otherwise.
+ */
+[[nodiscard]] int read_all(const fd_t& fd, std::string& contents);
+
+/**
+ * @brief Write an integer to the beginning of an open file. Intended for sysfs
+ * attributes, which are always written at offset zero.
+ *
+ * @param[in] fd - The open file descriptor to write to.
  * @param[in] integer - The integer to write to the given file.
- * @return success if the given integer was successfully written to the given
- * file and failure otherwise.
+ * @return zero if the operation succeeded or an errno value otherwise.
  */
-res::result_t write_int(const std::filesystem::path& path, uint64_t integer);
+[[nodiscard]] int write_int(const fd_t& fd, uint64_t integer);
+
+/**
+ * @brief Create a non-blocking timer file descriptor that expires periodically
+ * on the monotonic clock. The file descriptor becomes readable each time the
+ * timer expires.
+ *
+ * @param[in] period - The time between expirations.
+ * @return the timer file descriptor if the operation succeeded or an error
+ * otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> create_timer(
+  std::chrono::nanoseconds period);
+
+/**
+ * @brief Change the period of a timer created by create_timer. The first
+ * expiration occurs one period from now.
+ *
+ * @param[in] timer - The timer file descriptor.
+ * @param[in] period - The time between expirations. Zero disarms the timer.
+ * @return a result indicating success or failure.
+ */
+res::result_t set_timer(const fd_t& timer, std::chrono::nanoseconds period);
+
+/**
+ * @brief Make a timer created by create_timer expire once at the given time on
+ * the monotonic clock instead of periodically.
+ *
+ * @param[in] timer - The timer file descriptor.
+ * @param[in] deadline - The time of the expiration. The timer expires
+ * immediately if this is in the past.
+ * @return a result indicating success or failure.
+ */
+res::result_t set_timer_deadline(
+  const fd_t& timer, std::chrono::steady_clock::time_point deadline);
+
+/**
+ * @brief Consume all pending expirations of a timer created by create_timer.
+ *
+ * @param[in] timer - The timer file descriptor.
+ * @return the number of expirations since the last call (zero if the timer has
+ * not expired yet) if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<uint64_t> read_timer(const fd_t& timer);
+
+/**
+ * @brief Open a non-blocking netlink socket bound to the given multicast
+ * groups.
+ *
+ * @param[in] protocol - The netlink protocol (e.g. NETLINK_KOBJECT_UEVENT).
+ * @param[in] groups - The bitmask of multicast groups to join.
+ * @return the socket if the operation succeeded or an error otherwise.
+ */
+[[nodiscard]] res::optional_t<fd_t> open_netlink_socket(
+  int protocol, uint32_t groups);
+
+/**
+ * @brief Receive every pending message from a non-blocking netlink socket.
+ *
+ * @param[in] fd - The netlink socket.
+ * @param[in] handle_message - Called with each message and its size.
+ * @return true if the kernel dropped messages because the receive buffer
+ * overflowed, false otherwise, or an error if receiving failed.
+ */
+[[nodiscard]] res::optional_t<bool> receive_netlink(const fd_t& fd,
+  const std::function<void(const char*, size_t)>& handle_message);
+
+/**
+ * @brief Parse a kernel event (uevent) of the form "action@devpath" followed
+ * by null-terminated "KEY=value" pairs.
+ *
+ * @param[in] message - The message received from the uevent socket.
+ * @param[in] size - The size of the message.
+ * @return the properties of the event.
+ */
+[[nodiscard]] std::unordered_map<std::string, std::string>
+parse_netlink_uevent(
+  const char* message, size_t size);
 
 /**
  * @brief Check whether a target string has the given prefix.
@@ -22,6 +22,8 @@
 #ifndef SYST_SYSTEM_STATE_H
 #define SYST_SYSTEM_STATE_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 #include "system_state.hpp"
 #endif
@@ -32,6 +34,24 @@ extern "C" {
 
 void syst_string_free(char* error);
 
+/* The size of the name buffers in snapshots, including the null terminator. */
+#define SYST_NAME_SIZE 256
+
+/* Returned by the snapshot functions. Only syst_error_failed has a message,
+ * which is converted to a string by syst_get_last_error. */
+typedef enum syst_error_t {
+    syst_ok,
+    syst_error_null_argument,
+    syst_error_buffer_too_small,
+    syst_error_failed,
+} syst_error_t;
+
+/* Copies the message of the error of the last call on this thread that
+ * returned a syst_error_t into the given buffer, truncated and null
+ * terminated, and returns the length of the whole message (like snprintf).
+ * Returns zero if that call succeeded or did not set a message. */
+unsigned long syst_get_last_error(char* buffer, unsigned long size);
+
 #ifdef __cplusplus
 using syst_backlight_t = syst::backlight_t;
 using syst_backlight_list_t = std::vector<syst_backlight_t>;
@@ -52,6 +72,12 @@ void syst_backlight_set_brightness(
   syst_backlight_t* backlight, double brightness, char** error);
 void syst_backlight_set_brightness_relative(
   syst_backlight_t* backlight, double brightness, char** error);
+typedef struct syst_backlight_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    double brightness;
+} syst_backlight_snapshot_t;
+syst_error_t syst_backlight_snapshot(
+  syst_backlight_t* backlight, syst_backlight_snapshot_t* snapshot);
 
 #ifdef __cplusplus
 using syst_battery_t = syst::battery_t;
@@ -83,6 +109,25 @@ double syst_battery_get_charge(syst_battery_t* battery, char** error);
 double syst_battery_get_capacity(syst_battery_t* battery, char** error);
 unsigned long syst_battery_get_time_remaining(
   syst_battery_t* battery, char** error);
+/* Values that the battery does not report are zero and their has_ flag is
+ * zero. */
+typedef struct syst_battery_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    int has_status;
+    syst_battery_status_t status;
+    int has_current;
+    double current;
+    int has_power;
+    double power;
+    int has_charge;
+    double charge;
+    int has_capacity;
+    double capacity;
+    int has_time_remaining;
+    unsigned long time_remaining;
+} syst_battery_snapshot_t;
+syst_error_t syst_battery_snapshot(
+  syst_battery_t* battery, syst_battery_snapshot_t* snapshot);
 
 #ifdef __cplusplus
 using syst_sound_mixer_t = syst::sound_mixer_t;
@@ -135,6 +180,193 @@ void syst_sound_control_set_capture_volume_all(
   syst_sound_control_t* sound_control, double volume, char** error);
 void syst_sound_control_set_capture_volume_all_relative(
   syst_sound_control_t* sound_control, double volume, char** error);
+typedef enum syst_sound_channel_t {
+    syst_sound_channel_front_left,
+    syst_sound_channel_front_right,
+    syst_sound_channel_rear_left,
+    syst_sound_channel_rear_right,
+    syst_sound_channel_front_center,
+    syst_sound_channel_woofer,
+    syst_sound_channel_side_left,
+    syst_sound_channel_side_right,
+    syst_sound_channel_rear_center,
+    syst_sound_channel_count,
+} syst_sound_channel_t;
+/* Bit (1 << channel) of 'channels' is set for each channel that is present. */
+typedef struct syst_sound_volume_t {
+    unsigned int channels;
+    double volume[syst_sound_channel_count];
+} syst_sound_volume_t;
+typedef struct syst_sound_status_t {
+    unsigned int channels;
+    int status[syst_sound_channel_count];
+} syst_sound_status_t;
+typedef struct syst_sound_control_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    unsigned int index;
+    syst_sound_volume_t playback_volume;
+    syst_sound_status_t playback_status;
+    syst_sound_volume_t capture_volume;
+    syst_sound_status_t capture_status;
+} syst_sound_control_snapshot_t;
+/* Any of the output arguments may be null if they are not needed. */
+syst_error_t syst_sound_control_read(syst_sound_control_t* sound_control,
+  syst_sound_volume_t* playback_volume,
+  syst_sound_status_t* playback_status);
+syst_error_t syst_sound_control_snapshot(
+  syst_sound_control_t* sound_control,
+  syst_sound_control_snapshot_t* snapshot);
+
+typedef struct syst_system_info_t {
+    uint64_t uptime;
+    double load_1;
+    double load_5;
+    double load_15;
+    uint64_t ram_total;
+    uint64_t ram_free;
+    uint64_t ram_shared;
+    uint64_t ram_buffered;
+    uint64_t swap_total;
+    uint64_t swap_free;
+    uint64_t procs;
+    double ram_usage;
+    double swap_usage;
+} syst_system_info_t;
+syst_error_t syst_get_system_info(syst_system_info_t* info);
+
+/* Keeps the previous sample between calls to syst_cpu_usage_update. */
+#ifdef __cplusplus
+using syst_cpu_usage_t = syst::cpu_usage_t;
+#else
+typedef struct syst_cpu_usage_t syst_cpu_usage_t;
+#endif
+syst_cpu_usage_t* syst_cpu_usage_new(void);
+void syst_cpu_usage_free(syst_cpu_usage_t* cpu_usage);
+syst_error_t syst_cpu_usage_update(syst_cpu_usage_t* cpu_usage);
+syst_error_t syst_cpu_usage_get_total(
+  syst_cpu_usage_t* cpu_usage, double* total);
+/* On input, *count is the capacity of the array. On output, *count is the
+ * number of cores, even if the array is too small. */
+syst_error_t syst_cpu_usage_get_per_core(
+  syst_cpu_usage_t* cpu_usage, double* per_core, unsigned long* count);
+
+/* Times are in milliseconds. */
+typedef struct syst_io_stat_t {
+    uint64_t reads_completed;
+    uint64_t reads_merged;
+    uint64_t sectors_read;
+    uint64_t time_by_reads;
+    uint64_t writes_completed;
+    uint64_t writes_merged;
+    uint64_t sectors_written;
+    uint64_t time_by_writes;
+    uint64_t io_in_flight;
+    uint64_t time_spent_queued;
+    uint64_t time_by_queued_io;
+    uint64_t discards_completed;
+    uint64_t discards_merged;
+    uint64_t sectors_discarded;
+    uint64_t time_by_discards;
+} syst_io_stat_t;
+typedef struct syst_inflight_stat_t {
+    uint64_t reads;
+    uint64_t writes;
+} syst_inflight_stat_t;
+
+#ifdef __cplusplus
+using syst_disk_t = syst::disk_t;
+using syst_disk_list_t = std::vector<syst_disk_t>;
+using syst_part_list_t = std::vector<syst::part_t>;
+#else
+typedef struct syst_disk_t syst_disk_t;
+typedef struct syst_disk_list_t syst_disk_list_t;
+typedef struct syst_part_list_t syst_part_list_t;
+#endif
+syst_disk_list_t* syst_get_disks(char** error);
+unsigned long syst_disk_list_get_size(
+  syst_disk_list_t* disk_list, char** error);
+syst_disk_t* syst_disk_list_get(
+  syst_disk_list_t* disk_list, unsigned long index, char** error);
+void syst_disk_list_free(syst_disk_list_t* disk_list);
+syst_part_list_t* syst_disk_get_parts(syst_disk_t* disk, char** error);
+unsigned long syst_part_list_get_size(
+  syst_part_list_t* part_list, char** error);
+void syst_part_list_free(syst_part_list_t* part_list);
+/* Values that the device does not report are zero and their has_ flag is
+ * zero. */
+typedef struct syst_block_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    int has_size;
+    uint64_t size;
+    int has_inflight_stat;
+    syst_inflight_stat_t inflight_stat;
+    int has_io_stat;
+    syst_io_stat_t io_stat;
+} syst_block_snapshot_t;
+/* Fill one snapshot per device. The array must have room for every device in
+ * the list. */
+syst_error_t syst_disk_list_snapshot(syst_disk_list_t* disk_list,
+  syst_block_snapshot_t* snapshots,
+  unsigned long count);
+syst_error_t syst_part_list_snapshot(syst_part_list_t* part_list,
+  syst_block_snapshot_t* snapshots,
+  unsigned long count);
+
+#ifdef __cplusplus
+using syst_network_interface_list_t = std::vector<syst::network_interface_t>;
+#else
+typedef struct syst_network_interface_list_t syst_network_interface_list_t;
+#endif
+syst_network_interface_list_t* syst_get_network_interfaces(char** error);
+unsigned long syst_network_interface_list_get_size(
+  syst_network_interface_list_t* network_interface_list, char** error);
+void syst_network_interface_list_free(
+  syst_network_interface_list_t* network_interface_list);
+typedef enum syst_network_interface_status_t {
+    syst_network_interface_status_unknown,
+    syst_network_interface_status_up,
+    syst_network_interface_status_dormant,
+    syst_network_interface_status_down,
+} syst_network_interface_status_t;
+typedef struct syst_network_interface_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    int has_status;
+    syst_network_interface_status_t status;
+    int has_stat;
+    uint64_t bytes_down;
+    uint64_t bytes_up;
+    uint64_t packets_down;
+    uint64_t packets_up;
+} syst_network_interface_snapshot_t;
+syst_error_t syst_network_interface_list_snapshot(
+  syst_network_interface_list_t* network_interface_list,
+  syst_network_interface_snapshot_t* snapshots,
+  unsigned long count);
+
+#ifdef __cplusplus
+using syst_thermal_zone_list_t = std::vector<syst::thermal_zone_t>;
+#else
+typedef struct syst_thermal_zone_list_t syst_thermal_zone_list_t;
+#endif
+syst_thermal_zone_list_t* syst_get_thermal_zones(char** error);
+unsigned long syst_thermal_zone_list_get_size(
+  syst_thermal_zone_list_t* thermal_zone_list, char** error);
+void syst_thermal_zone_list_free(syst_thermal_zone_list_t* thermal_zone_list);
+/* The type does not change, so it is not part of the snapshot. */
+syst_error_t syst_thermal_zone_list_get_type(
+  syst_thermal_zone_list_t* thermal_zone_list,
+  unsigned long index,
+  char* buffer,
+  unsigned long size);
+typedef struct syst_thermal_zone_snapshot_t {
+    char name[SYST_NAME_SIZE];
+    int has_temperature;
+    double temperature;
+} syst_thermal_zone_snapshot_t;
+syst_error_t syst_thermal_zone_list_snapshot(
+  syst_thermal_zone_list_t* thermal_zone_list,
+  syst_thermal_zone_snapshot_t* snapshots,
+  unsigned long count);
 
 #ifdef __cplusplus
 } // extern "C"
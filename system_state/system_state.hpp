@@ -25,6 +25,10 @@
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <optional>
@@ -37,6 +41,98 @@ namespace syst {
 namespace fs = std::filesystem;
 namespace ch = std::chrono;
 
+// An open file descriptor. Devices share the O_PATH file descriptor of their
+// sysfs directory between copies and open their attributes relative to it.
+class fd_t;
+
+// A device in a sysfs class directory. Devices are created from these when
+// their class directory is enumerated or when the kernel reports them.
+struct class_entry_t;
+
+/**
+ * @brief The directories that procfs, sysfs, and devfs are read from.
+ */
+struct roots_t {
+    fs::path sys = "/sys";
+    fs::path proc = "/proc";
+    fs::path dev = "/dev";
+};
+
+/**
+ * @brief Read procfs, sysfs, and devfs from other directories, such as the
+ * /host/proc and /host/sys of a container or a generated tree for testing.
+ * Each directory is opened once and later lookups are made relative to it.
+ *
+ * Relative paths given to this library (such as the default class paths of
+ * the enumeration functions) are resolved against these directories, while
+ * absolute paths are used as they are. Devices that were already enumerated
+ * keep reading from their original directories. Replaced directories stay
+ * open until the process exits so that concurrent reads never wait for this
+ * function, which is meant to be called rarely (usually once at startup).
+ *
+ * @param[in] roots - The directories to read from.
+ * @return a result indicating success or failure. The previous directories
+ * are kept if any of the new ones cannot be opened.
+ */
+[[nodiscard]] res::result_t set_roots(const roots_t& roots);
+
+/**
+ * @return the directories that procfs, sysfs, and devfs are read from.
+ */
+[[nodiscard]] roots_t get_roots();
+
+/**
+ * @brief Record the contents of every procfs and sysfs file read by this
+ * library into a capture file so that the reads can later be replayed (see
+ * start_replay). Each successful read is appended to the file with its path
+ * and the time it was made. Paths within the roots (see set_roots) are
+ * recorded as if the default roots were used, so a capture recorded in a
+ * container is replayed like one recorded on its host.
+ *
+ * The devices listed in class directories and the files whose existence is
+ * checked are recorded as well. Files that are held open and read repeatedly
+ * (such as by the thermal governor, ramps, and hwmon sensors) are only
+ * recorded if they were opened while reads were being recorded.
+ *
+ * @param[in] capture_path - The path to the capture file. It is replaced if
+ * it already exists.
+ * @return a result indicating success or failure. Fails if reads are already
+ * being recorded or replayed.
+ */
+[[nodiscard]] res::result_t start_recording(const fs::path& capture_path);
+
+/**
+ * @brief Stop recording reads and close the capture file.
+ *
+ * @return a result indicating success or failure. Fails if no reads are being
+ * recorded or if any read could not be written to the capture file.
+ */
+[[nodiscard]] res::result_t stop_recording();
+
+/**
+ * @brief Serve the contents of files read by this library from a capture file
+ * (see start_recording) instead of reading them. The contents recorded for a
+ * file are served in the order they were recorded and start over after the
+ * last one, so a capture can be replayed any number of times. The recorded
+ * times are not waited for.
+ *
+ * Devices are enumerated from the capture and their directories are not
+ * opened, so a capture can be replayed without the directories it was
+ * recorded from. Reading a file that was not recorded fails. Files that are
+ * written (such as by the thermal governor and ramps) are still opened, and
+ * files that were held open before the replay started are still read.
+ *
+ * @param[in] capture_path - The path to the capture file.
+ * @return a result indicating success or failure. Fails if reads are already
+ * being recorded or replayed.
+ */
+[[nodiscard]] res::result_t start_replay(const fs::path& capture_path);
+
+/**
+ * @brief Stop replaying reads so that files are read again.
+ */
+void stop_replay();
+
 /**
  * @return the username of the owner of this process.
  */
@@ -87,7 +183,9 @@ struct system_info_t {
 };
 
 /**
- * @return system information from sysinfo.
+ * @return system information from sysinfo(2), or from the uptime, loadavg,
+ * and meminfo files of procfs if another procfs directory is set (see
+ * set_roots).
  */
 [[nodiscard]] res::optional_t<system_info_t> get_system_info();
 
@@ -168,17 +266,40 @@ class part_t;
  * @brief Represents a disk block device on this system.
  */
 class disk_t {
+  public:
+    /**
+     * @brief Optional attributes of a disk, probed once when the disk is
+     * enumerated.
+     */
+    struct capabilities_t {
+        // The disk reports whether it is rotational (queue/rotational).
+        bool rotational;
+
+        // The disk reports in-flight statistics (inflight).
+        bool inflight_stat;
+
+        // The disk reports I/O statistics (stat and queue/iostats).
+        bool io_stat;
+    };
+
+  private:
     fs::path sysfs_path_;
+    std::shared_ptr<const fd_t> dir_;
     fs::path devfs_path_;
+    capabilities_t capabilities_;
 
-    disk_t(const fs::path& sysfs_path, const fs::path& devfs_path);
+    disk_t(const fs::path& sysfs_path,
+      std::shared_ptr<const fd_t> dir,
+      const fs::path& devfs_path,
+      const capabilities_t& capabilities);
 
     // Some classes need to access the private constructor for this class, but
     // not all classes need access.
     friend part_t;
 
     // Some functions require access to private members.
-    friend res::optional_t<std::vector<disk_t>> get_disks();
+    friend res::result_t append_disk(
+      const class_entry_t& entry, std::vector<disk_t>& disks);
 
   public:
     /**
@@ -193,8 +314,8 @@ class disk_t {
     [[nodiscard]] fs::path get_sysfs_path() const;
 
     /**
-     * @return the path to this device in /dev. This provides access to the
-     * device itself.
+     * @return the path to this device in devfs (see set_roots). This provides
+     * access to the device itself. The device node is not guaranteed to exist.
      */
     [[nodiscard]] fs::path get_devfs_path() const;
 
@@ -203,6 +324,11 @@ class disk_t {
      */
     [[nodiscard]] std::string get_name() const;
 
+    /**
+     * @return the optional attributes supported by this device.
+     */
+    [[nodiscard]] capabilities_t get_capabilities() const;
+
     /**
      * @return the size of this device in bytes.
      */
@@ -253,14 +379,14 @@ struct mount_info_t {
  */
 class part_t {
     fs::path sysfs_path_;
+    std::shared_ptr<const fd_t> dir_;
     fs::path devfs_path_;
-    fs::path disk_sysfs_path_;
-    fs::path disk_devfs_path_;
+    disk_t disk_;
 
     part_t(const fs::path& sysfs_path,
+      std::shared_ptr<const fd_t> dir,
       const fs::path& devfs_path,
-      const fs::path& disk_sysfs_path,
-      const fs::path& disk_devfs_path);
+      const disk_t& disk);
 
     // Some classes need to access the private constructor for this class, but
     // not all classes need access.
@@ -274,8 +400,9 @@ class part_t {
     [[nodiscard]] fs::path get_sysfs_path() const;
 
     /**
-     * @return the path to this partition in /dev. This provides access to the
-     * partition itself.
+     * @return the path to this partition in devfs (see set_roots). This
+     * provides access to the partition itself. The device node is not
+     * guaranteed to exist.
      */
     [[nodiscard]] fs::path get_devfs_path() const;
 
@@ -377,21 +504,44 @@ class cpu_usage_t {
 class thermal_zone_t;
 
 /**
+ * @param[in] thermal_path - The path to the thermal class directory. This is
+ * only changed for testing. Relative paths are resolved against the sysfs root
+ * (see set_roots).
  * @return all thermal zones on this system.
  */
-[[nodiscard]] res::optional_t<std::vector<thermal_zone_t>> get_thermal_zones();
+[[nodiscard]] res::optional_t<std::vector<thermal_zone_t>> get_thermal_zones(
+  const fs::path& thermal_path = "class/thermal");
 
 /**
  * @brief Represents a device with thermal information, such as a temperature
  * sensor.
  */
 class thermal_zone_t {
+  public:
+    /**
+     * @brief Optional attributes of a thermal zone, probed once when the zone
+     * is enumerated.
+     */
+    struct capabilities_t {
+        // The zone reports its temperature (temp).
+        bool temperature;
+
+        // The number of trip points reported by the zone (trip_point_N_temp).
+        uint64_t trip_points;
+    };
+
+  private:
     fs::path sysfs_path_;
+    std::shared_ptr<const fd_t> dir_;
+    capabilities_t capabilities_;
 
-    thermal_zone_t(const fs::path& sysfs_path);
+    thermal_zone_t(const fs::path& sysfs_path,
+      std::shared_ptr<const fd_t> dir,
+      const capabilities_t& capabilities);
 
     // Some functions require access to private members.
-    friend res::optional_t<std::vector<thermal_zone_t>> get_thermal_zones();
+    friend res::result_t append_thermal_zone(
+      const class_entry_t& entry, std::vector<thermal_zone_t>& thermal_zones);
 
   public:
     /**
@@ -400,6 +550,11 @@ class thermal_zone_t {
      */
     [[nodiscard]] fs::path get_sysfs_path() const;
 
+    /**
+     * @return the optional attributes supported by this thermal zone.
+     */
+    [[nodiscard]] capabilities_t get_capabilities() const;
+
     /**
      * @return the type of this thermal zone represented as a string.
      */
@@ -414,10 +569,13 @@ class thermal_zone_t {
 class cooling_device_t;
 
 /**
+ * @param[in] thermal_path - The path to the thermal class directory. This is
+ * only changed for testing. Relative paths are resolved against the sysfs root
+ * (see set_roots).
  * @return all cooling devices on this system.
  */
 [[nodiscard]] res::optional_t<std::vector<cooling_device_t>>
-get_cooling_devices();
+get_cooling_devices(const fs::path& thermal_path = "class/thermal");
 
 /**
  * @brief Represents a thermal management device, such as a fan.
@@ -428,7 +586,8 @@ class cooling_device_t {
     cooling_device_t(const fs::path& sysfs_path);
 
     // Some functions require access to private members.
-    friend res::optional_t<std::vector<cooling_device_t>> get_cooling_devices();
+    friend res::optional_t<std::vector<cooling_device_t>> get_cooling_devices(
+      const fs::path& thermal_path);
 
   public:
     /**
@@ -450,7 +609,8 @@ class cooling_device_t {
 
     /**
      * @brief Attempt to set the state of this cooling device.
-     * State is clamped to between 0% and 100%.
+     * State is clamped to between 0% and 100%. Use an actuator to change the
+     * state repeatedly.
      *
      * This function requires root privileges.
      *
@@ -460,441 +620,2230 @@ class cooling_device_t {
     res::result_t set_state(double state);
 };
 
-class backlight_t;
+/**
+ * @brief Raises the cooling state by one level each period while the
+ * temperature is above the trip temperature and lowers it by one level each
+ * period once the temperature falls below the trip temperature minus the
+ * hysteresis.
+ */
+struct step_policy_t {
+    // The temperature (in degrees Celsius) above which cooling is increased.
+    double trip_temperature;
+
+    // The number of degrees Celsius below the trip temperature at which
+    // cooling is decreased.
+    double hysteresis;
+};
 
 /**
- * @return all backlights on this system.
+ * @brief Sets the cooling state proportionally to the output of a PID
+ * controller that drives the temperature toward the target temperature.
  */
-[[nodiscard]] res::optional_t<std::vector<backlight_t>> get_backlights();
+struct pid_policy_t {
+    // The temperature (in degrees Celsius) to maintain.
+    double target_temperature;
 
-class backlight_t {
-    fs::path sysfs_path_;
+    // Percent of cooling per degree Celsius above the target.
+    double proportional;
 
-    backlight_t(const fs::path& sysfs_path);
+    // Percent of cooling per degree Celsius second above the target.
+    double integral;
 
-    // Some functions require access to private members.
-    friend res::optional_t<std::vector<backlight_t>> get_backlights();
+    // Percent of cooling per degree Celsius per second of temperature change.
+    double derivative;
+};
+
+/**
+ * @brief A user-space thermal governor that periodically adjusts cooling
+ * devices based on the temperature of thermal zones.
+ *
+ * The 'temp' and 'cur_state' files of every binding are opened once and kept
+ * open, 'max_state' is read once when a binding is created, and 'cur_state' is
+ * only written when the requested state changes.
+ */
+class thermal_governor_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
 
   public:
+    thermal_governor_t();
+    thermal_governor_t(const thermal_governor_t&) = delete;
+    thermal_governor_t(thermal_governor_t&&) noexcept;
+    thermal_governor_t& operator=(const thermal_governor_t&) = delete;
+    thermal_governor_t& operator=(thermal_governor_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~thermal_governor_t();
+
     /**
-     * @return the path to this backlight in /sys. This provides access to
-     * various backlight-specific information exposed by the kernel.
+     * @brief Attempt to bind a cooling device to a thermal zone using a step
+     * policy.
+     *
+     * @param[in] zone - The thermal zone to monitor.
+     * @param[in] device - The cooling device to control.
+     * @param[in] policy - The policy used to choose the cooling state.
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] fs::path get_sysfs_path() const;
+    [[nodiscard]] res::result_t bind(const thermal_zone_t& zone,
+      const cooling_device_t& device,
+      const step_policy_t& policy);
 
     /**
-     * @return the name of this backlight.
+     * @brief Attempt to bind a cooling device to a thermal zone using a PID
+     * policy.
+     *
+     * @param[in] zone - The thermal zone to monitor.
+     * @param[in] device - The cooling device to control.
+     * @param[in] policy - The policy used to choose the cooling state.
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] res::result_t bind(const thermal_zone_t& zone,
+      const cooling_device_t& device,
+      const pid_policy_t& policy);
 
     /**
-     * @brief Attempt to calculate the brightness percentage of this backlight.
-     * The percentage is calculated by dividing the current brightness by the
-     * maximum brightness and multiplying the result by 100.
+     * @brief Attempt to start the periodic timer that drives this governor.
+     * Calling this method again changes the period.
      *
-     * @return the brightness percentage.
+     * @param[in] period - The time between control steps.
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] res::optional_t<double> get_brightness() const;
+    [[nodiscard]] res::result_t start(ch::nanoseconds period);
 
     /**
-     * @brief Attempt to set the brightness percentage of this backlight.
-     * Brightness is clamped to between 0% and 100%.
+     * @return the timer file descriptor of this governor or -1 if the governor
+     * has not been started. The file descriptor becomes readable when the next
+     * control step is due and can be added to an existing poll or epoll loop,
+     * in which case 'dispatch' must be called whenever it is readable.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Attempt to run one control step if the timer has expired since
+     * the last call. Does nothing otherwise.
      *
-     * @param[in] brightness - The new brightness percentage of this backlight.
      * @return a result indicating success or failure.
      */
-    res::result_t set_brightness(double brightness);
+    [[nodiscard]] res::result_t dispatch();
 
     /**
-     * @brief Attempt to increment the brightness of this backlight by a
-     * given percentage. A negative value decrements the brightness.
-     * Absolute brightness is clamped to between 0% and 100%.
+     * @brief Attempt to run one control step immediately: read the temperature
+     * of every bound zone and update the state of every bound device.
      *
-     * @param[in] brightness - The percentage to increment the brightness of
-     * this backlight by.
-     * @return a result indicating success or failure.
+     * Every binding is updated even if others fail.
+     *
+     * This function requires root privileges (unless the governor controls
+     * devices writable by the current user).
+     *
+     * @return a result indicating success or failure. The first binding that
+     * failed is reported.
      */
-    res::result_t set_brightness_relative(double brightness);
+    [[nodiscard]] res::result_t step();
+
+    /**
+     * @brief Attempt to run control steps on every timer expiration until
+     * 'stop' is called. Bindings that fail do not stop the governor. The
+     * governor must be started first.
+     *
+     * @return a result indicating success or failure. The first binding that
+     * failed is reported once the governor stops.
+     */
+    [[nodiscard]] res::result_t run();
+
+    /**
+     * @brief Make 'run' return as soon as possible. If 'run' is not running,
+     * the next call to 'run' returns immediately. Has no effect before
+     * 'start' is called. Safe to call from any thread.
+     */
+    void stop();
 };
 
-class battery_t;
+struct thermal_trip_point_t {
+    // The type of this trip point (active, passive, hot, critical, ...).
+    std::string type;
+
+    // The temperature (in degrees Celsius) at which this trip point is reached.
+    double temperature;
+};
+
+struct thermal_zone_summary_t {
+    // The path to the thermal zone in /sys.
+    fs::path sysfs_path;
+
+    // The type of the thermal zone.
+    std::string type;
+
+    // All trip points of the thermal zone.
+    std::vector<thermal_trip_point_t> trip_points;
+
+    // The number of samples taken so far.
+    uint64_t samples;
+
+    // The most recent temperature in degrees Celsius.
+    double current;
+
+    // The lowest temperature sampled in degrees Celsius.
+    double min;
+
+    // The highest temperature sampled in degrees Celsius.
+    double max;
+
+    // The exponentially weighted moving average of all samples in degrees
+    // Celsius.
+    double ewma;
+};
+
+struct thermal_event_t {
+    enum class type_t {
+        // The temperature rose to within the configured margin of a trip point.
+        approaching_trip,
+
+        // The temperature reached a passive trip point, at which the kernel
+        // starts throttling.
+        throttling_started,
+
+        // The temperature fell below a passive trip point.
+        throttling_stopped,
+
+        // The temperature reached a trip point that is not passive (active,
+        // hot, critical, ...).
+        trip_reached,
+    };
+
+    type_t type;
+
+    // The index of the zone in thermal_monitor_t::get_zones.
+    size_t zone;
+
+    // The trip point that caused this event.
+    thermal_trip_point_t trip_point;
+
+    // The temperature that caused this event in degrees Celsius.
+    double temperature;
+};
+
+class thermal_monitor_t;
+
+struct thermal_monitor_options_t {
+    // The weight of each new sample in the moving average (0 - 1).
+    double ewma_weight = 0.1;
+
+    // The number of degrees Celsius below a trip point at which an
+    // 'approaching_trip' event is generated.
+    double trip_margin = 5;
+
+    // Read the 'temp' files of all zones as one batch with io_uring when it is
+    // available (see get_hwmon_chips).
+    bool use_io_uring = false;
+};
 
 /**
- * @return all batteries on this system.
+ * @brief Attempt to create a monitor for all thermal zones. The type and trip
+ * points of each zone are read once here and never read again.
+ *
+ * @param[in] options - Options for computing summaries and events.
+ * @param[in] thermal_path - The path to the thermal class directory. This is
+ * only changed for testing. Relative paths are resolved against the sysfs root
+ * (see set_roots).
+ * @return a new thermal monitor.
  */
-[[nodiscard]] res::optional_t<std::vector<battery_t>> get_batteries();
+[[nodiscard]] res::optional_t<thermal_monitor_t> get_thermal_monitor(
+  const thermal_monitor_options_t& options = {},
+  const fs::path& thermal_path = "class/thermal");
 
 /**
- * @brief Represents a battery connected to this system.
+ * @brief Samples the temperature of many thermal zones and maintains summaries
+ * in constant memory per zone.
  */
-class battery_t {
-    fs::path sysfs_path_;
+class thermal_monitor_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
 
-    battery_t(const fs::path& sysfs_path);
+    thermal_monitor_t(std::unique_ptr<impl_t>&& impl);
 
     // Some functions require access to private members.
-    friend res::optional_t<std::vector<battery_t>> get_batteries();
+    friend res::optional_t<thermal_monitor_t> get_thermal_monitor(
+      const thermal_monitor_options_t& options, const fs::path& thermal_path);
 
   public:
-    enum class status_t {
-        unknown,
-        charging,
-        discharging,
-        not_charging,
-        full,
-    };
-
-    /**
-     * @return the path to this battery in /sys. This provides access to
-     * various battery-specific information exposed by the kernel.
-     */
-    [[nodiscard]] fs::path get_sysfs_path() const;
+    thermal_monitor_t(const thermal_monitor_t&) = delete;
+    thermal_monitor_t(thermal_monitor_t&&) noexcept;
+    thermal_monitor_t& operator=(const thermal_monitor_t&) = delete;
+    thermal_monitor_t& operator=(thermal_monitor_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~thermal_monitor_t();
 
     /**
-     * @return the name of this battery.
+     * @brief Attempt to start the periodic timer that drives this monitor.
+     * Calling this method again changes the period.
+     *
+     * @param[in] period - The time between samples.
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] res::result_t start(ch::nanoseconds period);
 
     /**
-     * @return the current status of this battery.
+     * @return the timer file descriptor of this monitor or -1 if the monitor
+     * has not been started. The file descriptor becomes readable when the next
+     * sample is due and can be added to an existing poll or epoll loop, in
+     * which case 'dispatch' must be called whenever it is readable.
      */
-    [[nodiscard]] res::optional_t<status_t> get_status() const;
+    [[nodiscard]] int get_fd() const;
 
     /**
-     * @return the amount of current (in amperes) being drawn from this battery.
+     * @brief Attempt to take one sample if the timer has expired since the last
+     * call. Does nothing otherwise.
+     *
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] res::optional_t<double> get_current() const;
+    [[nodiscard]] res::result_t dispatch();
 
     /**
-     * @return the amount of power (in watts) being drawn from this battery.
+     * @brief Attempt to sample the temperature of every zone immediately and
+     * update all summaries and events. Only the 'temp' file of each zone is
+     * read, all of them as one batch, and they are kept open between calls.
+     * Zones that fail to be read are skipped and the others are still
+     * sampled.
+     *
+     * @return a result indicating success or failure. The first zone that
+     * failed to be read is reported.
      */
-    [[nodiscard]] res::optional_t<double> get_power() const;
+    [[nodiscard]] res::result_t update();
 
     /**
-     * @brief Attempt to calculate the current energy percentage of this
-     * battery. This is calculated by dividing the current energy level by the
-     * available energy capacity and multiplying by 100.
-     *
-     * @return the current energy percentage.
+     * @return the summaries of all monitored zones.
      */
-    [[nodiscard]] res::optional_t<double> get_charge() const;
+    [[nodiscard]] const std::vector<thermal_zone_summary_t>& get_zones() const;
 
     /**
-     * @brief Attempt to calculate the percentage of energy still storable
-     * within this battery compared to when this battery was new. This
-     * percentage is calculated by dividing the current energy capacity by the
-     * original energy capacity given by the manufacturer and multiplying by
-     * 100.
+     * @brief Attempt to estimate a percentile of all temperatures sampled from
+     * a zone. Estimates are accurate to half a degree Celsius.
      *
-     * @return the capacity percentage.
+     * @param[in] zone - The index of the zone in 'get_zones'.
+     * @param[in] percentile - The percentile to estimate (0 - 100).
+     * @return the estimated temperature in degrees Celsius.
      */
-    [[nodiscard]] res::optional_t<double> get_capacity() const;
+    [[nodiscard]] res::optional_t<double> get_percentile(
+      size_t zone, double percentile) const;
 
     /**
-     * @brief If this battery is discharging, attempt to calculate the number of
-     * seconds until this battery is empty. If this battery is charging, attempt
-     * to calculate the number of seconds until this battery is full.
-     *
-     * @return the number of seconds until this battery is empty or full
-     * (depending on charge status).
+     * @return all events generated since the last call to this method.
      */
-    [[nodiscard]] res::optional_t<ch::seconds> get_time_remaining() const;
+    [[nodiscard]] std::vector<thermal_event_t> take_events();
 };
 
-class network_interface_t;
+class hwmon_chip_t;
 
 /**
- * @return all network interfaces on this system.
+ * @brief Attempt to enumerate all hardware monitoring chips and their sensors.
+ * Immutable sensor information (labels and limits) is read once here and never
+ * read again.
+ *
+ * @param[in] hwmon_path - The path to the hwmon class directory. This is only
+ * changed for testing. Relative paths are resolved against the sysfs root (see
+ * set_roots).
+ * @param[in] use_io_uring - Read the inputs of each chip as one batch with
+ * io_uring when it is available. Kernels complete sysfs reads made through
+ * io_uring on worker threads, so this is only faster when a chip has many
+ * sensors.
+ * @return all hardware monitoring chips on this system.
  */
-[[nodiscard]] res::optional_t<std::vector<network_interface_t>>
-get_network_interfaces();
+[[nodiscard]] res::optional_t<std::vector<hwmon_chip_t>> get_hwmon_chips(
+  const fs::path& hwmon_path = "class/hwmon", bool use_io_uring = false);
 
 /**
- * @brief Represents a network interface (either physical and virtual) on this
- * system.
+ * @brief Represents a single input channel of a hardware monitoring chip, such
+ * as a temperature sensor, a fan tachometer, or a voltage rail.
  */
-class network_interface_t {
-    fs::path sysfs_path_;
+class hwmon_sensor_t {
+  public:
+    enum class type_t {
+        temperature, // degrees Celsius
+        fan,         // revolutions per minute
+        voltage,     // volts
+        power,       // watts
+        current,     // amperes
+    };
 
-    network_interface_t(const fs::path& sysfs_path);
+    struct limits_t {
+        // The lowest value that is considered normal.
+        std::optional<double> min;
 
-    // Some functions require access to private members.
-    friend res::optional_t<std::vector<network_interface_t>>
-    get_network_interfaces();
+        // The highest value that is considered normal.
+        std::optional<double> max;
 
-  public:
-    enum class status_t {
-        unknown,
-        up,
-        dormant,
-        down,
-    };
+        // The value below which the hardware takes critical action.
+        std::optional<double> lcrit;
 
-    struct stat_t {
-        uint64_t bytes_down;
-        uint64_t bytes_up;
-        uint64_t packets_down;
-        uint64_t packets_up;
+        // The value above which the hardware takes critical action.
+        std::optional<double> crit;
     };
 
+  private:
+    type_t type_;
+    uint64_t index_;
+    std::string name_;
+    std::string label_;
+    limits_t limits_;
+    double value_ = 0;
+    // Zero if the last read succeeded, -1 if no read has been attempted, or
+    // the errno value of the last failed read.
+    int read_errno_ = -1;
+
+    hwmon_sensor_t(type_t type,
+      uint64_t index,
+      const std::string& name,
+      const std::string& label,
+      const limits_t& limits);
+
+    // Some functions require access to private members.
+    friend res::optional_t<std::vector<hwmon_chip_t>> get_hwmon_chips(
+      const fs::path& hwmon_path, bool use_io_uring);
+    friend hwmon_chip_t;
+
+  public:
     /**
-     * @return the path to this network interface in /sys. This provides access
-     * to various interface-specific information exposed by the kernel.
+     * @return the type of this sensor.
      */
-    [[nodiscard]] fs::path get_sysfs_path() const;
+    [[nodiscard]] type_t get_type() const;
 
     /**
-     * @return the name of this network interface.
+     * @return the channel number of this sensor (the 1 in temp1_input).
      */
-    [[nodiscard]] std::string get_name() const;
+    [[nodiscard]] uint64_t get_index() const;
 
     /**
-     * @return true if this network interface represents a physical device
-     * or false if it is virtual.
+     * @return the name of this sensor within its chip (temp1, fan2, in0, ...).
      */
-    [[nodiscard]] res::optional_t<bool> is_physical() const;
+    [[nodiscard]] std::string get_name() const;
 
     /**
-     * @return true if this network interface is a loopback device or false
-     * otherwise.
+     * @return the label of this sensor or its name if the chip does not
+     * provide a label.
      */
-    [[nodiscard]] res::optional_t<bool> is_loopback() const;
+    [[nodiscard]] std::string get_label() const;
 
     /**
-     * @brief Attempt to get the current status of this network interface.
-     *
-     * @return the current status.
+     * @return the limits of this sensor. Limits not provided by the chip are
+     * empty.
      */
-    [[nodiscard]] res::optional_t<status_t> get_status() const;
+    [[nodiscard]] limits_t get_limits() const;
 
     /**
-     * @brief Attempt to get the statistics for transmitted and received data
-     * for this network interface.
-     *
-     * @return the interface statistics.
+     * @return the value read from this sensor by the last call to
+     * hwmon_chip_t::update in the units given by the sensor type.
      */
-    [[nodiscard]] res::optional_t<stat_t> get_stat() const;
+    [[nodiscard]] res::optional_t<double> get_value() const;
 };
 
-class sound_mixer_t;
-
-/**
- * @return a new sound mixer object.
- */
-[[nodiscard]] res::optional_t<sound_mixer_t> get_sound_mixer();
-
-class sound_control_t;
-
 /**
- * @brief Represents a sound mixer device, which is used to access sound control
- * elements.
+ * @brief Represents a hardware monitoring chip, which exposes one or more
+ * sensors.
  */
-class sound_mixer_t {
+class hwmon_chip_t {
     struct impl_t;
     std::unique_ptr<impl_t> impl_;
 
-    sound_mixer_t(const impl_t& impl);
+    hwmon_chip_t(const fs::path& sysfs_path,
+      const std::string& name,
+      std::vector<hwmon_sensor_t>&& sensors,
+      bool use_io_uring);
 
     // Some functions require access to private members.
-    friend res::optional_t<sound_mixer_t> get_sound_mixer();
+    friend res::optional_t<std::vector<hwmon_chip_t>> get_hwmon_chips(
+      const fs::path& hwmon_path, bool use_io_uring);
 
   public:
-    sound_mixer_t(const sound_mixer_t&) = delete;
-    // Classes with custom destructors must also have custom move constructors.
-    sound_mixer_t(sound_mixer_t&& sound_mixer) noexcept;
-    sound_mixer_t& operator=(const sound_mixer_t&) = delete;
-    sound_mixer_t& operator=(sound_mixer_t&&) noexcept = default;
+    hwmon_chip_t(const hwmon_chip_t&) = delete;
+    hwmon_chip_t(hwmon_chip_t&&) noexcept;
+    hwmon_chip_t& operator=(const hwmon_chip_t&) = delete;
+    hwmon_chip_t& operator=(hwmon_chip_t&&) noexcept;
     // The destructor must be implemented where 'impl' is defined.
-    ~sound_mixer_t();
+    ~hwmon_chip_t();
 
     /**
-     * @return all active sound control elements.
+     * @return the path to the directory containing the attributes of this chip
+     * in /sys.
      */
-    [[nodiscard]] std::vector<sound_control_t> get_controls() const;
-};
+    [[nodiscard]] fs::path get_sysfs_path() const;
 
-/**
- * @brief Represents a sound control element, which manages the volume and
- * status of an individual playback/capture device.
- */
-class sound_control_t {
-    struct impl_t;
-    std::unique_ptr<impl_t> impl_;
+    /**
+     * @return the name of the driver for this chip.
+     */
+    [[nodiscard]] std::string get_name() const;
 
-    sound_control_t(const impl_t& impl);
+    /**
+     * @return all sensors of this chip. Values are only updated by calling the
+     * 'update' method.
+     */
+    [[nodiscard]] const std::vector<hwmon_sensor_t>& get_sensors() const;
+
+    /**
+     * @brief Attempt to read the current value of every sensor of this chip.
+     * The input file of each sensor is opened on the first call and kept open
+     * for subsequent calls. All inputs are read as one batch. A sensor that
+     * cannot be read does not prevent the other sensors from being read; its
+     * error is reported by hwmon_sensor_t::get_value instead.
+     *
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] res::result_t update();
+};
+
+class backlight_t;
+
+/**
+ * @brief Attempt to find all backlights on this system.
+ *
+ * @param[in] backlight_path - The directory containing a symbolic link for
+ * each backlight. Relative paths are resolved against the sysfs root (see
+ * set_roots).
+ * @return all backlights on this system.
+ */
+[[nodiscard]] res::optional_t<std::vector<backlight_t>> get_backlights(
+  const fs::path& backlight_path = "class/backlight");
+
+class backlight_t {
+    fs::path sysfs_path_;
+
+    backlight_t(const fs::path& sysfs_path);
+
+    // Some functions require access to private members.
+    friend res::result_t append_backlight(
+      const class_entry_t& entry, std::vector<backlight_t>& backlights);
+
+  public:
+    /**
+     * @return the path to this backlight in /sys. This provides access to
+     * various backlight-specific information exposed by the kernel.
+     */
+    [[nodiscard]] fs::path get_sysfs_path() const;
+
+    /**
+     * @return the name of this backlight.
+     */
+    [[nodiscard]] std::string get_name() const;
+
+    /**
+     * @brief Attempt to calculate the brightness percentage of this backlight.
+     * The percentage is calculated by dividing the current brightness by the
+     * maximum brightness and multiplying the result by 100.
+     *
+     * @return the brightness percentage.
+     */
+    [[nodiscard]] res::optional_t<double> get_brightness() const;
+
+    /**
+     * @brief Attempt to set the brightness percentage of this backlight.
+     * Brightness is clamped to between 0% and 100%. Use an actuator to change
+     * the brightness repeatedly.
+     *
+     * @param[in] brightness - The new brightness percentage of this backlight.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_brightness(double brightness);
+
+    /**
+     * @brief Attempt to increment the brightness of this backlight by a
+     * given percentage. A negative value decrements the brightness.
+     * Absolute brightness is clamped to between 0% and 100%.
+     *
+     * @param[in] brightness - The percentage to increment the brightness of
+     * this backlight by.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_brightness_relative(double brightness);
+};
+
+class actuator_t;
+
+/**
+ * @brief Prepare to change the brightness of a backlight repeatedly.
+ *
+ * @param[in] backlight - The backlight to change.
+ * @param[in] min_interval - The minimum time between two writes. Zero writes
+ * every change immediately.
+ * @return an actuator for the brightness of the given backlight.
+ */
+[[nodiscard]] res::optional_t<actuator_t> get_actuator(
+  const backlight_t& backlight,
+  ch::nanoseconds min_interval = ch::nanoseconds::zero());
+
+/**
+ * @brief Prepare to change the state of a cooling device repeatedly.
+ *
+ * This function requires root privileges.
+ *
+ * @param[in] device - The cooling device to change.
+ * @param[in] min_interval - The minimum time between two writes. Zero writes
+ * every change immediately.
+ * @return an actuator for the state of the given cooling device.
+ */
+[[nodiscard]] res::optional_t<actuator_t> get_actuator(
+  const cooling_device_t& device,
+  ch::nanoseconds min_interval = ch::nanoseconds::zero());
+
+/**
+ * @brief Changes a percentage-based sysfs attribute, such as the brightness of
+ * a backlight or the state of a cooling device, without redundant writes. The
+ * maximum value is read once and the attribute is kept open. Changes to the
+ * value that was written last are not written again.
+ *
+ * With a minimum interval, rapid changes are combined and only the latest one
+ * is written once the interval has passed. Pending changes are written by the
+ * 'dispatch' method, by the 'flush' method, or when the actuator is destroyed.
+ */
+class actuator_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    actuator_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<actuator_t> get_actuator(
+      const backlight_t& backlight, ch::nanoseconds min_interval);
+    friend res::optional_t<actuator_t> get_actuator(
+      const cooling_device_t& device, ch::nanoseconds min_interval);
+
+  public:
+    actuator_t(const actuator_t&) = delete;
+    actuator_t(actuator_t&&) noexcept;
+    actuator_t& operator=(const actuator_t&) = delete;
+    actuator_t& operator=(actuator_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~actuator_t();
+
+    /**
+     * @return the path to the attribute changed by this actuator.
+     */
+    [[nodiscard]] fs::path get_path() const;
+
+    /**
+     * @return the most recently requested percentage (0 - 100), which may not
+     * have been written yet. Changes made by other processes are not
+     * observed.
+     */
+    [[nodiscard]] double get() const;
+
+    /**
+     * @return true if a change is waiting for the minimum interval to pass and
+     * false otherwise.
+     */
+    [[nodiscard]] bool is_pending() const;
+
+    /**
+     * @brief Change the attribute to the given percentage. The percentage is
+     * clamped to between 0% and 100%.
+     *
+     * @param[in] percent - The new percentage.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set(double percent);
+
+    /**
+     * @brief Increment the most recently requested percentage by the given
+     * percentage. A negative value decrements it.
+     *
+     * @param[in] percent - The percentage to increment by.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_relative(double percent);
+
+    /**
+     * @return a file descriptor that becomes readable when a pending change is
+     * due, or -1 if this actuator has no minimum interval. The 'dispatch'
+     * method should be called whenever it is readable.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Write the pending change if the minimum interval has passed.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t dispatch();
+
+    /**
+     * @brief Write the pending change immediately.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t flush();
+};
+
+class battery_t;
+
+/**
+ * @param[in] power_supply_path - The path to the power supply class directory.
+ * This is only changed for testing. Relative paths are resolved against the
+ * sysfs root (see set_roots).
+ * @return all batteries on this system.
+ */
+[[nodiscard]] res::optional_t<std::vector<battery_t>> get_batteries(
+  const fs::path& power_supply_path = "class/power_supply");
+
+/**
+ * @brief Represents a battery connected to this system.
+ */
+class battery_t {
+  public:
+    /**
+     * @brief Optional attributes of a battery, probed once when the battery is
+     * enumerated by checking whether their files exist. These determine which
+     * method is used to calculate each value.
+     */
+    struct capabilities_t {
+        // The battery reports energy (energy_now and energy_full).
+        bool energy;
+
+        // The battery reports its design energy (energy_full_design).
+        bool energy_design;
+
+        // The battery reports charge (charge_now and charge_full).
+        bool charge;
+
+        // The battery reports its design charge (charge_full_design).
+        bool charge_design;
+
+        // The battery reports its charge level as a percentage (capacity).
+        bool capacity;
+
+        // The battery reports current (current_now).
+        bool current;
+
+        // The battery reports power (power_now).
+        bool power;
+
+        // The battery reports voltage (voltage_now).
+        bool voltage;
+
+        // The battery reports the time until empty (time_to_empty_now or
+        // time_to_empty_avg).
+        bool time_to_empty;
+
+        // The battery reports the time until full (time_to_full_now or
+        // time_to_full_avg).
+        bool time_to_full;
+    };
+
+  private:
+    fs::path sysfs_path_;
+    std::shared_ptr<const fd_t> dir_;
+    capabilities_t capabilities_;
+
+    battery_t(const fs::path& sysfs_path,
+      std::shared_ptr<const fd_t> dir,
+      const capabilities_t& capabilities);
+
+    // Some functions require access to private members.
+    friend res::result_t append_battery(
+      const class_entry_t& entry, std::vector<battery_t>& batteries);
+
+  public:
+    enum class status_t {
+        unknown,
+        charging,
+        discharging,
+        not_charging,
+        full,
+    };
+
+    /**
+     * @brief The attributes of a battery read together at one point in time.
+     * All values are calculated from the same sample without accessing the
+     * filesystem.
+     */
+    class snapshot_t {
+        // The sysfs directory of the battery, for describing errors.
+        fs::path sysfs_path_;
+        capabilities_t capabilities_;
+
+        // Attribute names (lowercase and without the POWER_SUPPLY_ prefix)
+        // mapped to their values.
+        std::unordered_map<std::string, std::string> attributes_;
+
+        snapshot_t(const fs::path& sysfs_path,
+          const capabilities_t& capabilities,
+          std::unordered_map<std::string, std::string>&& attributes);
+
+        [[nodiscard]] res::error_t missing(
+          const std::vector<std::string>& attributes) const;
+
+        // Some classes require access to private members.
+        friend class battery_t;
+
+      public:
+        /**
+         * @param[in] attribute - The name of the attribute in lowercase and
+         * without the POWER_SUPPLY_ prefix (e.g. "energy_now").
+         * @return the raw value of the given attribute if it was present in
+         * this snapshot.
+         */
+        [[nodiscard]] std::optional<std::string> get_attribute(
+          const std::string& attribute) const;
+
+        /**
+         * @return the status of the battery.
+         */
+        [[nodiscard]] res::optional_t<status_t> get_status() const;
+
+        /**
+         * @return the amount of current (in amperes) being drawn from the
+         * battery.
+         */
+        [[nodiscard]] res::optional_t<double> get_current() const;
+
+        /**
+         * @return the amount of power (in watts) being drawn from the battery.
+         */
+        [[nodiscard]] res::optional_t<double> get_power() const;
+
+        /**
+         * @return the current energy percentage of the battery. See
+         * battery_t::get_charge.
+         */
+        [[nodiscard]] res::optional_t<double> get_charge() const;
+
+        /**
+         * @return the capacity percentage of the battery. See
+         * battery_t::get_capacity.
+         */
+        [[nodiscard]] res::optional_t<double> get_capacity() const;
+
+        /**
+         * @return the number of seconds until the battery is empty or full
+         * (depending on charge status). See battery_t::get_time_remaining.
+         */
+        [[nodiscard]] res::optional_t<ch::seconds> get_time_remaining() const;
+    };
+
+    /**
+     * @return the path to this battery in /sys. This provides access to
+     * various battery-specific information exposed by the kernel.
+     */
+    [[nodiscard]] fs::path get_sysfs_path() const;
+
+    /**
+     * @return the name of this battery.
+     */
+    [[nodiscard]] std::string get_name() const;
+
+    /**
+     * @return the optional attributes supported by this battery.
+     */
+    [[nodiscard]] capabilities_t get_capabilities() const;
+
+    /**
+     * @brief Attempt to read every attribute of this battery at once. Use this
+     * method instead of the other getters when sampling more than one value,
+     * since each getter takes a new snapshot.
+     *
+     * @return a snapshot of the attributes of this battery.
+     */
+    [[nodiscard]] res::optional_t<snapshot_t> get_snapshot() const;
+
+    /**
+     * @return the current status of this battery.
+     */
+    [[nodiscard]] res::optional_t<status_t> get_status() const;
+
+    /**
+     * @return the amount of current (in amperes) being drawn from this battery.
+     */
+    [[nodiscard]] res::optional_t<double> get_current() const;
+
+    /**
+     * @return the amount of power (in watts) being drawn from this battery.
+     */
+    [[nodiscard]] res::optional_t<double> get_power() const;
+
+    /**
+     * @brief Attempt to calculate the current energy percentage of this
+     * battery. This is calculated by dividing the current energy level by the
+     * available energy capacity and multiplying by 100.
+     *
+     * @return the current energy percentage.
+     */
+    [[nodiscard]] res::optional_t<double> get_charge() const;
+
+    /**
+     * @brief Attempt to calculate the percentage of energy still storable
+     * within this battery compared to when this battery was new. This
+     * percentage is calculated by dividing the current energy capacity by the
+     * original energy capacity given by the manufacturer and multiplying by
+     * 100.
+     *
+     * @return the capacity percentage.
+     */
+    [[nodiscard]] res::optional_t<double> get_capacity() const;
+
+    /**
+     * @brief If this battery is discharging, attempt to calculate the number of
+     * seconds until this battery is empty. If this battery is charging, attempt
+     * to calculate the number of seconds until this battery is full.
+     *
+     * @return the number of seconds until this battery is empty or full
+     * (depending on charge status).
+     */
+    [[nodiscard]] res::optional_t<ch::seconds> get_time_remaining() const;
+};
+
+class network_interface_t;
+
+/**
+ * @return all network interfaces on this system.
+ */
+[[nodiscard]] res::optional_t<std::vector<network_interface_t>>
+get_network_interfaces();
+
+/**
+ * @brief Represents a network interface (either physical and virtual) on this
+ * system.
+ */
+class network_interface_t {
+  public:
+    /**
+     * @brief Optional attributes of a network interface, probed once when the
+     * interface is enumerated.
+     */
+    struct capabilities_t {
+        // The interface reports its operational status (operstate).
+        bool status;
+
+        // The interface reports transfer statistics (statistics).
+        bool stat;
+    };
+
+  private:
+    fs::path sysfs_path_;
+    std::shared_ptr<const fd_t> dir_;
+    capabilities_t capabilities_;
+
+    network_interface_t(const fs::path& sysfs_path,
+      std::shared_ptr<const fd_t> dir,
+      const capabilities_t& capabilities);
+
+    // Some functions require access to private members.
+    friend res::result_t append_network_interface(const class_entry_t& entry,
+      std::vector<network_interface_t>& network_interfaces);
+
+  public:
+    enum class status_t {
+        unknown,
+        up,
+        dormant,
+        down,
+    };
+
+    struct stat_t {
+        uint64_t bytes_down;
+        uint64_t bytes_up;
+        uint64_t packets_down;
+        uint64_t packets_up;
+    };
+
+    /**
+     * @return the path to this network interface in /sys. This provides access
+     * to various interface-specific information exposed by the kernel.
+     */
+    [[nodiscard]] fs::path get_sysfs_path() const;
+
+    /**
+     * @return the name of this network interface.
+     */
+    [[nodiscard]] std::string get_name() const;
+
+    /**
+     * @return the optional attributes supported by this network interface.
+     */
+    [[nodiscard]] capabilities_t get_capabilities() const;
+
+    /**
+     * @return true if this network interface represents a physical device
+     * or false if it is virtual.
+     */
+    [[nodiscard]] res::optional_t<bool> is_physical() const;
+
+    /**
+     * @return true if this network interface is a loopback device or false
+     * otherwise.
+     */
+    [[nodiscard]] res::optional_t<bool> is_loopback() const;
+
+    /**
+     * @brief Attempt to get the current status of this network interface.
+     *
+     * @return the current status.
+     */
+    [[nodiscard]] res::optional_t<status_t> get_status() const;
+
+    /**
+     * @brief Attempt to get the statistics for transmitted and received data
+     * for this network interface.
+     *
+     * @return the interface statistics.
+     */
+    [[nodiscard]] res::optional_t<stat_t> get_stat() const;
+};
+
+struct collect_options_t {
+    // Collect system information (get_system_info).
+    bool system_info = true;
+
+    // Update this CPU usage tracker and collect its usage. CPU usage is not
+    // collected if this is null. The tracker must not be used by another
+    // thread while it is being updated.
+    const cpu_usage_t* cpu_usage = nullptr;
+
+    // Collect the size and statistics of every disk.
+    bool disks = true;
+
+    // Collect the status and statistics of every network interface.
+    bool network_interfaces = true;
+
+    // Collect the temperature of every thermal zone.
+    bool thermal_zones = true;
+
+    // Collect a snapshot of every battery.
+    bool batteries = true;
+
+    // Collect the brightness of every backlight.
+    bool backlights = true;
+
+    // Collect independent subsystems concurrently on a small internal pool of
+    // threads instead of one after another.
+    bool parallel = true;
+
+    // The paths to the class directories. These are only changed for testing.
+    // Relative paths are resolved against the sysfs root (see set_roots).
+    fs::path thermal_path = "class/thermal";
+    fs::path power_supply_path = "class/power_supply";
+    fs::path backlight_path = "class/backlight";
+};
+
+/**
+ * @brief The result of collecting one subsystem.
+ */
+template<typename value_t>
+struct subsystem_snapshot_t {
+    // The collected value or the error that prevented collecting it.
+    res::optional_t<value_t> value;
+
+    // The time spent collecting this subsystem.
+    ch::nanoseconds latency;
+};
+
+struct collected_cpu_usage_t {
+    res::optional_t<double> total;
+    res::optional_t<std::vector<double>> per_core;
+};
+
+struct collected_disk_t {
+    disk_t disk;
+    res::optional_t<uint64_t> size;
+    res::optional_t<inflight_stat_t> inflight_stat;
+    res::optional_t<io_stat_t> io_stat;
+};
+
+struct collected_network_interface_t {
+    network_interface_t network_interface;
+    res::optional_t<network_interface_t::status_t> status;
+    res::optional_t<network_interface_t::stat_t> stat;
+};
+
+struct collected_thermal_zone_t {
+    thermal_zone_t thermal_zone;
+    res::optional_t<double> temperature;
+};
+
+struct collected_battery_t {
+    battery_t battery;
+    res::optional_t<battery_t::snapshot_t> snapshot;
+};
+
+struct collected_backlight_t {
+    backlight_t backlight;
+    res::optional_t<double> brightness;
+};
+
+struct system_snapshot_t {
+    // When collection started. Every subsystem was collected after this time.
+    ch::steady_clock::time_point timestamp;
+
+    // The time spent collecting all subsystems.
+    ch::nanoseconds latency;
+
+    // Subsystems that were not selected are empty. Values that a device does
+    // not report contain the error returned by the corresponding method.
+    std::optional<subsystem_snapshot_t<system_info_t>> system_info;
+    std::optional<subsystem_snapshot_t<collected_cpu_usage_t>> cpu_usage;
+    std::optional<subsystem_snapshot_t<std::vector<collected_disk_t>>> disks;
+    std::optional<
+      subsystem_snapshot_t<std::vector<collected_network_interface_t>>>
+      network_interfaces;
+    std::optional<subsystem_snapshot_t<std::vector<collected_thermal_zone_t>>>
+      thermal_zones;
+    std::optional<subsystem_snapshot_t<std::vector<collected_battery_t>>>
+      batteries;
+    std::optional<subsystem_snapshot_t<std::vector<collected_backlight_t>>>
+      backlights;
+};
+
+/**
+ * @brief Collect the selected subsystems in one call. Devices are enumerated
+ * again on every call. A subsystem that fails does not prevent the others from
+ * being collected.
+ *
+ * @param[in] options - The subsystems to collect and how to collect them.
+ * @return a snapshot of the selected subsystems.
+ */
+[[nodiscard]] system_snapshot_t collect(const collect_options_t& options = {});
+
+class scheduler_t;
+
+struct scheduler_options_t {
+    // The common tick. Intervals are rounded up to a multiple of the tick and
+    // each collector runs on multiples of its interval on the monotonic clock,
+    // so collectors that fall due together run in a single wakeup.
+    ch::nanoseconds tick = ch::milliseconds(100);
+
+    // How late a wakeup may be so that it can be combined with other wakeups.
+    // The timer is delayed by up to this much so that collectors that fall due
+    // within it run in a single wakeup. Also applied as the timer slack of the
+    // thread that calls 'run' while it runs (PR_SET_TIMERSLACK), which delays
+    // the other timers of the collectors. Zero disables both.
+    ch::nanoseconds timer_slack = ch::nanoseconds::zero();
+
+    // Run collectors with the SCHED_IDLE policy on the thread that calls 'run'
+    // while it runs, so that they only use otherwise idle CPU time. Restoring
+    // the previous policy requires CAP_SYS_NICE (or a sufficient RLIMIT_NICE),
+    // so 'run' should be called on a dedicated thread.
+    bool idle_priority = false;
+};
+
+/**
+ * @brief Attempt to create a scheduler with no collectors.
+ *
+ * @param[in] options - Options for aligning wakeups and running collectors.
+ * @return a new scheduler.
+ */
+[[nodiscard]] res::optional_t<scheduler_t> get_scheduler(
+  const scheduler_options_t& options = {});
+
+/**
+ * @brief Runs collectors at their own intervals using a single timer that only
+ * expires when at least one collector is due.
+ *
+ * Collectors are added, removed, and run on the thread that owns the
+ * scheduler. Only 'stop' may be called from another thread.
+ */
+class scheduler_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    scheduler_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<scheduler_t> get_scheduler(
+      const scheduler_options_t& options);
+
+  public:
+    using collector_t = std::function<res::result_t()>;
+
+    scheduler_t(const scheduler_t&) = delete;
+    scheduler_t(scheduler_t&&) noexcept;
+    scheduler_t& operator=(const scheduler_t&) = delete;
+    scheduler_t& operator=(scheduler_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~scheduler_t();
+
+    /**
+     * @brief Attempt to add a collector. It first runs on the next multiple of
+     * its interval. Must not be called by a collector.
+     *
+     * @param[in] interval - The time between runs. Rounded up to a multiple of
+     * the tick.
+     * @param[in] collector - The function to run.
+     * @return an identifier for removing the collector.
+     */
+    [[nodiscard]] res::optional_t<uint64_t> add(
+      ch::nanoseconds interval, collector_t collector);
+
+    /**
+     * @brief Attempt to remove a collector. Must not be called by a collector.
+     *
+     * @param[in] id - The identifier returned by 'add'.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] res::result_t remove(uint64_t id);
+
+    /**
+     * @return the timer file descriptor of this scheduler. The file descriptor
+     * becomes readable when at least one collector is due and can be added to
+     * an existing poll or epoll loop, in which case 'dispatch' must be called
+     * whenever it is readable.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Attempt to run every collector that is due and arm the timer for
+     * the next one. Collectors that are more than one interval late run once.
+     * Every due collector runs even if another one fails.
+     *
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] res::result_t dispatch();
+
+    /**
+     * @return the number of times 'dispatch' ran at least one collector.
+     */
+    [[nodiscard]] uint64_t get_wakeups() const;
+
+    /**
+     * @brief Attempt to run collectors until 'stop' is called or a collector
+     * fails. The timer slack and priority options are applied to the calling
+     * thread until this method returns.
+     *
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] res::result_t run();
+
+    /**
+     * @brief Make 'run' return as soon as possible. If 'run' is not running,
+     * the next call to 'run' returns immediately. Safe to call from any thread.
+     */
+    void stop();
+};
+
+class sound_mixer_t;
+
+/**
+ * @brief Attempt to open a sound mixer attached to the given ALSA control
+ * device.
+ *
+ * @param[in] device - The name of the control device (e.g. "default" or
+ * "hw:0").
+ * @return a new sound mixer object.
+ */
+[[nodiscard]] res::optional_t<sound_mixer_t> get_sound_mixer(
+  const std::string& device = "default");
+
+/**
+ * @return a separate sound mixer object for each sound card ("hw:0", "hw:1",
+ * etc.).
+ */
+[[nodiscard]] res::optional_t<std::vector<sound_mixer_t>> get_sound_mixers();
+
+class sound_control_t;
+struct sound_event_t;
+
+/**
+ * @brief Represents a sound mixer device, which is used to access sound control
+ * elements.
+ */
+class sound_mixer_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    // ALSA callbacks keep a pointer to the implementation, so it must never be
+    // copied or relocated.
+    sound_mixer_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<sound_mixer_t> get_sound_mixer(
+      const std::string& device);
+
+  public:
+    sound_mixer_t(const sound_mixer_t&) = delete;
+    sound_mixer_t(sound_mixer_t&&) noexcept;
+    sound_mixer_t& operator=(const sound_mixer_t&) = delete;
+    sound_mixer_t& operator=(sound_mixer_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~sound_mixer_t();
+
+    /**
+     * @return the name of the ALSA control device this mixer is attached to.
+     */
+    [[nodiscard]] std::string get_device() const;
+
+    /**
+     * @return all active sound control elements.
+     */
+    [[nodiscard]] std::vector<sound_control_t> get_controls() const;
+
+    /**
+     * @brief Find an active sound control element by name and index in
+     * constant time. The control element is created on the first lookup and
+     * the same object is returned by every later lookup.
+     *
+     * @param[in] name - The name of the control element (e.g. "Master").
+     * @param[in] index - The index of the control element, which distinguishes
+     * control elements with the same name.
+     * @return the control element owned by this mixer or nullptr if there is
+     * no such control element. It remains valid until this mixer is destroyed
+     * or until 'dispatch' reports that the control element was removed.
+     */
+    [[nodiscard]] sound_control_t* find_control(
+      const std::string& name, unsigned int index = 0);
+
+    /**
+     * @return a file descriptor that becomes readable when a sound control
+     * element is changed, added, or removed. The 'dispatch' method should be
+     * called whenever it is readable. Waiting on this file descriptor costs
+     * nothing while no control element changes.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Handle all pending ALSA events and report which sound control
+     * elements changed along with their new state. The state reported by this
+     * mixer's control elements is only refreshed when this method is called.
+     *
+     * @return the changed control elements in the order in which they first
+     * changed. Each control element is reported at most once. A state that
+     * fails to be read is left empty rather than failing the whole dispatch.
+     */
+    [[nodiscard]] res::optional_t<std::vector<sound_event_t>> dispatch();
+};
+
+/**
+ * @brief Represents a sound control element, which manages the volume and
+ * status of an individual playback/capture device.
+ */
+class sound_control_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    sound_control_t(const impl_t& impl);
+
+    // Some classes need to access the private constructor for this class, but
+    // not all classes need access.
+    friend sound_mixer_t;
+
+    template<typename type_t>
+    struct state_t {
+        type_t front_left;
+        type_t front_right;
+        type_t rear_left;
+        type_t rear_right;
+        type_t front_center;
+        type_t woofer;
+        type_t side_left;
+        type_t side_right;
+        type_t rear_center;
+    };
+
+  public:
+    using status_t = state_t<std::optional<bool>>;
+    using volume_t = state_t<std::optional<double>>;
+
+    /**
+     * @brief The range of a volume in decibels.
+     */
+    struct db_range_t {
+        double min;
+        double max;
+    };
+
+    sound_control_t(const sound_control_t&) = delete;
+    sound_control_t(sound_control_t&&) noexcept = default;
+    sound_control_t& operator=(const sound_control_t&) = delete;
+    sound_control_t& operator=(sound_control_t&&) noexcept = default;
+    // The destructor must be implemented where 'impl' is defined.
+    ~sound_control_t();
+
+    /**
+     * @return the name of this sound control element.
+     */
+    [[nodiscard]] std::string get_name() const;
+
+    /**
+     * @return the index of this sound control element, which distinguishes
+     * control elements with the same name.
+     */
+    [[nodiscard]] unsigned int get_index() const;
+
+    /**
+     * @return true if this control has a playback status and false otherwise.
+     */
+    [[nodiscard]] bool has_playback_status() const;
+
+    /**
+     * @return true if this control has a playback volume and false
+     * otherwise.
+     */
+    [[nodiscard]] bool has_playback_volume() const;
+
+    /**
+     * @return true if this control has a capture status and false otherwise.
+     */
+    [[nodiscard]] bool has_capture_status() const;
+
+    /**
+     * @return true if this control has a capture volume and false
+     * otherwise.
+     */
+    [[nodiscard]] bool has_capture_volume() const;
+
+    /**
+     * @return the current playback status.
+     */
+    [[nodiscard]] res::optional_t<status_t> get_playback_status() const;
+
+    /**
+     * @return the current playback volume as a percentage.
+     */
+    [[nodiscard]] res::optional_t<volume_t> get_playback_volume() const;
+
+    /**
+     * @return the playback volume in decibels at 0% and 100%.
+     */
+    [[nodiscard]] res::optional_t<db_range_t> get_playback_db_range() const;
+
+    /**
+     * @return the current capture status.
+     */
+    [[nodiscard]] res::optional_t<status_t> get_capture_status() const;
+
+    /**
+     * @return the current capture volume as a percentage.
+     */
+    [[nodiscard]] res::optional_t<volume_t> get_capture_volume() const;
+
+    /**
+     * @return the capture volume in decibels at 0% and 100%.
+     */
+    [[nodiscard]] res::optional_t<db_range_t> get_capture_db_range() const;
+
+    /**
+     * @brief Attempt to set the playback status.
+     *
+     * @param[in] status - The new playback status.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_playback_status(const status_t& status);
+
+    /**
+     * @brief Attempt to set the playback status for all channels.
+     *
+     * @param[in] status - The new playback status.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_playback_status_all(bool status);
+
+    /**
+     * @brief Attempt to toggle the playback status of each individual channel.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t toggle_playback_status();
+
+    /**
+     * @brief Attempt to set the playback volume.
+     *
+     * @param[in] volume - The new playback volume.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_playback_volume(const volume_t& volume);
+
+    /**
+     * @brief Attempt to set the playback volume for all channels.
+     *
+     * @param[in] volume - The new playback volume.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_playback_volume_all(double volume);
+
+    /**
+     * @brief Attempt to increment the playback volume for all channels by a
+     * given percentage. A negative value decrements the playback volume.
+     * Absolute volume percentages are clamped to between 0% and 100%.
+     *
+     * @param[in] volume - The percentage to increment the playback volume by.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_playback_volume_all_relative(double volume);
+
+    /**
+     * @brief Attempt to set the capture status.
+     *
+     * @param[in] status - The new capture status.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_capture_status(const status_t& status);
+
+    /**
+     * @brief Attempt to set the capture status for all channels.
+     *
+     * @param[in] status - The new capture status.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_capture_status_all(bool status);
+
+    /**
+     * @brief Attempt to toggle the capture status of each individual channel.
+     *
+     * @return a result indicating success or failure.
+     */
+    res::result_t toggle_capture_status();
+
+    /**
+     * @brief Attempt to set the capture volume.
+     *
+     * @param[in] volume - The new capture volume in percents.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_capture_volume(const volume_t& volume);
+
+    /**
+     * @brief Attempt to set the capture volume for all channels.
+     *
+     * @param[in] volume - The new capture volume.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_capture_volume_all(double volume);
+
+    /**
+     * @brief Attempt to increment the capture volume for all channels by a
+     * given percentage. A negative value decrements the capture volume.
+     * Absolute volume percentages are clamped to between 0% and 100%.
+     *
+     * @param[in] volume - The percentage to increment the capture volume by.
+     * @return a result indicating success or failure.
+     */
+    res::result_t set_capture_volume_all_relative(double volume);
+};
+
+/**
+ * @brief A change to a sound control element reported by a sound mixer.
+ */
+struct sound_event_t {
+    enum class type_t {
+        // The state of the control element changed.
+        changed,
+        // The control element was added to the mixer (e.g. hot-plugged).
+        added,
+        // The control element was removed from the mixer.
+        removed,
+    };
+
+    type_t type;
+
+    // The name and index of the control element.
+    std::string name;
+    unsigned int index;
+
+    // The state of the control element after the change. States that the
+    // control element does not have or that failed to be read are empty, as
+    // are all states of removed control elements.
+    std::optional<sound_control_t::status_t> playback_status;
+    std::optional<sound_control_t::volume_t> playback_volume;
+    std::optional<sound_control_t::status_t> capture_status;
+    std::optional<sound_control_t::volume_t> capture_volume;
+};
+
+class sound_worker_t;
+
+/**
+ * @brief Attempt to start a worker thread that owns a sound mixer attached to
+ * the given ALSA control device.
+ *
+ * @param[in] device - The name of the control device (e.g. "default" or
+ * "hw:0").
+ * @return a new sound worker object.
+ */
+[[nodiscard]] res::optional_t<sound_worker_t> get_sound_worker(
+  const std::string& device = "default");
+
+/**
+ * @brief Owns a sound mixer on a dedicated worker thread. ALSA mixer handles
+ * are not thread-safe, so every ALSA call is made by the worker thread. All
+ * methods of this class are thread-safe and never block. Commands are passed
+ * to the worker thread through a lock-free queue, executed in the order in
+ * which they were submitted, and their results are returned through futures.
+ * If the worker thread can no longer wait for commands, it exits and every
+ * pending and future command fails with the same error (functions passed to
+ * 'submit' are not run and their futures throw std::runtime_error instead).
+ */
+class sound_worker_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    sound_worker_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<sound_worker_t> get_sound_worker(
+      const std::string& device);
+
+  public:
+    sound_worker_t(const sound_worker_t&) = delete;
+    sound_worker_t(sound_worker_t&&) noexcept;
+    sound_worker_t& operator=(const sound_worker_t&) = delete;
+    sound_worker_t& operator=(sound_worker_t&&) noexcept;
+    // Commands that are still queued are executed before the worker thread
+    // exits. Unfinished ramps are cancelled.
+    ~sound_worker_t();
+
+    /**
+     * @brief Read the playback volume of a control element on the worker
+     * thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return the current playback volume as a percentage.
+     */
+    [[nodiscard]] std::future<res::optional_t<sound_control_t::volume_t>>
+    get_playback_volume(const std::string& name, unsigned int index = 0);
+
+    /**
+     * @brief Set the playback volume for all channels of a control element on
+     * the worker thread. Cancels any playback volume ramp of the control
+     * element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The new playback volume.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_playback_volume_all(
+      const std::string& name, unsigned int index, double volume);
+
+    /**
+     * @brief Increment the playback volume for all channels of a control
+     * element on the worker thread. Consecutive increments of the same control
+     * element that are waiting in the queue are combined into a single write,
+     * so the sum is clamped instead of each increment. Cancels any playback
+     * volume ramp of the control element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The percentage to increment the playback volume by.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_playback_volume_all_relative(
+      const std::string& name, unsigned int index, double volume);
+
+    /**
+     * @brief Gradually change the playback volume for all channels of a control
+     * element to the given volume. Replaces any playback volume ramp of the
+     * control element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The final playback volume.
+     * @param[in] duration - The time taken to reach the final volume.
+     * @return a result indicating whether the final volume was reached. The
+     * result is a failure if the ramp is cancelled.
+     */
+    [[nodiscard]] std::future<res::result_t> ramp_playback_volume_all(
+      const std::string& name,
+      unsigned int index,
+      double volume,
+      ch::nanoseconds duration);
+
+    /**
+     * @brief Read the playback status of a control element on the worker
+     * thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return the current playback status.
+     */
+    [[nodiscard]] std::future<res::optional_t<sound_control_t::status_t>>
+    get_playback_status(const std::string& name, unsigned int index = 0);
+
+    /**
+     * @brief Set the playback status for all channels of a control element on
+     * the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] status - The new playback status.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_playback_status_all(
+      const std::string& name, unsigned int index, bool status);
+
+    /**
+     * @brief Toggle the playback status of each channel of a control element on
+     * the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> toggle_playback_status(
+      const std::string& name, unsigned int index = 0);
 
-    // Some classes need to access the private constructor for this class, but
-    // not all classes need access.
-    friend sound_mixer_t;
+    /**
+     * @brief Read the capture volume of a control element on the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return the current capture volume as a percentage.
+     */
+    [[nodiscard]] std::future<res::optional_t<sound_control_t::volume_t>>
+    get_capture_volume(const std::string& name, unsigned int index = 0);
 
-    template<typename type_t>
-    struct state_t {
-        type_t front_left;
-        type_t front_right;
-        type_t rear_left;
-        type_t rear_right;
-        type_t front_center;
-        type_t woofer;
-        type_t side_left;
-        type_t side_right;
-        type_t rear_center;
+    /**
+     * @brief Set the capture volume for all channels of a control element on
+     * the worker thread. Cancels any capture volume ramp of the control
+     * element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The new capture volume.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_capture_volume_all(
+      const std::string& name, unsigned int index, double volume);
+
+    /**
+     * @brief Increment the capture volume for all channels of a control element
+     * on the worker thread. Consecutive increments of the same control element
+     * that are waiting in the queue are combined into a single write, so the
+     * sum is clamped instead of each increment. Cancels any capture volume ramp
+     * of the control element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The percentage to increment the capture volume by.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_capture_volume_all_relative(
+      const std::string& name, unsigned int index, double volume);
+
+    /**
+     * @brief Gradually change the capture volume for all channels of a control
+     * element to the given volume. Replaces any capture volume ramp of the
+     * control element.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] volume - The final capture volume.
+     * @param[in] duration - The time taken to reach the final volume.
+     * @return a result indicating whether the final volume was reached. The
+     * result is a failure if the ramp is cancelled.
+     */
+    [[nodiscard]] std::future<res::result_t> ramp_capture_volume_all(
+      const std::string& name,
+      unsigned int index,
+      double volume,
+      ch::nanoseconds duration);
+
+    /**
+     * @brief Read the capture status of a control element on the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return the current capture status.
+     */
+    [[nodiscard]] std::future<res::optional_t<sound_control_t::status_t>>
+    get_capture_status(const std::string& name, unsigned int index = 0);
+
+    /**
+     * @brief Set the capture status for all channels of a control element on
+     * the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @param[in] status - The new capture status.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> set_capture_status_all(
+      const std::string& name, unsigned int index, bool status);
+
+    /**
+     * @brief Toggle the capture status of each channel of a control element on
+     * the worker thread.
+     *
+     * @param[in] name - The name of the control element.
+     * @param[in] index - The index of the control element.
+     * @return a result indicating success or failure.
+     */
+    [[nodiscard]] std::future<res::result_t> toggle_capture_status(
+      const std::string& name, unsigned int index = 0);
+
+    /**
+     * @brief Run an arbitrary function with the sound mixer on the worker
+     * thread.
+     *
+     * @param[in] function - The function to run.
+     * @return a future that becomes ready once the function has returned.
+     */
+    [[nodiscard]] std::future<void> submit(
+      std::function<void(sound_mixer_t&)> function);
+};
+
+/**
+ * @brief Reports how a ramp started by a ramp engine ended.
+ */
+struct ramp_event_t {
+    enum class type_t {
+        // The final value was reached.
+        finished,
+        // The ramp was cancelled or replaced by a new ramp of the same target.
+        cancelled,
+        // A step could not be written. The target is left at the last value
+        // that was written successfully.
+        failed,
     };
 
-  public:
-    using status_t = state_t<std::optional<bool>>;
-    using volume_t = state_t<std::optional<double>>;
+    type_t type;
 
-    sound_control_t(const sound_control_t&) = delete;
-    sound_control_t(sound_control_t&&) noexcept = default;
-    sound_control_t& operator=(const sound_control_t&) = delete;
-    sound_control_t& operator=(sound_control_t&&) noexcept = default;
+    // The identifier returned when the ramp was started.
+    uint64_t ramp;
+
+    // The reason a failed ramp failed.
+    std::optional<res::error_t> error;
+};
+
+/**
+ * @brief Gradually changes the brightness of backlights and the volume of
+ * sound control elements. All ramps share a single timer wheel driven by one
+ * timer file descriptor, so any number of ramps can run concurrently on one
+ * thread. Each ramp is only stepped when its target changes by at least one
+ * step and steps that are already late are skipped. The timer is disarmed
+ * while no ramps are running.
+ */
+class ramp_engine_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+  public:
+    ramp_engine_t();
+    ramp_engine_t(const ramp_engine_t&) = delete;
+    ramp_engine_t(ramp_engine_t&&) noexcept;
+    ramp_engine_t& operator=(const ramp_engine_t&) = delete;
+    ramp_engine_t& operator=(ramp_engine_t&&) noexcept;
     // The destructor must be implemented where 'impl' is defined.
-    ~sound_control_t();
+    ~ramp_engine_t();
 
     /**
-     * @return the name of this sound control element.
+     * @brief Create the timer used by all ramps. Must be called before any
+     * ramps are started.
+     *
+     * @param[in] resolution - The time between the slots of the timer wheel.
+     * No two steps of a ramp are closer together than this.
+     * @return a result indicating success or failure.
      */
-    [[nodiscard]] std::string get_name() const;
+    res::result_t start(ch::nanoseconds resolution = ch::milliseconds(10));
 
     /**
-     * @return true if this control has a playback status and false otherwise.
+     * @return a file descriptor that becomes readable whenever a ramp is due
+     * for a step, or -1 if the engine has not been started. The 'dispatch'
+     * method should be called whenever it is readable.
      */
-    [[nodiscard]] bool has_playback_status() const;
+    [[nodiscard]] int get_fd() const;
 
     /**
-     * @return true if this control has a playback volume and false
-     * otherwise.
+     * @brief Write the current value of every ramp that is due for a step.
+     *
+     * @return a result indicating success or failure. Errors writing a single
+     * ramp are reported as a failed ramp event instead.
      */
-    [[nodiscard]] bool has_playback_volume() const;
+    res::result_t dispatch();
 
     /**
-     * @return true if this control has a capture status and false otherwise.
+     * @brief Gradually change the brightness of a backlight. The brightness
+     * file is opened once and kept open until the ramp ends. Replaces any
+     * ramp of the same backlight.
+     *
+     * @param[in] backlight - The backlight to change.
+     * @param[in] brightness - The final brightness percentage.
+     * @param[in] duration - The time taken to reach the final brightness.
+     * @return an identifier for the new ramp.
      */
-    [[nodiscard]] bool has_capture_status() const;
+    [[nodiscard]] res::optional_t<uint64_t> ramp_brightness(
+      const backlight_t& backlight,
+      double brightness,
+      ch::nanoseconds duration);
 
     /**
-     * @return true if this control has a capture volume and false
-     * otherwise.
+     * @brief Gradually change the playback volume for all channels of a sound
+     * control element. The control element must outlive the ramp. Replaces
+     * any playback volume ramp of the same control element.
+     *
+     * @param[in] control - The sound control element to change.
+     * @param[in] volume - The final playback volume.
+     * @param[in] duration - The time taken to reach the final volume.
+     * @return an identifier for the new ramp.
      */
-    [[nodiscard]] bool has_capture_volume() const;
+    [[nodiscard]] res::optional_t<uint64_t> ramp_playback_volume(
+      sound_control_t& control, double volume, ch::nanoseconds duration);
 
     /**
-     * @return the current playback status.
+     * @brief Gradually change the capture volume for all channels of a sound
+     * control element. The control element must outlive the ramp. Replaces
+     * any capture volume ramp of the same control element.
+     *
+     * @param[in] control - The sound control element to change.
+     * @param[in] volume - The final capture volume.
+     * @param[in] duration - The time taken to reach the final volume.
+     * @return an identifier for the new ramp.
      */
-    [[nodiscard]] res::optional_t<status_t> get_playback_status() const;
+    [[nodiscard]] res::optional_t<uint64_t> ramp_capture_volume(
+      sound_control_t& control, double volume, ch::nanoseconds duration);
 
     /**
-     * @return the current playback volume as a percentage.
+     * @brief Stop a ramp at its current value.
+     *
+     * @param[in] ramp - The identifier of the ramp.
+     * @return true if the ramp was running and false otherwise.
      */
-    [[nodiscard]] res::optional_t<volume_t> get_playback_volume() const;
+    bool cancel(uint64_t ramp);
 
     /**
-     * @return the current capture status.
+     * @return the number of ramps that are running.
      */
-    [[nodiscard]] res::optional_t<status_t> get_capture_status() const;
+    [[nodiscard]] size_t get_ramp_count() const;
 
     /**
-     * @return the current capture volume as a percentage.
+     * @return all events generated since the last call.
      */
-    [[nodiscard]] res::optional_t<volume_t> get_capture_volume() const;
+    [[nodiscard]] std::vector<ramp_event_t> take_events();
+};
+
+struct power_supply_event_t {
+    enum class action_t {
+        added,
+        removed,
+        changed,
+        other,
+    };
+
+    action_t action;
+
+    // The name of the power supply (e.g. "BAT0" or "AC").
+    std::string name;
+};
+
+struct link_event_t {
+    // The name of the network interface.
+    std::string name;
+
+    // The index of the network interface.
+    int index;
+
+    // The interface was removed.
+    bool removed;
+
+    // The interface is administratively up (IFF_UP).
+    bool up;
+
+    // The interface has a carrier (IFF_LOWER_UP).
+    bool lower_up;
+};
+
+struct pressure_trigger_t {
+    enum class resource_t {
+        cpu,
+        memory,
+        io,
+    };
+
+    resource_t resource;
+
+    // Trigger on time in which all tasks were stalled instead of time in which
+    // at least one task was stalled.
+    bool full = false;
+
+    // The stall time within the window that triggers an event.
+    ch::microseconds stall;
+
+    // The length of the window. The kernel requires this to be between 500
+    // milliseconds and 10 seconds (and a multiple of 2 seconds for
+    // unprivileged users).
+    ch::microseconds window;
+};
+
+class event_loop_t;
+
+/**
+ * @brief Attempt to create an event loop with no subscriptions.
+ *
+ * @return a new event loop.
+ */
+[[nodiscard]] res::optional_t<event_loop_t> get_event_loop();
+
+/**
+ * @brief Delivers events from sources that support readiness notification
+ * using a single epoll instance, so nothing is read until something changes.
+ *
+ * Callbacks run on the thread that calls 'dispatch' or 'run' and may
+ * unsubscribe any subscription (including their own). Only 'stop' may be
+ * called from another thread.
+ */
+class event_loop_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    event_loop_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<event_loop_t> get_event_loop();
+
+  public:
+    event_loop_t(const event_loop_t&) = delete;
+    event_loop_t(event_loop_t&&) noexcept;
+    event_loop_t& operator=(const event_loop_t&) = delete;
+    event_loop_t& operator=(event_loop_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~event_loop_t();
 
     /**
-     * @brief Attempt to set the playback status.
+     * @brief Attempt to subscribe to changes of a sysfs attribute that
+     * notifies pollers (sysfs_notify). Attributes that do not notify pollers
+     * are rejected.
      *
-     * @param[in] status - The new playback status.
-     * @return a result indicating success or failure.
+     * @param[in] path - The path to the attribute.
+     * @param[in] callback - Called with the new contents of the attribute.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_playback_status(const status_t& status);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_attribute(
+      const fs::path& path,
+      std::function<void(const std::string& contents)> callback);
 
     /**
-     * @brief Attempt to set the playback status for all channels.
+     * @brief Attempt to subscribe to brightness changes of a backlight
+     * (actual_brightness), including changes made by the firmware.
      *
-     * @param[in] status - The new playback status.
-     * @return a result indicating success or failure.
+     * @param[in] backlight - The backlight to watch.
+     * @param[in] callback - Called with the new brightness percentage.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_playback_status_all(bool status);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_backlight(
+      const backlight_t& backlight, std::function<void(double)> callback);
 
     /**
-     * @brief Attempt to toggle the playback status of each individual channel.
+     * @brief Attempt to subscribe to kernel events (uevents) of batteries and
+     * other power supplies, which are sent when a power supply is added,
+     * removed, or its state changes.
      *
-     * @return a result indicating success or failure.
+     * @param[in] callback - Called for each event.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t toggle_playback_status();
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_power_supply(
+      std::function<void(const power_supply_event_t&)> callback);
 
     /**
-     * @brief Attempt to set the playback volume.
+     * @brief Attempt to subscribe to changes of the mount table.
      *
-     * @param[in] volume - The new playback volume.
-     * @return a result indicating success or failure.
+     * @param[in] callback - Called whenever a filesystem is mounted,
+     * unmounted, or remounted.
+     * @param[in] mountinfo_path - The path to the mount table. This is only
+     * changed for testing. Relative paths are resolved against the procfs
+     * root (see set_roots).
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_playback_volume(const volume_t& volume);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_mounts(
+      std::function<void()> callback,
+      const fs::path& mountinfo_path = "self/mountinfo");
 
     /**
-     * @brief Attempt to set the playback volume for all channels.
+     * @brief Attempt to subscribe to network interface changes using an
+     * rtnetlink socket.
      *
-     * @param[in] volume - The new playback volume.
-     * @return a result indicating success or failure.
+     * @param[in] callback - Called whenever an interface is added, removed, or
+     * its flags change.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_playback_volume_all(double volume);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_links(
+      std::function<void(const link_event_t&)> callback);
 
     /**
-     * @brief Attempt to increment the playback volume for all channels by a
-     * given percentage. A negative value decrements the playback volume.
-     * Absolute volume percentages are clamped to between 0% and 100%.
+     * @brief Attempt to create a pressure stall information (PSI) trigger.
      *
-     * @param[in] volume - The percentage to increment the playback volume by.
-     * @return a result indicating success or failure.
+     * @param[in] trigger - The resource and the stall threshold.
+     * @param[in] callback - Called whenever the threshold is exceeded (at most
+     * once per window).
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_playback_volume_all_relative(double volume);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_pressure(
+      const pressure_trigger_t& trigger, std::function<void()> callback);
 
     /**
-     * @brief Attempt to set the capture status.
+     * @brief Attempt to subscribe to changes of the control elements of a
+     * sound mixer. The mixer must outlive the subscription.
      *
-     * @param[in] status - The new capture status.
-     * @return a result indicating success or failure.
+     * @param[in] mixer - The mixer to watch.
+     * @param[in] callback - Called with the events returned by the 'dispatch'
+     * method of the mixer.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_capture_status(const status_t& status);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_mixer(
+      sound_mixer_t& mixer,
+      std::function<void(const std::vector<sound_event_t>&)> callback);
 
     /**
-     * @brief Attempt to set the capture status for all channels.
+     * @brief Attempt to subscribe to any file descriptor that becomes readable
+     * (e.g. the file descriptor of a scheduler or an actuator). The file
+     * descriptor must remain open until it is unsubscribed.
      *
-     * @param[in] status - The new capture status.
-     * @return a result indicating success or failure.
+     * @param[in] fd - The file descriptor to watch.
+     * @param[in] callback - Called whenever the file descriptor is readable.
+     * @return an identifier for unsubscribing.
      */
-    res::result_t set_capture_status_all(bool status);
+    [[nodiscard]] res::optional_t<uint64_t> subscribe_fd(
+      int fd, std::function<res::result_t()> callback);
 
     /**
-     * @brief Attempt to toggle the capture status of each individual channel.
+     * @brief Attempt to remove a subscription.
      *
+     * @param[in] id - The identifier returned when subscribing.
      * @return a result indicating success or failure.
      */
-    res::result_t toggle_capture_status();
+    [[nodiscard]] res::result_t unsubscribe(uint64_t id);
 
     /**
-     * @brief Attempt to set the capture volume.
+     * @return the epoll file descriptor of this event loop. It becomes
+     * readable when an event is pending and can be added to an existing poll
+     * or epoll loop, in which case 'dispatch' must be called whenever it is
+     * readable.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Attempt to deliver every pending event without waiting. Every
+     * pending event is delivered even if handling another one fails.
      *
-     * @param[in] volume - The new capture volume in percents.
      * @return a result indicating success or failure.
      */
-    res::result_t set_capture_volume(const volume_t& volume);
+    [[nodiscard]] res::result_t dispatch();
 
     /**
-     * @brief Attempt to set the capture volume for all channels.
+     * @brief Attempt to wait for and deliver events until 'stop' is called or
+     * handling an event fails.
      *
-     * @param[in] volume - The new capture volume.
      * @return a result indicating success or failure.
      */
-    res::result_t set_capture_volume_all(double volume);
+    [[nodiscard]] res::result_t run();
 
     /**
-     * @brief Attempt to increment the capture volume for all channels by a
-     * given percentage. A negative value decrements the capture volume.
-     * Absolute volume percentages are clamped to between 0% and 100%.
+     * @brief Make 'run' return as soon as possible. If 'run' is not running,
+     * the next call to 'run' returns immediately. Safe to call from any thread.
+     */
+    void stop();
+};
+
+class device_registry_t;
+
+struct device_registry_options_t {
+    // The paths to the class directories. These are only changed for testing.
+    // Relative paths are resolved against the sysfs root (see set_roots).
+    fs::path thermal_path = "class/thermal";
+    fs::path power_supply_path = "class/power_supply";
+    fs::path backlight_path = "class/backlight";
+};
+
+/**
+ * @brief Attempt to create a device registry and enumerate every subsystem
+ * once.
+ *
+ * @param[in] options - The options for the registry.
+ * @return a new device registry.
+ */
+[[nodiscard]] res::optional_t<device_registry_t> get_device_registry(
+  const device_registry_options_t& options = {});
+
+/**
+ * @brief Maintains the disks, network interfaces, thermal zones, batteries and
+ * backlights of this system from kernel events (uevents) so that sysfs is not
+ * enumerated every time the devices are needed.
+ *
+ * Removed devices are dropped from their list and added devices are appended
+ * to it without enumerating the rest of their subsystem. A subsystem is only
+ * enumerated again if an added device could not be created, and every
+ * subsystem is enumerated again if the kernel dropped events. Devices only
+ * change when 'dispatch' or 'rescan' is called, and the registry must not be
+ * used by more than one thread at a time.
+ */
+class device_registry_t {
+    struct impl_t;
+    std::unique_ptr<impl_t> impl_;
+
+    device_registry_t(std::unique_ptr<impl_t>&& impl);
+
+    // Some functions require access to private members.
+    friend res::optional_t<device_registry_t> get_device_registry(
+      const device_registry_options_t& options);
+
+  public:
+    device_registry_t(const device_registry_t&) = delete;
+    device_registry_t(device_registry_t&&) noexcept;
+    device_registry_t& operator=(const device_registry_t&) = delete;
+    device_registry_t& operator=(device_registry_t&&) noexcept;
+    // The destructor must be implemented where 'impl' is defined.
+    ~device_registry_t();
+
+    /**
+     * @return the disks or the error that occurred when they were last
+     * enumerated.
+     */
+    [[nodiscard]] const res::optional_t<std::vector<disk_t>>& get_disks()
+      const;
+
+    /**
+     * @return the network interfaces or the error that occurred when they were
+     * last enumerated.
+     */
+    [[nodiscard]] const res::optional_t<std::vector<network_interface_t>>&
+    get_network_interfaces() const;
+
+    /**
+     * @return the thermal zones or the error that occurred when they were last
+     * enumerated.
+     */
+    [[nodiscard]] const res::optional_t<std::vector<thermal_zone_t>>&
+    get_thermal_zones() const;
+
+    /**
+     * @return the batteries or the error that occurred when they were last
+     * enumerated.
+     */
+    [[nodiscard]] const res::optional_t<std::vector<battery_t>>&
+    get_batteries() const;
+
+    /**
+     * @return the backlights or the error that occurred when they were last
+     * enumerated.
+     */
+    [[nodiscard]] const res::optional_t<std::vector<backlight_t>>&
+    get_backlights() const;
+
+    /**
+     * @return a counter that is incremented whenever the devices of any
+     * subsystem change. Comparing it with a previous value is enough to know
+     * whether anything was added or removed.
+     */
+    [[nodiscard]] uint64_t get_generation() const;
+
+    /**
+     * @return the number of times a subsystem has been enumerated, including
+     * the enumeration of every subsystem when the registry was created.
+     */
+    [[nodiscard]] uint64_t get_enumerations() const;
+
+    /**
+     * @return the uevent socket of this registry. It becomes readable when a
+     * kernel event is pending and can be added to an existing poll or epoll
+     * loop (or subscribed to an event loop with 'subscribe_fd'), in which case
+     * 'dispatch' must be called whenever it is readable.
+     */
+    [[nodiscard]] int get_fd() const;
+
+    /**
+     * @brief Attempt to apply every pending kernel event without waiting.
+     * Errors from enumerating a subsystem are stored in that subsystem instead
+     * of being returned.
      *
-     * @param[in] volume - The percentage to increment the capture volume by.
      * @return a result indicating success or failure.
      */
-    res::result_t set_capture_volume_all_relative(double volume);
+    [[nodiscard]] res::result_t dispatch();
+
+    /**
+     * @brief Enumerate every subsystem again regardless of pending events.
+     */
+    void rescan();
 };
 
 /**
@@ -907,4 +2856,65 @@ class sound_control_t {
  */
 [[nodiscard]] res::optional_t<std::vector<std::string>> get_installed_kernels();
 
+/**
+ * @brief The work done by calls to one public function.
+ */
+struct api_stats_t {
+    // The number of calls. Calls made by another public function are
+    // attributed to the outermost function instead.
+    uint64_t calls = 0;
+
+    // The number of files and directories opened.
+    uint64_t opens = 0;
+
+    // The number of read system calls.
+    uint64_t reads = 0;
+
+    // The number of stat-like system calls (stat, faccessat, readlink, ...).
+    uint64_t stats = 0;
+
+    // The number of directory entries scanned.
+    uint64_t directory_entries = 0;
+
+    // The number of bytes read.
+    uint64_t bytes_read = 0;
+
+    // The number of heap allocations. Allocations made through operator new
+    // are only counted by the tests and benchmarks, which link a replacement
+    // of it. Strings allocated by the C API are always counted.
+    uint64_t allocations = 0;
+};
+
+/**
+ * @brief The counters of the work done by the library.
+ */
+struct stats_t {
+    // Whether the library was built with instrumentation (the meson option
+    // 'instrumentation'). Every counter is zero otherwise.
+    bool enabled = false;
+
+    // The work done by the calling thread, including work done outside of any
+    // public function.
+    api_stats_t total;
+
+    // The names of public functions (such as "disk_t::get_parts") mapped to
+    // the work done by the calling thread within them.
+    std::unordered_map<std::string, api_stats_t> apis;
+};
+
+/**
+ * @brief Get the counters of the calling thread. Counters are thread-local,
+ * so work done by internal threads (such as the pool used by 'collect') is
+ * counted by those threads.
+ *
+ * @return the counters of the calling thread since it started or since they
+ * were last reset.
+ */
+[[nodiscard]] stats_t stats();
+
+/**
+ * @brief Reset the counters of the calling thread to zero.
+ */
+void reset_stats();
+
 } // namespace syst
@@ -0,0 +1,191 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+
+// External includes
+#include <gtest/gtest.h>
+#include <poll.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class actuator_test : public fixture_test_t {
+  protected:
+    fs::path backlight_class_path_;
+    fs::path thermal_class_path_;
+    fs::path backlight_path_;
+    fs::path device_path_;
+
+    actuator_test() : fixture_test_t("actuator") {
+    }
+
+    static std::string read(const fs::path& path) {
+        std::ifstream file{ path };
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->backlight_class_path_ = this->root_ / "class" / "backlight";
+        fs::create_directories(this->backlight_class_path_);
+        this->thermal_class_path_ = this->root_ / "class" / "thermal";
+        fs::create_directories(this->thermal_class_path_);
+
+        // Attributes are padded since the actuators overwrite them in place.
+        this->backlight_path_ = this->root_ / "devices" / "backlight0";
+        fs::create_directories(this->backlight_path_);
+        overwrite_file(this->backlight_path_ / "brightness", "0     ");
+        overwrite_file(this->backlight_path_ / "max_brightness", "1000");
+        fs::create_directory_symlink(
+          this->backlight_path_, this->backlight_class_path_ / "backlight0");
+
+        this->device_path_ = this->root_ / "devices" / "cooling_device0";
+        fs::create_directories(this->device_path_);
+        overwrite_file(this->device_path_ / "type", "Fan");
+        overwrite_file(this->device_path_ / "max_state", "10");
+        overwrite_file(this->device_path_ / "cur_state", "5    ");
+        fs::create_directory_symlink(
+          this->device_path_, this->thermal_class_path_ / "cooling_device0");
+    }
+
+    [[nodiscard]] syst::actuator_t backlight_actuator(
+      std::chrono::nanoseconds min_interval = {}) {
+        auto backlights = syst::get_backlights(this->backlight_class_path_);
+        EXPECT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+        EXPECT_EQ(backlights->size(), 1);
+
+        auto actuator = syst::get_actuator(backlights->front(), min_interval);
+        EXPECT_TRUE(actuator.has_value()) << RES_TRACE(actuator.error());
+        return std::move(actuator.value());
+    }
+
+    [[nodiscard]] std::string brightness() const {
+        return read(this->backlight_path_ / "brightness");
+    }
+};
+
+TEST_F(actuator_test, set) {
+    auto actuator = this->backlight_actuator();
+    ASSERT_EQ(actuator.get_path(),
+      this->backlight_class_path_ / "backlight0" / "brightness");
+    ASSERT_DOUBLE_EQ(actuator.get(), 0);
+    ASSERT_EQ(actuator.get_fd(), -1);
+    ASSERT_FALSE(actuator.dispatch().success());
+
+    ASSERT_TRUE(actuator.set(50).success());
+    ASSERT_FALSE(actuator.is_pending());
+    ASSERT_DOUBLE_EQ(actuator.get(), 50);
+    ASSERT_EQ(this->brightness().substr(0, 3), "500");
+
+    ASSERT_TRUE(actuator.set_relative(-25).success());
+    ASSERT_DOUBLE_EQ(actuator.get(), 25);
+    ASSERT_EQ(this->brightness().substr(0, 3), "250");
+
+    // Values are clamped.
+    ASSERT_TRUE(actuator.set(150).success());
+    ASSERT_DOUBLE_EQ(actuator.get(), 100);
+    ASSERT_EQ(this->brightness().substr(0, 4), "1000");
+}
+
+TEST_F(actuator_test, identical_writes_are_suppressed) {
+    auto actuator = this->backlight_actuator();
+
+    ASSERT_TRUE(actuator.set(50).success());
+    overwrite_file(this->backlight_path_ / "brightness", "1     ");
+
+    // The value that was written last is not written again.
+    ASSERT_TRUE(actuator.set(50).success());
+    ASSERT_EQ(this->brightness(), "1     ");
+
+    // Neither is the value read when the actuator was created.
+    auto other = this->backlight_actuator();
+    ASSERT_TRUE(other.set(0.1).success());
+    overwrite_file(this->backlight_path_ / "brightness", "2     ");
+    ASSERT_TRUE(other.set(0.1).success());
+    ASSERT_EQ(this->brightness(), "2     ");
+}
+
+TEST_F(actuator_test, rate_limit) {
+    auto actuator = this->backlight_actuator(std::chrono::milliseconds(20));
+    ASSERT_GE(actuator.get_fd(), 0);
+
+    // The first change is written immediately.
+    ASSERT_TRUE(actuator.set(10).success());
+    ASSERT_FALSE(actuator.is_pending());
+    ASSERT_EQ(this->brightness().substr(0, 3), "100");
+
+    // Rapid changes are combined and the latest one wins.
+    for (double brightness : { 20.0, 30.0, 40.0 }) {
+        ASSERT_TRUE(actuator.set(brightness).success());
+    }
+    ASSERT_TRUE(actuator.is_pending());
+    ASSERT_EQ(this->brightness().substr(0, 3), "100");
+
+    struct pollfd poll_fd {};
+    poll_fd.fd = actuator.get_fd();
+    poll_fd.events = POLLIN;
+    ASSERT_EQ(poll(&poll_fd, 1, 1000), 1);
+    ASSERT_TRUE(actuator.dispatch().success());
+    ASSERT_FALSE(actuator.is_pending());
+    ASSERT_EQ(this->brightness().substr(0, 3), "400");
+}
+
+TEST_F(actuator_test, pending_change_cancelled) {
+    auto actuator = this->backlight_actuator(std::chrono::seconds(10));
+
+    ASSERT_TRUE(actuator.set(10).success());
+    ASSERT_TRUE(actuator.set(20).success());
+    ASSERT_TRUE(actuator.is_pending());
+
+    // Returning to the value that was written last cancels the pending write.
+    ASSERT_TRUE(actuator.set(10).success());
+    ASSERT_FALSE(actuator.is_pending());
+}
+
+TEST_F(actuator_test, flush) {
+    {
+        auto actuator = this->backlight_actuator(std::chrono::seconds(10));
+
+        ASSERT_TRUE(actuator.set(10).success());
+        ASSERT_TRUE(actuator.set(20).success());
+        ASSERT_TRUE(actuator.flush().success());
+        ASSERT_FALSE(actuator.is_pending());
+        ASSERT_EQ(this->brightness().substr(0, 3), "200");
+
+        ASSERT_TRUE(actuator.set(30).success());
+        ASSERT_TRUE(actuator.is_pending());
+    }
+
+    // Pending changes are written when the actuator is destroyed.
+    ASSERT_EQ(this->brightness().substr(0, 3), "300");
+}
+
+TEST_F(actuator_test, cooling_device) {
+    auto cooling_devices = syst::get_cooling_devices(this->thermal_class_path_);
+    ASSERT_TRUE(cooling_devices.has_value())
+      << RES_TRACE(cooling_devices.error());
+    ASSERT_EQ(cooling_devices->size(), 1);
+
+    auto actuator = syst::get_actuator(cooling_devices->front());
+    ASSERT_TRUE(actuator.has_value()) << RES_TRACE(actuator.error());
+    ASSERT_DOUBLE_EQ(actuator->get(), 50);
+
+    ASSERT_TRUE(actuator->set_relative(30).success());
+    ASSERT_EQ(read(this->device_path_ / "cur_state").substr(0, 1), "8");
+}
+
+TEST_F(actuator_test, missing_maximum) {
+    fs::remove(this->backlight_path_ / "max_brightness");
+
+    auto backlights = syst::get_backlights(this->backlight_class_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+
+    auto actuator = syst::get_actuator(backlights->front());
+    ASSERT_FALSE(actuator.has_value());
+}
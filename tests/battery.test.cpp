@@ -1,8 +1,56 @@
+// Standard includes
+#include <filesystem>
+
 // External includes
 #include <gtest/gtest.h>
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class battery_fixture_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+    fs::path battery_path_;
+
+    battery_fixture_test() : fixture_test_t("battery") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->class_path_ = this->root_ / "class" / "power_supply";
+        fs::create_directories(this->class_path_);
+
+        this->battery_path_ = this->root_ / "devices" / "BAT0";
+        fs::create_directories(this->battery_path_);
+        write_file(this->battery_path_ / "type", "Battery");
+        fs::create_directory_symlink(
+          this->battery_path_, this->class_path_ / "BAT0");
+
+        fs::path mains_path = this->root_ / "devices" / "AC";
+        fs::create_directories(mains_path);
+        write_file(mains_path / "type", "Mains");
+        write_file(mains_path / "uevent", "POWER_SUPPLY_NAME=AC");
+        fs::create_directory_symlink(mains_path, this->class_path_ / "AC");
+    }
+
+    void set_uevent(const std::string& contents) {
+        write_power_supply_uevent(this->battery_path_, contents);
+    }
+
+    [[nodiscard]] syst::battery_t::snapshot_t snapshot() {
+        auto batteries = syst::get_batteries(this->class_path_);
+        EXPECT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+        EXPECT_EQ(batteries->size(), 1);
+
+        auto snapshot = batteries->front().get_snapshot();
+        EXPECT_TRUE(snapshot.has_value()) << RES_TRACE(snapshot.error());
+        return std::move(snapshot.value());
+    }
+};
 
 TEST(battery_test, all) {
     auto batteries = syst::get_batteries();
@@ -165,3 +213,158 @@ TEST(battery_test, time_remaining) {
 
     ASSERT_TRUE(time_remaining_found);
 }
+
+TEST_F(battery_fixture_test, energy_discharging) {
+    this->set_uevent("POWER_SUPPLY_NAME=BAT0\n"
+                     "POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_POWER_NOW=10000000\n"
+                     "POWER_SUPPLY_VOLTAGE_NOW=12000000\n"
+                     "POWER_SUPPLY_ENERGY_FULL_DESIGN=50000000\n"
+                     "POWER_SUPPLY_ENERGY_FULL=40000000\n"
+                     "POWER_SUPPLY_ENERGY_NOW=20000000\n"
+                     "POWER_SUPPLY_CAPACITY=51");
+
+    auto snapshot = this->snapshot();
+    ASSERT_EQ(snapshot.get_attribute("name").value(), "BAT0");
+    ASSERT_EQ(snapshot.get_status().value(),
+      syst::battery_t::status_t::discharging);
+    ASSERT_DOUBLE_EQ(snapshot.get_power().value(), 10);
+    ASSERT_DOUBLE_EQ(snapshot.get_current().value(), 10.0 / 12.0);
+    ASSERT_DOUBLE_EQ(snapshot.get_charge().value(), 50);
+    ASSERT_DOUBLE_EQ(snapshot.get_capacity().value(), 80);
+    // 20 Wh at 10 W lasts two hours.
+    ASSERT_EQ(snapshot.get_time_remaining().value().count(), 7200);
+}
+
+TEST_F(battery_fixture_test, charge_charging) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Charging\n"
+                     "POWER_SUPPLY_CURRENT_NOW=-2000000\n"
+                     "POWER_SUPPLY_VOLTAGE_NOW=10000000\n"
+                     "POWER_SUPPLY_CHARGE_FULL_DESIGN=5000000\n"
+                     "POWER_SUPPLY_CHARGE_FULL=4000000\n"
+                     "POWER_SUPPLY_CHARGE_NOW=1000000");
+
+    auto snapshot = this->snapshot();
+    ASSERT_EQ(
+      snapshot.get_status().value(), syst::battery_t::status_t::charging);
+    ASSERT_DOUBLE_EQ(snapshot.get_current().value(), 2);
+    ASSERT_DOUBLE_EQ(snapshot.get_power().value(), 20);
+    ASSERT_DOUBLE_EQ(snapshot.get_charge().value(), 25);
+    ASSERT_DOUBLE_EQ(snapshot.get_capacity().value(), 80);
+    // 3 Ah at 2 A takes one and a half hours.
+    ASSERT_EQ(snapshot.get_time_remaining().value().count(), 5400);
+}
+
+TEST_F(battery_fixture_test, time_to_empty) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_TIME_TO_EMPTY_NOW=1234\n"
+                     "POWER_SUPPLY_CAPACITY=42");
+
+    auto snapshot = this->snapshot();
+    ASSERT_EQ(snapshot.get_time_remaining().value().count(), 1234);
+    ASSERT_DOUBLE_EQ(snapshot.get_charge().value(), 42);
+}
+
+TEST_F(battery_fixture_test, missing_attributes) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Full");
+
+    auto snapshot = this->snapshot();
+    ASSERT_EQ(snapshot.get_status().value(), syst::battery_t::status_t::full);
+    ASSERT_FALSE(snapshot.get_current().has_value());
+    ASSERT_FALSE(snapshot.get_power().has_value());
+    ASSERT_FALSE(snapshot.get_charge().has_value());
+    ASSERT_FALSE(snapshot.get_capacity().has_value());
+    ASSERT_FALSE(snapshot.get_time_remaining().has_value());
+    ASSERT_FALSE(snapshot.get_attribute("energy_now").has_value());
+}
+
+TEST_F(battery_fixture_test, invalid_status) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Exploding");
+
+    auto snapshot = this->snapshot();
+    ASSERT_FALSE(snapshot.get_status().has_value());
+}
+
+TEST_F(battery_fixture_test, getters_read_uevent) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_POWER_NOW=5000000");
+
+    auto batteries = syst::get_batteries(this->class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+    const syst::battery_t& battery = batteries->front();
+
+    ASSERT_DOUBLE_EQ(battery.get_power().value(), 5);
+
+    // Each getter takes a new snapshot.
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_POWER_NOW=7000000");
+    ASSERT_DOUBLE_EQ(battery.get_power().value(), 7);
+}
+
+TEST_F(battery_fixture_test, missing_uevent) {
+    auto batteries = syst::get_batteries(this->class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+    ASSERT_FALSE(batteries->front().get_snapshot().has_value());
+}
+
+TEST_F(battery_fixture_test, capabilities) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_POWER_NOW=10000000\n"
+                     "POWER_SUPPLY_ENERGY_FULL=40000000\n"
+                     "POWER_SUPPLY_ENERGY_NOW=20000000\n"
+                     "POWER_SUPPLY_TIME_TO_EMPTY_AVG=60");
+
+    auto batteries = syst::get_batteries(this->class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+
+    auto capabilities = batteries->front().get_capabilities();
+    ASSERT_TRUE(capabilities.energy);
+    ASSERT_FALSE(capabilities.energy_design);
+    ASSERT_FALSE(capabilities.charge);
+    ASSERT_FALSE(capabilities.capacity);
+    ASSERT_FALSE(capabilities.current);
+    ASSERT_TRUE(capabilities.power);
+    ASSERT_FALSE(capabilities.voltage);
+    ASSERT_TRUE(capabilities.time_to_empty);
+    ASSERT_FALSE(capabilities.time_to_full);
+}
+
+TEST_F(battery_fixture_test, capabilities_of_unreadable_attributes) {
+    // The kernel omits attributes that cannot be read at the moment from the
+    // uevent file, but their files still exist.
+    write_file(this->battery_path_ / "time_to_full_now", "");
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_TIME_TO_EMPTY_NOW=60");
+
+    auto batteries = syst::get_batteries(this->class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+    const syst::battery_t& battery = batteries->front();
+    ASSERT_TRUE(battery.get_capabilities().time_to_full);
+
+    this->set_uevent("POWER_SUPPLY_STATUS=Charging\n"
+                     "POWER_SUPPLY_TIME_TO_FULL_NOW=120");
+    auto time = battery.get_time_remaining();
+    ASSERT_TRUE(time.has_value()) << RES_TRACE(time.error());
+    ASSERT_EQ(time.value(), std::chrono::seconds{ 120 });
+}
+
+TEST_F(battery_fixture_test, capabilities_are_cached) {
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_ENERGY_FULL=40000000\n"
+                     "POWER_SUPPLY_ENERGY_NOW=20000000");
+
+    auto batteries = syst::get_batteries(this->class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+    const syst::battery_t& battery = batteries->front();
+    ASSERT_DOUBLE_EQ(battery.get_charge().value(), 50);
+
+    // Attributes that were missing at enumeration are never read.
+    this->set_uevent("POWER_SUPPLY_STATUS=Discharging\n"
+                     "POWER_SUPPLY_CAPACITY=42");
+    ASSERT_FALSE(battery.get_charge().has_value());
+}
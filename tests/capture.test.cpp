@@ -0,0 +1,224 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class capture_test : public fixture_test_t {
+  protected:
+    fs::path capture_path_;
+    syst::roots_t roots_;
+
+    capture_test() : fixture_test_t("capture") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+        this->capture_path_ = this->root_ / "capture";
+
+        this->roots_.sys = this->root_ / "sys";
+        this->roots_.proc = this->root_ / "proc";
+        this->roots_.dev = this->root_ / "dev";
+        fs::create_directories(this->roots_.sys / "block");
+        fs::create_directories(this->roots_.proc);
+        fs::create_directories(this->roots_.dev);
+
+        fs::path disk_path = this->roots_.sys / "devices" / "sda";
+        fs::create_directories(disk_path / "queue");
+        write_file(disk_path / "queue" / "iostats", "1");
+        write_file(disk_path / "stat",
+          "     100        2      300        4      500        6      700"
+          "        8        9       10       11       12       13       14"
+          "       15       16       17");
+        fs::create_directory_symlink(
+          disk_path, this->roots_.sys / "block" / "sda");
+
+        write_file(this->roots_.proc / "stat",
+          "cpu  10 0 10 80 0 0 0 0 0 0\n"
+          "cpu0 10 0 10 80 0 0 0 0 0 0\n"
+          "intr 0");
+
+        auto result = syst::set_roots(this->roots_);
+        ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    }
+
+    void TearDown() override {
+        // Tests stop their sessions unless they fail first.
+        syst::stop_replay();
+        auto stopped = syst::stop_recording();
+        EXPECT_TRUE(syst::set_roots({}).success());
+        fixture_test_t::TearDown();
+    }
+
+    [[nodiscard]] syst::disk_t get_disk() const {
+        auto disks = syst::get_disks();
+        EXPECT_TRUE(disks.has_value()) << RES_TRACE(disks.error());
+        EXPECT_EQ(disks->size(), 1);
+        return disks->front();
+    }
+};
+
+TEST_F(capture_test, replay_io_stat) {
+    const syst::disk_t disk = this->get_disk();
+
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    auto recorded = disk.get_io_stat();
+    ASSERT_TRUE(recorded.has_value()) << RES_TRACE(recorded.error());
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    // The recorded contents are served even though the file changed.
+    write_file(this->roots_.sys / "devices" / "sda" / "stat", "invalid");
+
+    result = syst::start_replay(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    for (int replay = 0; replay < 3; ++replay) {
+        auto replayed = disk.get_io_stat();
+        ASSERT_TRUE(replayed.has_value()) << RES_TRACE(replayed.error());
+        EXPECT_EQ(replayed->reads_completed, recorded->reads_completed);
+        EXPECT_EQ(replayed->sectors_read, recorded->sectors_read);
+        EXPECT_EQ(replayed->discards_merged, recorded->discards_merged);
+    }
+    syst::stop_replay();
+
+    EXPECT_TRUE(disk.get_io_stat().has_error());
+}
+
+TEST_F(capture_test, replay_proc_stat) {
+    const syst::cpu_usage_t cpu_usage;
+
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    result = cpu_usage.update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    write_file(this->roots_.proc / "stat",
+      "cpu  20 0 20 160 0 0 0 0 0 0\n"
+      "cpu0 20 0 20 160 0 0 0 0 0 0\n"
+      "intr 0");
+    result = cpu_usage.update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    fs::remove(this->roots_.proc / "stat");
+
+    result = syst::start_replay(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    const syst::cpu_usage_t replayed;
+    result = replayed.update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    result = replayed.update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto total = replayed.get_total();
+    ASSERT_TRUE(total.has_value()) << RES_TRACE(total.error());
+    EXPECT_DOUBLE_EQ(total.value(), 20.0);
+}
+
+TEST_F(capture_test, not_recorded) {
+    const syst::disk_t disk = this->get_disk();
+
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    result = syst::start_replay(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    EXPECT_TRUE(disk.get_io_stat().has_error());
+}
+
+TEST_F(capture_test, invalid_capture) {
+    EXPECT_TRUE(syst::start_replay(this->root_ / "missing").failure());
+
+    write_file(this->capture_path_, "not a capture");
+    EXPECT_TRUE(syst::start_replay(this->capture_path_).failure());
+}
+
+TEST_F(capture_test, one_session) {
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    EXPECT_TRUE(syst::start_recording(this->root_ / "other").failure());
+    EXPECT_TRUE(syst::start_replay(this->capture_path_).failure());
+
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    EXPECT_TRUE(syst::stop_recording().failure());
+}
+
+TEST_F(capture_test, replay_without_directories) {
+    const fs::path chip_path = this->roots_.sys / "devices" / "hwmon0";
+    fs::create_directories(chip_path);
+    fs::create_directories(this->roots_.sys / "class" / "hwmon");
+    write_file(chip_path / "name", "cpu");
+    write_file(chip_path / "temp1_input", "42000");
+    write_file(chip_path / "temp1_max", "90000");
+    fs::create_directory_symlink(
+      chip_path, this->roots_.sys / "class" / "hwmon" / "hwmon0");
+
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    auto recorded = this->get_disk().get_io_stat();
+    ASSERT_TRUE(recorded.has_value()) << RES_TRACE(recorded.error());
+    auto chips = syst::get_hwmon_chips();
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+    ASSERT_EQ(chips->size(), 1);
+    result = chips->front().update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    // Devices are enumerated and read from the capture alone.
+    fs::remove_all(this->roots_.sys);
+
+    result = syst::start_replay(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto replayed = this->get_disk().get_io_stat();
+    ASSERT_TRUE(replayed.has_value()) << RES_TRACE(replayed.error());
+    EXPECT_EQ(replayed->reads_completed, recorded->reads_completed);
+
+    chips = syst::get_hwmon_chips();
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+    ASSERT_EQ(chips->size(), 1);
+    EXPECT_EQ(chips->front().get_name(), "cpu");
+    result = chips->front().update();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    const auto& sensors = chips->front().get_sensors();
+    ASSERT_EQ(sensors.size(), 1);
+    auto value = sensors.front().get_value();
+    ASSERT_TRUE(value.has_value()) << RES_TRACE(value.error());
+    EXPECT_DOUBLE_EQ(value.value(), 42.0);
+    EXPECT_EQ(sensors.front().get_limits().max, 90.0);
+}
+
+TEST_F(capture_test, record_whole_integer_files) {
+    const fs::path path = this->roots_.sys / "devices" / "sda" / "size";
+    const std::string contents = "123\n" + std::string(40, 'x');
+    write_file(path, contents);
+
+    auto result = syst::start_recording(this->capture_path_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    auto size = this->get_disk().get_size();
+    result = syst::stop_recording();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    // The capture holds the file as it was, not only the beginning that is
+    // needed to parse an integer.
+    std::ifstream capture{ this->capture_path_, std::ios::binary };
+    const std::string data{ std::istreambuf_iterator<char>{ capture }, {} };
+    ASSERT_TRUE(size.has_value()) << RES_TRACE(size.error());
+    EXPECT_NE(data.find(contents + '\n'), std::string::npos);
+}
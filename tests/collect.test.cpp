@@ -0,0 +1,173 @@
+// Standard includes
+#include <filesystem>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class collect_test : public fixture_test_t {
+  protected:
+    syst::collect_options_t options_;
+
+    collect_test() : fixture_test_t("collect") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->options_.thermal_path = this->root_ / "class" / "thermal";
+        fs::create_directories(this->options_.thermal_path);
+        this->options_.power_supply_path =
+          this->root_ / "class" / "power_supply";
+        fs::create_directories(this->options_.power_supply_path);
+        this->options_.backlight_path = this->root_ / "class" / "backlight";
+        fs::create_directories(this->options_.backlight_path);
+
+        fs::path zone_path = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(zone_path);
+        write_file(zone_path / "type", "x86_pkg_temp");
+        write_file(zone_path / "temp", "45000");
+        fs::create_directory_symlink(
+          zone_path, this->options_.thermal_path / "thermal_zone0");
+
+        fs::path battery_path = this->root_ / "devices" / "BAT0";
+        fs::create_directories(battery_path);
+        write_file(battery_path / "type", "Battery");
+        write_power_supply_uevent(battery_path,
+          "POWER_SUPPLY_STATUS=Discharging\n"
+          "POWER_SUPPLY_ENERGY_FULL=40000000\n"
+          "POWER_SUPPLY_ENERGY_NOW=20000000");
+        fs::create_directory_symlink(
+          battery_path, this->options_.power_supply_path / "BAT0");
+
+        fs::path backlight_path = this->root_ / "devices" / "intel_backlight";
+        fs::create_directories(backlight_path);
+        write_file(backlight_path / "brightness", "250");
+        write_file(backlight_path / "max_brightness", "1000");
+        fs::create_directory_symlink(
+          backlight_path, this->options_.backlight_path / "intel_backlight");
+    }
+
+    void check(const syst::system_snapshot_t& snapshot) const {
+        ASSERT_TRUE(snapshot.thermal_zones.has_value());
+        const auto& thermal_zones = snapshot.thermal_zones->value;
+        ASSERT_TRUE(thermal_zones.has_value())
+          << RES_TRACE(thermal_zones.error());
+        ASSERT_EQ(thermal_zones->size(), 1);
+        ASSERT_TRUE(thermal_zones->front().temperature.has_value());
+        ASSERT_DOUBLE_EQ(thermal_zones->front().temperature.value(), 45);
+
+        ASSERT_TRUE(snapshot.batteries.has_value());
+        const auto& batteries = snapshot.batteries->value;
+        ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+        ASSERT_EQ(batteries->size(), 1);
+        const auto& battery_snapshot = batteries->front().snapshot;
+        ASSERT_TRUE(battery_snapshot.has_value())
+          << RES_TRACE(battery_snapshot.error());
+        auto charge = battery_snapshot->get_charge();
+        ASSERT_TRUE(charge.has_value()) << RES_TRACE(charge.error());
+        ASSERT_DOUBLE_EQ(charge.value(), 50);
+
+        ASSERT_TRUE(snapshot.backlights.has_value());
+        const auto& backlights = snapshot.backlights->value;
+        ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+        ASSERT_EQ(backlights->size(), 1);
+        ASSERT_TRUE(backlights->front().brightness.has_value());
+        ASSERT_DOUBLE_EQ(backlights->front().brightness.value(), 25);
+
+        ASSERT_TRUE(snapshot.system_info.has_value());
+        const auto& system_info = snapshot.system_info->value;
+        ASSERT_TRUE(system_info.has_value()) << RES_TRACE(system_info.error());
+        ASSERT_GT(system_info->ram_total, 0);
+
+        ASSERT_TRUE(snapshot.disks.has_value());
+        ASSERT_TRUE(snapshot.network_interfaces.has_value());
+
+        // Every subsystem is collected within the whole snapshot.
+        const std::vector<std::chrono::nanoseconds> latencies{
+            snapshot.system_info->latency,
+            snapshot.disks->latency,
+            snapshot.network_interfaces->latency,
+            snapshot.thermal_zones->latency,
+            snapshot.batteries->latency,
+            snapshot.backlights->latency,
+        };
+        for (std::chrono::nanoseconds latency : latencies) {
+            ASSERT_GE(latency.count(), 0);
+            ASSERT_LE(latency, snapshot.latency);
+        }
+    }
+};
+
+TEST_F(collect_test, parallel) {
+    const auto before = std::chrono::steady_clock::now();
+    auto snapshot = syst::collect(this->options_);
+    ASSERT_GE(snapshot.timestamp, before);
+    ASSERT_LE(snapshot.timestamp + snapshot.latency,
+      std::chrono::steady_clock::now());
+
+    this->check(snapshot);
+}
+
+TEST_F(collect_test, serial) {
+    this->options_.parallel = false;
+    this->check(syst::collect(this->options_));
+}
+
+TEST_F(collect_test, repeated) {
+    // The pool is reused between calls.
+    for (int idx = 0; idx < 20; ++idx) {
+        this->check(syst::collect(this->options_));
+    }
+}
+
+TEST_F(collect_test, selected_subsystems) {
+    this->options_.system_info = false;
+    this->options_.disks = false;
+    this->options_.network_interfaces = false;
+    this->options_.batteries = false;
+    this->options_.backlights = false;
+
+    auto snapshot = syst::collect(this->options_);
+    ASSERT_TRUE(snapshot.thermal_zones.has_value());
+    ASSERT_FALSE(snapshot.system_info.has_value());
+    ASSERT_FALSE(snapshot.cpu_usage.has_value());
+    ASSERT_FALSE(snapshot.disks.has_value());
+    ASSERT_FALSE(snapshot.network_interfaces.has_value());
+    ASSERT_FALSE(snapshot.batteries.has_value());
+    ASSERT_FALSE(snapshot.backlights.has_value());
+}
+
+TEST_F(collect_test, failed_subsystem) {
+    fs::remove_all(this->options_.backlight_path);
+
+    // A subsystem that fails does not prevent the others from being collected.
+    auto snapshot = syst::collect(this->options_);
+    ASSERT_TRUE(snapshot.backlights.has_value());
+    ASSERT_FALSE(snapshot.backlights->value.has_value());
+    ASSERT_TRUE(snapshot.thermal_zones.has_value());
+    ASSERT_TRUE(snapshot.thermal_zones->value.has_value());
+}
+
+TEST_F(collect_test, cpu_usage) {
+    syst::cpu_usage_t cpu_usage;
+    this->options_.cpu_usage = &cpu_usage;
+
+    auto first = syst::collect(this->options_);
+    ASSERT_TRUE(first.cpu_usage.has_value());
+
+    auto second = syst::collect(this->options_);
+    ASSERT_TRUE(second.cpu_usage.has_value());
+    const auto& collected = second.cpu_usage->value;
+    ASSERT_TRUE(collected.has_value()) << RES_TRACE(collected.error());
+    ASSERT_TRUE(collected->total.has_value())
+      << RES_TRACE(collected->total.error());
+    ASSERT_GE(collected->total.value(), 0);
+    ASSERT_LE(collected->total.value(), 100);
+}
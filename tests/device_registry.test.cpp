@@ -0,0 +1,227 @@
+// Standard includes
+#include <cerrno>
+#include <filesystem>
+#include <string>
+
+// External includes
+#include <gtest/gtest.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class device_registry_test : public fixture_test_t {
+  protected:
+    syst::device_registry_options_t options_;
+
+    device_registry_test() : fixture_test_t("device_registry") {
+    }
+
+    void add_backlight(const std::string& name) const {
+        fs::path backlight_path = this->root_ / "devices" / name;
+        fs::create_directories(backlight_path);
+        write_file(backlight_path / "brightness", "250");
+        write_file(backlight_path / "max_brightness", "1000");
+        fs::create_directory_symlink(
+          backlight_path, this->options_.backlight_path / name);
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->options_.thermal_path = this->root_ / "class" / "thermal";
+        fs::create_directories(this->options_.thermal_path);
+        this->options_.power_supply_path =
+          this->root_ / "class" / "power_supply";
+        fs::create_directories(this->options_.power_supply_path);
+        this->options_.backlight_path = this->root_ / "class" / "backlight";
+        fs::create_directories(this->options_.backlight_path);
+
+        fs::path zone_path = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(zone_path);
+        write_file(zone_path / "type", "x86_pkg_temp");
+        write_file(zone_path / "temp", "45000");
+        fs::create_directory_symlink(
+          zone_path, this->options_.thermal_path / "thermal_zone0");
+
+        fs::path battery_path = this->root_ / "devices" / "BAT0";
+        fs::create_directories(battery_path);
+        write_file(battery_path / "type", "Battery");
+        fs::create_directory_symlink(
+          battery_path, this->options_.power_supply_path / "BAT0");
+
+        this->add_backlight("intel_backlight");
+    }
+
+    [[nodiscard]] syst::device_registry_t make_registry() const {
+        auto registry = syst::get_device_registry(this->options_);
+        EXPECT_TRUE(registry.has_value()) << RES_TRACE(registry.error());
+        return std::move(registry.value());
+    }
+};
+
+/**
+ * @brief Send a kernel event to the uevent multicast group. Only privileged
+ * processes may send to it.
+ *
+ * @return zero if the event was sent or an errno value otherwise.
+ */
+[[nodiscard]] int send_uevent(const std::string& action,
+  const std::string& subsystem,
+  const std::string& devpath) {
+    const int fd =
+      socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        return errno;
+    }
+
+    std::string message = action + "@" + devpath;
+    message.push_back('\0');
+    for (const std::string& property : { "ACTION=" + action,
+           "DEVPATH=" + devpath,
+           "SUBSYSTEM=" + subsystem }) {
+        message += property;
+        message.push_back('\0');
+    }
+
+    struct sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;
+
+    int err = 0;
+    if (sendto(fd,
+          message.data(),
+          message.size(),
+          0,
+          reinterpret_cast<struct sockaddr*>(&address),
+          sizeof(address))
+      < 0) {
+        err = errno;
+    }
+    close(fd);
+    return err;
+}
+
+[[nodiscard]] bool wait_readable(int fd) {
+    struct pollfd poll_fd {};
+    poll_fd.fd = fd;
+    poll_fd.events = POLLIN;
+    return poll(&poll_fd, 1, 1000) == 1;
+}
+
+TEST_F(device_registry_test, enumerate) {
+    auto registry = this->make_registry();
+
+    // Every subsystem is enumerated once when the registry is created.
+    ASSERT_EQ(registry.get_enumerations(), 5);
+
+    const auto& thermal_zones = registry.get_thermal_zones();
+    ASSERT_TRUE(thermal_zones.has_value()) << RES_TRACE(thermal_zones.error());
+    ASSERT_EQ(thermal_zones->size(), 1);
+
+    const auto& batteries = registry.get_batteries();
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+
+    const auto& backlights = registry.get_backlights();
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+    ASSERT_EQ(backlights->size(), 1);
+    ASSERT_EQ(backlights->front().get_name(), "intel_backlight");
+
+    ASSERT_TRUE(registry.get_disks().has_value())
+      << RES_TRACE(registry.get_disks().error());
+    ASSERT_TRUE(registry.get_network_interfaces().has_value())
+      << RES_TRACE(registry.get_network_interfaces().error());
+}
+
+TEST_F(device_registry_test, dispatch_without_events) {
+    auto registry = this->make_registry();
+    const uint64_t generation = registry.get_generation();
+
+    // Nothing is enumerated again until a device is added.
+    for (int idx = 0; idx < 10; ++idx) {
+        ASSERT_TRUE(registry.dispatch().success());
+    }
+    ASSERT_EQ(registry.get_enumerations(), 5);
+    ASSERT_EQ(registry.get_generation(), generation);
+}
+
+TEST_F(device_registry_test, rescan) {
+    auto registry = this->make_registry();
+    uint64_t generation = registry.get_generation();
+
+    // Enumerating unchanged subsystems does not change the generation.
+    registry.rescan();
+    ASSERT_EQ(registry.get_enumerations(), 10);
+    ASSERT_EQ(registry.get_generation(), generation);
+
+    this->add_backlight("acpi_video0");
+    registry.rescan();
+    ASSERT_GT(registry.get_generation(), generation);
+    ASSERT_EQ(registry.get_backlights()->size(), 2);
+    generation = registry.get_generation();
+
+    // Subsystems that fail to be enumerated keep the error.
+    fs::remove_all(this->options_.backlight_path);
+    registry.rescan();
+    ASSERT_GT(registry.get_generation(), generation);
+    ASSERT_FALSE(registry.get_backlights().has_value());
+    ASSERT_TRUE(registry.get_thermal_zones().has_value());
+}
+
+TEST_F(device_registry_test, uevents) {
+    auto registry = this->make_registry();
+    const std::string devpath = "/devices/platform/intel_backlight";
+
+    int err = send_uevent("change", "backlight", devpath);
+    if (err == EPERM || err == EACCES) {
+        GTEST_SKIP() << "Sending kernel events requires CAP_NET_ADMIN.";
+    }
+    ASSERT_EQ(err, 0);
+
+    // Changes do not add or remove devices.
+    ASSERT_TRUE(wait_readable(registry.get_fd()));
+    const uint64_t generation = registry.get_generation();
+    ASSERT_TRUE(registry.dispatch().success());
+    ASSERT_EQ(registry.get_generation(), generation);
+    ASSERT_EQ(registry.get_enumerations(), 5);
+
+    // Removed devices are dropped without enumerating the subsystem.
+    ASSERT_EQ(send_uevent("remove", "backlight", devpath), 0);
+    ASSERT_TRUE(wait_readable(registry.get_fd()));
+    ASSERT_TRUE(registry.dispatch().success());
+    ASSERT_GT(registry.get_generation(), generation);
+    ASSERT_EQ(registry.get_enumerations(), 5);
+    ASSERT_TRUE(registry.get_backlights()->empty());
+
+    // Added devices are created without enumerating their subsystem.
+    this->add_backlight("acpi_video0");
+    ASSERT_EQ(send_uevent("add", "backlight", "/devices/pci/acpi_video0"), 0);
+    ASSERT_TRUE(wait_readable(registry.get_fd()));
+    ASSERT_TRUE(registry.dispatch().success());
+    ASSERT_EQ(registry.get_enumerations(), 5);
+    ASSERT_EQ(registry.get_backlights()->size(), 1);
+    ASSERT_EQ(registry.get_backlights()->front().get_name(), "acpi_video0");
+
+    // Devices that cannot be created enumerate their subsystem instead, once
+    // per batch.
+    ASSERT_EQ(send_uevent("add", "backlight", "/devices/pci/acpi_video1"), 0);
+    ASSERT_EQ(send_uevent("add", "backlight", "/devices/pci/acpi_video2"), 0);
+    ASSERT_TRUE(wait_readable(registry.get_fd()));
+    ASSERT_TRUE(registry.dispatch().success());
+    ASSERT_EQ(registry.get_enumerations(), 6);
+    ASSERT_EQ(registry.get_backlights()->size(), 2);
+
+    // Cooling devices and partitions are not tracked.
+    ASSERT_EQ(
+      send_uevent("add", "thermal", "/devices/virtual/cooling_device0"), 0);
+    ASSERT_TRUE(wait_readable(registry.get_fd()));
+    ASSERT_TRUE(registry.dispatch().success());
+    ASSERT_EQ(registry.get_enumerations(), 6);
+}
@@ -0,0 +1,246 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// External includes
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+
+namespace fs = std::filesystem;
+
+[[nodiscard]] syst::event_loop_t make_event_loop() {
+    auto event_loop = syst::get_event_loop();
+    EXPECT_TRUE(event_loop.has_value()) << RES_TRACE(event_loop.error());
+    return std::move(event_loop.value());
+}
+
+void signal(int fd) {
+    const uint64_t increment = 1;
+    ASSERT_EQ(write(fd, &increment, sizeof(increment)), sizeof(increment));
+}
+
+void drain(int fd) {
+    uint64_t count = 0;
+    ssize_t len = read(fd, &count, sizeof(count));
+    static_cast<void>(len);
+}
+
+[[nodiscard]] bool is_readable(int fd) {
+    struct pollfd poll_fd {};
+    poll_fd.fd = fd;
+    poll_fd.events = POLLIN;
+    return poll(&poll_fd, 1, 0) == 1;
+}
+
+TEST(event_loop_test, fd) {
+    auto event_loop = make_event_loop();
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+
+    size_t calls = 0;
+    auto id = event_loop.subscribe_fd(fd, [&]() -> res::result_t {
+        ++calls;
+        drain(fd);
+        return res::success;
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    // Nothing is pending.
+    ASSERT_FALSE(is_readable(event_loop.get_fd()));
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_EQ(calls, 0);
+
+    // The epoll instance becomes readable, so it can be embedded.
+    signal(fd);
+    ASSERT_TRUE(is_readable(event_loop.get_fd()));
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_EQ(calls, 1);
+    ASSERT_FALSE(is_readable(event_loop.get_fd()));
+
+    ASSERT_TRUE(event_loop.unsubscribe(id.value()).success());
+    ASSERT_FALSE(event_loop.unsubscribe(id.value()).success());
+
+    signal(fd);
+    ASSERT_FALSE(is_readable(event_loop.get_fd()));
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_EQ(calls, 1);
+
+    close(fd);
+}
+
+TEST(event_loop_test, unsubscribe_from_callback) {
+    auto event_loop = make_event_loop();
+    const int first_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    const int second_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    // Each callback removes both subscriptions, so only one of them runs even
+    // though both file descriptors are ready.
+    size_t calls = 0;
+    uint64_t first = 0;
+    uint64_t second = 0;
+    const auto callback = [&]() -> res::result_t {
+        ++calls;
+        EXPECT_TRUE(event_loop.unsubscribe(first).success());
+        EXPECT_TRUE(event_loop.unsubscribe(second).success());
+        return res::success;
+    };
+
+    auto first_id = event_loop.subscribe_fd(first_fd, callback);
+    ASSERT_TRUE(first_id.has_value()) << RES_TRACE(first_id.error());
+    first = first_id.value();
+    auto second_id = event_loop.subscribe_fd(second_fd, callback);
+    ASSERT_TRUE(second_id.has_value()) << RES_TRACE(second_id.error());
+    second = second_id.value();
+
+    signal(first_fd);
+    signal(second_fd);
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_EQ(calls, 1);
+
+    close(first_fd);
+    close(second_fd);
+}
+
+TEST(event_loop_test, unsubscribe_closed_fd) {
+    auto event_loop = make_event_loop();
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+
+    auto id = event_loop.subscribe_fd(fd, []() -> res::result_t {
+        return res::success;
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    // Closing the file descriptor already removed it from epoll, so the
+    // subscription is removed without an error and only once.
+    close(fd);
+    ASSERT_TRUE(event_loop.unsubscribe(id.value()).success());
+    ASSERT_FALSE(event_loop.unsubscribe(id.value()).success());
+}
+
+TEST(event_loop_test, failed_callback) {
+    auto event_loop = make_event_loop();
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    auto id = event_loop.subscribe_fd(fd, [&]() -> res::result_t {
+        drain(fd);
+        return RES_NEW_ERROR("Callback failed.");
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    signal(fd);
+    ASSERT_FALSE(event_loop.run().success());
+
+    close(fd);
+}
+
+TEST(event_loop_test, stop) {
+    auto event_loop = make_event_loop();
+
+    // Stopping before running makes the next run return immediately.
+    event_loop.stop();
+    ASSERT_TRUE(event_loop.run().success());
+
+    // A pending stop does not make the epoll instance readable.
+    event_loop.stop();
+    ASSERT_FALSE(is_readable(event_loop.get_fd()));
+
+    std::thread thread{ [&event_loop]() {
+        auto result = event_loop.run();
+        EXPECT_TRUE(result.success()) << RES_TRACE(result.error());
+    } };
+    thread.join();
+
+    std::thread stopping{ [&event_loop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        event_loop.stop();
+    } };
+    ASSERT_TRUE(event_loop.run().success());
+    stopping.join();
+}
+
+TEST(event_loop_test, attribute_without_notifications) {
+    const fs::path path = fs::temp_directory_path()
+      / ("system_state_event_loop_test_" + std::to_string(getpid()));
+    {
+        std::ofstream file{ path };
+        file << "0" << '\n';
+    }
+
+    // Regular files cannot be polled, unlike sysfs attributes.
+    auto event_loop = make_event_loop();
+    auto id = event_loop.subscribe_attribute(
+      path, [](const std::string&) { FAIL(); });
+    ASSERT_FALSE(id.has_value());
+
+    fs::remove(path);
+}
+
+TEST(event_loop_test, mounts) {
+    auto event_loop = make_event_loop();
+
+    size_t calls = 0;
+    auto id = event_loop.subscribe_mounts([&]() { ++calls; });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    // The mount table only reports changes made after it was opened.
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_EQ(calls, 0);
+}
+
+TEST(event_loop_test, links) {
+    auto event_loop = make_event_loop();
+
+    auto id = event_loop.subscribe_links([](const syst::link_event_t&) {});
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+    ASSERT_TRUE(event_loop.dispatch().success());
+}
+
+TEST(event_loop_test, power_supply) {
+    auto event_loop = make_event_loop();
+
+    auto id = event_loop.subscribe_power_supply(
+      [](const syst::power_supply_event_t&) {});
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+    ASSERT_TRUE(event_loop.dispatch().success());
+}
+
+TEST(event_loop_test, pressure) {
+    if (! fs::exists("/proc/pressure/cpu")) {
+        GTEST_SKIP() << "Pressure stall information is not available.";
+    }
+
+    auto event_loop = make_event_loop();
+
+    syst::pressure_trigger_t trigger{};
+    trigger.resource = syst::pressure_trigger_t::resource_t::cpu;
+    trigger.stall = std::chrono::milliseconds(150);
+    trigger.window = std::chrono::seconds(2);
+
+    auto id = event_loop.subscribe_pressure(trigger, []() {});
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+    ASSERT_TRUE(event_loop.dispatch().success());
+    ASSERT_TRUE(event_loop.unsubscribe(id.value()).success());
+
+    // The kernel rejects windows outside its limits.
+    trigger.window = std::chrono::minutes(1);
+    ASSERT_FALSE(event_loop.subscribe_pressure(trigger, []() {}).has_value());
+}
+
+TEST(event_loop_test, mixer) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+
+    auto event_loop = make_event_loop();
+
+    auto id = event_loop.subscribe_mixer(
+      mixer.value(), [](const std::vector<syst::sound_event_t>&) {});
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+    ASSERT_TRUE(event_loop.dispatch().success());
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Standard includes
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// External includes
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+/**
+ * @brief Replace the contents of a file with a single line, like the
+ * attributes of sysfs.
+ *
+ * @param[in] path - The path to the file.
+ * @param[in] contents - The contents of the file without a trailing newline.
+ */
+inline void write_file(
+  const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream file{ path };
+    file << contents << '\n';
+}
+
+/**
+ * @brief Replace the contents of a file in place so that open file
+ * descriptors observe the change. Pad the contents to overwrite longer ones.
+ *
+ * @param[in] path - The path to the file.
+ * @param[in] contents - The contents of the file without a trailing newline.
+ */
+inline void overwrite_file(
+  const std::filesystem::path& path, const std::string& contents) {
+    std::fstream file{ path, std::ios::in | std::ios::out };
+    if (! file.is_open()) {
+        file.open(path, std::ios::out);
+    }
+    file << contents << '\n' << std::flush;
+}
+
+/**
+ * @brief Replace the uevent file of a power supply and write the attribute
+ * file of each of its properties, like sysfs does.
+ *
+ * @param[in] dir - The directory of the power supply.
+ * @param[in] contents - The contents of the uevent file without a trailing
+ * newline (POWER_SUPPLY_<NAME>=<value> on each line).
+ */
+inline void write_power_supply_uevent(
+  const std::filesystem::path& dir, const std::string& contents) {
+    write_file(dir / "uevent", contents);
+
+    const std::string prefix = "POWER_SUPPLY_";
+    std::istringstream lines{ contents };
+    std::string line;
+    while (std::getline(lines, line)) {
+        const size_t separator = line.find('=');
+        std::string name =
+          line.substr(prefix.size(), separator - prefix.size());
+        std::transform(name.begin(), name.end(), name.begin(), [](char chr) {
+            return static_cast<char>(std::tolower(chr));
+        });
+        write_file(dir / name, line.substr(separator + 1));
+    }
+}
+
+/**
+ * @brief A test that generates files (usually a copy of part of sysfs or
+ * procfs) in a temporary directory. The directory is unique to the process
+ * and is removed before and after each test.
+ */
+class fixture_test_t : public testing::Test {
+  protected:
+    std::filesystem::path root_;
+
+    /**
+     * @param[in] name - Identifies the test in the name of the directory.
+     */
+    explicit fixture_test_t(const std::string& name)
+    : root_(std::filesystem::temp_directory_path()
+        / ("system_state_" + name + "_test_" + std::to_string(getpid()))) {
+    }
+
+    void SetUp() override {
+        std::filesystem::remove_all(this->root_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(this->root_);
+    }
+};
@@ -0,0 +1,230 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class hwmon_fixture_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+    fs::path chip_path_;
+
+    hwmon_fixture_test() : fixture_test_t("hwmon") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        // Mimic the layout of sysfs: devices live under /sys/devices and the
+        // class directory only contains symbolic links to them.
+        this->class_path_ = this->root_ / "class" / "hwmon";
+        fs::create_directories(this->class_path_);
+
+        this->chip_path_ = this->root_ / "devices" / "coretemp.0" / "hwmon0";
+        fs::create_directories(this->chip_path_);
+        write_file(this->chip_path_ / "name", "coretemp");
+        write_file(this->chip_path_ / "temp1_input", "45000");
+        write_file(this->chip_path_ / "temp1_label", "Package id 0");
+        write_file(this->chip_path_ / "temp1_max", "80000");
+        write_file(this->chip_path_ / "temp1_crit", "100000");
+        write_file(this->chip_path_ / "temp2_input", "-5500");
+        write_file(this->chip_path_ / "fan1_input", "1200");
+        write_file(this->chip_path_ / "fan1_min", "300");
+        write_file(this->chip_path_ / "in0_input", "1050");
+        write_file(this->chip_path_ / "power1_input", "15000000");
+        write_file(this->chip_path_ / "curr1_input", "2500");
+        write_file(this->chip_path_ / "curr1_lcrit", "-1000");
+        write_file(this->chip_path_ / "intrusion0_alarm", "0");
+        fs::create_directory_symlink(
+          this->chip_path_, this->class_path_ / "hwmon0");
+
+        // Drivers written before the hwmon class existed keep their
+        // attributes in the parent device directory.
+        fs::path legacy_path = this->root_ / "devices" / "w83627hf.656";
+        fs::create_directories(legacy_path / "hwmon" / "hwmon1");
+        write_file(legacy_path / "name", "w83627hf");
+        write_file(legacy_path / "in1_input", "3300");
+        fs::create_directory_symlink(legacy_path, this->root_ / "legacy");
+        fs::create_directory_symlink(legacy_path / "hwmon" / "hwmon1",
+          this->class_path_ / "hwmon1");
+        fs::create_directory_symlink(
+          this->root_ / "legacy", legacy_path / "hwmon" / "hwmon1" / "device");
+
+        // Entries that are not symbolic links are ignored.
+        fs::create_directory(this->class_path_ / "not_a_chip");
+    }
+
+    [[nodiscard]] static syst::hwmon_chip_t* find_chip(
+      std::vector<syst::hwmon_chip_t>& chips, const std::string& name) {
+        for (auto& chip : chips) {
+            if (chip.get_name() == name) {
+                return &chip;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] static const syst::hwmon_sensor_t* find_sensor(
+      const syst::hwmon_chip_t& chip, const std::string& name) {
+        for (const auto& sensor : chip.get_sensors()) {
+            if (sensor.get_name() == name) {
+                return &sensor;
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST(hwmon_test, all) {
+    auto chips = syst::get_hwmon_chips();
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+}
+
+TEST(hwmon_test, update) {
+    auto chips = syst::get_hwmon_chips();
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+
+    for (auto& chip : chips.value()) {
+        ASSERT_TRUE(chip.update().success());
+    }
+}
+
+TEST_F(hwmon_fixture_test, enumerate) {
+    auto chips = syst::get_hwmon_chips(this->class_path_);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+    ASSERT_EQ(chips->size(), 2);
+
+    const auto* coretemp = this->find_chip(chips.value(), "coretemp");
+    ASSERT_NE(coretemp, nullptr);
+    ASSERT_EQ(coretemp->get_sensors().size(), 6);
+
+    const auto* legacy = this->find_chip(chips.value(), "w83627hf");
+    ASSERT_NE(legacy, nullptr);
+    ASSERT_EQ(legacy->get_sensors().size(), 1);
+    ASSERT_EQ(legacy->get_sysfs_path().filename(), "device");
+}
+
+TEST_F(hwmon_fixture_test, metadata) {
+    auto chips = syst::get_hwmon_chips(this->class_path_);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+    const auto* chip = this->find_chip(chips.value(), "coretemp");
+    ASSERT_NE(chip, nullptr);
+
+    const auto* temp1 = this->find_sensor(*chip, "temp1");
+    ASSERT_NE(temp1, nullptr);
+    ASSERT_EQ(temp1->get_type(), syst::hwmon_sensor_t::type_t::temperature);
+    ASSERT_EQ(temp1->get_index(), 1);
+    ASSERT_EQ(temp1->get_label(), "Package id 0");
+    ASSERT_DOUBLE_EQ(temp1->get_limits().max.value(), 80);
+    ASSERT_DOUBLE_EQ(temp1->get_limits().crit.value(), 100);
+    ASSERT_FALSE(temp1->get_limits().min.has_value());
+
+    const auto* temp2 = this->find_sensor(*chip, "temp2");
+    ASSERT_NE(temp2, nullptr);
+    ASSERT_EQ(temp2->get_label(), "temp2");
+
+    const auto* curr1 = this->find_sensor(*chip, "curr1");
+    ASSERT_NE(curr1, nullptr);
+    ASSERT_EQ(curr1->get_type(), syst::hwmon_sensor_t::type_t::current);
+    ASSERT_DOUBLE_EQ(curr1->get_limits().lcrit.value(), -1);
+
+    // Metadata is cached at enumeration.
+    write_file(this->chip_path_ / "temp1_label", "Changed");
+    ASSERT_EQ(temp1->get_label(), "Package id 0");
+}
+
+TEST_F(hwmon_fixture_test, value_before_update) {
+    auto chips = syst::get_hwmon_chips(this->class_path_);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+
+    for (const auto& chip : chips.value()) {
+        for (const auto& sensor : chip.get_sensors()) {
+            ASSERT_FALSE(sensor.get_value().has_value());
+        }
+    }
+}
+
+TEST_F(hwmon_fixture_test, values) {
+    auto chips = syst::get_hwmon_chips(this->class_path_);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+
+    for (auto& chip : chips.value()) {
+        ASSERT_TRUE(chip.update().success());
+    }
+
+    const auto* chip = this->find_chip(chips.value(), "coretemp");
+    ASSERT_NE(chip, nullptr);
+
+    auto value = [&](const std::string& name) {
+        const auto* sensor = this->find_sensor(*chip, name);
+        EXPECT_NE(sensor, nullptr);
+        auto value = sensor->get_value();
+        EXPECT_TRUE(value.has_value()) << RES_TRACE(value.error());
+        return value.value();
+    };
+
+    ASSERT_DOUBLE_EQ(value("temp1"), 45);
+    ASSERT_DOUBLE_EQ(value("temp2"), -5.5);
+    ASSERT_DOUBLE_EQ(value("fan1"), 1200);
+    ASSERT_DOUBLE_EQ(value("in0"), 1.05);
+    ASSERT_DOUBLE_EQ(value("power1"), 15);
+    ASSERT_DOUBLE_EQ(value("curr1"), 2.5);
+}
+
+TEST_F(hwmon_fixture_test, values_reread) {
+    auto chips = syst::get_hwmon_chips(this->class_path_);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+
+    auto* chip = this->find_chip(chips.value(), "coretemp");
+    ASSERT_NE(chip, nullptr);
+    ASSERT_TRUE(chip->update().success());
+
+    // Overwrite the file in place so that the open file descriptor observes
+    // the new value.
+    {
+        std::fstream file{ this->chip_path_ / "temp1_input" };
+        file << "51000\n";
+    }
+    ASSERT_TRUE(chip->update().success());
+
+    const auto* temp1 = this->find_sensor(*chip, "temp1");
+    ASSERT_NE(temp1, nullptr);
+    ASSERT_DOUBLE_EQ(temp1->get_value().value(), 51);
+}
+
+TEST_F(hwmon_fixture_test, values_io_uring) {
+    // Falls back to pread(2) if io_uring is unavailable, so the values are the
+    // same either way.
+    auto chips = syst::get_hwmon_chips(this->class_path_, true);
+    ASSERT_TRUE(chips.has_value()) << RES_TRACE(chips.error());
+
+    auto* chip = this->find_chip(chips.value(), "coretemp");
+    ASSERT_NE(chip, nullptr);
+    ASSERT_TRUE(chip->update().success());
+
+    {
+        std::fstream file{ this->chip_path_ / "temp1_input" };
+        file << "51000\n";
+    }
+    ASSERT_TRUE(chip->update().success());
+
+    const auto* temp1 = this->find_sensor(*chip, "temp1");
+    ASSERT_NE(temp1, nullptr);
+    ASSERT_DOUBLE_EQ(temp1->get_value().value(), 51);
+
+    const auto* fan1 = this->find_sensor(*chip, "fan1");
+    ASSERT_NE(fan1, nullptr);
+    ASSERT_DOUBLE_EQ(fan1->get_value().value(), 1200);
+}
+
+TEST_F(hwmon_fixture_test, missing_directory) {
+    auto chips = syst::get_hwmon_chips(this->root_ / "does_not_exist");
+    ASSERT_FALSE(chips.has_value());
+}
@@ -0,0 +1,103 @@
+// Standard includes
+#include <filesystem>
+#include <string>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class instrument_test : public fixture_test_t {
+  protected:
+    fs::path backlight_path_;
+
+    instrument_test() : fixture_test_t("instrument") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        fs::path device_path = this->root_ / "devices" / "intel_backlight";
+        fs::create_directories(device_path);
+        write_file(device_path / "brightness", "250");
+        write_file(device_path / "max_brightness", "1000");
+
+        this->backlight_path_ = this->root_ / "class" / "backlight";
+        fs::create_directories(this->backlight_path_);
+        fs::create_directory_symlink(
+          device_path, this->backlight_path_ / "intel_backlight");
+
+        syst::reset_stats();
+    }
+};
+
+TEST_F(instrument_test, reset) {
+    auto backlights = syst::get_backlights(this->backlight_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+
+    syst::reset_stats();
+    const syst::stats_t stats = syst::stats();
+    ASSERT_EQ(stats.total.calls, 0);
+    ASSERT_EQ(stats.total.opens, 0);
+    ASSERT_EQ(stats.total.reads, 0);
+    ASSERT_EQ(stats.total.bytes_read, 0);
+    ASSERT_TRUE(stats.apis.empty());
+}
+
+TEST_F(instrument_test, per_api) {
+    auto backlights = syst::get_backlights(this->backlight_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+    ASSERT_EQ(backlights->size(), 1);
+
+    for (int idx = 0; idx < 2; ++idx) {
+        auto brightness = backlights->front().get_brightness();
+        ASSERT_TRUE(brightness.has_value()) << RES_TRACE(brightness.error());
+    }
+
+    const syst::stats_t stats = syst::stats();
+    if (! stats.enabled) {
+        ASSERT_EQ(stats.total.opens, 0);
+        ASSERT_TRUE(stats.apis.empty());
+        GTEST_SKIP() << "The library was built without instrumentation.";
+    }
+
+    const syst::api_stats_t& enumerate = stats.apis.at("get_backlights");
+    ASSERT_EQ(enumerate.calls, 1);
+    ASSERT_EQ(enumerate.opens, 1);
+    ASSERT_EQ(enumerate.directory_entries, 3);
+
+    // Both attributes are opened and read once per call.
+    const syst::api_stats_t& brightness =
+      stats.apis.at("backlight_t::get_brightness");
+    ASSERT_EQ(brightness.calls, 2);
+    ASSERT_EQ(brightness.opens, 4);
+    ASSERT_EQ(brightness.reads, 4);
+    ASSERT_EQ(brightness.bytes_read, 2 * (4 + 5));
+
+    ASSERT_GE(stats.total.opens, enumerate.opens + brightness.opens);
+}
+
+TEST_F(instrument_test, outermost) {
+    auto backlights = syst::get_backlights(this->backlight_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+    syst::reset_stats();
+
+    // The brightness is read and written by the outermost function.
+    auto result = backlights->front().set_brightness_relative(10);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    const syst::stats_t stats = syst::stats();
+    if (! stats.enabled) {
+        GTEST_SKIP() << "The library was built without instrumentation.";
+    }
+
+    ASSERT_EQ(stats.apis.size(), 1);
+    const syst::api_stats_t& relative =
+      stats.apis.at("backlight_t::set_brightness_relative");
+    ASSERT_EQ(relative.calls, 1);
+    ASSERT_GE(relative.opens, 3);
+}
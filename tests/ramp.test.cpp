@@ -0,0 +1,172 @@
+// Standard includes
+#include <filesystem>
+#include <fstream>
+
+// External includes
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class ramp_fixture_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+    fs::path backlight_path_;
+
+    ramp_fixture_test() : fixture_test_t("ramp") {
+    }
+
+    static std::string read(const fs::path& path) {
+        std::ifstream file{ path };
+        std::string contents;
+        std::getline(file, contents);
+        return contents;
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->class_path_ = this->root_ / "class" / "backlight";
+        fs::create_directories(this->class_path_);
+
+        this->backlight_path_ = this->root_ / "devices" / "backlight0";
+        fs::create_directories(this->backlight_path_);
+        write_file(this->backlight_path_ / "brightness", "0");
+        write_file(this->backlight_path_ / "max_brightness", "100");
+        fs::create_directory_symlink(
+          this->backlight_path_, this->class_path_ / "backlight0");
+    }
+
+    [[nodiscard]] syst::backlight_t backlight() {
+        auto backlights = syst::get_backlights(this->class_path_);
+        EXPECT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+        EXPECT_EQ(backlights->size(), 1);
+        return backlights->front();
+    }
+
+    [[nodiscard]] std::string brightness() const {
+        return read(this->backlight_path_ / "brightness");
+    }
+
+    // Dispatch the engine until every ramp has ended.
+    static void run(syst::ramp_engine_t& engine) {
+        while (engine.get_ramp_count() > 0) {
+            struct pollfd poll_fd {};
+            poll_fd.fd = engine.get_fd();
+            poll_fd.events = POLLIN;
+            ASSERT_EQ(poll(&poll_fd, 1, 1000), 1);
+            ASSERT_TRUE(engine.dispatch().success());
+        }
+    }
+};
+
+TEST_F(ramp_fixture_test, brightness) {
+    syst::ramp_engine_t engine;
+    ASSERT_EQ(engine.get_fd(), -1);
+    ASSERT_TRUE(engine.start(std::chrono::milliseconds(1)).success());
+    ASSERT_GE(engine.get_fd(), 0);
+
+    auto ramp = engine.ramp_brightness(
+      this->backlight(), 50, std::chrono::milliseconds(50));
+    ASSERT_TRUE(ramp.has_value()) << RES_TRACE(ramp.error());
+    ASSERT_EQ(engine.get_ramp_count(), 1);
+
+    run(engine);
+    ASSERT_EQ(this->brightness(), "50");
+
+    auto events = engine.take_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events[0].type, syst::ramp_event_t::type_t::finished);
+    ASSERT_EQ(events[0].ramp, ramp.value());
+    ASSERT_FALSE(events[0].error.has_value());
+}
+
+TEST_F(ramp_fixture_test, no_duration) {
+    syst::ramp_engine_t engine;
+    ASSERT_TRUE(engine.start().success());
+
+    auto ramp = engine.ramp_brightness(
+      this->backlight(), 100, std::chrono::milliseconds(0));
+    ASSERT_TRUE(ramp.has_value()) << RES_TRACE(ramp.error());
+
+    // The final value is written immediately.
+    ASSERT_EQ(engine.get_ramp_count(), 0);
+    ASSERT_EQ(this->brightness(), "100");
+
+    auto events = engine.take_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events[0].type, syst::ramp_event_t::type_t::finished);
+}
+
+TEST_F(ramp_fixture_test, replace) {
+    syst::ramp_engine_t engine;
+    ASSERT_TRUE(engine.start(std::chrono::milliseconds(1)).success());
+
+    auto first =
+      engine.ramp_brightness(this->backlight(), 100, std::chrono::seconds(10));
+    ASSERT_TRUE(first.has_value()) << RES_TRACE(first.error());
+
+    // Only one ramp may change a backlight at a time.
+    auto second = engine.ramp_brightness(
+      this->backlight(), 20, std::chrono::milliseconds(20));
+    ASSERT_TRUE(second.has_value()) << RES_TRACE(second.error());
+    ASSERT_NE(first.value(), second.value());
+    ASSERT_EQ(engine.get_ramp_count(), 1);
+
+    run(engine);
+    ASSERT_EQ(this->brightness(), "20");
+
+    auto events = engine.take_events();
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_EQ(events[0].type, syst::ramp_event_t::type_t::cancelled);
+    ASSERT_EQ(events[0].ramp, first.value());
+    ASSERT_EQ(events[1].type, syst::ramp_event_t::type_t::finished);
+    ASSERT_EQ(events[1].ramp, second.value());
+}
+
+TEST_F(ramp_fixture_test, cancel) {
+    syst::ramp_engine_t engine;
+    ASSERT_TRUE(engine.start().success());
+
+    auto ramp =
+      engine.ramp_brightness(this->backlight(), 100, std::chrono::seconds(10));
+    ASSERT_TRUE(ramp.has_value()) << RES_TRACE(ramp.error());
+
+    ASSERT_TRUE(engine.cancel(ramp.value()));
+    ASSERT_FALSE(engine.cancel(ramp.value()));
+    ASSERT_EQ(engine.get_ramp_count(), 0);
+
+    auto events = engine.take_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events[0].type, syst::ramp_event_t::type_t::cancelled);
+    ASSERT_TRUE(engine.take_events().empty());
+}
+
+TEST_F(ramp_fixture_test, late_steps_are_skipped) {
+    syst::ramp_engine_t engine;
+    ASSERT_TRUE(engine.start(std::chrono::milliseconds(1)).success());
+
+    auto ramp = engine.ramp_brightness(
+      this->backlight(), 100, std::chrono::milliseconds(20));
+    ASSERT_TRUE(ramp.has_value()) << RES_TRACE(ramp.error());
+
+    // A single dispatch after the ramp has ended writes the final value.
+    usleep(30000);
+    ASSERT_TRUE(engine.dispatch().success());
+    ASSERT_EQ(engine.get_ramp_count(), 0);
+    ASSERT_EQ(this->brightness(), "100");
+}
+
+TEST_F(ramp_fixture_test, not_started) {
+    syst::ramp_engine_t engine;
+    ASSERT_FALSE(engine.dispatch().success());
+
+    auto ramp = engine.ramp_brightness(
+      this->backlight(), 100, std::chrono::milliseconds(20));
+    ASSERT_FALSE(ramp.has_value());
+}
@@ -0,0 +1,155 @@
+// Standard includes
+#include <filesystem>
+#include <string>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class roots_test : public fixture_test_t {
+  protected:
+    syst::roots_t roots_;
+
+    roots_test() : fixture_test_t("roots") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->roots_.sys = this->root_ / "sys";
+        this->roots_.proc = this->root_ / "proc";
+        this->roots_.dev = this->root_ / "dev";
+        fs::create_directories(this->roots_.sys / "class" / "net");
+        fs::create_directories(this->roots_.sys / "block");
+        fs::create_directories(this->roots_.sys / "class" / "block");
+        fs::create_directories(this->roots_.proc);
+        fs::create_directories(this->roots_.dev);
+
+        fs::path eth_path = this->roots_.sys / "devices" / "eth0";
+        fs::create_directories(eth_path / "statistics");
+        write_file(eth_path / "operstate", "up");
+        write_file(eth_path / "type", "1");
+        fs::create_directory_symlink(
+          eth_path, this->roots_.sys / "class" / "net" / "eth0");
+
+        fs::path disk_path = this->roots_.sys / "devices" / "sda";
+        fs::create_directories(disk_path / "sda1");
+        write_file(disk_path / "sda1" / "partition", "1");
+        fs::create_directory_symlink(
+          disk_path, this->roots_.sys / "block" / "sda");
+        fs::create_directory_symlink(
+          disk_path, this->roots_.sys / "class" / "block" / "sda");
+        fs::create_directory_symlink(disk_path / "sda1",
+          this->roots_.sys / "class" / "block" / "sda1");
+
+        write_file(this->roots_.proc / "stat",
+          "cpu  10 0 10 80 0 0 0 0 0 0\n"
+          "cpu0 10 0 10 80 0 0 0 0 0 0\n"
+          "intr 0");
+        write_file(this->roots_.proc / "mounts", "/dev/sda1 / ext4 rw 0 0");
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(syst::set_roots({}).success());
+        fixture_test_t::TearDown();
+    }
+};
+
+TEST_F(roots_test, get_roots) {
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    const syst::roots_t roots = syst::get_roots();
+    EXPECT_EQ(roots.sys, this->roots_.sys);
+    EXPECT_EQ(roots.proc, this->roots_.proc);
+    EXPECT_EQ(roots.dev, this->roots_.dev);
+}
+
+TEST_F(roots_test, missing_root) {
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    syst::roots_t roots = this->roots_;
+    roots.proc = this->root_ / "missing";
+    EXPECT_TRUE(syst::set_roots(roots).failure());
+
+    // The previous roots are kept.
+    EXPECT_EQ(syst::get_roots().proc, this->roots_.proc);
+}
+
+TEST_F(roots_test, network_interfaces) {
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto interfaces = syst::get_network_interfaces();
+    ASSERT_TRUE(interfaces.has_value()) << RES_TRACE(interfaces.error());
+    ASSERT_EQ(interfaces->size(), 1);
+    EXPECT_EQ(interfaces->front().get_name(), "eth0");
+    EXPECT_EQ(interfaces->front().get_sysfs_path(),
+      this->roots_.sys / "class" / "net" / "eth0");
+}
+
+TEST_F(roots_test, cpu_usage) {
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    syst::cpu_usage_t cpu_usage;
+    auto update = cpu_usage.update();
+    EXPECT_TRUE(update.success()) << RES_TRACE(update.error());
+}
+
+TEST_F(roots_test, system_info) {
+    write_file(this->roots_.proc / "uptime", "1234.56 4321.00");
+    write_file(this->roots_.proc / "loadavg", "0.50 0.25 0.10 2/345 6789");
+    write_file(this->roots_.proc / "meminfo",
+      "MemTotal:        8000 kB\n"
+      "MemFree:         2000 kB\n"
+      "Buffers:          100 kB\n"
+      "Shmem:             50 kB\n"
+      "SwapTotal:       1000 kB\n"
+      "SwapFree:         750 kB");
+
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto system_info = syst::get_system_info();
+    ASSERT_TRUE(system_info.has_value()) << RES_TRACE(system_info.error());
+    EXPECT_EQ(system_info->uptime.count(), 1234);
+    EXPECT_DOUBLE_EQ(system_info->load_1, 0.5);
+    EXPECT_DOUBLE_EQ(system_info->load_5, 0.25);
+    EXPECT_DOUBLE_EQ(system_info->load_15, 0.1);
+    EXPECT_EQ(system_info->procs, 345);
+    EXPECT_EQ(system_info->ram_total, 8000 * 1024);
+    EXPECT_EQ(system_info->ram_free, 2000 * 1024);
+    EXPECT_EQ(system_info->ram_shared, 50 * 1024);
+    EXPECT_EQ(system_info->ram_buffered, 100 * 1024);
+    EXPECT_EQ(system_info->swap_total, 1000 * 1024);
+    EXPECT_EQ(system_info->swap_free, 750 * 1024);
+    EXPECT_DOUBLE_EQ(system_info->ram_usage, 75.0);
+    EXPECT_DOUBLE_EQ(system_info->swap_usage, 25.0);
+}
+
+TEST_F(roots_test, disks) {
+    auto result = syst::set_roots(this->roots_);
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto disks = syst::get_disks();
+    ASSERT_TRUE(disks.has_value()) << RES_TRACE(disks.error());
+    ASSERT_EQ(disks->size(), 1);
+    EXPECT_EQ(disks->front().get_devfs_path(), this->roots_.dev / "sda");
+
+    auto parts = disks->front().get_parts();
+    ASSERT_TRUE(parts.has_value()) << RES_TRACE(parts.error());
+    ASSERT_EQ(parts->size(), 1);
+    EXPECT_EQ(parts->front().get_devfs_path(), this->roots_.dev / "sda1");
+
+    // The mount table names devices by their path in /dev.
+    auto mounted = parts->front().is_mounted();
+    ASSERT_TRUE(mounted.has_value()) << RES_TRACE(mounted.error());
+    EXPECT_TRUE(mounted.value());
+}
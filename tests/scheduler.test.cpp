@@ -0,0 +1,205 @@
+// Standard includes
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/prctl.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+
+[[nodiscard]] syst::scheduler_t make_scheduler(
+  const syst::scheduler_options_t& options = {}) {
+    auto scheduler = syst::get_scheduler(options);
+    EXPECT_TRUE(scheduler.has_value()) << RES_TRACE(scheduler.error());
+    return std::move(scheduler.value());
+}
+
+void wait_and_dispatch(syst::scheduler_t& scheduler) {
+    struct pollfd poll_fd {};
+    poll_fd.fd = scheduler.get_fd();
+    poll_fd.events = POLLIN;
+    ASSERT_EQ(poll(&poll_fd, 1, 1000), 1);
+
+    auto result = scheduler.dispatch();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+}
+
+TEST(scheduler_test, invalid_options) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::nanoseconds::zero();
+    ASSERT_FALSE(syst::get_scheduler(options).has_value());
+
+    options = {};
+    options.timer_slack = std::chrono::nanoseconds(-1);
+    ASSERT_FALSE(syst::get_scheduler(options).has_value());
+
+    auto scheduler = make_scheduler();
+    auto id = scheduler.add(std::chrono::nanoseconds::zero(),
+      []() -> res::result_t { return res::success; });
+    ASSERT_FALSE(id.has_value());
+    ASSERT_FALSE(scheduler.add(std::chrono::seconds(1), {}).has_value());
+}
+
+TEST(scheduler_test, coalesced_wakeups) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(5);
+    auto scheduler = make_scheduler(options);
+
+    size_t dispatches = 0;
+    std::vector<size_t> fast_runs;
+    std::vector<size_t> slow_runs;
+
+    auto fast = scheduler.add(std::chrono::milliseconds(10), [&]() {
+        fast_runs.push_back(dispatches);
+        return res::success;
+    });
+    ASSERT_TRUE(fast.has_value()) << RES_TRACE(fast.error());
+
+    // Rounded up to 20 milliseconds.
+    auto slow = scheduler.add(std::chrono::milliseconds(16), [&]() {
+        slow_runs.push_back(dispatches);
+        return res::success;
+    });
+    ASSERT_TRUE(slow.has_value()) << RES_TRACE(slow.error());
+
+    while (slow_runs.size() < 4) {
+        ++dispatches;
+        wait_and_dispatch(scheduler);
+    }
+
+    // The slow collector is always due together with the fast collector, so
+    // it never causes a wakeup of its own.
+    for (size_t run : slow_runs) {
+        ASSERT_NE(std::find(fast_runs.begin(), fast_runs.end(), run),
+          fast_runs.end());
+    }
+    ASSERT_EQ(scheduler.get_wakeups(), fast_runs.size());
+}
+
+TEST(scheduler_test, timer_slack) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(1);
+    options.timer_slack = std::chrono::seconds(1);
+    auto scheduler = make_scheduler(options);
+
+    size_t first_runs = 0;
+    size_t second_runs = 0;
+    auto first = scheduler.add(std::chrono::milliseconds(200), [&]() {
+        ++first_runs;
+        return res::success;
+    });
+    ASSERT_TRUE(first.has_value()) << RES_TRACE(first.error());
+    auto second = scheduler.add(std::chrono::milliseconds(300), [&]() {
+        ++second_runs;
+        return res::success;
+    });
+    ASSERT_TRUE(second.has_value()) << RES_TRACE(second.error());
+
+    // Both collectors first fall due within 300 milliseconds of each other,
+    // which is within the slack, so the earlier one waits for the later one.
+    wait_and_dispatch(scheduler);
+    ASSERT_EQ(first_runs, 1);
+    ASSERT_EQ(second_runs, 1);
+    ASSERT_EQ(scheduler.get_wakeups(), 1);
+}
+
+TEST(scheduler_test, remove) {
+    auto scheduler = make_scheduler();
+
+    size_t runs = 0;
+    auto id = scheduler.add(std::chrono::milliseconds(100), [&]() {
+        ++runs;
+        return res::success;
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    ASSERT_TRUE(scheduler.remove(id.value()).success());
+    ASSERT_FALSE(scheduler.remove(id.value()).success());
+
+    // The timer is disarmed when there are no collectors.
+    struct pollfd poll_fd {};
+    poll_fd.fd = scheduler.get_fd();
+    poll_fd.events = POLLIN;
+    ASSERT_EQ(poll(&poll_fd, 1, 200), 0);
+    ASSERT_EQ(runs, 0);
+}
+
+TEST(scheduler_test, failed_collector) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(5);
+    auto scheduler = make_scheduler(options);
+
+    size_t runs = 0;
+    auto failing = scheduler.add(std::chrono::milliseconds(10),
+      []() -> res::result_t { return RES_NEW_ERROR("Collector failed."); });
+    ASSERT_TRUE(failing.has_value()) << RES_TRACE(failing.error());
+    auto other = scheduler.add(std::chrono::milliseconds(10), [&]() {
+        ++runs;
+        return res::success;
+    });
+    ASSERT_TRUE(other.has_value()) << RES_TRACE(other.error());
+
+    // The other collector runs even though the first one fails.
+    auto result = scheduler.run();
+    ASSERT_TRUE(result.failure());
+    ASSERT_EQ(runs, 1);
+}
+
+TEST(scheduler_test, stop) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(5);
+    auto scheduler = make_scheduler(options);
+
+    size_t runs = 0;
+    auto id = scheduler.add(std::chrono::milliseconds(5), [&]() {
+        if (++runs == 3) {
+            scheduler.stop();
+        }
+        return res::success;
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    auto result = scheduler.run();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    ASSERT_EQ(runs, 3);
+
+    // Stopping before running makes the next run return immediately.
+    scheduler.stop();
+    result = scheduler.run();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    ASSERT_EQ(runs, 3);
+}
+
+TEST(scheduler_test, thread_settings) {
+    syst::scheduler_options_t options;
+    options.tick = std::chrono::milliseconds(5);
+    options.timer_slack = std::chrono::milliseconds(2);
+    options.idle_priority = true;
+    auto scheduler = make_scheduler(options);
+
+    int policy = -1;
+    int timer_slack = -1;
+    auto id = scheduler.add(std::chrono::milliseconds(5), [&]() {
+        policy = sched_getscheduler(0);
+        timer_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+        scheduler.stop();
+        return res::success;
+    });
+    ASSERT_TRUE(id.has_value()) << RES_TRACE(id.error());
+
+    // The settings are applied to the thread that runs the scheduler.
+    std::thread thread{ [&scheduler]() {
+        auto result = scheduler.run();
+        EXPECT_TRUE(result.success()) << RES_TRACE(result.error());
+    } };
+    thread.join();
+
+    ASSERT_EQ(policy, SCHED_IDLE);
+    ASSERT_EQ(timer_slack, 2000000);
+    ASSERT_NE(sched_getscheduler(0), SCHED_IDLE);
+}
@@ -0,0 +1,309 @@
+// Standard includes
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.h"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class snapshot_c_test : public fixture_test_t {
+  protected:
+    fs::path backlight_class_path_;
+    fs::path power_supply_class_path_;
+    fs::path thermal_class_path_;
+    fs::path backlight_path_;
+
+    snapshot_c_test() : fixture_test_t("snapshot_c") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->backlight_class_path_ = this->root_ / "class" / "backlight";
+        fs::create_directories(this->backlight_class_path_);
+        this->power_supply_class_path_ = this->root_ / "class" / "power_supply";
+        fs::create_directories(this->power_supply_class_path_);
+        this->thermal_class_path_ = this->root_ / "class" / "thermal";
+        fs::create_directories(this->thermal_class_path_);
+
+        this->backlight_path_ = this->root_ / "devices" / "intel_backlight";
+        fs::create_directories(this->backlight_path_);
+        write_file(this->backlight_path_ / "brightness", "250");
+        write_file(this->backlight_path_ / "max_brightness", "1000");
+        fs::create_directory_symlink(this->backlight_path_,
+          this->backlight_class_path_ / "intel_backlight");
+
+        fs::path battery_path = this->root_ / "devices" / "BAT0";
+        fs::create_directories(battery_path);
+        write_file(battery_path / "type", "Battery");
+        write_power_supply_uevent(battery_path,
+          "POWER_SUPPLY_STATUS=Discharging\n"
+          "POWER_SUPPLY_POWER_NOW=10000000\n"
+          "POWER_SUPPLY_ENERGY_FULL=40000000\n"
+          "POWER_SUPPLY_ENERGY_NOW=20000000");
+        fs::create_directory_symlink(
+          battery_path, this->power_supply_class_path_ / "BAT0");
+
+        fs::path zone_path = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(zone_path);
+        write_file(zone_path / "type", "x86_pkg_temp");
+        write_file(zone_path / "temp", "45000");
+        fs::create_directory_symlink(
+          zone_path, this->thermal_class_path_ / "thermal_zone0");
+    }
+};
+
+TEST_F(snapshot_c_test, backlight) {
+    auto backlights = syst::get_backlights(this->backlight_class_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+    ASSERT_EQ(backlights->size(), 1);
+
+    syst_backlight_snapshot_t snapshot{};
+    ASSERT_EQ(
+      syst_backlight_snapshot(&backlights->front(), &snapshot), syst_ok);
+    ASSERT_STREQ(snapshot.name, "intel_backlight");
+    ASSERT_DOUBLE_EQ(snapshot.brightness, 25);
+}
+
+TEST_F(snapshot_c_test, battery) {
+    auto batteries = syst::get_batteries(this->power_supply_class_path_);
+    ASSERT_TRUE(batteries.has_value()) << RES_TRACE(batteries.error());
+    ASSERT_EQ(batteries->size(), 1);
+
+    syst_battery_snapshot_t snapshot{};
+    ASSERT_EQ(syst_battery_snapshot(&batteries->front(), &snapshot), syst_ok);
+    ASSERT_STREQ(snapshot.name, "BAT0");
+    ASSERT_TRUE(snapshot.has_status);
+    ASSERT_EQ(snapshot.status, syst_battery_status_discharging);
+    ASSERT_TRUE(snapshot.has_power);
+    ASSERT_DOUBLE_EQ(snapshot.power, 10);
+    ASSERT_TRUE(snapshot.has_charge);
+    ASSERT_DOUBLE_EQ(snapshot.charge, 50);
+
+    // Values that the battery does not report are flagged instead of failing.
+    ASSERT_FALSE(snapshot.has_current);
+    ASSERT_DOUBLE_EQ(snapshot.current, 0);
+}
+
+TEST_F(snapshot_c_test, last_error) {
+    fs::remove(this->backlight_path_ / "max_brightness");
+
+    auto backlights = syst::get_backlights(this->backlight_class_path_);
+    ASSERT_TRUE(backlights.has_value()) << RES_TRACE(backlights.error());
+
+    syst_backlight_snapshot_t snapshot{};
+    ASSERT_EQ(syst_backlight_snapshot(&backlights->front(), &snapshot),
+      syst_error_failed);
+
+    // The length of the whole message is returned even if it is truncated.
+    char buffer[8];
+    const unsigned long length = syst_get_last_error(buffer, sizeof(buffer));
+    ASSERT_GT(length, sizeof(buffer));
+    ASSERT_EQ(std::strlen(buffer), sizeof(buffer) - 1);
+
+    std::string message(length, '\0');
+    ASSERT_EQ(syst_get_last_error(message.data(), length + 1), length);
+    ASSERT_NE(message.find("max_brightness"), std::string::npos);
+
+    // A call that succeeds clears the error.
+    write_file(this->backlight_path_ / "max_brightness", "1000");
+    ASSERT_EQ(
+      syst_backlight_snapshot(&backlights->front(), &snapshot), syst_ok);
+    ASSERT_EQ(syst_get_last_error(buffer, sizeof(buffer)), 0);
+}
+
+TEST_F(snapshot_c_test, thermal_zones) {
+    auto zones = syst::get_thermal_zones(this->thermal_class_path_);
+    ASSERT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+    ASSERT_EQ(zones->size(), 1);
+
+    // The array must have room for every zone.
+    ASSERT_EQ(syst_thermal_zone_list_snapshot(&zones.value(), NULL, 0),
+      syst_error_buffer_too_small);
+
+    syst_thermal_zone_snapshot_t snapshots[2]{};
+    ASSERT_EQ(syst_thermal_zone_list_snapshot(&zones.value(), snapshots, 2),
+      syst_ok);
+    ASSERT_STREQ(snapshots[0].name, "thermal_zone0");
+    ASSERT_TRUE(snapshots[0].has_temperature);
+    ASSERT_DOUBLE_EQ(snapshots[0].temperature, 45);
+
+    char type[SYST_NAME_SIZE];
+    ASSERT_EQ(
+      syst_thermal_zone_list_get_type(&zones.value(), 0, type, sizeof(type)),
+      syst_ok);
+    ASSERT_STREQ(type, "x86_pkg_temp");
+
+    char short_type[4];
+    ASSERT_EQ(syst_thermal_zone_list_get_type(
+                &zones.value(), 0, short_type, sizeof(short_type)),
+      syst_error_buffer_too_small);
+    ASSERT_STREQ(short_type, "x86");
+
+    ASSERT_EQ(
+      syst_thermal_zone_list_get_type(&zones.value(), 1, type, sizeof(type)),
+      syst_error_failed);
+}
+
+TEST_F(snapshot_c_test, thermal_zone_without_temperature) {
+    fs::remove(this->root_ / "devices" / "thermal_zone0" / "temp");
+
+    auto zones = syst::get_thermal_zones(this->thermal_class_path_);
+    ASSERT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+
+    // Values that the zone does not report are flagged instead of failing.
+    syst_thermal_zone_snapshot_t snapshot{};
+    ASSERT_EQ(
+      syst_thermal_zone_list_snapshot(&zones.value(), &snapshot, 1), syst_ok);
+    ASSERT_FALSE(snapshot.has_temperature);
+}
+
+TEST(snapshot_c_null_test, null_arguments) {
+    syst_backlight_snapshot_t backlight_snapshot{};
+    ASSERT_EQ(syst_backlight_snapshot(NULL, &backlight_snapshot),
+      syst_error_null_argument);
+
+    syst_battery_snapshot_t battery_snapshot{};
+    ASSERT_EQ(syst_battery_snapshot(NULL, &battery_snapshot),
+      syst_error_null_argument);
+
+    ASSERT_EQ(
+      syst_sound_control_read(NULL, NULL, NULL), syst_error_null_argument);
+
+    ASSERT_EQ(syst_get_system_info(NULL), syst_error_null_argument);
+    ASSERT_EQ(syst_cpu_usage_update(NULL), syst_error_null_argument);
+    ASSERT_EQ(syst_disk_list_snapshot(NULL, NULL, 0), syst_error_null_argument);
+}
+
+TEST(snapshot_c_host_test, system_info) {
+    syst_system_info_t info{};
+    ASSERT_EQ(syst_get_system_info(&info), syst_ok);
+    ASSERT_GT(info.ram_total, 0);
+    ASSERT_GE(info.ram_usage, 0);
+    ASSERT_LE(info.ram_usage, 100);
+}
+
+TEST(snapshot_c_host_test, cpu_usage) {
+    syst_cpu_usage_t* cpu_usage = syst_cpu_usage_new();
+    ASSERT_NE(cpu_usage, nullptr);
+
+    ASSERT_EQ(syst_cpu_usage_update(cpu_usage), syst_ok);
+    ASSERT_EQ(syst_cpu_usage_update(cpu_usage), syst_ok);
+
+    double total = -1;
+    ASSERT_EQ(syst_cpu_usage_get_total(cpu_usage, &total), syst_ok);
+    ASSERT_GE(total, 0);
+    ASSERT_LE(total, 100);
+
+    // The number of cores is returned even if the array is too small.
+    unsigned long count = 0;
+    ASSERT_EQ(syst_cpu_usage_get_per_core(cpu_usage, NULL, &count),
+      syst_error_buffer_too_small);
+    ASSERT_GT(count, 0);
+
+    std::vector<double> per_core(count, -1);
+    ASSERT_EQ(
+      syst_cpu_usage_get_per_core(cpu_usage, per_core.data(), &count),
+      syst_ok);
+    ASSERT_EQ(count, per_core.size());
+    for (double usage : per_core) {
+        ASSERT_GE(usage, 0);
+        ASSERT_LE(usage, 100);
+    }
+
+    syst_cpu_usage_free(cpu_usage);
+}
+
+TEST(snapshot_c_host_test, disks) {
+    syst_disk_list_t* disk_list = syst_get_disks(NULL);
+    ASSERT_NE(disk_list, nullptr);
+
+    const unsigned long count = syst_disk_list_get_size(disk_list, NULL);
+    std::vector<syst_block_snapshot_t> snapshots(count);
+    // Every disk is filled even if the statistics of one of them are disabled.
+    const syst_error_t status =
+      syst_disk_list_snapshot(disk_list, snapshots.data(), count);
+    ASSERT_TRUE(status == syst_ok || status == syst_error_failed);
+
+    for (unsigned long idx = 0; idx < count; ++idx) {
+        syst_disk_t* disk = syst_disk_list_get(disk_list, idx, NULL);
+        ASSERT_EQ(snapshots[idx].name, disk->get_name());
+        if (! disk->get_capabilities().io_stat) {
+            ASSERT_FALSE(snapshots[idx].has_io_stat);
+        }
+
+        syst_part_list_t* part_list = syst_disk_get_parts(disk, NULL);
+        ASSERT_NE(part_list, nullptr);
+
+        const unsigned long part_count =
+          syst_part_list_get_size(part_list, NULL);
+        std::vector<syst_block_snapshot_t> part_snapshots(part_count);
+        const syst_error_t part_status = syst_part_list_snapshot(
+          part_list, part_snapshots.data(), part_count);
+        ASSERT_TRUE(part_status == syst_ok || part_status == syst_error_failed);
+
+        syst_part_list_free(part_list);
+    }
+
+    syst_disk_list_free(disk_list);
+}
+
+TEST(snapshot_c_host_test, network_interfaces) {
+    syst_network_interface_list_t* interface_list =
+      syst_get_network_interfaces(NULL);
+    ASSERT_NE(interface_list, nullptr);
+
+    const unsigned long count =
+      syst_network_interface_list_get_size(interface_list, NULL);
+    std::vector<syst_network_interface_snapshot_t> snapshots(count);
+    ASSERT_EQ(syst_network_interface_list_snapshot(
+                interface_list, snapshots.data(), count),
+      syst_ok);
+
+    for (const syst_network_interface_snapshot_t& snapshot : snapshots) {
+        ASSERT_GT(std::strlen(snapshot.name), 0);
+    }
+
+    syst_network_interface_list_free(interface_list);
+}
+
+TEST(snapshot_c_sound_test, sound_control) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+
+    for (syst::sound_control_t& control : mixer->get_controls()) {
+        syst_sound_control_snapshot_t snapshot{};
+        ASSERT_EQ(syst_sound_control_snapshot(&control, &snapshot), syst_ok);
+        ASSERT_EQ(snapshot.name, control.get_name());
+        ASSERT_EQ(snapshot.index, control.get_index());
+
+        auto volume = control.get_playback_volume();
+        if (! control.has_playback_volume()) {
+            ASSERT_EQ(snapshot.playback_volume.channels, 0);
+            continue;
+        }
+        ASSERT_TRUE(volume.has_value()) << RES_TRACE(volume.error());
+
+        const unsigned int front_left = 1U << syst_sound_channel_front_left;
+        ASSERT_EQ((snapshot.playback_volume.channels & front_left) != 0,
+          volume->front_left.has_value());
+        if (volume->front_left.has_value()) {
+            ASSERT_DOUBLE_EQ(
+              snapshot.playback_volume.volume[syst_sound_channel_front_left],
+              volume->front_left.value());
+        }
+
+        // Only the requested values are read.
+        syst_sound_volume_t playback_volume{};
+        ASSERT_EQ(syst_sound_control_read(&control, &playback_volume, NULL),
+          syst_ok);
+        ASSERT_EQ(
+          playback_volume.channels, snapshot.playback_volume.channels);
+    }
+}
@@ -3,8 +3,10 @@
 
 // External includes
 #include <gtest/gtest.h>
+#include <poll.h>
 
 // Local includes
+#include "../src/sound_events.hpp"
 #include "../system_state/system_state.hpp"
 
 TEST(sound_test, sound_mixer_get) {
@@ -21,6 +23,107 @@ TEST(sound_test, sound_mixer_all_controls) {
     ASSERT_NE(controls.size(), 0);
 }
 
+TEST(sound_test, sound_mixer_get_device) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+    ASSERT_EQ(mixer->get_device(), "default");
+
+    ASSERT_FALSE(syst::get_sound_mixer("hw:999").has_value());
+}
+
+TEST(sound_test, sound_mixer_all_cards) {
+    auto mixers = syst::get_sound_mixers();
+    ASSERT_TRUE(mixers.has_value()) << RES_TRACE(mixers.error());
+
+    // For testing purposes, there must be at least one sound card.
+    ASSERT_NE(mixers->size(), 0);
+
+    for (size_t card = 0; card < mixers->size(); ++card) {
+        ASSERT_EQ(mixers->at(card).get_device(), "hw:" + std::to_string(card));
+    }
+}
+
+TEST(sound_test, sound_mixer_find_control) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+    auto controls = mixer->get_controls();
+
+    // For testing purposes, there must be at least one sound control element.
+    ASSERT_NE(controls.size(), 0);
+
+    for (auto& control : controls) {
+        syst::sound_control_t* found =
+          mixer->find_control(control.get_name(), control.get_index());
+        ASSERT_NE(found, nullptr);
+        ASSERT_EQ(found->get_name(), control.get_name());
+        ASSERT_EQ(found->get_index(), control.get_index());
+
+        // The same control element is returned by every lookup.
+        ASSERT_EQ(
+          mixer->find_control(control.get_name(), control.get_index()), found);
+    }
+
+    ASSERT_EQ(mixer->find_control(""), nullptr);
+}
+
+TEST(sound_test, sound_mixer_events) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+    ASSERT_GE(mixer->get_fd(), 0);
+
+    // Changes made through one mixer are reported by every other mixer.
+    auto other_mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(other_mixer.has_value()) << RES_TRACE(other_mixer.error());
+    auto controls = other_mixer->get_controls();
+
+    // Discard events caused by other processes.
+    ASSERT_TRUE(mixer->dispatch().has_value());
+
+    bool has_playback_volume = false;
+
+    for (auto& control : controls) {
+        if (! control.has_playback_volume()) {
+            continue;
+        }
+
+        has_playback_volume = true;
+
+        auto old_volume = control.get_playback_volume();
+        ASSERT_TRUE(old_volume.has_value()) << RES_TRACE(old_volume.error());
+
+        ASSERT_TRUE(control.set_playback_volume_all(0).success());
+
+        struct pollfd mixer_poll{};
+        mixer_poll.fd = mixer->get_fd();
+        mixer_poll.events = POLLIN;
+        const int timeout_ms = 1000;
+        ASSERT_EQ(poll(&mixer_poll, 1, timeout_ms), 1);
+
+        auto events = mixer->dispatch();
+        ASSERT_TRUE(events.has_value()) << RES_TRACE(events.error());
+
+        bool found = false;
+        for (const auto& event : events.value()) {
+            if (event.name != control.get_name()
+              || event.index != control.get_index()) {
+                continue;
+            }
+
+            found = true;
+            ASSERT_EQ(event.type, syst::sound_event_t::type_t::changed);
+            ASSERT_TRUE(event.playback_volume.has_value());
+            ASSERT_TRUE(event.playback_volume->front_left.has_value());
+            ASSERT_DOUBLE_EQ(event.playback_volume->front_left.value(), 0);
+        }
+        ASSERT_TRUE(found);
+
+        ASSERT_TRUE(control.set_playback_volume(old_volume.value()).success());
+        break;
+    }
+
+    ASSERT_TRUE(has_playback_volume);
+}
+
 TEST(sound_test, sound_control_name) {
     auto mixer = syst::get_sound_mixer();
     ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
@@ -122,6 +225,30 @@ TEST(sound_test, sound_control_get_playback_volume) {
     ASSERT_TRUE(has_playback_volume);
 }
 
+TEST(sound_test, sound_control_get_db_range) {
+    auto mixer = syst::get_sound_mixer();
+    ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
+    auto controls = mixer->get_controls();
+
+    // For testing purposes, there must be at least one sound control element.
+    ASSERT_NE(controls.size(), 0);
+
+    for (auto& control : controls) {
+        // Not all control elements provide decibel information.
+        auto playback_range = control.get_playback_db_range();
+        if (playback_range.has_value()) {
+            ASSERT_TRUE(control.has_playback_volume());
+            ASSERT_LE(playback_range->min, playback_range->max);
+        }
+
+        auto capture_range = control.get_capture_db_range();
+        if (capture_range.has_value()) {
+            ASSERT_TRUE(control.has_capture_volume());
+            ASSERT_LE(capture_range->min, capture_range->max);
+        }
+    }
+}
+
 TEST(sound_test, sound_control_get_capture_status) {
     auto mixer = syst::get_sound_mixer();
     ASSERT_TRUE(mixer.has_value()) << RES_TRACE(mixer.error());
@@ -1040,3 +1167,71 @@ TEST(sound_test, sound_control_set_capture_volume_all_relative) {
 
     ASSERT_TRUE(has_capture_volume);
 }
+
+namespace {
+
+// Stands in for a control element whose playback volume fails to be read.
+struct failing_control_t {
+    bool has_playback_status() const { return true; }
+    bool has_playback_volume() const { return true; }
+    bool has_capture_status() const { return false; }
+    bool has_capture_volume() const { return false; }
+
+    res::optional_t<syst::sound_control_t::status_t>
+    get_playback_status() const {
+        syst::sound_control_t::status_t status{};
+        status.front_left = true;
+        return status;
+    }
+
+    res::optional_t<syst::sound_control_t::volume_t>
+    get_playback_volume() const {
+        return RES_NEW_ERROR("Failed to read the playback volume.");
+    }
+
+    res::optional_t<syst::sound_control_t::status_t>
+    get_capture_status() const {
+        return RES_NEW_ERROR("The control element has no capture status.");
+    }
+
+    res::optional_t<syst::sound_control_t::volume_t>
+    get_capture_volume() const {
+        return RES_NEW_ERROR("The control element has no capture volume.");
+    }
+};
+
+} // namespace
+
+TEST(sound_test, sound_events_keep_events_after_failed_read) {
+    using type_t = syst::sound_event_t::type_t;
+
+    std::vector<syst::pending_sound_event_t> pending{
+        {nullptr, type_t::changed, "Master", 0},
+        {nullptr, type_t::added, "Headphone", 0},
+        {nullptr, type_t::removed, "Speaker", 1},
+    };
+
+    const failing_control_t control;
+    auto events = syst::make_sound_events(
+      pending,
+      [&control](const std::string& name, unsigned int) {
+          return name == "Master" ? &control : nullptr;
+      });
+
+    ASSERT_EQ(events.size(), 3);
+
+    EXPECT_EQ(events[0].type, type_t::changed);
+    EXPECT_EQ(events[0].name, "Master");
+    ASSERT_TRUE(events[0].playback_status.has_value());
+    EXPECT_EQ(events[0].playback_status->front_left, true);
+    EXPECT_FALSE(events[0].playback_volume.has_value());
+    EXPECT_FALSE(events[0].capture_status.has_value());
+    EXPECT_FALSE(events[0].capture_volume.has_value());
+
+    EXPECT_EQ(events[1].type, type_t::added);
+    EXPECT_EQ(events[1].name, "Headphone");
+
+    EXPECT_EQ(events[2].type, type_t::removed);
+    EXPECT_EQ(events[2].name, "Speaker");
+    EXPECT_EQ(events[2].index, 1);
+}
@@ -0,0 +1,161 @@
+// Standard includes
+#include <thread>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+
+[[nodiscard]] std::optional<std::pair<std::string, unsigned int>>
+find_playback_volume(syst::sound_worker_t& worker) {
+    std::optional<std::pair<std::string, unsigned int>> found;
+
+    worker
+      .submit([&found](syst::sound_mixer_t& mixer) {
+          for (auto& control : mixer.get_controls()) {
+              if (control.has_playback_volume()) {
+                  found = { control.get_name(), control.get_index() };
+                  return;
+              }
+          }
+      })
+      .get();
+
+    return found;
+}
+
+TEST(sound_worker_test, get) {
+    auto worker = syst::get_sound_worker();
+    ASSERT_TRUE(worker.has_value()) << RES_TRACE(worker.error());
+
+    ASSERT_FALSE(syst::get_sound_worker("hw:999").has_value());
+}
+
+TEST(sound_worker_test, missing_control) {
+    auto worker = syst::get_sound_worker();
+    ASSERT_TRUE(worker.has_value()) << RES_TRACE(worker.error());
+
+    ASSERT_FALSE(worker->get_playback_volume("").get().has_value());
+    ASSERT_FALSE(worker->set_playback_volume_all("", 0, 0).get().success());
+}
+
+TEST(sound_worker_test, set_playback_volume) {
+    auto worker = syst::get_sound_worker();
+    ASSERT_TRUE(worker.has_value()) << RES_TRACE(worker.error());
+
+    // For testing purposes, there must be at least one control element with a
+    // playback volume.
+    auto control = find_playback_volume(worker.value());
+    ASSERT_TRUE(control.has_value());
+    const auto& [name, index] = control.value();
+
+    auto old_volume = worker->get_playback_volume(name, index).get();
+    ASSERT_TRUE(old_volume.has_value()) << RES_TRACE(old_volume.error());
+
+    auto result = worker->set_playback_volume_all(name, index, 0).get();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    // Commands submitted by several threads are executed in order for each
+    // thread.
+    const size_t thread_count = 4;
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < thread_count; ++thread) {
+        threads.emplace_back([&worker, &name = name, index = index]() {
+            std::vector<std::future<res::result_t>> results;
+            for (int step = 0; step < 5; ++step) {
+                results.push_back(
+                  worker->set_playback_volume_all_relative(name, index, 1));
+            }
+            for (auto& result : results) {
+                EXPECT_TRUE(result.get().success());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto volume = worker->get_playback_volume(name, index).get();
+    ASSERT_TRUE(volume.has_value()) << RES_TRACE(volume.error());
+    ASSERT_TRUE(volume->front_left.has_value());
+    ASSERT_GT(volume->front_left.value(), 0);
+
+    ASSERT_FALSE(
+      worker->set_playback_volume_all(name, index, 101).get().success());
+
+    auto status = worker->get_playback_status(name, index).get();
+    ASSERT_TRUE(status.has_value()) << RES_TRACE(status.error());
+
+    // For some reason, resetting the volume too quickly fails but does not
+    // provide a reason why.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    worker
+      ->submit([&](syst::sound_mixer_t& mixer) {
+          auto* control = mixer.find_control(name, index);
+          ASSERT_NE(control, nullptr);
+          ASSERT_TRUE(
+            control->set_playback_volume(old_volume.value()).success());
+      })
+      .get();
+}
+
+TEST(sound_worker_test, ramp_playback_volume) {
+    auto worker = syst::get_sound_worker();
+    ASSERT_TRUE(worker.has_value()) << RES_TRACE(worker.error());
+
+    auto control = find_playback_volume(worker.value());
+    ASSERT_TRUE(control.has_value());
+    const auto& [name, index] = control.value();
+
+    auto old_volume = worker->get_playback_volume(name, index).get();
+    ASSERT_TRUE(old_volume.has_value()) << RES_TRACE(old_volume.error());
+
+    ASSERT_TRUE(
+      worker->set_playback_volume_all(name, index, 100).get().success());
+
+    // A new ramp cancels the previous ramp of the same control element.
+    auto cancelled = worker->ramp_playback_volume_all(
+      name, index, 50, std::chrono::seconds(10));
+    auto ramp = worker->ramp_playback_volume_all(
+      name, index, 0, std::chrono::milliseconds(50));
+    ASSERT_FALSE(cancelled.get().success());
+
+    auto result = ramp.get();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+
+    auto volume = worker->get_playback_volume(name, index).get();
+    ASSERT_TRUE(volume.has_value()) << RES_TRACE(volume.error());
+    ASSERT_TRUE(volume->front_left.has_value());
+    ASSERT_DOUBLE_EQ(volume->front_left.value(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    worker
+      ->submit([&](syst::sound_mixer_t& mixer) {
+          auto* control = mixer.find_control(name, index);
+          ASSERT_NE(control, nullptr);
+          ASSERT_TRUE(
+            control->set_playback_volume(old_volume.value()).success());
+      })
+      .get();
+}
+
+TEST(sound_worker_test, stop_cancels_ramps) {
+    std::future<res::result_t> ramp;
+
+    {
+        auto worker = syst::get_sound_worker();
+        ASSERT_TRUE(worker.has_value()) << RES_TRACE(worker.error());
+
+        auto control = find_playback_volume(worker.value());
+        ASSERT_TRUE(control.has_value());
+        const auto& [name, index] = control.value();
+
+        ramp = worker->ramp_playback_volume_all(
+          name, index, 0, std::chrono::seconds(10));
+    }
+
+    ASSERT_FALSE(ramp.get().success());
+}
@@ -1,9 +1,12 @@
+// Standard includes
+
 // External includes
 #include <filesystem>
 #include <gtest/gtest.h>
 
 // Local includes
 #include "../system_state/system_state.hpp"
+#include "fixture.hpp"
 
 TEST(thermal_test, thermal_zone_all) {
     auto thermal_zones = syst::get_thermal_zones();
@@ -144,3 +147,92 @@ TEST(thermal_test, cooling_device_set_state) {
         ASSERT_TRUE(device.set_state(old_state.value()).success());
     }
 }
+
+namespace fs = std::filesystem;
+
+class thermal_fixture_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+
+    thermal_fixture_test() : fixture_test_t("thermal") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->class_path_ = this->root_ / "class" / "thermal";
+        fs::create_directories(this->class_path_);
+
+        fs::path zone_path = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(zone_path);
+        write_file(zone_path / "type", "acpitz");
+        write_file(zone_path / "temp", "40000");
+        write_file(zone_path / "trip_point_0_temp", "90000");
+        write_file(zone_path / "trip_point_0_type", "passive");
+        write_file(zone_path / "trip_point_1_temp", "105000");
+        write_file(zone_path / "trip_point_1_type", "critical");
+        fs::create_directory_symlink(
+          zone_path, this->class_path_ / "thermal_zone0");
+    }
+};
+
+TEST_F(thermal_fixture_test, capabilities) {
+    auto thermal_zones = syst::get_thermal_zones(this->class_path_);
+    ASSERT_TRUE(thermal_zones.has_value()) << RES_TRACE(thermal_zones.error());
+    ASSERT_EQ(thermal_zones->size(), 1);
+
+    auto capabilities = thermal_zones->front().get_capabilities();
+    ASSERT_TRUE(capabilities.temperature);
+    ASSERT_EQ(capabilities.trip_points, 2);
+    ASSERT_DOUBLE_EQ(thermal_zones->front().get_temperature().value(), 40);
+}
+
+TEST_F(thermal_fixture_test, missing_temperature) {
+    fs::remove(this->class_path_ / "thermal_zone0" / "temp");
+
+    auto thermal_zones = syst::get_thermal_zones(this->class_path_);
+    ASSERT_TRUE(thermal_zones.has_value()) << RES_TRACE(thermal_zones.error());
+    ASSERT_EQ(thermal_zones->size(), 1);
+
+    ASSERT_FALSE(thermal_zones->front().get_capabilities().temperature);
+
+    // The temperature is not read even if the attribute appears later.
+    write_file(this->class_path_ / "thermal_zone0" / "temp", "40000");
+    ASSERT_FALSE(thermal_zones->front().get_temperature().has_value());
+}
+
+TEST_F(thermal_fixture_test, class_entries) {
+    // Regular files, directories and cooling devices are not thermal zones.
+    write_file(this->class_path_ / "thermal_zone_file", "0");
+    fs::create_directory(this->class_path_ / "thermal_zone_directory");
+
+    fs::path device_path = this->root_ / "devices" / "cooling_device0";
+    fs::create_directories(device_path);
+    fs::create_directory_symlink(
+      device_path, this->class_path_ / "cooling_device0");
+
+    // More entries than fit into a single read of the directory.
+    const int zones = 1000;
+    for (int idx = 1; idx < zones; ++idx) {
+        fs::create_directory_symlink(this->root_ / "devices" / "thermal_zone0",
+          this->class_path_ / ("thermal_zone" + std::to_string(idx)));
+    }
+
+    auto thermal_zones = syst::get_thermal_zones(this->class_path_);
+    ASSERT_TRUE(thermal_zones.has_value()) << RES_TRACE(thermal_zones.error());
+    ASSERT_EQ(thermal_zones->size(), zones);
+
+    auto cooling_devices = syst::get_cooling_devices(this->class_path_);
+    ASSERT_TRUE(cooling_devices.has_value())
+      << RES_TRACE(cooling_devices.error());
+    ASSERT_EQ(cooling_devices->size(), 1);
+    ASSERT_EQ(cooling_devices->front().get_sysfs_path(),
+      this->class_path_ / "cooling_device0");
+}
+
+TEST_F(thermal_fixture_test, missing_class) {
+    ASSERT_FALSE(syst::get_thermal_zones(this->root_ / "missing").has_value());
+    ASSERT_FALSE(
+      syst::get_thermal_zones(this->class_path_ / "thermal_zone0" / "type")
+        .has_value());
+}
@@ -0,0 +1,256 @@
+// Standard includes
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class thermal_governor_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+    fs::path zone_path_;
+    fs::path device_path_;
+
+    thermal_governor_test() : fixture_test_t("thermal_governor") {
+    }
+
+    static std::string read(const fs::path& path) {
+        std::ifstream file{ path };
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->class_path_ = this->root_ / "class" / "thermal";
+        fs::create_directories(this->class_path_);
+
+        this->zone_path_ = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(this->zone_path_);
+        overwrite_file(this->zone_path_ / "type", "x86_pkg_temp");
+        overwrite_file(this->zone_path_ / "temp", "40000");
+        fs::create_directory_symlink(
+          this->zone_path_, this->class_path_ / "thermal_zone0");
+
+        this->device_path_ = this->root_ / "devices" / "cooling_device0";
+        fs::create_directories(this->device_path_);
+        overwrite_file(this->device_path_ / "type", "Fan");
+        overwrite_file(this->device_path_ / "max_state", "10");
+        overwrite_file(this->device_path_ / "cur_state", "0    ");
+        fs::create_directory_symlink(
+          this->device_path_, this->class_path_ / "cooling_device0");
+    }
+
+    void set_temperature(double celsius) {
+        overwrite_file(this->zone_path_ / "temp",
+          std::to_string(static_cast<int64_t>(celsius * 1e3)));
+    }
+
+    [[nodiscard]] uint64_t get_state() {
+        return std::stoull(read(this->device_path_ / "cur_state"));
+    }
+
+    [[nodiscard]] syst::thermal_governor_t bind(
+      const syst::step_policy_t& policy) {
+        auto zones = syst::get_thermal_zones(this->class_path_);
+        EXPECT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+        EXPECT_EQ(zones->size(), 1);
+        auto devices = syst::get_cooling_devices(this->class_path_);
+        EXPECT_TRUE(devices.has_value()) << RES_TRACE(devices.error());
+        EXPECT_EQ(devices->size(), 1);
+
+        syst::thermal_governor_t governor;
+        auto result = governor.bind(zones->front(), devices->front(), policy);
+        EXPECT_TRUE(result.success()) << RES_TRACE(result.error());
+        return governor;
+    }
+
+    [[nodiscard]] syst::thermal_governor_t bind(
+      const syst::pid_policy_t& policy) {
+        auto zones = syst::get_thermal_zones(this->class_path_);
+        EXPECT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+        auto devices = syst::get_cooling_devices(this->class_path_);
+        EXPECT_TRUE(devices.has_value()) << RES_TRACE(devices.error());
+
+        syst::thermal_governor_t governor;
+        auto result = governor.bind(zones->front(), devices->front(), policy);
+        EXPECT_TRUE(result.success()) << RES_TRACE(result.error());
+        return governor;
+    }
+};
+
+TEST_F(thermal_governor_test, step_policy_increase) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+
+    this->set_temperature(70);
+    for (uint64_t expected = 1; expected <= 10; ++expected) {
+        ASSERT_TRUE(governor.step().success());
+        ASSERT_EQ(this->get_state(), expected);
+    }
+
+    // The state never exceeds 'max_state'.
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 10);
+}
+
+TEST_F(thermal_governor_test, step_policy_hysteresis) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+
+    this->set_temperature(70);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 2);
+
+    // Within the hysteresis band the state is held.
+    this->set_temperature(57);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 2);
+
+    this->set_temperature(50);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 1);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 0);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 0);
+}
+
+TEST_F(thermal_governor_test, pid_policy_proportional) {
+    auto governor = this->bind(syst::pid_policy_t{ 50, 10, 0, 0 });
+
+    this->set_temperature(55);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 5);
+
+    this->set_temperature(80);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 10);
+
+    this->set_temperature(40);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 0);
+}
+
+TEST_F(thermal_governor_test, unchanged_state_is_not_written) {
+    auto governor = this->bind(syst::pid_policy_t{ 50, 10, 0, 0 });
+
+    this->set_temperature(55);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 5);
+
+    // The governor does not write the same state twice, so a value written by
+    // someone else survives the next step.
+    overwrite_file(this->device_path_ / "cur_state", "7");
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 7);
+}
+
+TEST_F(thermal_governor_test, max_state_is_cached) {
+    auto governor = this->bind(syst::pid_policy_t{ 50, 10, 0, 0 });
+
+    overwrite_file(this->device_path_ / "max_state", "20");
+    this->set_temperature(55);
+    ASSERT_TRUE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 5);
+}
+
+TEST_F(thermal_governor_test, dispatch_requires_start) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+    ASSERT_EQ(governor.get_fd(), -1);
+    ASSERT_FALSE(governor.dispatch().success());
+}
+
+TEST_F(thermal_governor_test, dispatch) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+    ASSERT_TRUE(governor.start(std::chrono::milliseconds(1)).success());
+    ASSERT_GE(governor.get_fd(), 0);
+
+    this->set_temperature(70);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Several expirations collapse into a single control step.
+    ASSERT_TRUE(governor.dispatch().success());
+    ASSERT_EQ(this->get_state(), 1);
+}
+
+TEST_F(thermal_governor_test, run_and_stop) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+    ASSERT_TRUE(governor.start(std::chrono::milliseconds(1)).success());
+
+    this->set_temperature(70);
+    std::thread stopper{ [&governor]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        governor.stop();
+    } };
+    auto result = governor.run();
+    stopper.join();
+
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    ASSERT_GE(this->get_state(), 1);
+}
+
+TEST_F(thermal_governor_test, stop_before_run) {
+    auto governor = this->bind(syst::step_policy_t{ 60, 5 });
+    ASSERT_TRUE(governor.start(std::chrono::hours(1)).success());
+
+    governor.stop();
+    auto result = governor.run();
+    ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+}
+
+TEST_F(thermal_governor_test, failed_binding_does_not_skip_others) {
+    fs::path zone_path = this->root_ / "devices" / "thermal_zone1";
+    fs::create_directories(zone_path);
+    overwrite_file(zone_path / "type", "acpitz");
+    overwrite_file(zone_path / "temp", "40000");
+    fs::create_directory_symlink(
+      zone_path, this->class_path_ / "thermal_zone1");
+
+    auto zones = syst::get_thermal_zones(this->class_path_);
+    ASSERT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+    ASSERT_EQ(zones->size(), 2);
+    auto devices = syst::get_cooling_devices(this->class_path_);
+    ASSERT_TRUE(devices.has_value()) << RES_TRACE(devices.error());
+
+    // Bind the zone that fails first.
+    std::sort(zones->begin(), zones->end(), [](const auto& a, const auto& b) {
+        return a.get_sysfs_path().filename() > b.get_sysfs_path().filename();
+    });
+    syst::thermal_governor_t governor;
+    for (const syst::thermal_zone_t& zone : zones.value()) {
+        auto result = governor.bind(
+          zone, devices->front(), syst::step_policy_t{ 60, 5 });
+        ASSERT_TRUE(result.success()) << RES_TRACE(result.error());
+    }
+
+    overwrite_file(zone_path / "temp", "invalid");
+    this->set_temperature(70);
+    ASSERT_FALSE(governor.step().success());
+    ASSERT_EQ(this->get_state(), 1);
+}
+
+TEST_F(thermal_governor_test, bind_missing_device) {
+    auto zones = syst::get_thermal_zones(this->class_path_);
+    ASSERT_TRUE(zones.has_value()) << RES_TRACE(zones.error());
+    auto devices = syst::get_cooling_devices(this->class_path_);
+    ASSERT_TRUE(devices.has_value()) << RES_TRACE(devices.error());
+
+    fs::remove(this->device_path_ / "max_state");
+
+    syst::thermal_governor_t governor;
+    ASSERT_FALSE(governor
+                   .bind(zones->front(),
+                     devices->front(),
+                     syst::step_policy_t{ 60, 5 })
+                   .success());
+}
@@ -0,0 +1,230 @@
+// Standard includes
+#include <filesystem>
+#include <thread>
+
+// External includes
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class thermal_monitor_fixture_test : public fixture_test_t {
+  protected:
+    fs::path class_path_;
+    fs::path zone_path_;
+
+    thermal_monitor_fixture_test() : fixture_test_t("thermal_monitor") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->class_path_ = this->root_ / "class" / "thermal";
+        fs::create_directories(this->class_path_);
+
+        this->zone_path_ = this->root_ / "devices" / "thermal_zone0";
+        fs::create_directories(this->zone_path_);
+        overwrite_file(this->zone_path_ / "type", "x86_pkg_temp");
+        overwrite_file(this->zone_path_ / "temp", "40000");
+        overwrite_file(this->zone_path_ / "trip_point_0_temp", "80000");
+        overwrite_file(this->zone_path_ / "trip_point_0_type", "passive");
+        overwrite_file(this->zone_path_ / "trip_point_1_temp", "100000");
+        overwrite_file(this->zone_path_ / "trip_point_1_type", "critical");
+        fs::create_directory_symlink(
+          this->zone_path_, this->class_path_ / "thermal_zone0");
+    }
+
+    void set_temperature(double celsius) {
+        overwrite_file(this->zone_path_ / "temp",
+          std::to_string(static_cast<int64_t>(celsius * 1e3)));
+    }
+
+    [[nodiscard]] syst::thermal_monitor_t monitor(
+      const syst::thermal_monitor_options_t& options = {}) {
+        auto monitor = syst::get_thermal_monitor(options, this->class_path_);
+        EXPECT_TRUE(monitor.has_value()) << RES_TRACE(monitor.error());
+        return std::move(monitor.value());
+    }
+};
+
+TEST(thermal_monitor_test, all) {
+    auto monitor = syst::get_thermal_monitor();
+    ASSERT_TRUE(monitor.has_value()) << RES_TRACE(monitor.error());
+    ASSERT_TRUE(monitor->update().success());
+}
+
+TEST_F(thermal_monitor_fixture_test, trip_points) {
+    auto monitor = this->monitor();
+    ASSERT_EQ(monitor.get_zones().size(), 1);
+
+    const auto& zone = monitor.get_zones().front();
+    ASSERT_EQ(zone.type, "x86_pkg_temp");
+    ASSERT_EQ(zone.samples, 0);
+    ASSERT_EQ(zone.trip_points.size(), 2);
+    ASSERT_EQ(zone.trip_points[0].type, "passive");
+    ASSERT_DOUBLE_EQ(zone.trip_points[0].temperature, 80);
+    ASSERT_EQ(zone.trip_points[1].type, "critical");
+    ASSERT_DOUBLE_EQ(zone.trip_points[1].temperature, 100);
+}
+
+TEST_F(thermal_monitor_fixture_test, summary) {
+    auto monitor = this->monitor({ 0.5, 5 });
+
+    for (double temperature : { 40.0, 50.0, 30.0 }) {
+        this->set_temperature(temperature);
+        ASSERT_TRUE(monitor.update().success());
+    }
+
+    const auto& zone = monitor.get_zones().front();
+    ASSERT_EQ(zone.samples, 3);
+    ASSERT_DOUBLE_EQ(zone.current, 30);
+    ASSERT_DOUBLE_EQ(zone.min, 30);
+    ASSERT_DOUBLE_EQ(zone.max, 50);
+    ASSERT_DOUBLE_EQ(zone.ewma, 37.5);
+}
+
+TEST_F(thermal_monitor_fixture_test, percentile) {
+    auto monitor = this->monitor();
+    ASSERT_FALSE(monitor.get_percentile(0, 50).has_value());
+
+    for (int temperature = 1; temperature <= 100; ++temperature) {
+        this->set_temperature(temperature);
+        ASSERT_TRUE(monitor.update().success());
+    }
+
+    auto median = monitor.get_percentile(0, 50);
+    ASSERT_TRUE(median.has_value()) << RES_TRACE(median.error());
+    ASSERT_NEAR(median.value(), 50, 0.5);
+
+    auto p99 = monitor.get_percentile(0, 99);
+    ASSERT_TRUE(p99.has_value()) << RES_TRACE(p99.error());
+    ASSERT_NEAR(p99.value(), 99, 0.5);
+
+    ASSERT_DOUBLE_EQ(monitor.get_percentile(0, 0).value(), 1);
+    ASSERT_DOUBLE_EQ(monitor.get_percentile(0, 100).value(), 100);
+
+    ASSERT_FALSE(monitor.get_percentile(1, 50).has_value());
+    ASSERT_FALSE(monitor.get_percentile(0, 101).has_value());
+}
+
+TEST_F(thermal_monitor_fixture_test, events) {
+    auto monitor = this->monitor({ 0.1, 5 });
+
+    ASSERT_TRUE(monitor.update().success());
+    ASSERT_TRUE(monitor.take_events().empty());
+
+    this->set_temperature(77);
+    ASSERT_TRUE(monitor.update().success());
+    auto events = monitor.take_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(events[0].type, syst::thermal_event_t::type_t::approaching_trip);
+    ASSERT_EQ(events[0].zone, 0);
+    ASSERT_EQ(events[0].trip_point.type, "passive");
+    ASSERT_DOUBLE_EQ(events[0].temperature, 77);
+
+    // Events are only generated when the level of a trip point changes.
+    ASSERT_TRUE(monitor.update().success());
+    ASSERT_TRUE(monitor.take_events().empty());
+
+    this->set_temperature(96);
+    ASSERT_TRUE(monitor.update().success());
+    events = monitor.take_events();
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_EQ(
+      events[0].type, syst::thermal_event_t::type_t::throttling_started);
+    ASSERT_EQ(events[1].type, syst::thermal_event_t::type_t::approaching_trip);
+    ASSERT_EQ(events[1].trip_point.type, "critical");
+
+    this->set_temperature(60);
+    ASSERT_TRUE(monitor.update().success());
+    events = monitor.take_events();
+    ASSERT_EQ(events.size(), 1);
+    ASSERT_EQ(
+      events[0].type, syst::thermal_event_t::type_t::throttling_stopped);
+}
+
+TEST_F(thermal_monitor_fixture_test, summary_io_uring) {
+    // Falls back to pread(2) if io_uring is unavailable, so the summary is the
+    // same either way.
+    auto monitor = this->monitor({ 0.5, 5, true });
+
+    for (double temperature : { 40.0, 50.0, 30.0 }) {
+        this->set_temperature(temperature);
+        ASSERT_TRUE(monitor.update().success());
+    }
+
+    const auto& zone = monitor.get_zones().front();
+    ASSERT_EQ(zone.samples, 3);
+    ASSERT_DOUBLE_EQ(zone.current, 30);
+    ASSERT_DOUBLE_EQ(zone.min, 30);
+    ASSERT_DOUBLE_EQ(zone.max, 50);
+}
+
+TEST_F(thermal_monitor_fixture_test, trip_points_reached_at_once) {
+    auto monitor = this->monitor({ 0.1, 5 });
+
+    ASSERT_TRUE(monitor.update().success());
+    ASSERT_TRUE(monitor.take_events().empty());
+
+    this->set_temperature(101);
+    ASSERT_TRUE(monitor.update().success());
+    auto events = monitor.take_events();
+    ASSERT_EQ(events.size(), 4);
+    ASSERT_EQ(events[0].type, syst::thermal_event_t::type_t::approaching_trip);
+    ASSERT_EQ(events[0].trip_point.type, "passive");
+    ASSERT_EQ(
+      events[1].type, syst::thermal_event_t::type_t::throttling_started);
+    ASSERT_EQ(events[2].type, syst::thermal_event_t::type_t::approaching_trip);
+    ASSERT_EQ(events[2].trip_point.type, "critical");
+    ASSERT_EQ(events[3].type, syst::thermal_event_t::type_t::trip_reached);
+    ASSERT_EQ(events[3].trip_point.type, "critical");
+}
+
+TEST_F(thermal_monitor_fixture_test, failed_zone_does_not_skip_others) {
+    fs::path zone_path = this->root_ / "devices" / "thermal_zone1";
+    fs::create_directories(zone_path);
+    overwrite_file(zone_path / "type", "acpitz");
+    overwrite_file(zone_path / "temp", "40000");
+    fs::create_directory_symlink(
+      zone_path, this->class_path_ / "thermal_zone1");
+
+    auto monitor = this->monitor();
+    ASSERT_EQ(monitor.get_zones().size(), 2);
+
+    overwrite_file(zone_path / "temp", "invalid");
+    ASSERT_FALSE(monitor.update().success());
+    for (const syst::thermal_zone_summary_t& zone : monitor.get_zones()) {
+        ASSERT_EQ(zone.samples, zone.type == "acpitz" ? 0 : 1);
+    }
+}
+
+TEST_F(thermal_monitor_fixture_test, trip_points_are_cached) {
+    auto monitor = this->monitor();
+    overwrite_file(this->zone_path_ / "trip_point_0_temp", "50000");
+
+    this->set_temperature(60);
+    ASSERT_TRUE(monitor.update().success());
+    ASSERT_TRUE(monitor.take_events().empty());
+}
+
+TEST_F(thermal_monitor_fixture_test, dispatch) {
+    auto monitor = this->monitor();
+    ASSERT_EQ(monitor.get_fd(), -1);
+    ASSERT_FALSE(monitor.dispatch().success());
+
+    ASSERT_TRUE(monitor.start(std::chrono::milliseconds(1)).success());
+    ASSERT_GE(monitor.get_fd(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Several expirations collapse into a single sample.
+    ASSERT_TRUE(monitor.dispatch().success());
+    ASSERT_EQ(monitor.get_zones().front().samples, 1);
+}
+
+TEST_F(thermal_monitor_fixture_test, invalid_weight) {
+    auto monitor = syst::get_thermal_monitor({ 0, 5 }, this->class_path_);
+    ASSERT_FALSE(monitor.has_value());
+}
@@ -0,0 +1,101 @@
+// Standard includes
+#include <filesystem>
+#include <string>
+
+// External includes
+#include <fcntl.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "../src/util.hpp"
+#include "../system_state/system_state.hpp"
+#include "fixture.hpp"
+
+namespace fs = std::filesystem;
+
+class util_test : public fixture_test_t {
+  protected:
+    fs::path device_path_;
+
+    util_test() : fixture_test_t("util") {
+    }
+
+    void SetUp() override {
+        fixture_test_t::SetUp();
+
+        this->device_path_ = this->root_ / "devices" / "backlight0";
+        fs::create_directories(this->device_path_);
+        write_file(this->device_path_ / "brightness", "250");
+        write_file(this->device_path_ / "max_brightness", "none");
+    }
+};
+
+TEST_F(util_test, read_int) {
+    const fs::path path = this->device_path_ / "brightness";
+    uint64_t integer = 0;
+    const syst::read_error_t error = syst::read_int(path, integer);
+    ASSERT_FALSE(error.failed()) << error.to_error();
+    ASSERT_EQ(integer, 250);
+}
+
+TEST_F(util_test, read_int_at) {
+    auto dir = syst::open_device_dir(nullptr, this->device_path_.c_str());
+    ASSERT_TRUE(dir.has_value()) << RES_TRACE(dir.error());
+
+    uint64_t integer = 0;
+    syst::read_error_t error =
+      syst::read_int_at(*dir.value(), "brightness", integer);
+    ASSERT_FALSE(error.failed()) << error.to_error();
+    ASSERT_EQ(integer, 250);
+
+    error = syst::read_int_at(*dir.value(), "max_brightness", integer);
+    ASSERT_TRUE(error.failed());
+}
+
+TEST_F(util_test, invalid_integer) {
+    const fs::path path = this->device_path_ / "max_brightness";
+    uint64_t integer = 0;
+    const syst::read_error_t error = syst::read_int(path, integer);
+    ASSERT_TRUE(error.failed());
+
+    // Errors are formatted when they are reported, so they still name the file
+    // and the reason.
+    const std::string message = error.to_error().string();
+    ASSERT_NE(message.find(path.string()), std::string::npos);
+    ASSERT_NE(message.find("not an integer"), std::string::npos);
+}
+
+TEST_F(util_test, missing_file) {
+    const fs::path path = this->device_path_ / "actual_brightness";
+    uint64_t integer = 0;
+    const syst::read_error_t error = syst::read_int(path, integer);
+    ASSERT_TRUE(error.failed());
+
+    const std::string message = error.to_error().string();
+    ASSERT_NE(message.find(path.string()), std::string::npos);
+}
+
+TEST_F(util_test, failed_probe_does_not_allocate) {
+    const fs::path invalid_path = this->device_path_ / "max_brightness";
+    const fs::path missing_path = this->device_path_ / "actual_brightness";
+    auto dir = syst::open_device_dir(nullptr, this->device_path_.c_str());
+    ASSERT_TRUE(dir.has_value()) << RES_TRACE(dir.error());
+
+    syst::reset_stats();
+    uint64_t integer = 0;
+    bool boolean = false;
+    const bool failed = syst::read_int(invalid_path, integer).failed()
+      && syst::read_int(missing_path, integer).failed()
+      && syst::read_bool(invalid_path, boolean).failed()
+      && syst::read_int_at(*dir.value(), "max_brightness", integer).failed()
+      && syst::read_bool_at(*dir.value(), "actual_brightness", boolean)
+           .failed();
+    const syst::stats_t stats = syst::stats();
+    ASSERT_TRUE(failed);
+
+    if (! stats.enabled) {
+        GTEST_SKIP() << "The library was built without instrumentation.";
+    }
+    ASSERT_EQ(stats.total.allocations, 0);
+    ASSERT_GT(stats.total.opens, 0);
+}